@@ -0,0 +1,96 @@
+/**
+ * @file SerialInputDma.cpp
+ * @brief Double-buffered DMA transmit path
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * The board engines (SERIAL_TX_DMA) live in SerialInputMonitor.cpp,
+ * next to the other platform code; this unit does not depend on the
+ * Arduino core.
+ *
+ * @author Leonardo Klein
+ */
+
+#include "SerialInputDma.h"
+
+#include <string.h>
+
+DmaTx::DmaTx(uint8_t *storage, uint16_t size, const TxDmaEngine &engine)
+    : m_storage(storage), m_size(size), m_engine(engine), m_fill(0), m_length(0), m_inFlight(0) {
+    resetStats();
+}
+
+bool DmaTx::fits(uint16_t length) {
+    service();
+    return m_size - m_length >= length;
+}
+
+void DmaTx::write(const uint8_t *data, uint16_t length) {
+    service();
+    m_stats.lines++;
+    m_stats.bytes += length;
+
+    bool waited = false;
+    while (length > 0) {
+        if (m_length == m_size) {
+            // Both buffers full: wait for the one on the wire
+            waited = true;
+            finish();
+            kick();
+        }
+        uint16_t part = m_size - m_length < length ? m_size - m_length : length;
+        memcpy(m_storage + m_fill * m_size + m_length, data, part);
+        m_length += part;
+        data += part;
+        length -= part;
+    }
+    if (waited) {
+        m_stats.waits++;
+    }
+    if (m_inFlight == 0) {
+        kick();
+    }
+}
+
+void DmaTx::service() {
+    if (m_inFlight > 0 && !m_engine.busy()) {
+        m_inFlight = 0;
+    }
+    if (m_inFlight == 0) {
+        kick();
+    }
+}
+
+void DmaTx::flush() {
+    service();
+    finish();
+    kick();
+    finish();
+}
+
+uint16_t DmaTx::pending() {
+    service();
+    return m_inFlight + m_length;
+}
+
+void DmaTx::resetStats() {
+    memset(&m_stats, 0, sizeof(m_stats));
+}
+
+void DmaTx::kick() {
+    if (m_length == 0) {
+        return;
+    }
+    m_engine.start(m_storage + m_fill * m_size, m_length);
+    m_stats.transfers++;
+    m_inFlight = m_length;
+    m_fill ^= 1;
+    m_length = 0;
+}
+
+void DmaTx::finish() {
+    if (m_inFlight > 0) {
+        m_engine.wait();
+        m_inFlight = 0;
+    }
+}
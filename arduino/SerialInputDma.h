@@ -0,0 +1,169 @@
+/**
+ * @file SerialInputDma.h
+ * @brief Double-buffered transmit path drained by DMA
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Serial copies each byte into a ring and the CPU takes a TX interrupt
+ * per byte. DmaTx instead appends lines to one of two buffers while a
+ * DMA channel sends the other, and swaps when the transfer completes:
+ *
+ *   DmaTxBuffer<128> tx(SERIAL_TX_DMA);
+ *   monitor.attachDmaTx(&tx);
+ *
+ * The CPU cost of a line is its encoding and one copy; a transfer
+ * carries every line written while the previous one was on the wire.
+ * Lines leave in the order they were written. A line that finds both
+ * buffers full waits for the transfer in flight, as Serial.write()
+ * waits on a full ring.
+ *
+ * The DMA channel sits behind TxDmaEngine, three plain functions.
+ * SERIAL_TX_DMA is the engine of the board, where the library has one
+ * (SIM_HAS_SERIAL_TX_DMA): the RP2040's UART0 and the native
+ * simulator, whose engine drains into the pty like a UART would and
+ * honours its -z stalls. Engines for other boards (SAMD21 DMAC, STM32
+ * DMA streams) fill in the same three functions.
+ *
+ * This header does not depend on the Arduino core, so host benchmarks
+ * can drive DmaTx with engines of their own.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_DMA_H
+#define SERIAL_INPUT_DMA_H
+
+#include <stdint.h>
+
+/**
+ * @brief DMA transmit is available (not on AVR boards, which have no DMA)
+ */
+#if defined(__AVR__)
+#define SIM_HAS_DMA_TX 0
+#else
+#define SIM_HAS_DMA_TX 1
+#endif
+
+/**
+ * @brief DMA channel feeding the transmitter
+ *
+ * DmaTx starts one transfer at a time and never touches its buffer
+ * until busy() returns false or wait() returns.
+ */
+struct TxDmaEngine {
+    void (*start)(const uint8_t *data, uint16_t length); ///< Start sending length bytes; called only when idle
+    bool (*busy)();                                      ///< The last transfer is still running
+    void (*wait)();                                      ///< Block until the last transfer has completed
+};
+
+/**
+ * @brief DmaTx counters
+ */
+struct DmaTxStats {
+    uint32_t lines;     ///< Lines written
+    uint32_t bytes;     ///< Bytes written
+    uint32_t transfers; ///< Transfers started: one completion each, where Serial takes one interrupt per byte
+    uint32_t waits;     ///< Writes that found both buffers full and waited
+};
+
+/**
+ * @brief Two transmit buffers, one filling while DMA drains the other
+ *
+ * Create one with DmaTxBuffer and pass it to attachDmaTx(). Not
+ * reentrant: write from one context (the monitor does not send from a
+ * timer interrupt while it is writing, see isSending()).
+ */
+class DmaTx {
+  public:
+    /**
+     * @brief Create a double buffer over caller-provided storage
+     * @param storage Storage for 2 * size bytes
+     * @param size Bytes per buffer
+     * @param engine DMA engine (copied)
+     */
+    DmaTx(uint8_t *storage, uint16_t size, const TxDmaEngine &engine);
+
+    /**
+     * @brief Check if a line can be written without waiting
+     * @param length Line length
+     * @return true if the filling buffer has room for it
+     */
+    bool fits(uint16_t length);
+
+    /**
+     * @brief Append a line
+     * @param data Line bytes
+     * @param length Line length
+     *
+     * Starts a transfer at once when the channel is idle. A line that
+     * does not fit continues in the other buffer once it is free.
+     */
+    void write(const uint8_t *data, uint16_t length);
+
+    /**
+     * @brief Start the filled buffer once the transfer in flight has completed
+     *
+     * write() does this too; call it while not writing (poll() does) so
+     * lines written during a transfer do not wait for the next write.
+     */
+    void service();
+
+    /**
+     * @brief Block until everything written has been sent
+     */
+    void flush();
+
+    /**
+     * @brief Bytes written and not yet sent
+     * @return Bytes in flight and in the filling buffer
+     */
+    uint16_t pending();
+
+    /**
+     * @brief Counters since the last resetStats()
+     */
+    inline const DmaTxStats &stats() const {
+        return m_stats;
+    }
+
+    /**
+     * @brief Clear the counters
+     */
+    void resetStats();
+
+  private:
+    uint8_t    *m_storage;  ///< Two buffers of m_size bytes
+    uint16_t    m_size;     ///< Bytes per buffer
+    TxDmaEngine m_engine;   ///< DMA channel
+    uint8_t     m_fill;     ///< Index of the filling buffer
+    uint16_t    m_length;   ///< Bytes in the filling buffer
+    uint16_t    m_inFlight; ///< Bytes of the transfer running, 0 when idle
+    DmaTxStats  m_stats;    ///< Counters
+
+    /**
+     * @brief Start sending the filling buffer and switch to the other one
+     */
+    void kick();
+
+    /**
+     * @brief Wait for the transfer in flight
+     */
+    void finish();
+};
+
+/**
+ * @brief DmaTx with its own storage
+ * @tparam Size Bytes per buffer; takes 2 * Size bytes of RAM
+ */
+template <uint16_t Size> class DmaTxBuffer : public DmaTx {
+    static_assert(Size >= 84, "a DMA buffer must hold the longest event line (EVENT_LINE_MAX)");
+
+  public:
+    explicit DmaTxBuffer(const TxDmaEngine &engine) : DmaTx(m_storage, Size, engine) {
+    }
+
+  private:
+    uint8_t m_storage[2 * Size]; ///< Buffer storage
+};
+
+#endif // SERIAL_INPUT_DMA_H
@@ -0,0 +1,349 @@
+/**
+ * @file SerialInputFilters.h
+ * @brief Filter stages for BasicSerialInputMonitor pipelines
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Stages are composed at compile time and inlined into the encoder:
+ *
+ *   typedef KeyTable<KeyMapping<VirtualKey::Y, VirtualKey::Z> > GermanLayout;
+ *   BasicSerialInputMonitor<Pipeline<Remap<GermanLayout>,
+ *                                    BlockCombo<VirtualKey::LEFT_ALT, VirtualKey::F4>,
+ *                                    RateLimit<Scroll, 50> > > monitor;
+ *
+ * Each stage exposes `bool apply(InputEvent &event)` and can be used on
+ * its own, outside of a monitor.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_FILTERS_H
+#define SERIAL_INPUT_FILTERS_H
+
+#include <limits.h>
+
+#include "SerialInputMonitor.h"
+
+// ==================== EVENT CLASSES ====================
+
+/**
+ * @brief Matches every event
+ */
+struct AnyEvent {
+    static inline bool matches(const InputEvent &) {
+        return true;
+    }
+};
+
+/**
+ * @brief Matches keyboard press/release events
+ */
+struct Keys {
+    static inline bool matches(const InputEvent &event) {
+        return event.device == Device::KEYBOARD;
+    }
+};
+
+/**
+ * @brief Matches mouse button press/release events
+ */
+struct MouseButtons {
+    static inline bool matches(const InputEvent &event) {
+        return event.device == Device::MOUSE && event.event <= static_cast<uint8_t>(MouseEvent::MIDDLE_RELEASE);
+    }
+};
+
+/**
+ * @brief Matches mouse wheel events
+ */
+struct Scroll {
+    static inline bool matches(const InputEvent &event) {
+        return event.device == Device::MOUSE && event.event == static_cast<uint8_t>(MouseEvent::SCROLL);
+    }
+};
+
+/**
+ * @brief Matches absolute and relative mouse movement
+ */
+struct Motion {
+    static inline bool matches(const InputEvent &event) {
+        return event.device == Device::MOUSE && (event.event == static_cast<uint8_t>(MouseEvent::POSITION) ||
+                                                 event.event == static_cast<uint8_t>(MouseEvent::MOVE));
+    }
+};
+
+// ==================== KEY TABLES ====================
+
+/**
+ * @brief Single entry of a KeyTable
+ */
+template <VirtualKey From, VirtualKey To> struct KeyMapping {
+    static inline bool map(int &key) {
+        if (key != static_cast<int>(From)) {
+            return false;
+        }
+        key = static_cast<int>(To);
+        return true;
+    }
+};
+
+/**
+ * @brief Compile-time key translation table for Remap
+ *
+ * The first matching mapping wins; unmatched keys pass unchanged.
+ */
+template <typename... Mappings> struct KeyTable;
+
+template <> struct KeyTable<> {
+    static inline bool map(int &) {
+        return false;
+    }
+};
+
+template <typename First, typename... Rest> struct KeyTable<First, Rest...> {
+    static inline bool map(int &key) {
+        return First::map(key) || KeyTable<Rest...>::map(key);
+    }
+};
+
+/**
+ * @brief Compile-time set of virtual keys
+ */
+template <VirtualKey... Members> struct KeySet;
+
+template <> struct KeySet<> {
+    static inline bool contains(int) {
+        return false;
+    }
+};
+
+template <VirtualKey First, VirtualKey... Rest> struct KeySet<First, Rest...> {
+    static inline bool contains(int key) {
+        return key == static_cast<int>(First) || KeySet<Rest...>::contains(key);
+    }
+};
+
+// ==================== STAGES ====================
+
+/**
+ * @brief Translate keyboard key codes through a table
+ * @tparam Table Type with `static bool map(int &key)`, e.g. KeyTable
+ */
+template <typename Table> class Remap {
+  public:
+    inline bool apply(InputEvent &event) {
+        if (event.device == Device::KEYBOARD) {
+            Table::map(event.param1);
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Drop press and release events of the given keys
+ */
+template <VirtualKey... Blocked> class Block {
+  public:
+    inline bool apply(InputEvent &event) {
+        return event.device != Device::KEYBOARD || !KeySet<Blocked...>::contains(event.param1);
+    }
+};
+
+/**
+ * @brief Drop a key while a modifier is held (e.g. Alt+F4)
+ *
+ * A release is only dropped when the matching press was, so the host
+ * never sees a dangling key.
+ */
+template <VirtualKey Modifier, VirtualKey Key> class BlockCombo {
+  private:
+    bool m_modifierHeld = false; ///< Modifier currently pressed
+    bool m_keyBlocked   = false; ///< Last press of Key was dropped
+
+  public:
+    inline bool apply(InputEvent &event) {
+        if (event.device != Device::KEYBOARD) {
+            return true;
+        }
+
+        bool pressed = event.event == static_cast<uint8_t>(KeyboardEvent::PRESS);
+
+        if (event.param1 == static_cast<int>(Modifier)) {
+            m_modifierHeld = pressed;
+            return true;
+        }
+
+        if (event.param1 != static_cast<int>(Key)) {
+            return true;
+        }
+
+        if (pressed) {
+            m_keyBlocked = m_modifierHeld;
+            return !m_keyBlocked;
+        }
+
+        bool blocked = m_keyBlocked;
+        m_keyBlocked = false;
+        return !blocked;
+    }
+};
+
+/**
+ * @brief Drop every event of a class
+ * @tparam Class Event class such as Scroll or Motion
+ */
+template <typename Class> class Suppress {
+  public:
+    inline bool apply(InputEvent &event) {
+        return !Class::matches(event);
+    }
+};
+
+/**
+ * @brief Let at most one scroll or motion event of a class through per interval
+ *
+ * Only scrolls, moves and positions are limited: presses and releases
+ * always pass, since dropping one would leave a key or button down on
+ * the host. Scroll and move deltas of dropped events are added to the
+ * next one that passes, and a dropped position is kept with the moves
+ * after it. Whatever is still held once the interval has expired is
+ * sent by release(), which the monitor calls from poll(), so the wheel
+ * and the pointer travel the whole distance and end where they should.
+ *
+ * @tparam Class Event class such as Scroll or Motion
+ * @tparam IntervalMs Minimum time between two passing events
+ */
+template <typename Class, unsigned long IntervalMs> class RateLimit {
+  private:
+    unsigned long m_lastPassed   = 0;     ///< millis() of the last passing event
+    bool          m_started      = false; ///< An event has passed already
+    bool          m_positionHeld = false; ///< A dropped position is in m_carryX/Y
+    long          m_carryScroll  = 0;     ///< Scroll of dropped events
+    long          m_carryX       = 0;     ///< X of the held position, or X delta of dropped moves
+    long          m_carryY       = 0;     ///< Y of the held position, or Y delta of dropped moves
+
+    static inline bool isMouse(const InputEvent &event, MouseEvent code) {
+        return event.device == Device::MOUSE && event.event == static_cast<uint8_t>(code);
+    }
+
+    /**
+     * @brief Take what fits an event parameter out of a carry
+     */
+    static inline int take(long &carry) {
+        long value = carry > INT_MAX ? INT_MAX : (carry < INT_MIN ? INT_MIN : carry);
+        carry -= value;
+        return static_cast<int>(value);
+    }
+
+    /**
+     * @brief Put the held position into an event and forget it
+     */
+    inline void releasePosition(InputEvent &event) {
+        event.param1   = take(m_carryX);
+        event.param2   = take(m_carryY);
+        m_positionHeld = false;
+        m_carryX       = 0;
+        m_carryY       = 0;
+    }
+
+    inline bool due(unsigned long now) const {
+        return !m_started || now - m_lastPassed >= IntervalMs;
+    }
+
+    inline void passed(unsigned long now) {
+        m_started    = true;
+        m_lastPassed = now;
+    }
+
+  public:
+    inline bool apply(InputEvent &event) {
+        bool scroll   = isMouse(event, MouseEvent::SCROLL);
+        bool move     = isMouse(event, MouseEvent::MOVE);
+        bool position = isMouse(event, MouseEvent::POSITION);
+        if (!(scroll || move || position) || !Class::matches(event)) {
+            return true;
+        }
+
+        unsigned long now = millis();
+        if (!due(now)) {
+            if (scroll) {
+                m_carryScroll += event.param1;
+            } else if (position) {
+                m_positionHeld = true;
+                m_carryX       = event.param1;
+                m_carryY       = event.param2;
+            } else {
+                m_carryX += event.param1;
+                m_carryY += event.param2;
+            }
+            return false;
+        }
+
+        if (scroll) {
+            m_carryScroll += event.param1;
+            event.param1 = take(m_carryScroll);
+        } else if (position) {
+            m_positionHeld = false;
+            m_carryX       = 0;
+            m_carryY       = 0;
+        } else if (m_positionHeld) {
+            // The move lands relative to the held position: send where it ends
+            m_carryX += event.param1;
+            m_carryY += event.param2;
+            event.event = static_cast<uint8_t>(MouseEvent::POSITION);
+            releasePosition(event);
+        } else {
+            m_carryX += event.param1;
+            m_carryY += event.param2;
+            event.param1 = take(m_carryX);
+            event.param2 = take(m_carryY);
+        }
+
+        passed(now);
+        return true;
+    }
+
+    /**
+     * @brief Hand out what is held once the interval has expired
+     * @param event Filled with the held position, move or scroll
+     * @return false when nothing is held or the interval still runs
+     */
+    inline bool release(InputEvent &event) {
+        unsigned long now = millis();
+        if (!due(now)) {
+            return false;
+        }
+
+        event.device = Device::MOUSE;
+        event.param2 = 0;
+        if (m_positionHeld) {
+            event.event = static_cast<uint8_t>(MouseEvent::POSITION);
+            releasePosition(event);
+        } else if (m_carryX != 0 || m_carryY != 0) {
+            event.event  = static_cast<uint8_t>(MouseEvent::MOVE);
+            event.param1 = take(m_carryX);
+            event.param2 = take(m_carryY);
+        } else if (m_carryScroll != 0) {
+            event.event  = static_cast<uint8_t>(MouseEvent::SCROLL);
+            event.param1 = take(m_carryScroll);
+        } else {
+            return false;
+        }
+
+        passed(now);
+        return true;
+    }
+};
+
+/**
+ * @brief Run a user function on every event
+ * @tparam Function Rewrites the event, returns false to drop it
+ */
+template <bool (*Function)(InputEvent &)> class Transform {
+  public:
+    inline bool apply(InputEvent &event) {
+        return Function(event);
+    }
+};
+
+#endif // SERIAL_INPUT_FILTERS_H
@@ -0,0 +1,449 @@
+/**
+ * @file SerialInputKeyNames.cpp
+ * @brief Key name tables, generated by host/gen_key_names.py from VirtualKey
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Do not edit: change VirtualKey and run python host/gen_key_names.py.
+ * 168 names, 165 codes, 1166 blob bytes.
+ *
+ * @author Leonardo Klein
+ */
+
+#include "SerialInputKeyNames.h"
+
+const char KEY_NAME_BLOB[] PROGMEM =
+    "BACKSPACE\0"
+    "TAB\0"
+    "CLEAR\0"
+    "ENTER\0"
+    "SHIFT\0"
+    "CONTROL\0"
+    "ALT\0"
+    "PAUSE\0"
+    "CAPS_LOCK\0"
+    "KANA\0"
+    "HANGEUL\0"
+    "HANGUL\0"
+    "IME_ON\0"
+    "JUNJA\0"
+    "FINAL\0"
+    "HANJA\0"
+    "KANJI\0"
+    "IME_OFF\0"
+    "ESCAPE\0"
+    "CONVERT\0"
+    "NONCONVERT\0"
+    "ACCEPT\0"
+    "MODECHANGE\0"
+    "SPACE\0"
+    "PAGE_UP\0"
+    "PAGE_DOWN\0"
+    "END\0"
+    "HOME\0"
+    "ARROW_LEFT\0"
+    "ARROW_UP\0"
+    "ARROW_RIGHT\0"
+    "ARROW_DOWN\0"
+    "SELECT\0"
+    "PRINT\0"
+    "EXECUTE\0"
+    "PRINT_SCREEN\0"
+    "INSERT\0"
+    "DELETE\0"
+    "HELP\0"
+    "NUM_0\0"
+    "NUM_1\0"
+    "NUM_2\0"
+    "NUM_3\0"
+    "NUM_4\0"
+    "NUM_5\0"
+    "NUM_6\0"
+    "NUM_7\0"
+    "NUM_8\0"
+    "NUM_9\0"
+    "A\0"
+    "B\0"
+    "C\0"
+    "D\0"
+    "E\0"
+    "F\0"
+    "G\0"
+    "H\0"
+    "I\0"
+    "J\0"
+    "K\0"
+    "L\0"
+    "M\0"
+    "N\0"
+    "O\0"
+    "P\0"
+    "Q\0"
+    "R\0"
+    "S\0"
+    "T\0"
+    "U\0"
+    "V\0"
+    "W\0"
+    "X\0"
+    "Y\0"
+    "Z\0"
+    "LEFT_WIN\0"
+    "RIGHT_WIN\0"
+    "APPS\0"
+    "SLEEP\0"
+    "NUMPAD_0\0"
+    "NUMPAD_1\0"
+    "NUMPAD_2\0"
+    "NUMPAD_3\0"
+    "NUMPAD_4\0"
+    "NUMPAD_5\0"
+    "NUMPAD_6\0"
+    "NUMPAD_7\0"
+    "NUMPAD_8\0"
+    "NUMPAD_9\0"
+    "MULTIPLY\0"
+    "ADD\0"
+    "SEPARATOR\0"
+    "SUBTRACT\0"
+    "DECIMAL\0"
+    "DIVIDE\0"
+    "F1\0"
+    "F2\0"
+    "F3\0"
+    "F4\0"
+    "F5\0"
+    "F6\0"
+    "F7\0"
+    "F8\0"
+    "F9\0"
+    "F10\0"
+    "F11\0"
+    "F12\0"
+    "F13\0"
+    "F14\0"
+    "F15\0"
+    "F16\0"
+    "F17\0"
+    "F18\0"
+    "F19\0"
+    "F20\0"
+    "F21\0"
+    "F22\0"
+    "F23\0"
+    "F24\0"
+    "NUM_LOCK\0"
+    "SCROLL_LOCK\0"
+    "LEFT_SHIFT\0"
+    "RIGHT_SHIFT\0"
+    "LEFT_CONTROL\0"
+    "RIGHT_CONTROL\0"
+    "LEFT_ALT\0"
+    "RIGHT_ALT\0"
+    "BROWSER_BACK\0"
+    "BROWSER_FORWARD\0"
+    "BROWSER_REFRESH\0"
+    "BROWSER_STOP\0"
+    "BROWSER_SEARCH\0"
+    "BROWSER_FAVORITES\0"
+    "BROWSER_HOME\0"
+    "VOLUME_MUTE\0"
+    "VOLUME_DOWN\0"
+    "VOLUME_UP\0"
+    "MEDIA_NEXT_TRACK\0"
+    "MEDIA_PREV_TRACK\0"
+    "MEDIA_STOP\0"
+    "MEDIA_PLAY_PAUSE\0"
+    "LAUNCH_MAIL\0"
+    "LAUNCH_MEDIA_SELECT\0"
+    "LAUNCH_APP1\0"
+    "LAUNCH_APP2\0"
+    "OEM_1\0"
+    "OEM_PLUS\0"
+    "OEM_COMMA\0"
+    "OEM_MINUS\0"
+    "OEM_PERIOD\0"
+    "OEM_2\0"
+    "OEM_3\0"
+    "OEM_4\0"
+    "OEM_5\0"
+    "OEM_6\0"
+    "OEM_7\0"
+    "OEM_8\0"
+    "OEM_102\0"
+    "PROCESS_KEY\0"
+    "PACKET\0"
+    "ATTN\0"
+    "CRSEL\0"
+    "EXSEL\0"
+    "EREOF\0"
+    "PLAY\0"
+    "ZOOM\0"
+    "PA1\0"
+    "OEM_CLEAR\0";
+
+const uint16_t KEY_NAME_OFFSETS[] PROGMEM = {
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x0000, 0x000A, 0xFFFF, 0xFFFF, 0x000E, 0x0014, 0xFFFF, 0xFFFF,
+    0x001A, 0x0020, 0x0028, 0x002C, 0x0032, 0x003C, 0x0050, 0x0057,
+    0x005D, 0x0063, 0x006F, 0x0077, 0x007E, 0x0086, 0x0091, 0x0098,
+    0x00A3, 0x00A9, 0x00B1, 0x00BB, 0x00BF, 0x00C4, 0x00CF, 0x00D8,
+    0x00E4, 0x00EF, 0x00F6, 0x00FC, 0x0104, 0x0111, 0x0118, 0x011F,
+    0x0124, 0x012A, 0x0130, 0x0136, 0x013C, 0x0142, 0x0148, 0x014E,
+    0x0154, 0x015A, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0x0160, 0x0162, 0x0164, 0x0166, 0x0168, 0x016A, 0x016C,
+    0x016E, 0x0170, 0x0172, 0x0174, 0x0176, 0x0178, 0x017A, 0x017C,
+    0x017E, 0x0180, 0x0182, 0x0184, 0x0186, 0x0188, 0x018A, 0x018C,
+    0x018E, 0x0190, 0x0192, 0x0194, 0x019D, 0x01A7, 0xFFFF, 0x01AC,
+    0x01B2, 0x01BB, 0x01C4, 0x01CD, 0x01D6, 0x01DF, 0x01E8, 0x01F1,
+    0x01FA, 0x0203, 0x020C, 0x0215, 0x0219, 0x0223, 0x022C, 0x0234,
+    0x023B, 0x023E, 0x0241, 0x0244, 0x0247, 0x024A, 0x024D, 0x0250,
+    0x0253, 0x0256, 0x025A, 0x025E, 0x0262, 0x0266, 0x026A, 0x026E,
+    0x0272, 0x0276, 0x027A, 0x027E, 0x0282, 0x0286, 0x028A, 0x028E,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x0292, 0x029B, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0x02A7, 0x02B2, 0x02BE, 0x02CB, 0x02D9, 0x02E2, 0x02EC, 0x02F9,
+    0x0309, 0x0319, 0x0326, 0x0335, 0x0347, 0x0354, 0x0360, 0x036C,
+    0x0376, 0x0387, 0x0398, 0x03A3, 0x03B4, 0x03C0, 0x03D4, 0x03E0,
+    0xFFFF, 0xFFFF, 0x03EC, 0x03F2, 0x03FB, 0x0405, 0x040F, 0x041A,
+    0x0420, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0426, 0x042C, 0x0432, 0x0438, 0x043E,
+    0xFFFF, 0xFFFF, 0x0444, 0xFFFF, 0xFFFF, 0x044C, 0xFFFF, 0x0458,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x045F, 0x0464,
+    0x046A, 0x0470, 0x0476, 0x047B, 0xFFFF, 0x0480, 0x0484, 0xFFFF,
+};
+
+const uint8_t KEY_NAME_SEEDS[] PROGMEM = {
+    0x01, 0x00, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00, 0x00, 0x06, 0x00, 0x03, 0x05, 0x03, 0x05, 0x06,
+    0x01, 0x03, 0x00, 0x0A, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00,
+    0x00, 0x02, 0x06, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0D, 0x08, 0x02, 0x09, 0x04,
+    0x07, 0x01, 0x00, 0x08, 0x02, 0x05, 0x03, 0x0E, 0x01, 0x03, 0x02, 0x02, 0x00, 0x00, 0x09, 0x00,
+};
+
+const uint16_t KEY_NAME_SLOT_OFFSETS[] PROGMEM = {
+    0x027E, 0x0347, 0x019D, 0x0219, 0xFFFF, 0xFFFF, 0x0174, 0x03A3,
+    0x014E, 0x0041, 0x046A, 0x02CB, 0x018C, 0x00CF, 0x0405, 0x0180,
+    0xFFFF, 0x0162, 0x022C, 0x0398, 0x0444, 0x03E0, 0x016A, 0x03B4,
+    0x036C, 0x03D4, 0xFFFF, 0x018A, 0x0190, 0x0098, 0x018E, 0x01D6,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0069, 0xFFFF, 0x0186, 0x0256, 0x00E4,
+    0x017A, 0x0241, 0x012A, 0x0262, 0x0130, 0x0160, 0x026A, 0x0172,
+    0x02A7, 0x0420, 0x0104, 0x0148, 0x03EC, 0xFFFF, 0x0124, 0x0111,
+    0xFFFF, 0x023E, 0x0484, 0x0049, 0x01B2, 0xFFFF, 0x0309, 0x024A,
+    0xFFFF, 0x01DF, 0x0077, 0x0154, 0x01F1, 0x015A, 0x027A, 0x0203,
+    0x0192, 0x0050, 0xFFFF, 0x000E, 0x0326, 0x0244, 0xFFFF, 0x02B2,
+    0xFFFF, 0x02EC, 0xFFFF, 0xFFFF, 0x007E, 0x0182, 0x00FC, 0xFFFF,
+    0x0215, 0x0247, 0x0136, 0x0063, 0x0276, 0xFFFF, 0x0020, 0x017E,
+    0x0166, 0x0184, 0xFFFF, 0x029B, 0x0188, 0x00BF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0x005D, 0xFFFF, 0x0170, 0x025E, 0xFFFF, 0xFFFF, 0x0266,
+    0x03C0, 0x000A, 0x01BB, 0xFFFF, 0x0272, 0x017C, 0x0354, 0x01A7,
+    0xFFFF, 0x00A9, 0x0464, 0x040F, 0x002C, 0xFFFF, 0x0032, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x0253, 0x045F, 0x0234, 0x0335, 0x0014, 0xFFFF,
+    0x00D8, 0xFFFF, 0x01C4, 0xFFFF, 0x00EF, 0x0176, 0x0118, 0x006F,
+    0x01E8, 0xFFFF, 0x00BB, 0x0086, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF,
+    0xFFFF, 0xFFFF, 0x01AC, 0x0387, 0x00B1, 0x011F, 0x0028, 0x02E2,
+    0x0376, 0xFFFF, 0x025A, 0xFFFF, 0xFFFF, 0x00F6, 0xFFFF, 0xFFFF,
+    0xFFFF, 0x026E, 0x041A, 0xFFFF, 0x00C4, 0xFFFF, 0x047B, 0x02D9,
+    0x0432, 0x020C, 0xFFFF, 0x0426, 0xFFFF, 0xFFFF, 0x0091, 0x01FA,
+    0xFFFF, 0xFFFF, 0x016E, 0x023B, 0x0057, 0x03FB, 0x042C, 0x043E,
+    0xFFFF, 0x0438, 0x0360, 0xFFFF, 0xFFFF, 0x024D, 0x03F2, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF, 0x0292, 0x0319, 0x001A,
+    0xFFFF, 0x02F9, 0xFFFF, 0xFFFF, 0xFFFF, 0x044C, 0xFFFF, 0x0282,
+    0x0142, 0xFFFF, 0x028A, 0x0286, 0x0480, 0xFFFF, 0x028E, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x01CD, 0x0000, 0x003C, 0x02BE, 0xFFFF,
+    0xFFFF, 0xFFFF, 0xFFFF, 0x0476, 0x0223, 0xFFFF, 0x0250, 0xFFFF,
+    0x00A3, 0xFFFF, 0xFFFF, 0x016C, 0xFFFF, 0x013C, 0x0194, 0x0470,
+    0xFFFF, 0x0164, 0xFFFF, 0x0168, 0x0458, 0x0178, 0xFFFF, 0xFFFF,
+};
+
+const uint8_t KEY_NAME_SLOT_CODES[] PROGMEM = {
+    0x83, 0xAC, 0x5C, 0x6C, 0x00, 0x00, 0x4B, 0xB3, 0x37, 0x15, 0xF8, 0xA3, 0x57, 0x26, 0xBD, 0x51,
+    0x00, 0x42, 0x6E, 0xB2, 0xE2, 0xB7, 0x46, 0xB4, 0xAF, 0xB6, 0x00, 0x56, 0x59, 0x1F, 0x58, 0x64,
+    0x00, 0x00, 0x00, 0x19, 0x00, 0x54, 0x79, 0x28, 0x4E, 0x72, 0x31, 0x7C, 0x32, 0x41, 0x7E, 0x4A,
+    0xA0, 0xC0, 0x2C, 0x36, 0xBA, 0x00, 0x30, 0x2D, 0x00, 0x71, 0xFE, 0x15, 0x60, 0x00, 0xA8, 0x75,
+    0x00, 0x65, 0x1B, 0x38, 0x67, 0x39, 0x82, 0x69, 0x5A, 0x16, 0x00, 0x0C, 0xAA, 0x73, 0x00, 0xA1,
+    0x00, 0xA6, 0x00, 0x00, 0x1C, 0x52, 0x2B, 0x00, 0x6B, 0x74, 0x33, 0x19, 0x81, 0x00, 0x11, 0x50,
+    0x44, 0x53, 0x00, 0x91, 0x55, 0x24, 0x00, 0x00, 0x00, 0x18, 0x00, 0x49, 0x7B, 0x00, 0x00, 0x7D,
+    0xB5, 0x09, 0x61, 0x00, 0x80, 0x4F, 0xAD, 0x5D, 0x00, 0x21, 0xF7, 0xBE, 0x13, 0x00, 0x14, 0x00,
+    0x00, 0x00, 0x78, 0xF6, 0x6F, 0xAB, 0x0D, 0x00, 0x27, 0x00, 0x62, 0x00, 0x29, 0x4C, 0x2E, 0x1A,
+    0x66, 0x00, 0x23, 0x1D, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x5F, 0xB1, 0x22, 0x2F, 0x12, 0xA5,
+    0xB0, 0x00, 0x7A, 0x00, 0x00, 0x2A, 0x00, 0x00, 0x00, 0x7F, 0xBF, 0x00, 0x25, 0x00, 0xFB, 0xA4,
+    0xDD, 0x6A, 0x00, 0xDB, 0x00, 0x00, 0x1E, 0x68, 0x00, 0x00, 0x48, 0x70, 0x17, 0xBC, 0xDC, 0xDF,
+    0x00, 0xDE, 0xAE, 0x00, 0x00, 0x76, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0xA9, 0x10,
+    0x00, 0xA7, 0x00, 0x00, 0x00, 0xE5, 0x00, 0x84, 0x35, 0x00, 0x86, 0x85, 0xFD, 0x00, 0x87, 0x00,
+    0x00, 0x00, 0x00, 0x63, 0x08, 0x15, 0xA2, 0x00, 0x00, 0x00, 0x00, 0xFA, 0x6D, 0x00, 0x77, 0x00,
+    0x20, 0x00, 0x00, 0x47, 0x00, 0x34, 0x5B, 0xF9, 0x00, 0x43, 0x00, 0x45, 0xE7, 0x4D, 0x00, 0x00,
+};
+
+// keyNameHash() must agree with the generator for the slots to be right
+static_assert(keyNameHash("BACKSPACE", 9) == 0xED22354CUL, "BACKSPACE");
+static_assert(keyNameHash("TAB", 3) == 0x1B33D96CUL, "TAB");
+static_assert(keyNameHash("CLEAR", 5) == 0x06B44BC2UL, "CLEAR");
+static_assert(keyNameHash("ENTER", 5) == 0xB57994ADUL, "ENTER");
+static_assert(keyNameHash("SHIFT", 5) == 0xBC6ACFE7UL, "SHIFT");
+static_assert(keyNameHash("CONTROL", 7) == 0xDE0DE97EUL, "CONTROL");
+static_assert(keyNameHash("ALT", 3) == 0x5D619EBCUL, "ALT");
+static_assert(keyNameHash("PAUSE", 5) == 0x4762B66DUL, "PAUSE");
+static_assert(keyNameHash("CAPS_LOCK", 9) == 0xD7447E02UL, "CAPS_LOCK");
+static_assert(keyNameHash("KANA", 4) == 0xDE699DA4UL, "KANA");
+static_assert(keyNameHash("HANGEUL", 7) == 0x665EEC4DUL, "HANGEUL");
+static_assert(keyNameHash("HANGUL", 6) == 0x59013AF8UL, "HANGUL");
+static_assert(keyNameHash("IME_ON", 6) == 0x1210498AUL, "IME_ON");
+static_assert(keyNameHash("JUNJA", 5) == 0x1069EA7BUL, "JUNJA");
+static_assert(keyNameHash("FINAL", 5) == 0xBE046417UL, "FINAL");
+static_assert(keyNameHash("HANJA", 5) == 0xAEA4B671UL, "HANJA");
+static_assert(keyNameHash("KANJI", 5) == 0xCD366B64UL, "KANJI");
+static_assert(keyNameHash("IME_OFF", 7) == 0x8B8F8F5CUL, "IME_OFF");
+static_assert(keyNameHash("ESCAPE", 6) == 0x5F8742C6UL, "ESCAPE");
+static_assert(keyNameHash("CONVERT", 7) == 0xB5385498UL, "CONVERT");
+static_assert(keyNameHash("NONCONVERT", 10) == 0xF704840BUL, "NONCONVERT");
+static_assert(keyNameHash("ACCEPT", 6) == 0x209E17E9UL, "ACCEPT");
+static_assert(keyNameHash("MODECHANGE", 10) == 0x55031D06UL, "MODECHANGE");
+static_assert(keyNameHash("SPACE", 5) == 0x1808F0E5UL, "SPACE");
+static_assert(keyNameHash("PAGE_UP", 7) == 0x270E795EUL, "PAGE_UP");
+static_assert(keyNameHash("PAGE_DOWN", 9) == 0x85D69CA7UL, "PAGE_DOWN");
+static_assert(keyNameHash("END", 3) == 0xAF43920AUL, "END");
+static_assert(keyNameHash("HOME", 4) == 0x10B8C84EUL, "HOME");
+static_assert(keyNameHash("ARROW_LEFT", 10) == 0x767ACA62UL, "ARROW_LEFT");
+static_assert(keyNameHash("ARROW_UP", 8) == 0x01235E4EUL, "ARROW_UP");
+static_assert(keyNameHash("ARROW_RIGHT", 11) == 0x1E30C46FUL, "ARROW_RIGHT");
+static_assert(keyNameHash("ARROW_DOWN", 10) == 0xB28019F7UL, "ARROW_DOWN");
+static_assert(keyNameHash("SELECT", 6) == 0xB4293AADUL, "SELECT");
+static_assert(keyNameHash("PRINT", 5) == 0x2623A5E8UL, "PRINT");
+static_assert(keyNameHash("EXECUTE", 7) == 0xCF77DFB8UL, "EXECUTE");
+static_assert(keyNameHash("PRINT_SCREEN", 12) == 0xE84A9C61UL, "PRINT_SCREEN");
+static_assert(keyNameHash("INSERT", 6) == 0xA4ED3768UL, "INSERT");
+static_assert(keyNameHash("DELETE", 6) == 0xF8718ECAUL, "DELETE");
+static_assert(keyNameHash("HELP", 4) == 0x3662D7FAUL, "HELP");
+static_assert(keyNameHash("NUM_0", 5) == 0xEBD236FCUL, "NUM_0");
+static_assert(keyNameHash("NUM_1", 5) == 0xECD2388FUL, "NUM_1");
+static_assert(keyNameHash("NUM_2", 5) == 0xEDD23A22UL, "NUM_2");
+static_assert(keyNameHash("NUM_3", 5) == 0xEED23BB5UL, "NUM_3");
+static_assert(keyNameHash("NUM_4", 5) == 0xE7D230B0UL, "NUM_4");
+static_assert(keyNameHash("NUM_5", 5) == 0xE8D23243UL, "NUM_5");
+static_assert(keyNameHash("NUM_6", 5) == 0xE9D233D6UL, "NUM_6");
+static_assert(keyNameHash("NUM_7", 5) == 0xEAD23569UL, "NUM_7");
+static_assert(keyNameHash("NUM_8", 5) == 0xF3D24394UL, "NUM_8");
+static_assert(keyNameHash("NUM_9", 5) == 0xF4D24527UL, "NUM_9");
+static_assert(keyNameHash("A", 1) == 0xC40BF6CCUL, "A");
+static_assert(keyNameHash("B", 1) == 0xC70BFB85UL, "B");
+static_assert(keyNameHash("C", 1) == 0xC60BF9F2UL, "C");
+static_assert(keyNameHash("D", 1) == 0xC10BF213UL, "D");
+static_assert(keyNameHash("E", 1) == 0xC00BF080UL, "E");
+static_assert(keyNameHash("F", 1) == 0xC30BF539UL, "F");
+static_assert(keyNameHash("G", 1) == 0xC20BF3A6UL, "G");
+static_assert(keyNameHash("H", 1) == 0xCD0C04F7UL, "H");
+static_assert(keyNameHash("I", 1) == 0xCC0C0364UL, "I");
+static_assert(keyNameHash("J", 1) == 0xCF0C081DUL, "J");
+static_assert(keyNameHash("K", 1) == 0xCE0C068AUL, "K");
+static_assert(keyNameHash("L", 1) == 0xC90BFEABUL, "L");
+static_assert(keyNameHash("M", 1) == 0xC80BFD18UL, "M");
+static_assert(keyNameHash("N", 1) == 0xCB0C01D1UL, "N");
+static_assert(keyNameHash("O", 1) == 0xCA0C003EUL, "O");
+static_assert(keyNameHash("P", 1) == 0xD50C118FUL, "P");
+static_assert(keyNameHash("Q", 1) == 0xD40C0FFCUL, "Q");
+static_assert(keyNameHash("R", 1) == 0xD70C14B5UL, "R");
+static_assert(keyNameHash("S", 1) == 0xD60C1322UL, "S");
+static_assert(keyNameHash("T", 1) == 0xD10C0B43UL, "T");
+static_assert(keyNameHash("U", 1) == 0xD00C09B0UL, "U");
+static_assert(keyNameHash("V", 1) == 0xD30C0E69UL, "V");
+static_assert(keyNameHash("W", 1) == 0xD20C0CD6UL, "W");
+static_assert(keyNameHash("X", 1) == 0xDD0C1E27UL, "X");
+static_assert(keyNameHash("Y", 1) == 0xDC0C1C94UL, "Y");
+static_assert(keyNameHash("Z", 1) == 0xDF0C214DUL, "Z");
+static_assert(keyNameHash("LEFT_WIN", 8) == 0xEFBE78E1UL, "LEFT_WIN");
+static_assert(keyNameHash("RIGHT_WIN", 9) == 0x458E0268UL, "RIGHT_WIN");
+static_assert(keyNameHash("APPS", 4) == 0x988FCA0DUL, "APPS");
+static_assert(keyNameHash("SLEEP", 5) == 0x6D3D9A28UL, "SLEEP");
+static_assert(keyNameHash("NUMPAD_0", 8) == 0x7D363CE3UL, "NUMPAD_0");
+static_assert(keyNameHash("NUMPAD_1", 8) == 0x7C363B50UL, "NUMPAD_1");
+static_assert(keyNameHash("NUMPAD_2", 8) == 0x7F364009UL, "NUMPAD_2");
+static_assert(keyNameHash("NUMPAD_3", 8) == 0x7E363E76UL, "NUMPAD_3");
+static_assert(keyNameHash("NUMPAD_4", 8) == 0x8136432FUL, "NUMPAD_4");
+static_assert(keyNameHash("NUMPAD_5", 8) == 0x8036419CUL, "NUMPAD_5");
+static_assert(keyNameHash("NUMPAD_6", 8) == 0x83364655UL, "NUMPAD_6");
+static_assert(keyNameHash("NUMPAD_7", 8) == 0x823644C2UL, "NUMPAD_7");
+static_assert(keyNameHash("NUMPAD_8", 8) == 0x8536497BUL, "NUMPAD_8");
+static_assert(keyNameHash("NUMPAD_9", 8) == 0x843647E8UL, "NUMPAD_9");
+static_assert(keyNameHash("MULTIPLY", 8) == 0xAC422B45UL, "MULTIPLY");
+static_assert(keyNameHash("ADD", 3) == 0x7D7558D4UL, "ADD");
+static_assert(keyNameHash("SEPARATOR", 9) == 0x67E803DCUL, "SEPARATOR");
+static_assert(keyNameHash("SUBTRACT", 8) == 0xE75F2EE1UL, "SUBTRACT");
+static_assert(keyNameHash("DECIMAL", 7) == 0x48AF9A2CUL, "DECIMAL");
+static_assert(keyNameHash("DIVIDE", 6) == 0x1E40BDF0UL, "DIVIDE");
+static_assert(keyNameHash("F1", 2) == 0x13D2BB98UL, "F1");
+static_assert(keyNameHash("F2", 2) == 0x16D2C051UL, "F2");
+static_assert(keyNameHash("F3", 2) == 0x15D2BEBEUL, "F3");
+static_assert(keyNameHash("F4", 2) == 0x18D2C377UL, "F4");
+static_assert(keyNameHash("F5", 2) == 0x17D2C1E4UL, "F5");
+static_assert(keyNameHash("F6", 2) == 0x1AD2C69DUL, "F6");
+static_assert(keyNameHash("F7", 2) == 0x19D2C50AUL, "F7");
+static_assert(keyNameHash("F8", 2) == 0x0CD2B093UL, "F8");
+static_assert(keyNameHash("F9", 2) == 0x0BD2AF00UL, "F9");
+static_assert(keyNameHash("F10", 3) == 0xDCBD6978UL, "F10");
+static_assert(keyNameHash("F11", 3) == 0xDDBD6B0BUL, "F11");
+static_assert(keyNameHash("F12", 3) == 0xDEBD6C9EUL, "F12");
+static_assert(keyNameHash("F13", 3) == 0xDFBD6E31UL, "F13");
+static_assert(keyNameHash("F14", 3) == 0xE0BD6FC4UL, "F14");
+static_assert(keyNameHash("F15", 3) == 0xE1BD7157UL, "F15");
+static_assert(keyNameHash("F16", 3) == 0xE2BD72EAUL, "F16");
+static_assert(keyNameHash("F17", 3) == 0xE3BD747DUL, "F17");
+static_assert(keyNameHash("F18", 3) == 0xD4BD5CE0UL, "F18");
+static_assert(keyNameHash("F19", 3) == 0xD5BD5E73UL, "F19");
+static_assert(keyNameHash("F20", 3) == 0x4EC4D8B3UL, "F20");
+static_assert(keyNameHash("F21", 3) == 0x4DC4D720UL, "F21");
+static_assert(keyNameHash("F22", 3) == 0x50C4DBD9UL, "F22");
+static_assert(keyNameHash("F23", 3) == 0x4FC4DA46UL, "F23");
+static_assert(keyNameHash("F24", 3) == 0x52C4DEFFUL, "F24");
+static_assert(keyNameHash("NUM_LOCK", 8) == 0x371F70CBUL, "NUM_LOCK");
+static_assert(keyNameHash("SCROLL_LOCK", 11) == 0xA6016326UL, "SCROLL_LOCK");
+static_assert(keyNameHash("LEFT_SHIFT", 10) == 0xDE38DA4FUL, "LEFT_SHIFT");
+static_assert(keyNameHash("RIGHT_SHIFT", 11) == 0xE37244AEUL, "RIGHT_SHIFT");
+static_assert(keyNameHash("LEFT_CONTROL", 12) == 0xDA8AE666UL, "LEFT_CONTROL");
+static_assert(keyNameHash("RIGHT_CONTROL", 13) == 0x7697DD03UL, "RIGHT_CONTROL");
+static_assert(keyNameHash("LEFT_ALT", 8) == 0x8AD601B4UL, "LEFT_ALT");
+static_assert(keyNameHash("RIGHT_ALT", 9) == 0xF1C01995UL, "RIGHT_ALT");
+static_assert(keyNameHash("BROWSER_BACK", 12) == 0xF868FC6BUL, "BROWSER_BACK");
+static_assert(keyNameHash("BROWSER_FORWARD", 15) == 0x3A63D1FDUL, "BROWSER_FORWARD");
+static_assert(keyNameHash("BROWSER_REFRESH", 15) == 0x7EF43EDBUL, "BROWSER_REFRESH");
+static_assert(keyNameHash("BROWSER_STOP", 12) == 0x29BFCEC8UL, "BROWSER_STOP");
+static_assert(keyNameHash("BROWSER_SEARCH", 14) == 0xC25E710CUL, "BROWSER_SEARCH");
+static_assert(keyNameHash("BROWSER_FAVORITES", 17) == 0x3B11857DUL, "BROWSER_FAVORITES");
+static_assert(keyNameHash("BROWSER_HOME", 12) == 0xA5AA01E7UL, "BROWSER_HOME");
+static_assert(keyNameHash("VOLUME_MUTE", 11) == 0xEC3C7619UL, "VOLUME_MUTE");
+static_assert(keyNameHash("VOLUME_DOWN", 11) == 0x4F77C23CUL, "VOLUME_DOWN");
+static_assert(keyNameHash("VOLUME_UP", 9) == 0x13A4183DUL, "VOLUME_UP");
+static_assert(keyNameHash("MEDIA_NEXT_TRACK", 16) == 0xD777B205UL, "MEDIA_NEXT_TRACK");
+static_assert(keyNameHash("MEDIA_PREV_TRACK", 16) == 0x94D9C269UL, "MEDIA_PREV_TRACK");
+static_assert(keyNameHash("MEDIA_STOP", 10) == 0x52CE137CUL, "MEDIA_STOP");
+static_assert(keyNameHash("MEDIA_PLAY_PAUSE", 16) == 0x549BD17BUL, "MEDIA_PLAY_PAUSE");
+static_assert(keyNameHash("LAUNCH_MAIL", 11) == 0x30C11794UL, "LAUNCH_MAIL");
+static_assert(keyNameHash("LAUNCH_MEDIA_SELECT", 19) == 0x34D970DEUL, "LAUNCH_MEDIA_SELECT");
+static_assert(keyNameHash("LAUNCH_APP1", 11) == 0xCE0219FDUL, "LAUNCH_APP1");
+static_assert(keyNameHash("LAUNCH_APP2", 11) == 0xCB021544UL, "LAUNCH_APP2");
+static_assert(keyNameHash("OEM_1", 5) == 0x6B7CB7D0UL, "OEM_1");
+static_assert(keyNameHash("OEM_PLUS", 8) == 0xC5128DD1UL, "OEM_PLUS");
+static_assert(keyNameHash("OEM_COMMA", 9) == 0xC44BBD84UL, "OEM_COMMA");
+static_assert(keyNameHash("OEM_MINUS", 9) == 0x3DCD0E9BUL, "OEM_MINUS");
+static_assert(keyNameHash("OEM_PERIOD", 10) == 0x46B87BD8UL, "OEM_PERIOD");
+static_assert(keyNameHash("OEM_2", 5) == 0x6E7CBC89UL, "OEM_2");
+static_assert(keyNameHash("OEM_3", 5) == 0x6D7CBAF6UL, "OEM_3");
+static_assert(keyNameHash("OEM_4", 5) == 0x707CBFAFUL, "OEM_4");
+static_assert(keyNameHash("OEM_5", 5) == 0x6F7CBE1CUL, "OEM_5");
+static_assert(keyNameHash("OEM_6", 5) == 0x727CC2D5UL, "OEM_6");
+static_assert(keyNameHash("OEM_7", 5) == 0x717CC142UL, "OEM_7");
+static_assert(keyNameHash("OEM_8", 5) == 0x747CC5FBUL, "OEM_8");
+static_assert(keyNameHash("OEM_102", 7) == 0x278814D6UL, "OEM_102");
+static_assert(keyNameHash("PROCESS_KEY", 11) == 0x7CC1D506UL, "PROCESS_KEY");
+static_assert(keyNameHash("PACKET", 6) == 0x27B54731UL, "PACKET");
+static_assert(keyNameHash("ATTN", 4) == 0xE710EAAEUL, "ATTN");
+static_assert(keyNameHash("CRSEL", 5) == 0xA794E5F8UL, "CRSEL");
+static_assert(keyNameHash("EXSEL", 5) == 0xA064A500UL, "EXSEL");
+static_assert(keyNameHash("EREOF", 5) == 0x02B6F7BCUL, "EREOF");
+static_assert(keyNameHash("PLAY", 4) == 0xAC85EB63UL, "PLAY");
+static_assert(keyNameHash("ZOOM", 4) == 0xA513AE72UL, "ZOOM");
+static_assert(keyNameHash("PA1", 3) == 0x0B0BC6A1UL, "PA1");
+static_assert(keyNameHash("OEM_CLEAR", 9) == 0x125F3A56UL, "OEM_CLEAR");
@@ -0,0 +1,125 @@
+/**
+ * @file SerialInputKeyNames.h
+ * @brief VirtualKey names: name to key by perfect hash, key to name by table
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * The tables in SerialInputKeyNames.cpp are generated from the
+ * VirtualKey enum by host/gen_key_names.py, which also writes
+ * src/key_names.py for the Python host. They sit in PROGMEM on AVR:
+ *
+ * - KEY_NAME_BLOB: every name, aliases included, NUL-terminated
+ * - KEY_NAME_OFFSETS: blob offset of each code's name (256 entries)
+ * - KEY_NAME_SEEDS, KEY_NAME_SLOT_*: a perfect hash over 256 slots
+ *
+ * Both lookups are O(1): keyName() reads one offset, keyFromName()
+ * hashes the name once and compares it with the one name in its slot.
+ * Names are case-sensitive, as in the enum (ENTER, NUMPAD_5, OEM_PLUS).
+ *
+ * Shared by the library, host/ScriptCompiler.cpp and the host tools; no
+ * Arduino dependency.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_KEY_NAMES_H
+#define SERIAL_INPUT_KEY_NAMES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#endif
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+
+#include "SerialInputProtocol.h"
+
+const uint16_t KEY_NAME_NONE    = 0xFFFF; ///< Offset of codes and slots without a name
+const uint8_t  KEY_NAME_BUCKETS = 64;     ///< Seeds of the perfect hash, picked by the hash's low bits
+
+extern const char     KEY_NAME_BLOB[];                  ///< NUL-terminated names
+extern const uint16_t KEY_NAME_OFFSETS[256];            ///< Code to blob offset, KEY_NAME_NONE for none
+extern const uint8_t  KEY_NAME_SEEDS[KEY_NAME_BUCKETS]; ///< Seed of each hash bucket
+extern const uint16_t KEY_NAME_SLOT_OFFSETS[256];       ///< Slot to blob offset, KEY_NAME_NONE if empty
+extern const uint8_t  KEY_NAME_SLOT_CODES[256];         ///< Slot to code
+
+/**
+ * @brief FNV-1a hash of a key name, usable in constant expressions
+ * @param name Name, not necessarily NUL-terminated
+ * @param length Name length
+ * @param hash Running hash (leave the default)
+ * @return 32-bit hash
+ */
+constexpr uint32_t keyNameHash(const char *name, size_t length, uint32_t hash = 2166136261UL) {
+    return length == 0 ? hash
+                       : keyNameHash(name + 1, length - 1,
+                                     (hash ^ static_cast<uint8_t>(*name)) * static_cast<uint32_t>(16777619UL));
+}
+
+inline uint8_t keyNameByte(const void *address) {
+#ifdef __AVR__
+    return pgm_read_byte(address);
+#else
+    return *static_cast<const uint8_t *>(address);
+#endif
+}
+
+inline uint16_t keyNameWord(const uint16_t *address) {
+#ifdef __AVR__
+    return pgm_read_word(address);
+#else
+    return *address;
+#endif
+}
+
+/**
+ * @brief Look up a key by name
+ * @param name VirtualKey name, not necessarily NUL-terminated
+ * @param length Name length
+ * @param key Receives the key
+ * @return false if no VirtualKey has this name
+ */
+inline bool keyFromName(const char *name, size_t length, VirtualKey &key) {
+    uint32_t hash  = keyNameHash(name, length);
+    uint8_t  seed  = keyNameByte(&KEY_NAME_SEEDS[hash & (KEY_NAME_BUCKETS - 1)]);
+    uint8_t  slot  = static_cast<uint8_t>((hash >> 8) + seed * ((hash >> 16) | 1));
+    uint16_t start = keyNameWord(&KEY_NAME_SLOT_OFFSETS[slot]);
+
+    if (start == KEY_NAME_NONE) {
+        return false;
+    }
+    const char *stored = KEY_NAME_BLOB + start;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = keyNameByte(stored + i);
+        if (byte == 0 || byte != static_cast<uint8_t>(name[i])) {
+            return false;
+        }
+    }
+    if (keyNameByte(stored + length) != 0) {
+        return false;
+    }
+    key = static_cast<VirtualKey>(keyNameByte(&KEY_NAME_SLOT_CODES[slot]));
+    return true;
+}
+
+/**
+ * @brief Name of a key
+ * @param key Key
+ * @return NUL-terminated name in KEY_NAME_BLOB (PROGMEM on AVR: print it
+ *         as a __FlashStringHelper), nullptr for codes without one. For
+ *         aliased codes, the first name in the enum.
+ */
+inline const char *keyName(VirtualKey key) {
+    uint16_t code = static_cast<uint16_t>(key);
+    if (code > 0xFF) {
+        return nullptr;
+    }
+    uint16_t start = keyNameWord(&KEY_NAME_OFFSETS[code]);
+    return start == KEY_NAME_NONE ? nullptr : KEY_NAME_BLOB + start;
+}
+
+#endif // SERIAL_INPUT_KEY_NAMES_H
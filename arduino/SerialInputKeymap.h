@@ -0,0 +1,484 @@
+/**
+ * @file SerialInputKeymap.h
+ * @brief Layered keymap engine with tap/hold keys and combos
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Turns physical key positions (from a matrix or buttons) into
+ * SerialInputMonitor key events. Layers live in PROGMEM as
+ * `const uint16_t keymap[LAYERS][KEYS]` tables of KeymapAction codes.
+ *
+ * Nothing in this engine blocks: feed it keyEvent() on every edge and
+ * call update() from loop(). Tap/hold keys are decided on the earliest
+ * event that settles them:
+ * - released before the tapping term: tap
+ * - another key pressed while undecided: hold
+ * - tapping term elapsed: hold
+ *
+ * All timing methods take an explicit `now` so the engine can be driven
+ * by a virtual clock; the overloads without it use millis().
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_KEYMAP_H
+#define SERIAL_INPUT_KEYMAP_H
+
+#include "SerialInputMonitor.h"
+
+/**
+ * @brief Builders for 16-bit keymap action codes
+ *
+ * Layout: bits 15-12 action type, bits 11-8 argument, bits 7-0 key.
+ */
+class KeymapAction {
+  public:
+    static const uint16_t NONE        = 0x0000; ///< Position does nothing
+    static const uint16_t TRANSPARENT = 0xFFFF; ///< Use the next lower active layer
+
+    static const uint8_t TYPE_KEY          = 0x0; ///< Plain virtual key
+    static const uint8_t TYPE_LAYER_HOLD   = 0x1; ///< Layer active while held
+    static const uint8_t TYPE_LAYER_TOGGLE = 0x2; ///< Layer toggled on press
+    static const uint8_t TYPE_MOD_TAP      = 0x3; ///< Tap: key, hold: modifier
+    static const uint8_t TYPE_LAYER_TAP    = 0x4; ///< Tap: key, hold: layer
+    static const uint8_t TYPE_INTERNAL     = 0xF; ///< Reserved for the engine
+
+    /**
+     * @brief Plain key
+     * @param key Virtual key to press and release with the position
+     */
+    static constexpr uint16_t key(VirtualKey key) {
+        return static_cast<uint16_t>(key) & 0xFF;
+    }
+
+    /**
+     * @brief Momentary layer
+     * @param layer Layer index (0-15)
+     */
+    static constexpr uint16_t layerHold(uint8_t layer) {
+        return (TYPE_LAYER_HOLD << 12) | ((layer & 0x0F) << 8);
+    }
+
+    /**
+     * @brief Toggle layer
+     * @param layer Layer index (0-15)
+     */
+    static constexpr uint16_t layerToggle(uint8_t layer) {
+        return (TYPE_LAYER_TOGGLE << 12) | ((layer & 0x0F) << 8);
+    }
+
+    /**
+     * @brief Tap for a key, hold for a modifier
+     * @param modifier One of the left/right Shift, Control, Alt or Windows keys
+     * @param tap Key sent when tapped
+     */
+    static constexpr uint16_t modTap(VirtualKey modifier, VirtualKey tap) {
+        return (TYPE_MOD_TAP << 12) | (modifierIndex(modifier) << 8) | key(tap);
+    }
+
+    /**
+     * @brief Tap for a key, hold for a layer
+     * @param layer Layer index (0-15)
+     * @param tap Key sent when tapped
+     */
+    static constexpr uint16_t layerTap(uint8_t layer, VirtualKey tap) {
+        return (TYPE_LAYER_TAP << 12) | ((layer & 0x0F) << 8) | key(tap);
+    }
+
+    /**
+     * @brief Position of a modifier in modifierKey()
+     * @param modifier Modifier virtual key
+     * @return Index 0-7 (unknown modifiers map to Left Shift)
+     */
+    static constexpr uint8_t modifierIndex(VirtualKey modifier) {
+        return modifier == VirtualKey::LEFT_CONTROL    ? 0
+               : modifier == VirtualKey::LEFT_SHIFT    ? 1
+               : modifier == VirtualKey::LEFT_ALT      ? 2
+               : modifier == VirtualKey::LEFT_WIN      ? 3
+               : modifier == VirtualKey::RIGHT_CONTROL ? 4
+               : modifier == VirtualKey::RIGHT_SHIFT   ? 5
+               : modifier == VirtualKey::RIGHT_ALT     ? 6
+               : modifier == VirtualKey::RIGHT_WIN     ? 7
+                                                       : 1;
+    }
+
+    /**
+     * @brief Modifier key for an index built by modifierIndex()
+     * @param index Index 0-7
+     * @return Modifier virtual key
+     */
+    static inline VirtualKey modifierKey(uint8_t index) {
+        switch (index & 0x07) {
+            case 0: return VirtualKey::LEFT_CONTROL;
+            case 1: return VirtualKey::LEFT_SHIFT;
+            case 2: return VirtualKey::LEFT_ALT;
+            case 3: return VirtualKey::LEFT_WIN;
+            case 4: return VirtualKey::RIGHT_CONTROL;
+            case 5: return VirtualKey::RIGHT_SHIFT;
+            case 6: return VirtualKey::RIGHT_ALT;
+            default: return VirtualKey::RIGHT_WIN;
+        }
+    }
+
+    static constexpr uint8_t type(uint16_t action) {
+        return action >> 12;
+    }
+
+    static constexpr uint8_t argument(uint16_t action) {
+        return (action >> 8) & 0x0F;
+    }
+
+    static constexpr uint8_t keyCode(uint16_t action) {
+        return action & 0xFF;
+    }
+
+    static constexpr bool isTapHold(uint16_t action) {
+        return type(action) == TYPE_MOD_TAP || type(action) == TYPE_LAYER_TAP;
+    }
+};
+
+/**
+ * @brief Two positions pressed together within the combo term
+ *
+ * Store tables in PROGMEM. Combo actions may be keys or layer actions;
+ * tap/hold actions fire their tap key.
+ */
+struct KeyCombo {
+    uint8_t  first;  ///< First key position
+    uint8_t  second; ///< Second key position
+    uint16_t action; ///< KeymapAction fired instead of both keys
+};
+
+/**
+ * @brief Keymap engine feeding a SerialInputMonitor
+ * @tparam Monitor Monitor type (any BasicSerialInputMonitor)
+ * @tparam MaxKeys Number of key positions tracked
+ */
+template <typename Monitor, uint8_t MaxKeys = 32> class SerialInputKeymap {
+  private:
+    static const uint8_t  NO_KEY   = 0xFF;   ///< No pending position
+    static const uint16_t CONSUMED = 0xFFFE; ///< Position absorbed by a combo
+
+    /**
+     * @brief What the pending position is waiting for
+     */
+    enum PendingKind : uint8_t { PENDING_NONE, PENDING_COMBO, PENDING_TAP_HOLD };
+
+    Monitor        &m_monitor;     ///< Output monitor
+    const uint16_t *m_layers;      ///< PROGMEM layer tables
+    uint8_t         m_layerCount;  ///< Number of layers
+    uint8_t         m_keyCount;    ///< Positions per layer
+    const KeyCombo *m_combos;      ///< PROGMEM combo table
+    uint8_t         m_comboCount;  ///< Number of combos
+    uint16_t        m_tappingTerm; ///< Tap/hold decision timeout in ms
+    uint16_t        m_comboTerm;   ///< Combo window in ms
+    uint16_t        m_layerState;  ///< Active layer bitmask (bit 0 = base)
+
+    uint16_t m_active[MaxKeys]; ///< Action resolved at press, per position
+
+    uint8_t       m_pendingKey;    ///< Undecided position or NO_KEY
+    PendingKind   m_pendingKind;   ///< What the position is waiting for
+    uint16_t      m_pendingAction; ///< Tap/hold action being decided
+    unsigned long m_pendingSince;  ///< Press time of the undecided position
+    unsigned long m_lastLatency;   ///< Press-to-decision time of the last key
+
+    uint16_t lookup(uint8_t position) const {
+        for (int8_t layer = m_layerCount - 1; layer >= 0; layer--) {
+            if (!(m_layerState & (1u << layer))) {
+                continue;
+            }
+            uint16_t action = pgm_read_word(m_layers + layer * m_keyCount + position);
+            if (action != KeymapAction::TRANSPARENT) {
+                return action;
+            }
+        }
+        return KeymapAction::NONE;
+    }
+
+    bool inCombo(uint8_t position) const {
+        for (uint8_t i = 0; i < m_comboCount; i++) {
+            if (pgm_read_byte(&m_combos[i].first) == position || pgm_read_byte(&m_combos[i].second) == position) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool findCombo(uint8_t a, uint8_t b, uint16_t &action) const {
+        for (uint8_t i = 0; i < m_comboCount; i++) {
+            uint8_t first  = pgm_read_byte(&m_combos[i].first);
+            uint8_t second = pgm_read_byte(&m_combos[i].second);
+            if ((first == a && second == b) || (first == b && second == a)) {
+                action = pgm_read_word(&m_combos[i].action);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void pressAction(uint8_t position, uint16_t action) {
+        switch (KeymapAction::type(action)) {
+            case KeymapAction::TYPE_KEY:
+                if (action != KeymapAction::NONE) {
+                    m_monitor.pressKey(static_cast<VirtualKey>(action));
+                }
+                break;
+            case KeymapAction::TYPE_LAYER_HOLD: m_layerState |= 1u << KeymapAction::argument(action); break;
+            case KeymapAction::TYPE_LAYER_TOGGLE: m_layerState ^= 1u << KeymapAction::argument(action); break;
+            case KeymapAction::TYPE_MOD_TAP:
+            case KeymapAction::TYPE_LAYER_TAP:
+                tap(action);
+                action = KeymapAction::NONE;
+                break;
+            default: break;
+        }
+        m_active[position] = action;
+    }
+
+    void releaseAction(uint8_t position) {
+        uint16_t action    = m_active[position];
+        m_active[position] = KeymapAction::NONE;
+
+        switch (KeymapAction::type(action)) {
+            case KeymapAction::TYPE_KEY:
+                if (action != KeymapAction::NONE) {
+                    m_monitor.releaseKey(static_cast<VirtualKey>(action));
+                }
+                break;
+            case KeymapAction::TYPE_LAYER_HOLD: m_layerState &= ~(1u << KeymapAction::argument(action)); break;
+            default: break;
+        }
+        m_layerState |= 1;
+    }
+
+    void tap(uint16_t action) {
+        VirtualKey key = static_cast<VirtualKey>(KeymapAction::keyCode(action));
+        m_monitor.pressKey(key);
+        m_monitor.releaseKey(key);
+    }
+
+    void hold(uint8_t position, uint16_t action) {
+        if (KeymapAction::type(action) == KeymapAction::TYPE_MOD_TAP) {
+            pressAction(position, KeymapAction::key(KeymapAction::modifierKey(KeymapAction::argument(action))));
+        } else {
+            pressAction(position, KeymapAction::layerHold(KeymapAction::argument(action)));
+        }
+    }
+
+    void clearPending(unsigned long now) {
+        m_lastLatency = now - m_pendingSince;
+        m_pendingKey  = NO_KEY;
+        m_pendingKind = PENDING_NONE;
+    }
+
+    /**
+     * @brief Start a freshly pressed (or combo-released) action
+     * @return true if the action is now waiting for a tap/hold decision
+     */
+    bool startAction(uint8_t position, uint16_t action, unsigned long since) {
+        if (KeymapAction::isTapHold(action)) {
+            m_pendingKey    = position;
+            m_pendingKind   = PENDING_TAP_HOLD;
+            m_pendingAction = action;
+            m_pendingSince  = since;
+            return true;
+        }
+        pressAction(position, action);
+        return false;
+    }
+
+    /**
+     * @brief Settle the pending position
+     * @param interrupted Another key was pressed (forces a full decision)
+     */
+    void resolvePending(bool interrupted, unsigned long now) {
+        if (m_pendingKind == PENDING_COMBO) {
+            uint8_t position = m_pendingKey;
+            m_pendingKind    = PENDING_NONE;
+            m_pendingKey     = NO_KEY;
+            if (!startAction(position, lookup(position), m_pendingSince)) {
+                m_lastLatency = now - m_pendingSince;
+                return;
+            }
+        }
+
+        if (m_pendingKind == PENDING_TAP_HOLD && (interrupted || now - m_pendingSince >= m_tappingTerm)) {
+            hold(m_pendingKey, m_pendingAction);
+            clearPending(now);
+        }
+    }
+
+  public:
+    /**
+     * @brief Create a keymap engine
+     * @param monitor Monitor receiving the key events
+     * @param layers PROGMEM table of layerCount * keyCount actions
+     * @param layerCount Number of layers (at most 16)
+     * @param keyCount Number of positions per layer (at most MaxKeys)
+     */
+    SerialInputKeymap(Monitor &monitor, const uint16_t *layers, uint8_t layerCount, uint8_t keyCount)
+        : m_monitor(monitor)
+        , m_layers(layers)
+        , m_layerCount(layerCount > 16 ? 16 : layerCount)
+        , m_keyCount(keyCount > MaxKeys ? MaxKeys : keyCount)
+        , m_combos(nullptr)
+        , m_comboCount(0)
+        , m_tappingTerm(200)
+        , m_comboTerm(30)
+        , m_layerState(1)
+        , m_pendingKey(NO_KEY)
+        , m_pendingKind(PENDING_NONE)
+        , m_pendingAction(KeymapAction::NONE)
+        , m_pendingSince(0)
+        , m_lastLatency(0) {
+        for (uint8_t i = 0; i < MaxKeys; i++) {
+            m_active[i] = KeymapAction::NONE;
+        }
+    }
+
+    /**
+     * @brief Set the combo table
+     * @param combos PROGMEM array of combos
+     * @param count Number of combos
+     */
+    void setCombos(const KeyCombo *combos, uint8_t count) {
+        m_combos     = combos;
+        m_comboCount = count;
+    }
+
+    /**
+     * @brief Set the time after which an undecided tap/hold key becomes a hold
+     * @param milliseconds Tapping term (default 200 ms)
+     */
+    void setTappingTerm(uint16_t milliseconds) {
+        m_tappingTerm = milliseconds;
+    }
+
+    /**
+     * @brief Set the window in which two keys count as a combo
+     * @param milliseconds Combo term (default 30 ms)
+     */
+    void setComboTerm(uint16_t milliseconds) {
+        m_comboTerm = milliseconds;
+    }
+
+    /**
+     * @brief Report a key edge
+     * @param position Key position (index into each layer)
+     * @param pressed true for press, false for release
+     * @param now Current time in ms
+     */
+    void keyEvent(uint8_t position, bool pressed, unsigned long now) {
+        if (position >= m_keyCount) {
+            return;
+        }
+
+        update(now);
+
+        if (pressed) {
+            if (m_pendingKind == PENDING_COMBO) {
+                uint16_t action;
+                if (findCombo(m_pendingKey, position, action)) {
+                    uint8_t first = m_pendingKey;
+                    clearPending(now);
+                    pressAction(first, action);
+                    m_active[position] = CONSUMED;
+                    return;
+                }
+            }
+
+            if (m_pendingKind != PENDING_NONE) {
+                resolvePending(true, now);
+            }
+
+            if (inCombo(position)) {
+                m_pendingKey   = position;
+                m_pendingKind  = PENDING_COMBO;
+                m_pendingSince = now;
+                return;
+            }
+
+            if (!startAction(position, lookup(position), now)) {
+                m_lastLatency = 0;
+            }
+            return;
+        }
+
+        // A combo key still waiting went down before this release: send it first
+        if (m_pendingKind == PENDING_COMBO && position != m_pendingKey) {
+            resolvePending(false, now);
+        }
+
+        if (position == m_pendingKey) {
+            if (m_pendingKind == PENDING_COMBO) {
+                m_pendingKind = PENDING_NONE;
+                m_pendingKey  = NO_KEY;
+                uint16_t action = lookup(position);
+                if (KeymapAction::isTapHold(action)) {
+                    tap(action);
+                } else {
+                    pressAction(position, action);
+                    releaseAction(position);
+                }
+            } else {
+                tap(m_pendingAction);
+            }
+            clearPending(now);
+            return;
+        }
+
+        if (m_active[position] == CONSUMED) {
+            m_active[position] = KeymapAction::NONE;
+            return;
+        }
+
+        releaseAction(position);
+    }
+
+    /**
+     * @brief Report a key edge at millis()
+     * @param position Key position
+     * @param pressed true for press, false for release
+     */
+    void keyEvent(uint8_t position, bool pressed) {
+        keyEvent(position, pressed, millis());
+    }
+
+    /**
+     * @brief Settle timeouts; call from loop()
+     * @param now Current time in ms
+     */
+    void update(unsigned long now) {
+        if (m_pendingKind == PENDING_COMBO && now - m_pendingSince >= m_comboTerm) {
+            resolvePending(false, now);
+        }
+        if (m_pendingKind == PENDING_TAP_HOLD) {
+            resolvePending(false, now);
+        }
+    }
+
+    /**
+     * @brief Settle timeouts at millis()
+     */
+    void update() {
+        update(millis());
+    }
+
+    /**
+     * @brief Get the active layer bitmask
+     * @return Bit n set when layer n is active (bit 0 always set)
+     */
+    inline uint16_t layerState() const {
+        return m_layerState;
+    }
+
+    /**
+     * @brief Time from press to decision for the last settled key
+     * @return Milliseconds (0 for keys that need no decision)
+     */
+    inline unsigned long lastDecisionLatency() const {
+        return m_lastLatency;
+    }
+};
+
+#endif // SERIAL_INPUT_KEYMAP_H
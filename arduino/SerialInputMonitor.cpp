@@ -4,321 +4,561 @@
  * @version 1.0.0
  * @date 2025-09-05
  * 
+ * Member definitions live in SerialInputMonitor.tpp so that filtered
+ * monitors can instantiate them; this unit holds the default one, the
+ * default idle hook, the DMA transmit engines, the event line encoder,
+ * the TX queue, the text window and the program buffer.
+ * 
  * @author Leonardo Klein
  */
 
 #include "SerialInputMonitor.h"
 
-SerialInputMonitor::SerialInputMonitor() 
-    : m_leftButtonPressed(false)
-    , m_rightButtonPressed(false)
-    , m_middleButtonPressed(false) {
+#include <limits.h>
+
+#if defined(__AVR__)
+#include <avr/sleep.h>
+#elif defined(ARDUINO_ARCH_RP2040)
+#include <hardware/dma.h>
+#include <hardware/uart.h>
+#endif
+
+void serialInputIdle(uint32_t maxUs) {
+#if defined(SERIAL_INPUT_SIMULATOR)
+    simIdle(maxUs);
+#elif defined(__AVR__)
+    (void)maxUs; // Timer0 wakes the CPU within 1.024 ms anyway
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    noInterrupts();
+    sleep_enable();
+    interrupts(); // SEI takes effect after the next instruction, SLEEP: no wake-up is missed
+    sleep_cpu();
+    sleep_disable();
+#else
+    (void)maxUs;
+    yield();
+#endif
+}
+
+Stream *serialInputLink = &Serial;
+
+// ==================== DMA TRANSMIT ====================
+
+#if SIM_HAS_DMA_TX
+DmaTx *serialInputDmaTx = nullptr;
+#endif
+
+#if defined(SERIAL_INPUT_SIMULATOR)
+const TxDmaEngine SERIAL_TX_DMA = {simTxDmaStart, simTxDmaBusy, simTxDmaWait};
+#elif defined(ARDUINO_ARCH_RP2040)
+namespace {
+
+int g_txDmaChannel = -1; ///< Claimed on the first transfer
+
+void rp2040TxDmaStart(const uint8_t *data, uint16_t length) {
+    if (g_txDmaChannel < 0) {
+        // Bytes to the UART0 data register, one per TX DREQ
+        g_txDmaChannel            = dma_claim_unused_channel(true);
+        dma_channel_config config = dma_channel_get_default_config(g_txDmaChannel);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+        channel_config_set_read_increment(&config, true);
+        channel_config_set_write_increment(&config, false);
+        channel_config_set_dreq(&config, uart_get_dreq(uart0, true));
+        dma_channel_configure(g_txDmaChannel, &config, &uart_get_hw(uart0)->dr, data, length, true);
+        return;
+    }
+    dma_channel_transfer_from_buffer_now(g_txDmaChannel, data, length);
 }
 
-void SerialInputMonitor::sendCommand(Device device, uint8_t event, int param1, int param2) {
-    Serial.print(static_cast<uint8_t>(device));
-    Serial.print(" ");
-    Serial.print(event);
-    
-    if (param1 != 0 || param2 != 0) {
-        Serial.print(" ");
-        Serial.print(param1);
-        
-        if (param2 != 0) {
-            Serial.print(" ");
-            Serial.print(param2);
-        }
-    }
-    
-    Serial.println();
+bool rp2040TxDmaBusy() {
+    return g_txDmaChannel >= 0 && dma_channel_is_busy(g_txDmaChannel);
 }
 
-void SerialInputMonitor::sendKeySequence(bool newLine, const char* text) {
-    if (!text) return;
-    
-    size_t length = strlen(text);
-    
-    for (size_t i = 0; i < length; i++) {
-        typeCharacter(text[i]);
-        delay(10);
-    }
-    
-    if (newLine) {
-        tapKey(VirtualKey::ENTER);
+void rp2040TxDmaWait() {
+    if (g_txDmaChannel >= 0) {
+        dma_channel_wait_for_finish_blocking(g_txDmaChannel);
     }
 }
 
-void SerialInputMonitor::setMousePosition(int x, int y) {
-    sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::POSITION), x, y);
-}
+} // namespace
 
-void SerialInputMonitor::moveMouseRelative(int deltaX, int deltaY) {
-    sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::MOVE), deltaX, deltaY);
-}
+const TxDmaEngine SERIAL_TX_DMA = {rp2040TxDmaStart, rp2040TxDmaBusy, rp2040TxDmaWait};
+#endif
+
+// ==================== EVENT LINES ====================
 
-void SerialInputMonitor::pressRightButton() {
-    if (!m_rightButtonPressed) {
-        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::RIGHT_PRESS));
-        m_rightButtonPressed = true;
+namespace {
+
+/**
+ * @brief Append a number in a base
+ * @return Position after the digits
+ */
+char *appendUnsigned(char *out, uint32_t value, uint8_t base) {
+    char    digits[10];
+    uint8_t count = 0;
+    do {
+        uint8_t digit   = static_cast<uint8_t>(value % base);
+        digits[count++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+    while (count > 0) {
+        *out++ = digits[--count];
     }
+    return out;
 }
 
-void SerialInputMonitor::releaseRightButton() {
-    if (m_rightButtonPressed) {
-        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::RIGHT_RELEASE));
-        m_rightButtonPressed = false;
+char *appendSigned(char *out, int32_t value) {
+    if (value < 0) {
+        *out++ = '-';
+        return appendUnsigned(out, 0UL - static_cast<uint32_t>(value), 10);
     }
+    return appendUnsigned(out, static_cast<uint32_t>(value), 10);
 }
 
-void SerialInputMonitor::pressLeftButton() {
-    if (!m_leftButtonPressed) {
-        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::LEFT_PRESS));
-        m_leftButtonPressed = true;
+/**
+ * @brief Frame and terminate a line in place
+ * @param line Line text, with room for the framed line after it
+ * @param length Text length
+ * @param framing Framing to apply
+ * @return Framed length, terminator included
+ */
+uint8_t frameLine(char *line, uint8_t length, Framing framing) {
+    if (framing == Framing::PLAIN) {
+        line[length++] = '\r';
+        line[length++] = '\n';
+        return length;
     }
-}
 
-void SerialInputMonitor::releaseLeftButton() {
-    if (m_leftButtonPressed) {
-        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::LEFT_RELEASE));
-        m_leftButtonPressed = false;
+    uint16_t crc = CRC_INIT;
+    for (uint8_t i = 0; i < length; i++) {
+        crc = crc16Update(crc, static_cast<uint8_t>(line[i]));
+    }
+
+    if (framing == Framing::CRC) {
+        char *out = line + length;
+        *out++    = ' ';
+        *out++    = CRC_PREFIX;
+        for (int8_t shift = 12; shift >= 0; shift -= 4) {
+            uint8_t digit = (crc >> shift) & 0x0F;
+            *out++        = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        }
+        *out++ = '\r';
+        *out++ = '\n';
+        return static_cast<uint8_t>(out - line);
     }
-}
 
-void SerialInputMonitor::pressMiddleButton() {
-    if (!m_middleButtonPressed) {
-        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::MIDDLE_PRESS));
-        m_middleButtonPressed = true;
+    // Byte i moves to 1 + 2i, never onto a byte still to be read: encode
+    // back to front in the same buffer
+    line[length]     = static_cast<char>(crc >> 8);
+    line[length + 1] = static_cast<char>(crc & 0xFF);
+    for (int16_t i = length + 1; i >= 0; i--) {
+        uint8_t byte    = static_cast<uint8_t>(line[i]);
+        line[1 + 2 * i] = static_cast<char>(fecEncodeNibble(byte >> 4));
+        line[2 + 2 * i] = static_cast<char>(fecEncodeNibble(byte & 0x0F));
     }
+    line[0]                    = FEC_PREFIX;
+    line[1 + 2 * (length + 2)] = '\n';
+    return static_cast<uint8_t>(2 + 2 * (length + 2));
 }
 
-void SerialInputMonitor::releaseMiddleButton() {
-    if (m_middleButtonPressed) {
-        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::MIDDLE_RELEASE));
-        m_middleButtonPressed = false;
+} // namespace
+
+uint8_t formatEventLine(char *line, const InputEvent &event, char stampPrefix, uint32_t stampUs, Framing framing) {
+    // Same text as Serial.print() of each field, so lines read as before
+    char *out = appendUnsigned(line, static_cast<uint8_t>(event.device), 10);
+    *out++    = ' ';
+    out       = appendUnsigned(out, event.event, 10);
+
+    if (event.param1 != 0 || event.param2 != 0) {
+        *out++ = ' ';
+        if (event.device == Device::KEYBOARD) {
+            out = appendUnsigned(out, static_cast<uint32_t>(static_cast<int32_t>(event.param1)), 16);
+        } else {
+            out = appendSigned(out, event.param1);
+        }
+
+        if (event.param2 != 0) {
+            *out++ = ' ';
+            out    = appendSigned(out, event.param2);
+        }
+    }
+
+    if (stampPrefix != 0) {
+        *out++ = ' ';
+        *out++ = stampPrefix;
+        out    = appendUnsigned(out, stampUs, 16);
     }
+
+    return frameLine(line, static_cast<uint8_t>(out - line), framing);
 }
 
-void SerialInputMonitor::clickLeft() {
-    pressLeftButton();
-    delay(50);
-    releaseLeftButton();
+uint8_t formatSyncLine(char *line, SyncMessage message, const uint32_t *values, uint8_t count, Framing framing) {
+    char *out = line;
+    *out++    = SYNC_PREFIX;
+    *out++    = static_cast<char>(message);
+    for (uint8_t i = 0; i < count; i++) {
+        *out++ = ' ';
+        out    = appendUnsigned(out, values[i], 16);
+    }
+    return frameLine(line, static_cast<uint8_t>(out - line), framing == Framing::PLAIN ? Framing::PLAIN : Framing::CRC);
 }
 
-void SerialInputMonitor::clickRight() {
-    pressRightButton();
-    delay(50);
-    releaseRightButton();
+// ==================== TX QUEUE ====================
+
+TxQueue::TxQueue(TxEntry *entries, uint8_t capacity)
+    : m_entries(entries), m_capacity(capacity), m_count(0), m_maxAgeMs(0) {
+    m_policy[static_cast<uint8_t>(TxClass::MOTION)] = TxPolicy::MERGE;
+    m_policy[static_cast<uint8_t>(TxClass::SCROLL)] = TxPolicy::MERGE;
+    m_policy[static_cast<uint8_t>(TxClass::EDGE)]   = TxPolicy::BLOCK;
+    m_policy[static_cast<uint8_t>(TxClass::TEXT)]   = TxPolicy::BLOCK;
+    resetStats();
 }
 
-void SerialInputMonitor::doubleClickLeft() {
-    clickLeft();
-    delay(100);
-    clickLeft();
+void TxQueue::setPolicy(TxClass txClass, TxPolicy policy) {
+    // Dropping an edge would leave a key or button stuck
+    if (txClass == TxClass::EDGE || (txClass == TxClass::TEXT && policy != TxPolicy::BLOCK && policy != TxPolicy::FAIL)) {
+        return;
+    }
+    m_policy[static_cast<uint8_t>(txClass)] = policy;
 }
 
-void SerialInputMonitor::scrollMouse(int scrollAmount) {
-    sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::SCROLL), scrollAmount);
+void TxQueue::resetStats() {
+    memset(&m_stats, 0, sizeof(m_stats));
+    m_stats.maxPending = m_count;
 }
 
-void SerialInputMonitor::pressKey(VirtualKey key) {
-    sendCommand(Device::KEYBOARD, static_cast<uint8_t>(KeyboardEvent::PRESS), 
-                static_cast<uint16_t>(key));
+void TxQueue::submit(const InputEvent &event, TxClass txClass, char stampPrefix, uint32_t stampUs, Framing framing) {
+    pump();
+
+    if (m_count == 0) {
+        char    line[EVENT_LINE_MAX];
+        uint8_t length = formatEventLine(line, event, stampPrefix, stampUs, framing);
+        if (fitsSerial(length)) {
+            writeSerial(line, length);
+            return;
+        }
+    }
+
+    TxPolicy policy = this->policy(txClass);
+    if (policy == TxPolicy::MERGE && mergeIntoLast(event, txClass, stampPrefix, stampUs, framing)) {
+        m_stats.merged++;
+        return;
+    }
+
+    if (m_count == m_capacity) {
+        // Text events are only refused between characters (see hasRoom())
+        bool droppable = txClass == TxClass::MOTION || txClass == TxClass::SCROLL;
+        if (droppable && policy == TxPolicy::FAIL) {
+            countDrop(txClass);
+            return;
+        }
+        if (!(droppable && policy != TxPolicy::BLOCK && dropOldest(txClass))) {
+            m_stats.blocked++;
+            writeFront(true);
+        }
+    }
+
+    TxEntry &entry    = m_entries[m_count++];
+    entry.event       = event;
+    entry.stampUs     = stampUs;
+    entry.queuedMs    = static_cast<uint32_t>(millis());
+    entry.stampPrefix = stampPrefix;
+    entry.txClass     = txClass;
+    entry.framing     = framing;
+    if (m_count > m_stats.maxPending) {
+        m_stats.maxPending = m_count;
+    }
 }
 
-void SerialInputMonitor::releaseKey(VirtualKey key) {
-    sendCommand(Device::KEYBOARD, static_cast<uint8_t>(KeyboardEvent::RELEASE), 
-                static_cast<uint16_t>(key));
+void TxQueue::pump() {
+    dropStale();
+    while (m_count > 0 && writeFront(false)) {
+    }
 }
 
-void SerialInputMonitor::tapKey(VirtualKey key) {
-    pressKey(key);
-    delay(50);
-    releaseKey(key);
+bool TxQueue::hasRoom(uint8_t count) {
+    pump();
+    return m_capacity - m_count >= count;
 }
 
-void SerialInputMonitor::pressKey(char character) {
-    VirtualKey key = charToVirtualKey(character);
-    
-    if (requiresShift(character)) {
-        pressKey(VirtualKey::LEFT_SHIFT);
-        delay(10);
-        pressKey(key);
-    } else {
-        pressKey(key);
+bool TxQueue::writeFront(bool wait) {
+    char    line[EVENT_LINE_MAX];
+    uint8_t length = formatEventLine(line, m_entries[0].event, m_entries[0].stampPrefix, m_entries[0].stampUs,
+                                     m_entries[0].framing);
+    if (!wait && !fitsSerial(length)) {
+        return false;
     }
+    writeSerial(line, length);
+    removeAt(0);
+    return true;
 }
 
-void SerialInputMonitor::releaseKey(char character) {
-    VirtualKey key = charToVirtualKey(character);
-    
-    if (requiresShift(character)) {
-        releaseKey(key);
-        delay(10);
-        releaseKey(VirtualKey::LEFT_SHIFT);
+bool TxQueue::mergeIntoLast(const InputEvent &event, TxClass txClass, char stampPrefix, uint32_t stampUs,
+                            Framing framing) {
+    if (m_count == 0) {
+        return false;
+    }
+    TxEntry &last = m_entries[m_count - 1];
+    if (last.txClass != txClass || last.event.device != event.device || last.event.event != event.event) {
+        return false;
+    }
+
+    if (event.event == static_cast<uint8_t>(MouseEvent::POSITION)) {
+        last.event.param1 = event.param1;
+        last.event.param2 = event.param2;
     } else {
-        releaseKey(key);
+        // Relative motion and scrolling add up, unless the sum overflows
+        long param1 = static_cast<long>(last.event.param1) + event.param1;
+        long param2 = static_cast<long>(last.event.param2) + event.param2;
+        if (param1 < INT_MIN || param1 > INT_MAX || param2 < INT_MIN || param2 > INT_MAX) {
+            return false;
+        }
+        last.event.param1 = static_cast<int>(param1);
+        last.event.param2 = static_cast<int>(param2);
     }
+    last.stampUs     = stampUs;
+    last.stampPrefix = stampPrefix;
+    last.framing     = framing;
+    last.queuedMs    = static_cast<uint32_t>(millis());
+    return true;
+}
+
+bool TxQueue::dropOldest(TxClass txClass) {
+    for (uint8_t i = 0; i < m_count; i++) {
+        if (m_entries[i].txClass == txClass) {
+            removeAt(i);
+            countDrop(txClass);
+            return true;
+        }
+    }
+    return false;
 }
 
-void SerialInputMonitor::typeCharacter(char character) {
-    pressKey(character);
-    delay(50);
-    releaseKey(character);
+void TxQueue::dropStale() {
+    if (m_maxAgeMs == 0) {
+        return;
+    }
+
+    uint32_t now = static_cast<uint32_t>(millis());
+    uint8_t  i   = 0;
+    while (i < m_count) {
+        TxClass txClass = m_entries[i].txClass;
+        bool    stale   = now - m_entries[i].queuedMs > m_maxAgeMs && policy(txClass) != TxPolicy::BLOCK &&
+                     (txClass == TxClass::MOTION || txClass == TxClass::SCROLL);
+        if (stale) {
+            removeAt(i);
+            countDrop(txClass);
+        } else {
+            i++;
+        }
+    }
 }
 
-void SerialInputMonitor::typeTextLine(const char* text) {
-    sendKeySequence(true, text);
+void TxQueue::removeAt(uint8_t index) {
+    m_count--;
+    for (uint8_t i = index; i < m_count; i++) {
+        m_entries[i] = m_entries[i + 1];
+    }
 }
 
-void SerialInputMonitor::typeText(const char* text) {
-    sendKeySequence(false, text);
+// ==================== TEXT WINDOW ====================
+
+namespace {
+
+/**
+ * @brief Character of a text as the window sees it
+ * @param text Text being sent
+ * @param length Text length
+ * @param index Character index, length for the ENTER of a text line
+ * @return The character, '\n' past the end, ' ' for anything outside ASCII
+ */
+inline char textCharacter(const char *text, size_t length, size_t index) {
+    if (index >= length) {
+        return '\n';
+    }
+    return static_cast<uint8_t>(text[index]) >= TEXT_ESCAPE ? ' ' : text[index];
 }
 
-void SerialInputMonitor::copy() {
-    pressKey(VirtualKey::LEFT_CONTROL);
-    delay(10);
-    tapKey(VirtualKey::C);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_CONTROL);
+/**
+ * @brief Start a text line with its window position
+ * @return Length of ">POS "
+ */
+uint8_t startTextLine(char *line, uint16_t position) {
+    line[0]   = TEXT_PREFIX;
+    char *out = appendUnsigned(line + 1, position, 16);
+    *out++    = ' ';
+    return static_cast<uint8_t>(out - line);
 }
 
-void SerialInputMonitor::paste() {
-    pressKey(VirtualKey::LEFT_CONTROL);
-    delay(10);
-    tapKey(VirtualKey::V);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_CONTROL);
+} // namespace
+
+TextWindow::TextWindow(char *storage, uint16_t size)
+    : m_storage(storage), m_size(size), m_position(0), m_filled(0) {
+    resetStats();
 }
 
-void SerialInputMonitor::cut() {
-    pressKey(VirtualKey::LEFT_CONTROL);
-    delay(10);
-    tapKey(VirtualKey::X);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_CONTROL);
+void TextWindow::resetStats() {
+    memset(&m_stats, 0, sizeof(m_stats));
 }
 
-void SerialInputMonitor::undo() {
-    pressKey(VirtualKey::LEFT_CONTROL);
-    delay(10);
-    tapKey(VirtualKey::Z);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_CONTROL);
+void TextWindow::write(const char *text, bool newLine, Framing framing) {
+    size_t length = strlen(text);
+    size_t end    = length + (newLine ? 1 : 0);
+
+    if (end == 0) {
+        return;
+    }
+
+    char    line[EVENT_LINE_MAX];
+    uint8_t header  = startTextLine(line, m_position);
+    uint8_t payload = 0;
+
+    size_t i = 0;
+    while (i < end) {
+        uint16_t distance  = 0;
+        uint8_t  match     = findMatch(text, length, i, end, distance);
+        uint8_t  character = static_cast<uint8_t>(textCharacter(text, length, i));
+        uint8_t  size      = match == 0 && textIsLiteral(character) ? 1 : 2;
+        if (payload + size > TEXT_PAYLOAD_MAX) {
+            writeLine(line, static_cast<uint8_t>(header + payload), framing);
+            header  = startTextLine(line, m_position);
+            payload = 0;
+        }
+
+        char *out = line + header + payload;
+        if (match > 0) {
+            uint16_t back = distance - 1;
+            out[0]        = static_cast<char>(0x80 | (match - TEXT_MATCH_MIN) << 2 | back >> 7);
+            out[1]        = static_cast<char>(0x80 | (back & 0x7F));
+            for (uint8_t k = 0; k < match; k++) {
+                push(textCharacter(text, length, i + k));
+            }
+            i += match;
+        } else {
+            if (size == 1) {
+                out[0] = static_cast<char>(character);
+            } else {
+                out[0] = static_cast<char>(TEXT_ESCAPE);
+                out[1] = static_cast<char>(character ^ 0x40);
+            }
+            push(static_cast<char>(character));
+            i++;
+        }
+        payload = static_cast<uint8_t>(payload + size);
+        m_stats.payload += size;
+    }
+
+    writeLine(line, static_cast<uint8_t>(header + payload), framing);
+    m_stats.characters += end;
 }
 
-void SerialInputMonitor::redo() {
-    pressKey(VirtualKey::LEFT_CONTROL);
-    delay(10);
-    tapKey(VirtualKey::Y);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_CONTROL);
+uint8_t TextWindow::findMatch(const char *text, size_t length, size_t index, size_t end, uint16_t &distance) {
+    size_t  left  = end - index;
+    uint8_t limit = left < TEXT_MATCH_MAX ? static_cast<uint8_t>(left) : TEXT_MATCH_MAX;
+    if (limit < TEXT_MATCH_MIN) {
+        return 0;
+    }
+
+    uint16_t mask     = m_size - 1;
+    uint16_t compares = 0;
+    uint8_t  best     = 0;
+    char     first    = textCharacter(text, length, index);
+    for (uint16_t back = 1; back <= m_filled; back++) {
+        compares++;
+        if (m_storage[(m_position - back) & mask] != first) {
+            continue;
+        }
+
+        // A match may run on into the characters it produces
+        uint8_t matched = 1;
+        while (matched < limit) {
+            char source = matched < back ? m_storage[(m_position - back + matched) & mask]
+                                         : textCharacter(text, length, index + matched - back);
+            compares++;
+            if (source != textCharacter(text, length, index + matched)) {
+                break;
+            }
+            matched++;
+        }
+        if (matched > best) {
+            best     = matched;
+            distance = back;
+            if (best == limit) {
+                break;
+            }
+        }
+    }
+
+    m_stats.compares += compares;
+    return best >= TEXT_MATCH_MIN ? best : 0;
 }
 
-void SerialInputMonitor::selectAll() {
-    pressKey(VirtualKey::LEFT_CONTROL);
-    delay(10);
-    tapKey(VirtualKey::A);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_CONTROL);
+void TextWindow::writeLine(char *line, uint8_t length, Framing framing) {
+    length = frameLine(line, length, framing);
+    writeSerial(line, length);
+    m_stats.bytes += length;
 }
 
-void SerialInputMonitor::altTab() {
-    pressKey(VirtualKey::LEFT_ALT);
-    delay(10);
-    tapKey(VirtualKey::TAB);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_ALT);
+// ==================== PROGRAM BUFFER ====================
+
+ProgramBuffer::ProgramBuffer(uint8_t *storage, uint16_t capacity)
+    : m_storage(storage), m_capacity(capacity), m_length(0), m_lineBytes(0), m_high(0), m_lineStart(true),
+      m_inLine(false), m_complete(false), m_failed(false) {
 }
 
-void SerialInputMonitor::altF4() {
-    pressKey(VirtualKey::LEFT_ALT);
-    delay(10);
-    tapKey(VirtualKey::F4);
-    delay(10);
-    releaseKey(VirtualKey::LEFT_ALT);
+void ProgramBuffer::clear() {
+    m_length   = 0;
+    m_complete = false;
+    m_failed   = false;
 }
 
-VirtualKey SerialInputMonitor::charToVirtualKey(char character) {
-    // Numbers 0-9
-    if (character >= '0' && character <= '9') {
-        return static_cast<VirtualKey>(VirtualKey::NUM_0 + (character - '0'));
-    }
-    
-    // Lowercase letters a-z
-    if (character >= 'a' && character <= 'z') {
-        return static_cast<VirtualKey>(VirtualKey::A + (character - 'a'));
-    }
-    
-    // Uppercase letters A-Z
-    if (character >= 'A' && character <= 'Z') {
-        return static_cast<VirtualKey>(VirtualKey::A + (character - 'A'));
-    }
-    
-    // Common special characters
-    switch (character) {
-        case ' ': return VirtualKey::SPACE;
-        case '\t': return VirtualKey::TAB;
-        case '\r':
-        case '\n': return VirtualKey::ENTER;
-        case '\b': return VirtualKey::BACKSPACE;
-        
-        // Punctuation that doesn't require Shift
-        case ',': return VirtualKey::OEM_COMMA;
-        case '.': return VirtualKey::OEM_PERIOD;
-        case '/': return VirtualKey::OEM_2;
-        case ';': return VirtualKey::OEM_1;
-        case '\'': return VirtualKey::OEM_7;
-        case '[': return VirtualKey::OEM_4;
-        case ']': return VirtualKey::OEM_6;
-        case '\\': return VirtualKey::OEM_5;
-        case '`': return VirtualKey::OEM_3;
-        case '-': return VirtualKey::OEM_MINUS;
-        case '=': return VirtualKey::OEM_PLUS;
-        
-        case '!': return VirtualKey::NUM_1;
-        case '@': return VirtualKey::NUM_2;
-        case '#': return VirtualKey::NUM_3;
-        case '$': return VirtualKey::NUM_4;
-        case '%': return VirtualKey::NUM_5;
-        case '^': return VirtualKey::NUM_6;
-        case '&': return VirtualKey::NUM_7;
-        case '*': return VirtualKey::NUM_8;
-        case '(': return VirtualKey::NUM_9;
-        case ')': return VirtualKey::NUM_0;
-        case '_': return VirtualKey::OEM_MINUS;
-        case '+': return VirtualKey::OEM_PLUS;
-        case '{': return VirtualKey::OEM_4;
-        case '}': return VirtualKey::OEM_6;
-        case '|': return VirtualKey::OEM_5;
-        case ':': return VirtualKey::OEM_1;
-        case '"': return VirtualKey::OEM_7;
-        case '<': return VirtualKey::OEM_COMMA;
-        case '>': return VirtualKey::OEM_PERIOD;
-        case '?': return VirtualKey::OEM_2;
-        case '~': return VirtualKey::OEM_3;
-        
-        default:
-            return VirtualKey::SPACE;
+bool ProgramBuffer::receive(char character) {
+    if (character == '\r' || character == '\n') {
+        bool programLine = m_inLine;
+        if (m_inLine && m_lineBytes == 0) {
+            // A lone "&" ends the program
+            m_complete = true;
+        } else if (m_inLine && m_lineBytes % 2 != 0) {
+            m_failed = true;
+        }
+        m_inLine    = false;
+        m_lineStart = true;
+        return programLine;
+    }
+
+    if (m_lineStart) {
+        m_lineStart = false;
+        m_inLine    = character == PROGRAM_PREFIX;
+        m_lineBytes = 0;
+        if (m_inLine && m_complete) {
+            clear(); // The next upload replaces a program nobody took
+        }
+        return m_inLine;
+    }
+    if (!m_inLine) {
+        return false;
     }
-}
 
-bool SerialInputMonitor::requiresShift(char character) {
-    if (character >= 'A' && character <= 'Z') {
+    uint8_t digit;
+    if (character >= '0' && character <= '9') {
+        digit = static_cast<uint8_t>(character - '0');
+    } else if (character >= 'A' && character <= 'F') {
+        digit = static_cast<uint8_t>(character - 'A' + 10);
+    } else if (character >= 'a' && character <= 'f') {
+        digit = static_cast<uint8_t>(character - 'a' + 10);
+    } else {
+        m_failed = true;
         return true;
     }
-    
-    switch (character) {
-        case '!': case '@': case '#': case '$': case '%':
-        case '^': case '&': case '*': case '(': case ')':
-        case '_': case '+': case '{': case '}': case '|':
-        case ':': case '"': case '<': case '>': case '?':
-        case '~':
-            return true;
-        default:
-            return false;
+
+    if (m_lineBytes++ % 2 == 0) {
+        m_high = digit;
+    } else if (m_length < m_capacity) {
+        m_storage[m_length++] = static_cast<uint8_t>(m_high << 4 | digit);
+    } else {
+        m_failed = true;
     }
+    return true;
 }
 
-void SerialInputMonitor::delay(unsigned long milliseconds) {
-    ::delay(milliseconds);
-}
+template class BasicSerialInputMonitor<Pipeline<> >;
@@ -16,6 +16,10 @@
  * - EVENT: Specific event code
  * - PARAMS: Optional parameters (coordinates, key codes, etc.)
  *
+ * With enableClockSync(), events also carry the device time at which
+ * they were generated, or with enableScheduledPlayback() the time at
+ * which the host should execute them (see SerialInputProtocol.h).
+ *
  * @author Leonardo Klein
  */
 
@@ -23,217 +27,813 @@
 #define SERIAL_INPUT_MONITOR_H
 
 #include <Arduino.h>
+#include "SerialInputDma.h"
+#include "SerialInputProtocol.h"
+
+/**
+ * @brief SIM_TEXT() is available (C++14 and later, see SIM_CONSTEXPR14)
+ */
+#if __cplusplus >= 201402L
+#define SIM_HAS_CONSTEXPR_TEXT 1
+#else
+#define SIM_HAS_CONSTEXPR_TEXT 0
+#endif
+
+/**
+ * @brief Key events of a text, pre-encoded at compile time
+ *
+ * Each event takes two bytes in program memory: the virtual key and
+ * a set of SimText flags. Build instances with SIM_TEXT().
+ */
+struct EncodedText {
+    const uint8_t *events; ///< Event byte pairs stored in PROGMEM
+    uint16_t count;        ///< Number of events
+};
+
+/**
+ * @brief Compiled event program (see ProgramStep)
+ *
+ * serial-input-script compiles DuckyScript-style scripts into headers
+ * defining one of these in PROGMEM; ProgramBuffer receives them over
+ * serial into RAM.
+ */
+struct EventProgram {
+    const uint8_t *steps;   ///< Encoded steps
+    uint16_t       length;  ///< Number of bytes
+    bool           inFlash; ///< steps is in PROGMEM
+};
 
 /**
- * @brief Supported device types
+ * @brief Single protocol event, as seen by filter stages
+ */
+struct InputEvent {
+    Device  device; ///< Target device
+    uint8_t event;  ///< MouseEvent or KeyboardEvent code
+    int     param1; ///< First parameter (coordinate, delta or key code)
+    int     param2; ///< Second parameter (Y coordinate or delta)
+};
+
+/**
+ * @brief Held events of a stage: none unless it has `bool release(InputEvent &)`
+ */
+template <typename Stage, typename = void> struct StageRelease {
+    static inline bool release(Stage &, InputEvent &) {
+        return false;
+    }
+};
+
+template <typename Stage> struct StageRelease<Stage, decltype(void(&Stage::release))> {
+    static inline bool release(Stage &stage, InputEvent &event) {
+        return stage.release(event);
+    }
+};
+
+/**
+ * @brief Compile-time chain of filter stages
+ *
+ * Each stage provides `bool apply(InputEvent &event)`: it may rewrite
+ * the event and returns false to suppress it. Stages run in order and
+ * stop at the first suppression. Stages live in SerialInputFilters.h.
+ *
+ * A stage that holds events back may also provide
+ * `bool release(InputEvent &event)`, which fills in one held event that
+ * is due and returns true. The monitor asks from poll(); a released
+ * event goes through the stages after its own.
+ *
+ * The same stage type may appear more than once: each stage is held by
+ * a PipelineStage of its own index. Empty stages take no storage.
  */
-enum class Device : uint8_t {
-    MOUSE    = 0, ///< Mouse device
-    KEYBOARD = 1  ///< Keyboard device
+template <uint8_t Index, typename Stage> class PipelineStage : private Stage {
+  protected:
+    inline bool applyStage(InputEvent &event) {
+        return Stage::apply(event);
+    }
+
+    inline bool releaseStage(InputEvent &event) {
+        return StageRelease<Stage>::release(*this, event);
+    }
 };
 
 /**
- * @brief Mouse events
+ * @brief Stages from Index on, each in its PipelineStage
  */
-enum class MouseEvent : uint8_t {
-    RIGHT_PRESS    = 0, ///< Press right button
-    RIGHT_RELEASE  = 1, ///< Release right button
-    LEFT_PRESS     = 2, ///< Press left button
-    LEFT_RELEASE   = 3, ///< Release left button
-    MIDDLE_PRESS   = 4, ///< Press middle button
-    MIDDLE_RELEASE = 5, ///< Release middle button
-    SCROLL         = 6, ///< Scroll wheel
-    POSITION       = 7, ///< Set absolute position
-    MOVE           = 8  ///< Move relatively
+template <uint8_t Index, typename... Stages> class PipelineStages;
+
+template <uint8_t Index> class PipelineStages<Index> {
+  public:
+    inline bool apply(InputEvent &) {
+        return true;
+    }
+
+    template <typename Emit> inline void release(const Emit &) {
+    }
+};
+
+template <uint8_t Index, typename First, typename... Rest>
+class PipelineStages<Index, First, Rest...> : private PipelineStage<Index, First>,
+                                              private PipelineStages<Index + 1, Rest...> {
+  public:
+    inline bool apply(InputEvent &event) {
+        return PipelineStage<Index, First>::applyStage(event) && PipelineStages<Index + 1, Rest...>::apply(event);
+    }
+
+    template <typename Emit> inline void release(const Emit &emit) {
+        InputEvent event;
+        while (PipelineStage<Index, First>::releaseStage(event)) {
+            if (PipelineStages<Index + 1, Rest...>::apply(event)) {
+                emit(event);
+            }
+        }
+        PipelineStages<Index + 1, Rest...>::release(emit);
+    }
+};
+
+template <typename... Stages> class Pipeline : private PipelineStages<0, Stages...> {
+  public:
+    inline bool apply(InputEvent &event) {
+        return PipelineStages<0, Stages...>::apply(event);
+    }
+
+    /**
+     * @brief Hand every held event that is due to emit(const InputEvent &)
+     */
+    template <typename Emit> inline void release(const Emit &emit) {
+        PipelineStages<0, Stages...>::release(emit);
+    }
 };
 
 /**
- * @brief Keyboard events
+ * @brief Check if a filter lets every event through unchanged
+ *
+ * Only such monitors send text lines: the host types those without
+ * the events ever passing the device's filter stages.
  */
-enum class KeyboardEvent : uint8_t {
-    PRESS   = 1, ///< Press key
-    RELEASE = 0  ///< Release key
+template <typename Filter> struct IsPassThrough {
+    static const bool value = false;
+};
+
+template <> struct IsPassThrough<Pipeline<> > {
+    static const bool value = true;
 };
 
+// ==================== TX QUEUE ====================
+
+const uint8_t  EVENT_LINE_MAX    = 84;    ///< Longest encoded event line: 39 characters, FEC-coded with their CRC
+const uint8_t  SYNC_LINE_MAX     = 32;    ///< Longest sync line, CRC token and "\r\n" included
+const uint32_t SYNC_PING_WAIT_US = 20000; ///< Longest wait for a ping to leave behind a TX queue (7 bytes at 9600 baud)
+
+/// Stream the library reads the host from and writes its lines to, &Serial by default (see attachLink())
+extern Stream *serialInputLink;
+
+#if SIM_HAS_DMA_TX
+/// Double buffer every library line goes through, nullptr for the link (see attachDmaTx())
+extern DmaTx *serialInputDmaTx;
+#endif
+
+/**
+ * @brief The board has a DMA engine for Serial in the library (SERIAL_TX_DMA)
+ */
+#if defined(SERIAL_INPUT_SIMULATOR) || defined(ARDUINO_ARCH_RP2040)
+#define SIM_HAS_SERIAL_TX_DMA 1
+
 /**
- * @brief Key codes based on Windows Virtual Key Codes standard
+ * @brief DMA engine feeding Serial's transmitter
  *
- * This enumeration contains standardized hexadecimal codes for keys,
- * compatible with Windows system and widely used in embedded systems.
- */
-enum class VirtualKey : uint16_t {
-    // Basic control keys
-    BACKSPACE = 0x08, ///< BACKSPACE key
-    TAB       = 0x09, ///< TAB key
-    CLEAR     = 0x0C, ///< CLEAR key
-    ENTER     = 0x0D, ///< ENTER key
-
-    // Modifier keys
-    SHIFT     = 0x10, ///< SHIFT key (generic)
-    CONTROL   = 0x11, ///< CTRL key (generic)
-    ALT       = 0x12, ///< ALT key (generic)
-    PAUSE     = 0x13, ///< PAUSE key
-    CAPS_LOCK = 0x14, ///< CAPS LOCK key
-
-    // IME keys
-    KANA    = 0x15, ///< Kana IME mode
-    HANGEUL = 0x15, ///< Hangeul IME mode (alias)
-    HANGUL  = 0x15, ///< Hangul IME mode (alias)
-    IME_ON  = 0x16, ///< IME enabled
-    JUNJA   = 0x17, ///< Junja IME mode
-    FINAL   = 0x18, ///< Final IME mode
-    HANJA   = 0x19, ///< Hanja IME mode
-    KANJI   = 0x19, ///< Kanji IME mode (alias)
-    IME_OFF = 0x1A, ///< IME disabled
-
-    // Navigation keys
-    ESCAPE     = 0x1B, ///< ESC key
-    CONVERT    = 0x1C, ///< IME conversion
-    NONCONVERT = 0x1D, ///< IME non-conversion
-    ACCEPT     = 0x1E, ///< IME accept
-    MODECHANGE = 0x1F, ///< IME mode change
-
-    // Special keys
-    SPACE     = 0x20, ///< Space bar
-    PAGE_UP   = 0x21, ///< PAGE UP key
-    PAGE_DOWN = 0x22, ///< PAGE DOWN key
-    END       = 0x23, ///< END key
-    HOME      = 0x24, ///< HOME key
-
-    // Arrow keys
-    ARROW_LEFT  = 0x25, ///< Left arrow
-    ARROW_UP    = 0x26, ///< Up arrow
-    ARROW_RIGHT = 0x27, ///< Right arrow
-    ARROW_DOWN  = 0x28, ///< Down arrow
-
-    // Special function keys
-    SELECT       = 0x29, ///< SELECT key
-    PRINT        = 0x2A, ///< PRINT key
-    EXECUTE      = 0x2B, ///< EXECUTE key
-    PRINT_SCREEN = 0x2C, ///< PRINT SCREEN key
-    INSERT       = 0x2D, ///< INSERT key
-    DELETE       = 0x2E, ///< DELETE key
-    HELP         = 0x2F, ///< HELP key
-
-    // Numbers (0-9)
-    NUM_0 = 0x30, NUM_1 = 0x31, NUM_2 = 0x32, NUM_3 = 0x33, NUM_4 = 0x34,
-    NUM_5 = 0x35, NUM_6 = 0x36, NUM_7 = 0x37, NUM_8 = 0x38, NUM_9 = 0x39,
-
-    // Letters (A-Z)
-    A = 0x41, B = 0x42, C = 0x43, D = 0x44, E = 0x45, F = 0x46,
-    G = 0x47, H = 0x48, I = 0x49, J = 0x4A, K = 0x4B, L = 0x4C,
-    M = 0x4D, N = 0x4E, O = 0x4F, P = 0x50, Q = 0x51, R = 0x52,
-    S = 0x53, T = 0x54, U = 0x55, V = 0x56, W = 0x57, X = 0x58,
-    Y = 0x59, Z = 0x5A,
-
-    // Windows keys
-    LEFT_WIN  = 0x5B, ///< Left Windows key
-    RIGHT_WIN = 0x5C, ///< Right Windows key
-    APPS      = 0x5D, ///< Applications key
-
-    // Special key
-    SLEEP = 0x5F, ///< Computer sleep key
-
-    // Numeric keypad
-    NUMPAD_0 = 0x60, NUMPAD_1 = 0x61, NUMPAD_2 = 0x62, NUMPAD_3 = 0x63, NUMPAD_4 = 0x64,
-    NUMPAD_5 = 0x65, NUMPAD_6 = 0x66, NUMPAD_7 = 0x67, NUMPAD_8 = 0x68, NUMPAD_9 = 0x69,
-
-    MULTIPLY  = 0x6A, ///< * (multiply)
-    ADD       = 0x6B, ///< + (add)
-    SEPARATOR = 0x6C, ///< Separator
-    SUBTRACT  = 0x6D, ///< - (subtract)
-    DECIMAL   = 0x6E, ///< . (decimal)
-    DIVIDE    = 0x6F, ///< / (divide)
-
-    // Function keys (F1-F24)
-    F1 = 0x70, F2 = 0x71, F3 = 0x72, F4 = 0x73, F5 = 0x74, F6 = 0x75,
-    F7 = 0x76, F8 = 0x77, F9 = 0x78, F10 = 0x79, F11 = 0x7A, F12 = 0x7B,
-    F13 = 0x7C, F14 = 0x7D, F15 = 0x7E, F16 = 0x7F, F17 = 0x80, F18 = 0x81,
-    F19 = 0x82, F20 = 0x83, F21 = 0x84, F22 = 0x85, F23 = 0x86, F24 = 0x87,
-
-    // Lock keys
-    NUM_LOCK    = 0x90, ///< NUM LOCK
-    SCROLL_LOCK = 0x91, ///< SCROLL LOCK
-
-    // Specific modifiers
-    LEFT_SHIFT    = 0xA0, ///< Left SHIFT
-    RIGHT_SHIFT   = 0xA1, ///< Right SHIFT
-    LEFT_CONTROL  = 0xA2, ///< Left CTRL
-    RIGHT_CONTROL = 0xA3, ///< Right CTRL
-    LEFT_ALT      = 0xA4, ///< Left ALT
-    RIGHT_ALT     = 0xA5, ///< Right ALT
-
-    // Browser keys
-    BROWSER_BACK      = 0xA6, ///< Browser back
-    BROWSER_FORWARD   = 0xA7, ///< Browser forward
-    BROWSER_REFRESH   = 0xA8, ///< Browser refresh
-    BROWSER_STOP      = 0xA9, ///< Browser stop
-    BROWSER_SEARCH    = 0xAA, ///< Browser search
-    BROWSER_FAVORITES = 0xAB, ///< Browser favorites
-    BROWSER_HOME      = 0xAC, ///< Browser home
-
-    // Volume controls
-    VOLUME_MUTE = 0xAD, ///< Mute
-    VOLUME_DOWN = 0xAE, ///< Volume down
-    VOLUME_UP   = 0xAF, ///< Volume up
-
-    // Media controls
-    MEDIA_NEXT_TRACK = 0xB0, ///< Next track
-    MEDIA_PREV_TRACK = 0xB1, ///< Previous track
-    MEDIA_STOP       = 0xB2, ///< Stop media
-    MEDIA_PLAY_PAUSE = 0xB3, ///< Play/Pause
-
-    // Launch keys
-    LAUNCH_MAIL         = 0xB4, ///< Launch mail
-    LAUNCH_MEDIA_SELECT = 0xB5, ///< Media selector
-    LAUNCH_APP1         = 0xB6, ///< Application 1
-    LAUNCH_APP2         = 0xB7, ///< Application 2
-
-    // OEM keys (keyboard specific)
-    OEM_1      = 0xBA, ///< Misc characters (;: in US)
-    OEM_PLUS   = 0xBB, ///< + key for any country
-    OEM_COMMA  = 0xBC, ///< , key for any country
-    OEM_MINUS  = 0xBD, ///< - key for any country
-    OEM_PERIOD = 0xBE, ///< . key for any country
-    OEM_2      = 0xBF, ///< Misc characters (/? in US)
-    OEM_3      = 0xC0, ///< Misc characters (`~ in US)
-
-    OEM_4 = 0xDB, ///< Misc characters ([{ in US)
-    OEM_5 = 0xDC, ///< Misc characters (\\| in US)
-    OEM_6 = 0xDD, ///< Misc characters (]} in US)
-    OEM_7 = 0xDE, ///< Misc characters ('" in US)
-    OEM_8 = 0xDF, ///< Misc characters
-
-    // Advanced special keys
-    OEM_102     = 0xE2, ///< <> or \\| key on RT 102
-    PROCESS_KEY = 0xE5, ///< IME process key
-    PACKET      = 0xE7, ///< Direct Unicode sending
-
-    // Final control keys
-    ATTN      = 0xF6, ///< ATTN key
-    CRSEL     = 0xF7, ///< CrSel key
-    EXSEL     = 0xF8, ///< ExSel key
-    EREOF     = 0xF9, ///< EOF erase key
-    PLAY      = 0xFA, ///< PLAY key
-    ZOOM      = 0xFB, ///< ZOOM key
-    PA1       = 0xFD, ///< PA1 key
-    OEM_CLEAR = 0xFE  ///< CLEAR key
+ * In the native simulator it drains into the pty after Serial's own
+ * buffer. On the RP2040 it feeds UART0 (Serial1 on the Philhower core),
+ * paced by its TX DREQ; attach SERIAL_TX_DMA_LINK as the link so that
+ * the host is read from the same UART.
+ */
+extern const TxDmaEngine SERIAL_TX_DMA;
+
+/// Stream whose transmitter SERIAL_TX_DMA feeds
+#if defined(ARDUINO_ARCH_RP2040) && !defined(SERIAL_INPUT_SIMULATOR)
+#define SERIAL_TX_DMA_LINK Serial1
+#else
+#define SERIAL_TX_DMA_LINK Serial
+#endif
+#else
+#define SIM_HAS_SERIAL_TX_DMA 0
+#endif
+
+/**
+ * @brief Check if the link has passed on everything written to it
+ * @return true when its transmit buffer is empty (always true on cores
+ *         without SERIAL_TX_BUFFER_SIZE), DMA buffers included
+ */
+inline bool serialTxEmpty() {
+#if SIM_HAS_DMA_TX
+    if (serialInputDmaTx) {
+        return serialInputDmaTx->pending() == 0;
+    }
+#endif
+#if defined(SERIAL_TX_BUFFER_SIZE)
+    return serialInputLink->availableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1;
+#else
+    return true;
+#endif
+}
+
+/**
+ * @brief Check if a line can be written to the link without waiting
+ * @param length Line length
+ * @return true if its transmit buffer has room for the line; a line
+ *         longer than the buffer only waits for its excess once the
+ *         buffer is empty, so that counts as room too
+ */
+inline bool fitsSerial(uint8_t length) {
+#if SIM_HAS_DMA_TX
+    if (serialInputDmaTx) {
+        return serialInputDmaTx->fits(length);
+    }
+#endif
+#if defined(SERIAL_TX_BUFFER_SIZE)
+    if (length >= SERIAL_TX_BUFFER_SIZE) {
+        return serialTxEmpty();
+    }
+#endif
+    return serialInputLink->availableForWrite() >= length;
+}
+
+/**
+ * @brief Write a line the way the library sends all of them
+ * @param line Line bytes
+ * @param length Line length
+ *
+ * Through the attached DmaTx if any, otherwise to the link.
+ */
+inline void writeSerial(const char *line, uint8_t length) {
+#if SIM_HAS_DMA_TX
+    if (serialInputDmaTx) {
+        serialInputDmaTx->write(reinterpret_cast<const uint8_t *>(line), length);
+        return;
+    }
+#endif
+    serialInputLink->write(line, length);
+}
+
+/**
+ * @brief Block until every line written has left
+ */
+inline void flushSerial() {
+#if SIM_HAS_DMA_TX
+    if (serialInputDmaTx) {
+        serialInputDmaTx->flush();
+    }
+#endif
+    serialInputLink->flush();
+}
+
+/**
+ * @brief Encode one event line as the monitor sends it
+ * @param line Buffer of EVENT_LINE_MAX bytes (not terminated)
+ * @param event Event to encode
+ * @param stampPrefix STAMP_PREFIX or DUE_PREFIX, 0 for no time token
+ * @param stampUs Device time written after the prefix
+ * @param framing Framing of the line
+ * @return Line length, terminator included
+ */
+uint8_t formatEventLine(char *line, const InputEvent &event, char stampPrefix, uint32_t stampUs,
+                        Framing framing = Framing::PLAIN);
+
+/**
+ * @brief Encode one sync line (~P or ~R) as the monitor sends it
+ * @param line Buffer of SYNC_LINE_MAX bytes (not terminated)
+ * @param message PING or REPORT
+ * @param values Hexadecimal fields after the message type
+ * @param count Number of fields (1-3)
+ * @param framing Framing of the event lines; sync lines take the CRC token unless PLAIN
+ * @return Line length, "\r\n" included
+ */
+uint8_t formatSyncLine(char *line, SyncMessage message, const uint32_t *values, uint8_t count, Framing framing);
+
+/**
+ * @brief Event classes of the TX queue, each with its own TxPolicy
+ */
+enum class TxClass : uint8_t {
+    MOTION = 0, ///< Relative and absolute mouse movement
+    SCROLL = 1, ///< Mouse wheel
+    EDGE   = 2, ///< Button and key presses and releases
+    TEXT   = 3  ///< Key events of typeText() and typeTextLine()
 };
 
+const uint8_t TX_CLASS_COUNT = 4; ///< Number of TxClass values
+
+/**
+ * @brief What a TX queue does with an event it has no room for
+ */
+enum class TxPolicy : uint8_t {
+    BLOCK       = 0, ///< Wait for the link, as without a queue
+    FAIL        = 1, ///< Drop the new event (TEXT: the rest of the text)
+    DROP_OLDEST = 2, ///< Drop the oldest queued event of the same class
+    MERGE       = 3  ///< Fold into the last queued event of the same kind, else DROP_OLDEST
+};
+
+/**
+ * @brief TxClass of an event sent outside of a text
+ * @param event Event to classify
+ * @return MOTION, SCROLL or EDGE
+ */
+inline TxClass txClassOf(const InputEvent &event) {
+    if (event.device == Device::MOUSE) {
+        if (event.event == static_cast<uint8_t>(MouseEvent::MOVE) ||
+            event.event == static_cast<uint8_t>(MouseEvent::POSITION)) {
+            return TxClass::MOTION;
+        }
+        if (event.event == static_cast<uint8_t>(MouseEvent::SCROLL)) {
+            return TxClass::SCROLL;
+        }
+    }
+    return TxClass::EDGE;
+}
+
+/**
+ * @brief Queued event line
+ */
+struct TxEntry {
+    InputEvent event;       ///< Event to write
+    uint32_t   stampUs;     ///< Device time of the time token
+    uint32_t   queuedMs;    ///< millis() when queued or last merged into
+    char       stampPrefix; ///< STAMP_PREFIX, DUE_PREFIX or 0
+    TxClass    txClass;     ///< Class the policy was taken from
+    Framing    framing;     ///< Framing of the line
+};
+
+/**
+ * @brief TX queue counters
+ */
+struct TxStats {
+    uint16_t dropped[TX_CLASS_COUNT]; ///< Events dropped per TxClass (TEXT: texts cut short)
+    uint16_t merged;                  ///< Events folded into a queued one
+    uint16_t blocked;                 ///< Events that had to wait for the link
+    uint8_t  maxPending;              ///< Most events queued at once
+};
+
+/**
+ * @brief Bounded queue between the monitor and Serial
+ *
+ * Lines go straight to Serial while its transmit buffer has room for
+ * them. Once it has not, because the link or the host stalls, events
+ * wait here and leave in order as room frees up, and a full queue
+ * applies the policy of the new event's class. Defaults: MERGE for
+ * MOTION and SCROLL, BLOCK for TEXT. EDGE is always BLOCK, so presses
+ * and releases are never lost or reordered, and TEXT takes BLOCK or
+ * FAIL only. With a maximum age set, queued MOTION and SCROLL events
+ * that are not BLOCK are dropped once older than that.
+ *
+ * Create one with TxQueueBuffer and pass it to attachTxQueue(). The
+ * queue is drained on every send and from poll().
+ */
+class TxQueue {
+  public:
+    /**
+     * @brief Create a queue over caller-provided storage
+     * @param entries Storage for capacity entries
+     * @param capacity Entries at most (4 or more)
+     */
+    TxQueue(TxEntry *entries, uint8_t capacity);
+
+    /**
+     * @brief Set the policy of a class
+     * @param txClass Event class
+     * @param policy What to do when the queue is full
+     */
+    void setPolicy(TxClass txClass, TxPolicy policy);
+
+    /**
+     * @brief Get the policy of a class
+     * @param txClass Event class
+     * @return Policy in effect
+     */
+    inline TxPolicy policy(TxClass txClass) const {
+        return m_policy[static_cast<uint8_t>(txClass)];
+    }
+
+    /**
+     * @brief Drop droppable events that waited longer than this
+     * @param maxAgeMs Age limit in ms, 0 for none (default)
+     */
+    inline void setMaxAgeMs(uint16_t maxAgeMs) {
+        m_maxAgeMs = maxAgeMs;
+    }
+
+    /**
+     * @brief Number of queued events
+     * @return Events not written to Serial yet
+     */
+    inline uint8_t pending() const {
+        return m_count;
+    }
+
+    /**
+     * @brief Counters since the last resetStats()
+     * @return Drop, merge and blocking counters
+     */
+    inline const TxStats &stats() const {
+        return m_stats;
+    }
+
+    /**
+     * @brief Clear the counters
+     */
+    void resetStats();
+
+    /**
+     * @brief Write or queue an event, applying the policy of its class
+     * @param event Event to send
+     * @param txClass Class of the event
+     * @param stampPrefix STAMP_PREFIX, DUE_PREFIX or 0
+     * @param stampUs Device time of the time token
+     * @param framing Framing of the line
+     */
+    void submit(const InputEvent &event, TxClass txClass, char stampPrefix, uint32_t stampUs,
+                Framing framing = Framing::PLAIN);
+
+    /**
+     * @brief Write queued events for which Serial has room, without blocking
+     */
+    void pump();
+
+    /**
+     * @brief Check if count events can be sent without waiting
+     * @param count Number of events
+     * @return true if the queue has room for them
+     */
+    bool hasRoom(uint8_t count);
+
+    /**
+     * @brief Count a drop made outside of submit() (a text cut short)
+     * @param txClass Class of the dropped events
+     */
+    inline void countDrop(TxClass txClass) {
+        m_stats.dropped[static_cast<uint8_t>(txClass)]++;
+    }
+
+  private:
+    TxEntry *m_entries;                ///< Storage, oldest first
+    uint8_t  m_capacity;               ///< Size of m_entries
+    uint8_t  m_count;                  ///< Queued entries
+    uint16_t m_maxAgeMs;               ///< Age limit, 0 for none
+    TxPolicy m_policy[TX_CLASS_COUNT]; ///< Policy per TxClass
+    TxStats  m_stats;                  ///< Counters
+
+    /**
+     * @brief Write the oldest entry
+     * @param wait Block until Serial has room instead of giving up
+     * @return true if it was written
+     */
+    bool writeFront(bool wait);
+
+    /**
+     * @brief Fold an event into the newest entry if it is the same kind
+     * @return true if merged
+     */
+    bool mergeIntoLast(const InputEvent &event, TxClass txClass, char stampPrefix, uint32_t stampUs, Framing framing);
+
+    /**
+     * @brief Drop the oldest entry of a class
+     * @return false if none is queued
+     */
+    bool dropOldest(TxClass txClass);
+
+    /**
+     * @brief Drop droppable entries older than m_maxAgeMs
+     */
+    void dropStale();
+
+    /**
+     * @brief Remove an entry, keeping the order of the others
+     * @param index Entry index
+     */
+    void removeAt(uint8_t index);
+};
+
+/**
+ * @brief TxQueue with its own storage
+ * @tparam Capacity Events queued at most (each takes sizeof(TxEntry), 17 bytes on AVR)
+ */
+template <uint8_t Capacity> class TxQueueBuffer : public TxQueue {
+    static_assert(Capacity >= 4, "a TX queue must hold a typed character (up to 4 events)");
+
+  public:
+    TxQueueBuffer() : TxQueue(m_storage, Capacity) {
+    }
+
+  private:
+    TxEntry m_storage[Capacity]; ///< Queue storage
+};
+
+// ==================== TEXT WINDOW ====================
+
+/**
+ * @brief Text line counters
+ */
+struct TextStats {
+    uint32_t characters; ///< Characters sent in text lines
+    uint32_t payload;    ///< Payload bytes they took (see SerialInputProtocol.h)
+    uint32_t bytes;      ///< Bytes written, line headers, framing and terminators included
+    uint32_t compares;   ///< Window bytes compared while looking for back-references
+};
+
+/**
+ * @brief Sliding window of sent text, for sending texts as text lines
+ *
+ * Sketches tend to type the same strings again and again. With a window
+ * attached, typeText() sends one text line instead of a key event per
+ * press and release, and any run of 3 or more characters found in the
+ * window goes out as a two-byte back-reference. The host keeps the
+ * same window and types the characters as the key events typeText()
+ * would have sent, Shift included.
+ *
+ * The search compares every position of the window, so the cost per
+ * character grows with its size (see stats()). A host that missed a
+ * line notices from the next line's position and drops lines that
+ * refer to text it does not have.
+ *
+ * Create one with TextWindowBuffer and pass it to attachTextWindow().
+ */
+class TextWindow {
+  public:
+    /**
+     * @brief Create a window over caller-provided storage
+     * @param storage Storage for size characters
+     * @param size Window size, a power of two up to TEXT_DISTANCE_MAX
+     */
+    TextWindow(char *storage, uint16_t size);
+
+    /**
+     * @brief Send a text as text lines
+     * @param text Null-terminated text; characters outside ASCII are typed as spaces
+     * @param newLine Type ENTER after the text
+     * @param framing Framing of the lines
+     */
+    void write(const char *text, bool newLine, Framing framing);
+
+    /**
+     * @brief Counters since the last resetStats()
+     * @return Characters, payload and wire bytes, compares
+     */
+    inline const TextStats &stats() const {
+        return m_stats;
+    }
+
+    /**
+     * @brief Clear the counters
+     */
+    void resetStats();
+
+  private:
+    char     *m_storage;  ///< Characters by position, modulo m_size
+    uint16_t  m_size;     ///< Size of m_storage
+    uint16_t  m_position; ///< Position of the next character
+    uint16_t  m_filled;   ///< Characters in the window, up to m_size
+    TextStats m_stats;    ///< Counters
+
+    /**
+     * @brief Find the longest back-reference for the next characters
+     * @param text Text being sent
+     * @param length Text length
+     * @param index Index of the next character
+     * @param end Characters in total, with the ENTER of a text line
+     * @param distance Receives how far back the match starts
+     * @return Match length, 0 if shorter than TEXT_MATCH_MIN
+     */
+    uint8_t findMatch(const char *text, size_t length, size_t index, size_t end, uint16_t &distance);
+
+    /**
+     * @brief Frame and write a text line
+     * @param line Line text, EVENT_LINE_MAX bytes of room
+     * @param length Text length
+     * @param framing Framing of the line
+     */
+    void writeLine(char *line, uint8_t length, Framing framing);
+
+    /**
+     * @brief Add a character to the window
+     * @param character Character sent
+     */
+    inline void push(char character) {
+        m_storage[m_position & (m_size - 1)] = character;
+        m_position++;
+        m_filled = m_filled < m_size ? m_filled + 1 : m_size;
+    }
+};
+
+/**
+ * @brief TextWindow with its own storage
+ * @tparam Size Window size in bytes: 64, 128, 256 or 512
+ */
+template <uint16_t Size> class TextWindowBuffer : public TextWindow {
+    static_assert(Size >= 64 && Size <= TEXT_DISTANCE_MAX && (Size & (Size - 1)) == 0,
+                  "a text window holds 64, 128, 256 or 512 characters");
+
+  public:
+    TextWindowBuffer() : TextWindow(m_storage, Size) {
+    }
+
+  private:
+    char m_storage[Size]; ///< Window storage
+};
+
+// ==================== PROGRAM BUFFER ====================
+
+/**
+ * @brief Receives event programs uploaded by the host
+ *
+ * The host sends "&HEX" lines that append to the program and a lone "&"
+ * to end it (serial-input-script -u). Attach with attachProgramBuffer():
+ * poll() then reads the input and passes program lines here. Once
+ * ready(), play program() and clear() the buffer for the next one.
+ */
+class ProgramBuffer {
+  public:
+    /**
+     * @brief Create a buffer over caller-provided storage
+     * @param storage Storage for capacity bytes
+     * @param capacity Longest program
+     */
+    ProgramBuffer(uint8_t *storage, uint16_t capacity);
+
+    /**
+     * @brief Read one input character
+     * @param character Character received
+     * @return true if it belonged to a program line
+     */
+    bool receive(char character);
+
+    /**
+     * @brief Check if a complete program has arrived
+     * @return true once the closing "&" arrived without errors
+     */
+    inline bool ready() const {
+        return m_complete && !m_failed;
+    }
+
+    /**
+     * @brief Check if an upload arrived damaged
+     * @return true once the closing "&" arrived after a line that was
+     *         malformed or did not fit
+     */
+    inline bool failed() const {
+        return m_complete && m_failed;
+    }
+
+    /**
+     * @brief Get the received program
+     * @return Program in RAM
+     */
+    inline EventProgram program() const {
+        EventProgram program = {m_storage, m_length, false};
+        return program;
+    }
+
+    /**
+     * @brief Drop the program and wait for the next one
+     */
+    void clear();
+
+  private:
+    uint8_t *m_storage;   ///< Program bytes
+    uint16_t m_capacity;  ///< Size of m_storage
+    uint16_t m_length;    ///< Bytes received
+    uint8_t  m_lineBytes; ///< Hex digits on the current program line
+    uint8_t  m_high;      ///< First digit of the byte being received
+    bool     m_lineStart; ///< Next character starts a line
+    bool     m_inLine;    ///< Current line is a program line
+    bool     m_complete;  ///< The closing "&" arrived
+    bool     m_failed;    ///< A line of the upload was malformed or did not fit
+};
+
+/**
+ * @brief ProgramBuffer with its own storage
+ * @tparam Capacity Longest program in bytes
+ */
+template <uint16_t Capacity> class ProgramBufferStorage : public ProgramBuffer {
+  public:
+    ProgramBufferStorage() : ProgramBuffer(m_storage, Capacity) {
+    }
+
+  private:
+    uint8_t m_storage[Capacity]; ///< Program storage
+};
+
+/**
+ * @brief Sleep until an interrupt, for at most maxUs microseconds
+ *
+ * Called by BasicSerialInputMonitor whenever it waits. Returning early
+ * is always fine: the caller checks the time and calls again.
+ */
+typedef void (*IdleHook)(uint32_t maxUs);
+
+/**
+ * @brief Default IdleHook: the deepest sleep that keeps millis() and Serial
+ * @param maxUs Microseconds to sleep at most
+ *
+ * On AVR this is idle mode. The deeper modes stop Timer0 and the UART
+ * clock, so millis() would stop and incoming bytes would be lost. Any
+ * interrupt wakes the CPU (UART, pin change, a compare match), and the
+ * Timer0 overflow does so at least every 1.024 ms. In the native
+ * simulator it is simIdle(); elsewhere it only calls yield().
+ */
+void serialInputIdle(uint32_t maxUs);
+
 /**
  * @brief Main class for input monitoring and control via serial
  *
  * This class encapsulates all functionality needed to send
  * input commands through serial port, following a
  * structured and documented protocol.
+ *
+ * @tparam Filter Pipeline applied to every event before it is encoded;
+ *                use the SerialInputMonitor typedef for no filtering
  */
-class SerialInputMonitor {
+template <typename Filter> class BasicSerialInputMonitor : private Filter {
   private:
     // Mouse button states
     bool m_leftButtonPressed;   ///< Left mouse button state
     bool m_rightButtonPressed;  ///< Right mouse button state
     bool m_middleButtonPressed; ///< Middle mouse button state
 
+    volatile bool  m_sending;       ///< A line is being written (see isSending())
+    IdleHook       m_idleHook;      ///< Sleeps while waiting, nullptr to busy-wait
+    TxQueue       *m_txQueue;       ///< Queue in front of Serial, nullptr for none
+    TextWindow    *m_textWindow;    ///< Window for text lines, nullptr to type key events
+    ProgramBuffer *m_programBuffer; ///< Receives uploaded programs, nullptr for none
+    bool           m_inText;        ///< Sending a text: key events are TxClass::TEXT
+    Framing        m_framing;       ///< Framing of event and sync lines
+
+    // What the host was last sent, to drop events that change nothing
+    bool     m_skipRedundant;    ///< Drop redundant events (see setSkipRedundant())
+    bool     m_positionKnown;    ///< m_positionX/Y is where the host pointer was last put
+    int      m_positionX;        ///< Last absolute position sent
+    int      m_positionY;        ///< Last absolute position sent
+    uint16_t m_positionDrops;    ///< TX queue MOTION drops when it was sent
+    uint8_t  m_keysDown[32];     ///< Keys pressed on the host, one bit per code
+    uint16_t m_redundantSkipped; ///< Events dropped as redundant
+
+    // Clock synchronisation
+    uint16_t      m_syncIntervalMs; ///< Ping interval, 0 when disabled
+    unsigned long m_syncPingMs;     ///< millis() of the last ping
+    uint32_t      m_syncPingUs;     ///< micros() once the last ping was sent (T1)
+    uint32_t      m_syncAnswerUs;   ///< micros() when the current input line started (T4)
+    uint8_t       m_syncSeq;        ///< Sequence number of the last ping
+    bool          m_syncPending;    ///< Last ping not answered yet
+    bool          m_syncStamping;   ///< A ping was answered: stamp events
+    uint8_t       m_syncRxLength;   ///< Bytes in m_syncRx
+    char          m_syncRx[8];      ///< Input line being received
+
+    // Scheduled playback
+    uint16_t m_scheduleLeadMs; ///< How far events are sent ahead, 0 when disabled
+    bool     m_scheduleValid;  ///< m_scheduleUs holds a due time
+    uint32_t m_scheduleUs;     ///< Due time of the next event
+
+    /**
+     * @brief Check if events are sent with due times
+     * @return true when playback is enabled and the clock is synced
+     */
+    inline bool isScheduling() const {
+        return m_scheduleLeadMs > 0 && m_syncStamping;
+    }
+
+    /**
+     * @brief Check if texts go out as text lines
+     * @return true with a window attached, unless something needs the key events
+     */
+    inline bool sendsTextLines() const {
+        return m_textWindow && !m_txQueue && !isScheduling() && IsPassThrough<Filter>::value;
+    }
+
+    /**
+     * @brief Restart the schedule if it fell behind the device clock
+     * @param now Current micros()
+     */
+    void catchUpSchedule(uint32_t now);
+
+    /**
+     * @brief Wait for up to waitUs, sleeping if an idle hook is set
+     * @param waitUs Microseconds left to wait
+     *
+     * Wakes in time for the next clock sync ping.
+     */
+    void idleFor(uint32_t waitUs);
+
+    /**
+     * @brief Check whether a text may send its next character
+     * @return false if the TEXT policy is FAIL and the queue lacks room
+     *         (the cut is counted)
+     */
+    bool textMayContinue();
+
+    /**
+     * @brief Send a clock sync ping
+     */
+    void sendPing();
+
+    /**
+     * @brief Handle a complete input line (answers to pings)
+     */
+    void handleSyncLine();
+
     /**
      * @brief Send a character string as key sequence
      * @param newLine If true, adds ENTER at the end
@@ -241,6 +841,13 @@ class SerialInputMonitor {
      */
     void sendKeySequence(bool newLine, const char *text);
 
+    /**
+     * @brief Stream a pre-encoded key sequence
+     * @param newLine If true, adds ENTER at the end
+     * @param text Events produced by SIM_TEXT()
+     */
+    void sendEncodedSequence(bool newLine, const EncodedText &text);
+
     /**
      * @brief Send formatted command via serial port
      * @param device Device type
@@ -250,12 +857,120 @@ class SerialInputMonitor {
      */
     void sendCommand(Device device, uint8_t event, int param1 = 0, int param2 = 0);
 
+    /**
+     * @brief Check if an event would leave the host as it is, and track it otherwise
+     * @param command Filtered event about to be written
+     * @return true for a zero move or scroll, a repeated absolute
+     *         position, or a press of a key the host has down already
+     */
+    bool isRedundant(const InputEvent &command);
+
+    /**
+     * @brief Mark a key as up on the host in the redundant-event state
+     * @param key Key code
+     */
+    inline void markKeyUp(uint8_t key) {
+        m_keysDown[key >> 3] &= static_cast<uint8_t>(~(1u << (key & 7)));
+    }
+
+    /**
+     * @brief Keep the redundant-event state right after a text line (m_sending set)
+     * @param text Text written
+     * @param newLine Text ended with ENTER
+     *
+     * The host types a text line as a press and release of each key,
+     * none of which went through isRedundant(): every key it used is up.
+     */
+    void releaseTextKeys(const char *text, bool newLine);
+
+    /**
+     * @brief MOTION drops of the TX queue so far
+     * @return 0 without a queue
+     */
+    inline uint16_t motionDrops() const {
+        return m_txQueue ? m_txQueue->stats().dropped[static_cast<uint8_t>(TxClass::MOTION)] : 0;
+    }
+
+    /**
+     * @brief Write one filtered event line
+     * @param command Event to write
+     * @param stampPrefix STAMP_PREFIX or DUE_PREFIX, written only while synced
+     * @param stampUs Device time written after the prefix
+     */
+    void writeCommand(const InputEvent &command, char stampPrefix, uint32_t stampUs);
+
   public:
     /**
      * @brief Class constructor
      * Initialize mouse button states
      */
-    SerialInputMonitor();
+    BasicSerialInputMonitor();
+
+    /**
+     * @brief Access the filter pipeline (e.g. to reset stage state)
+     * @return Pipeline instance owned by this monitor
+     */
+    inline Filter &pipeline() {
+        return *this;
+    }
+
+    /**
+     * @brief Send one event right away
+     * @param event Event to send (filters apply, button states are not tracked)
+     *
+     * Stamped with the current time when synced, never with a due time.
+     * Safe to call from an interrupt while isSending() is false; this is
+     * how TimedDispatcher (SerialInputTimer.h) emits its events.
+     */
+    void sendEvent(const InputEvent &event);
+
+    /**
+     * @brief Check if a line is being written
+     * @return true while the monitor writes to Serial; an interrupt must
+     *         not write then, or the lines would interleave
+     */
+    inline bool isSending() const {
+        return m_sending;
+    }
+
+    /**
+     * @brief Check if an event can be sent without waiting for the link
+     * @param event Event about to be sent
+     * @return true if the TX queue, or else Serial's transmit buffer, has
+     *         room for its line; non-blocking senders such as PathPlayer
+     *         hold their events back until then
+     */
+    bool canSend(const InputEvent &event);
+
+    /**
+     * @brief Drop events that would not change anything on the host
+     * @param enabled true (default) to skip zero moves and scrolls,
+     *                absolute positions equal to the last one sent and
+     *                presses of keys already down; false to send them
+     *                all, e.g. for hosts that repeat a key on each press
+     *
+     * Releases are always sent. The state is taken after the filter
+     * pipeline, from what actually went to the host.
+     */
+    inline void setSkipRedundant(bool enabled) {
+        m_skipRedundant = enabled;
+    }
+
+    /**
+     * @brief Number of events dropped as redundant
+     * @return Events not sent since the start (saturates at 65535)
+     */
+    inline uint16_t redundantSkipped() const {
+        return m_redundantSkipped;
+    }
+
+    /**
+     * @brief Forget what the host was sent
+     *
+     * For a host that restarted without resetting the board: the next
+     * position and key presses are sent even if they look redundant.
+     */
+    void forgetHostState();
 
     // ==================== MOUSE CONTROLS ====================
 
@@ -402,6 +1117,44 @@ class SerialInputMonitor {
      */
     void typeText(const char *text);
 
+    /**
+     * @brief Type a compile-time encoded text with line break
+     * @param text Events produced by SIM_TEXT()
+     */
+    void typeTextLine(const EncodedText &text);
+
+    /**
+     * @brief Type a compile-time encoded text without line break
+     * @param text Events produced by SIM_TEXT()
+     *
+     * No character lookup happens at runtime, and Shift is pressed once
+     * per run of shifted characters instead of once per character.
+     */
+    void typeText(const EncodedText &text);
+
+    // ==================== EVENT PROGRAMS ====================
+
+    /**
+     * @brief Play a compiled event program
+     * @param program Program from flash or a ProgramBuffer
+     * @return false if the program is malformed (events up to there are sent)
+     *
+     * Waits go through delay(), so they keep the schedule of scheduled
+     * playback and keep clock sync going.
+     */
+    bool play(const EventProgram &program);
+
+    /**
+     * @brief Accept programs uploaded over serial
+     * @param buffer Buffer to receive into, nullptr to ignore uploads (default)
+     *
+     * poll() reads the input while a buffer is attached, with or
+     * without clock sync.
+     */
+    inline void attachProgramBuffer(ProgramBuffer *buffer) {
+        m_programBuffer = buffer;
+    }
+
     // ==================== KEY COMBINATIONS ====================
 
     /**
@@ -451,20 +1204,262 @@ class SerialInputMonitor {
      * @param character ASCII character
      * @return Corresponding virtual key code
      */
-    static VirtualKey charToVirtualKey(char character);
+    static SIM_CONSTEXPR14 VirtualKey charToVirtualKey(char character);
 
     /**
      * @brief Check if a character requires Shift to be typed
      * @param character Character to check
      * @return true if requires Shift, false otherwise
      */
-    static bool requiresShift(char character);
+    static SIM_CONSTEXPR14 bool requiresShift(char character);
 
     /**
      * @brief Add delay between commands (useful to avoid timing issues)
      * @param milliseconds Time in milliseconds
+     *
+     * The CPU sleeps through the wait (see setIdleHook()). With clock
+     * sync enabled, poll() runs on every wake-up.
      */
     void delay(unsigned long milliseconds);
+
+    /**
+     * @brief Choose how delay() spends its waits
+     * @param hook Sleep function, serialInputIdle() by default; nullptr
+     *             busy-waits with yield() as before
+     *
+     * Sketches replace it to sleep deeper (e.g. with their own wake-up
+     * sources) or to count sleeping time.
+     */
+    inline void setIdleHook(IdleHook hook) {
+        m_idleHook = hook;
+    }
+
+    /**
+     * @brief Send through a bounded queue with drop policies
+     * @param queue Queue to use (see TxQueue), nullptr to write straight
+     *              to Serial and block when it is full (default)
+     */
+    inline void attachTxQueue(TxQueue *queue) {
+        m_txQueue = queue;
+    }
+
+    /**
+     * @brief Talk to the host over another stream than Serial
+     * @param link Stream to read the host from and write lines to,
+     *             begun by the sketch
+     *
+     * Library-wide: other monitors, TX queues and text windows use it
+     * too. With SERIAL_TX_DMA attached, it must be SERIAL_TX_DMA_LINK.
+     */
+    inline void attachLink(Stream &link) {
+        serialInputLink = &link;
+    }
+
+    /**
+     * @brief Get the stream the library talks to the host over
+     * @return Serial, or the stream given to attachLink()
+     */
+    inline Stream &link() const {
+        return *serialInputLink;
+    }
+
+#if SIM_HAS_DMA_TX
+    /**
+     * @brief Send every library line through DMA-drained buffers
+     * @param tx Double buffer (see DmaTx), nullptr to write to the link
+     *           (default)
+     *
+     * Library-wide, like the link: other monitors, TX queues and text
+     * windows write through it too. Lines the sketch prints itself
+     * still go straight to the link; call tx->flush() first where their
+     * order matters. poll() starts buffers filled during a transfer.
+     */
+    inline void attachDmaTx(DmaTx *tx) {
+        serialInputDmaTx = tx;
+    }
+#endif
+
+    /**
+     * @brief Protect lines against bit errors on the link
+     * @param framing PLAIN (default), CRC to let the host drop damaged
+     *                lines, FEC to also correct one flipped bit per byte
+     *
+     * Hosts decode every framing without being told; once they have
+     * seen a framed event they drop plain ones, which is what a damaged
+     * CRC token would leave behind.
+     */
+    inline void setFraming(Framing framing) {
+        m_framing = framing;
+    }
+
+    /**
+     * @brief Get the framing of event lines
+     * @return Framing set with setFraming()
+     */
+    inline Framing framing() const {
+        return m_framing;
+    }
+
+    /**
+     * @brief Send typeText() and typeTextLine() as compressed text lines
+     * @param window Window to use (see TextWindow), nullptr to send key
+     *               events (default)
+     *
+     * The host types the characters as fast as it injects events: the
+     * per-key delays of typeText() are not kept. Texts are still sent
+     * as key events while a TX queue is attached, while scheduling
+     * playback, from filtered monitors and for SIM_TEXT() texts.
+     */
+    inline void attachTextWindow(TextWindow *window) {
+        m_textWindow = window;
+    }
+
+    // ==================== CLOCK SYNC ====================
+
+    /**
+     * @brief Exchange timestamped pings with the host
+     * @param intervalMs Ping interval in ms, 0 to disable
+     *
+     * Once the host has answered a ping, every event carries its
+     * micros() so the host can map it to its own clock. Pings are sent
+     * and answers read from poll(), which delay() calls; sketches that
+     * do not use delay() should call poll() from loop().
+     */
+    void enableClockSync(uint16_t intervalMs = 1000);
+
+    /**
+     * @brief Drain the TX queue and DMA buffers, send events filter stages held back, send a due ping and read
+     *        answers and uploads from the host
+     */
+    void poll();
+
+    /**
+     * @brief Check if events are being timestamped
+     * @return true once the host has answered a ping
+     */
+    inline bool isClockSynced() const {
+        return m_syncStamping;
+    }
+
+    /**
+     * @brief Send events ahead of time with the time they are due
+     * @param leadMs How far ahead of its due time an event may be sent, 0 to disable
+     *
+     * Needs enableClockSync(). Once synced, delay() no longer waits for
+     * the time to pass but moves the due time of the following events,
+     * and only blocks when the sketch runs more than leadMs ahead. The
+     * host holds every event until its due time, so the spacing set with
+     * delay() survives UART buffering and host scheduling. Until the
+     * first ping is answered, delay() waits as usual.
+     */
+    void enableScheduledPlayback(uint16_t leadMs = 100);
 };
 
+/**
+ * @brief Monitor without filtering, the default for sketches
+ */
+typedef BasicSerialInputMonitor<Pipeline<> > SerialInputMonitor;
+
+extern template class BasicSerialInputMonitor<Pipeline<> >;
+
+// ==================== INLINE UTILITIES ====================
+
+template <typename Filter>
+inline SIM_CONSTEXPR14 VirtualKey BasicSerialInputMonitor<Filter>::charToVirtualKey(char character) {
+    return characterKey(character);
+}
+
+template <typename Filter>
+inline SIM_CONSTEXPR14 bool BasicSerialInputMonitor<Filter>::requiresShift(char character) {
+    return characterNeedsShift(character);
+}
+
+// ==================== COMPILE-TIME TEXT ====================
+
+/**
+ * @brief Helpers behind SIM_TEXT()
+ */
+namespace SimText {
+
+const uint8_t PRESS = 0x01; ///< Event is a key press (release otherwise)
+const uint8_t HOLD  = 0x02; ///< Wait the key hold time after this event
+
+/**
+ * @brief Flash storage for N encoded events
+ */
+template <size_t N> struct Storage {
+    uint8_t events[N ? N * 2 : 1]; ///< Key/flags byte pairs
+};
+
+#if SIM_HAS_CONSTEXPR_TEXT
+/**
+ * @brief Count the key events needed to type a text
+ * @param text Null-terminated text
+ * @return Number of events, including coalesced Shift presses/releases
+ */
+constexpr size_t eventCount(const char *text) {
+    size_t count   = 0;
+    bool   shifted = false;
+    for (; *text; ++text) {
+        bool shift = SerialInputMonitor::requiresShift(*text);
+        if (shift != shifted) {
+            ++count;
+            shifted = shift;
+        }
+        count += 2;
+    }
+    return shifted ? count + 1 : count;
+}
+
+/**
+ * @brief Encode a text into N key events
+ * @param text Null-terminated text, N must equal eventCount(text)
+ * @return Encoded events, Shift held across runs of shifted characters
+ */
+template <size_t N> constexpr Storage<N> encode(const char *text) {
+    Storage<N> out{};
+    size_t     i       = 0;
+    bool       shifted = false;
+    for (; *text; ++text) {
+        bool    shift = SerialInputMonitor::requiresShift(*text);
+        uint8_t key   = static_cast<uint8_t>(SerialInputMonitor::charToVirtualKey(*text));
+        if (shift != shifted) {
+            out.events[i++] = static_cast<uint8_t>(VirtualKey::LEFT_SHIFT);
+            out.events[i++] = shift ? PRESS : 0;
+            shifted         = shift;
+        }
+        out.events[i++] = key;
+        out.events[i++] = PRESS | HOLD;
+        out.events[i++] = key;
+        out.events[i++] = 0;
+    }
+    if (shifted) {
+        out.events[i++] = static_cast<uint8_t>(VirtualKey::LEFT_SHIFT);
+        out.events[i++] = 0;
+    }
+    return out;
+}
+#endif
+
+} // namespace SimText
+
+#if SIM_HAS_CONSTEXPR_TEXT
+/**
+ * @brief Encode a string literal into key events at compile time
+ *
+ * Usage: monitor.typeText(SIM_TEXT("admin"));
+ *
+ * The events are stored in PROGMEM; requires C++14 or later
+ * (e.g. -std=gnu++17 on AVR).
+ */
+#define SIM_TEXT(literal)                                                                                              \
+    ([]() -> EncodedText {                                                                                             \
+        static constexpr SimText::Storage<SimText::eventCount(literal)> storage PROGMEM =                             \
+            SimText::encode<SimText::eventCount(literal)>(literal);                                                    \
+        return EncodedText{storage.events, static_cast<uint16_t>(SimText::eventCount(literal))};                       \
+    }())
+#endif
+
+#include "SerialInputMonitor.tpp"
+
 #endif // SERIAL_INPUT_MONITOR_H
@@ -0,0 +1,714 @@
+/**
+ * @file SerialInputMonitor.tpp
+ * @brief Template implementation of input monitoring and control library via serial
+ * @version 1.0.0
+ * @date 2025-09-05
+ * 
+ * Included at the end of SerialInputMonitor.h; the default (unfiltered)
+ * instantiation is compiled once in SerialInputMonitor.cpp.
+ * 
+ * @author Leonardo Klein
+ */
+
+template <typename Filter>
+BasicSerialInputMonitor<Filter>::BasicSerialInputMonitor() 
+    : m_leftButtonPressed(false)
+    , m_rightButtonPressed(false)
+    , m_middleButtonPressed(false)
+    , m_sending(false)
+    , m_idleHook(serialInputIdle)
+    , m_txQueue(nullptr)
+    , m_textWindow(nullptr)
+    , m_programBuffer(nullptr)
+    , m_inText(false)
+    , m_framing(Framing::PLAIN)
+    , m_skipRedundant(true)
+    , m_positionKnown(false)
+    , m_positionX(0)
+    , m_positionY(0)
+    , m_positionDrops(0)
+    , m_keysDown()
+    , m_redundantSkipped(0)
+    , m_syncIntervalMs(0)
+    , m_syncPingMs(0)
+    , m_syncPingUs(0)
+    , m_syncAnswerUs(0)
+    , m_syncSeq(0)
+    , m_syncPending(false)
+    , m_syncStamping(false)
+    , m_syncRxLength(0)
+    , m_scheduleLeadMs(0)
+    , m_scheduleValid(false)
+    , m_scheduleUs(0) {
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::sendCommand(Device device, uint8_t event, int param1, int param2) {
+    m_sending = true;
+
+    uint32_t stampUs     = m_syncStamping ? static_cast<uint32_t>(micros()) : 0;
+    char     stampPrefix = STAMP_PREFIX;
+    if (isScheduling()) {
+        catchUpSchedule(stampUs);
+        stampUs     = m_scheduleUs;
+        stampPrefix = DUE_PREFIX;
+    }
+
+    InputEvent command = {device, event, param1, param2};
+    if (Filter::apply(command)) {
+        writeCommand(command, stampPrefix, stampUs);
+    }
+
+    m_sending = false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::sendEvent(const InputEvent& event) {
+    m_sending = true;
+
+    uint32_t   stampUs = m_syncStamping ? static_cast<uint32_t>(micros()) : 0;
+    InputEvent command = event;
+    if (Filter::apply(command)) {
+        writeCommand(command, STAMP_PREFIX, stampUs);
+    }
+
+    m_sending = false;
+}
+
+template <typename Filter>
+bool BasicSerialInputMonitor<Filter>::isRedundant(const InputEvent& command) {
+    if (command.device == Device::KEYBOARD) {
+        if (command.param1 < 0 || command.param1 > 0xFF) {
+            return false;
+        }
+        uint8_t &keys    = m_keysDown[command.param1 >> 3];
+        uint8_t  bit     = static_cast<uint8_t>(1u << (command.param1 & 7));
+        bool     wasDown = keys & bit;
+        if (command.event == static_cast<uint8_t>(KeyboardEvent::PRESS)) {
+            keys |= bit;
+            return wasDown;
+        }
+        keys &= static_cast<uint8_t>(~bit);
+        return false;
+    }
+
+    switch (static_cast<MouseEvent>(command.event)) {
+        case MouseEvent::MOVE:
+            if (command.param1 == 0 && command.param2 == 0) {
+                return true;
+            }
+            m_positionKnown = false;
+            return false;
+        case MouseEvent::SCROLL:
+            return command.param1 == 0;
+        case MouseEvent::POSITION:
+            // Unless the TX queue dropped motion since, which may have been that position
+            if (m_positionKnown && command.param1 == m_positionX && command.param2 == m_positionY &&
+                motionDrops() == m_positionDrops) {
+                return true;
+            }
+            m_positionKnown = true;
+            m_positionX     = command.param1;
+            m_positionY     = command.param2;
+            m_positionDrops = motionDrops();
+            return false;
+        default:
+            return false;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::releaseTextKeys(const char* text, bool newLine) {
+    // Shift goes around shifted characters, ENTER ends the line
+    for (; *text; text++) {
+        markKeyUp(static_cast<uint8_t>(characterKey(*text)));
+        if (characterNeedsShift(*text)) {
+            markKeyUp(static_cast<uint8_t>(VirtualKey::LEFT_SHIFT));
+        }
+    }
+    if (newLine) {
+        markKeyUp(static_cast<uint8_t>(VirtualKey::ENTER));
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::forgetHostState() {
+    // Held off like a line in progress: an interrupt sending an event
+    // meanwhile (TimedDispatcher) retries instead of reading it half-cleared
+    m_sending       = true;
+    m_positionKnown = false;
+    memset(m_keysDown, 0, sizeof(m_keysDown));
+    m_sending = false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::writeCommand(const InputEvent& command, char stampPrefix, uint32_t stampUs) {
+    // The state is tracked even while sending everything, so it is right when skipping is turned on
+    if (isRedundant(command) && m_skipRedundant) {
+        if (m_redundantSkipped < 0xFFFF) {
+            m_redundantSkipped++;
+        }
+        return;
+    }
+
+    char prefix = m_syncStamping ? stampPrefix : 0;
+    if (m_txQueue) {
+        TxClass txClass = m_inText && command.device == Device::KEYBOARD ? TxClass::TEXT : txClassOf(command);
+        m_txQueue->submit(command, txClass, prefix, stampUs, m_framing);
+        return;
+    }
+
+    char    line[EVENT_LINE_MAX];
+    uint8_t length = formatEventLine(line, command, prefix, stampUs, m_framing);
+    writeSerial(line, length);
+}
+
+template <typename Filter>
+bool BasicSerialInputMonitor<Filter>::canSend(const InputEvent& event) {
+    if (m_txQueue) {
+        return m_txQueue->hasRoom(1);
+    }
+
+    // With the longest time token the line may get
+    char line[EVENT_LINE_MAX];
+    return fitsSerial(formatEventLine(line, event, m_syncStamping ? STAMP_PREFIX : 0, 0xFFFFFFFFUL, m_framing));
+}
+
+template <typename Filter>
+bool BasicSerialInputMonitor<Filter>::textMayContinue() {
+    // A character takes up to four events (Shift press, key press and
+    // release, Shift release); refuse it as a whole, never half of it
+    if (!m_txQueue || m_txQueue->policy(TxClass::TEXT) != TxPolicy::FAIL || m_txQueue->hasRoom(4)) {
+        return true;
+    }
+    m_txQueue->countDrop(TxClass::TEXT);
+    return false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::sendKeySequence(bool newLine, const char* text) {
+    if (!text) return;
+
+    if (sendsTextLines()) {
+        // The keys are marked up before m_sending clears, so a timer
+        // interrupt never checks a key against half-updated state
+        m_sending = true;
+        m_textWindow->write(text, newLine, m_framing);
+        releaseTextKeys(text, newLine);
+        m_sending = false;
+        return;
+    }
+    
+    size_t length = strlen(text);
+    
+    m_inText = true;
+    for (size_t i = 0; i < length; i++) {
+        if (!textMayContinue()) {
+            m_inText = false;
+            return;
+        }
+        typeCharacter(text[i]);
+        delay(10);
+    }
+    
+    if (newLine && textMayContinue()) {
+        tapKey(VirtualKey::ENTER);
+    }
+    m_inText = false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::sendEncodedSequence(bool newLine, const EncodedText& text) {
+    m_inText     = true;
+    uint8_t held = 0; // Keys pressed by the text and not released yet
+    for (uint16_t i = 0; i < text.count; i++) {
+        uint8_t key   = pgm_read_byte(text.events + 2 * i);
+        uint8_t flags = pgm_read_byte(text.events + 2 * i + 1);
+
+        if ((flags & SimText::PRESS) && held == 0 && !textMayContinue()) {
+            m_inText = false;
+            return;
+        }
+        if (flags & SimText::PRESS) {
+            held++;
+        } else if (held > 0) {
+            held--;
+        }
+
+        KeyboardEvent event = (flags & SimText::PRESS) ? KeyboardEvent::PRESS : KeyboardEvent::RELEASE;
+        sendCommand(Device::KEYBOARD, static_cast<uint8_t>(event), key);
+        delay((flags & SimText::HOLD) ? 50 : 10);
+    }
+
+    if (newLine && textMayContinue()) {
+        tapKey(VirtualKey::ENTER);
+    }
+    m_inText = false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::setMousePosition(int x, int y) {
+    sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::POSITION), x, y);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::moveMouseRelative(int deltaX, int deltaY) {
+    sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::MOVE), deltaX, deltaY);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::pressRightButton() {
+    if (!m_rightButtonPressed) {
+        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::RIGHT_PRESS));
+        m_rightButtonPressed = true;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::releaseRightButton() {
+    if (m_rightButtonPressed) {
+        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::RIGHT_RELEASE));
+        m_rightButtonPressed = false;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::pressLeftButton() {
+    if (!m_leftButtonPressed) {
+        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::LEFT_PRESS));
+        m_leftButtonPressed = true;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::releaseLeftButton() {
+    if (m_leftButtonPressed) {
+        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::LEFT_RELEASE));
+        m_leftButtonPressed = false;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::pressMiddleButton() {
+    if (!m_middleButtonPressed) {
+        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::MIDDLE_PRESS));
+        m_middleButtonPressed = true;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::releaseMiddleButton() {
+    if (m_middleButtonPressed) {
+        sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::MIDDLE_RELEASE));
+        m_middleButtonPressed = false;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::clickLeft() {
+    pressLeftButton();
+    delay(50);
+    releaseLeftButton();
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::clickRight() {
+    pressRightButton();
+    delay(50);
+    releaseRightButton();
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::doubleClickLeft() {
+    clickLeft();
+    delay(100);
+    clickLeft();
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::scrollMouse(int scrollAmount) {
+    sendCommand(Device::MOUSE, static_cast<uint8_t>(MouseEvent::SCROLL), scrollAmount);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::pressKey(VirtualKey key) {
+    sendCommand(Device::KEYBOARD, static_cast<uint8_t>(KeyboardEvent::PRESS), 
+                static_cast<uint16_t>(key));
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::releaseKey(VirtualKey key) {
+    sendCommand(Device::KEYBOARD, static_cast<uint8_t>(KeyboardEvent::RELEASE), 
+                static_cast<uint16_t>(key));
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::tapKey(VirtualKey key) {
+    pressKey(key);
+    delay(50);
+    releaseKey(key);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::pressKey(char character) {
+    VirtualKey key = charToVirtualKey(character);
+    
+    if (requiresShift(character)) {
+        pressKey(VirtualKey::LEFT_SHIFT);
+        delay(10);
+        pressKey(key);
+    } else {
+        pressKey(key);
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::releaseKey(char character) {
+    VirtualKey key = charToVirtualKey(character);
+    
+    if (requiresShift(character)) {
+        releaseKey(key);
+        delay(10);
+        releaseKey(VirtualKey::LEFT_SHIFT);
+    } else {
+        releaseKey(key);
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::typeCharacter(char character) {
+    pressKey(character);
+    delay(50);
+    releaseKey(character);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::typeTextLine(const char* text) {
+    sendKeySequence(true, text);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::typeText(const char* text) {
+    sendKeySequence(false, text);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::typeTextLine(const EncodedText& text) {
+    sendEncodedSequence(true, text);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::typeText(const EncodedText& text) {
+    sendEncodedSequence(false, text);
+}
+
+template <typename Filter>
+bool BasicSerialInputMonitor<Filter>::play(const EventProgram& program) {
+    uint16_t offset = 0;
+    auto     next   = [&](uint8_t &byte) {
+        if (offset >= program.length) {
+            return false;
+        }
+        byte = program.inFlash ? pgm_read_byte(program.steps + offset) : program.steps[offset];
+        offset++;
+        return true;
+    };
+
+    ProgramStep step;
+    while (readProgramStep(next, step)) {
+        if (step.waitMs > 0) {
+            delay(step.waitMs);
+        }
+
+        switch (step.op) {
+            case ProgramOp::END: return true;
+            case ProgramOp::KEY_PRESS: pressKey(static_cast<VirtualKey>(step.code)); break;
+            case ProgramOp::KEY_RELEASE: releaseKey(static_cast<VirtualKey>(step.code)); break;
+            case ProgramOp::MOUSE_BUTTON:
+                // Through the button methods, so isLeftButtonPressed() and friends stay right
+                switch (static_cast<MouseEvent>(step.code)) {
+                    case MouseEvent::RIGHT_PRESS: pressRightButton(); break;
+                    case MouseEvent::RIGHT_RELEASE: releaseRightButton(); break;
+                    case MouseEvent::LEFT_PRESS: pressLeftButton(); break;
+                    case MouseEvent::LEFT_RELEASE: releaseLeftButton(); break;
+                    case MouseEvent::MIDDLE_PRESS: pressMiddleButton(); break;
+                    case MouseEvent::MIDDLE_RELEASE: releaseMiddleButton(); break;
+                    default: return false;
+                }
+                break;
+            case ProgramOp::MOUSE_POSITION: setMousePosition(step.x, step.y); break;
+            case ProgramOp::MOUSE_MOVE: moveMouseRelative(step.x, step.y); break;
+            case ProgramOp::MOUSE_SCROLL: scrollMouse(step.x); break;
+        }
+    }
+    return false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::copy() {
+    pressKey(VirtualKey::LEFT_CONTROL);
+    delay(10);
+    tapKey(VirtualKey::C);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_CONTROL);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::paste() {
+    pressKey(VirtualKey::LEFT_CONTROL);
+    delay(10);
+    tapKey(VirtualKey::V);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_CONTROL);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::cut() {
+    pressKey(VirtualKey::LEFT_CONTROL);
+    delay(10);
+    tapKey(VirtualKey::X);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_CONTROL);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::undo() {
+    pressKey(VirtualKey::LEFT_CONTROL);
+    delay(10);
+    tapKey(VirtualKey::Z);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_CONTROL);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::redo() {
+    pressKey(VirtualKey::LEFT_CONTROL);
+    delay(10);
+    tapKey(VirtualKey::Y);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_CONTROL);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::selectAll() {
+    pressKey(VirtualKey::LEFT_CONTROL);
+    delay(10);
+    tapKey(VirtualKey::A);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_CONTROL);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::altTab() {
+    pressKey(VirtualKey::LEFT_ALT);
+    delay(10);
+    tapKey(VirtualKey::TAB);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_ALT);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::altF4() {
+    pressKey(VirtualKey::LEFT_ALT);
+    delay(10);
+    tapKey(VirtualKey::F4);
+    delay(10);
+    releaseKey(VirtualKey::LEFT_ALT);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::delay(unsigned long milliseconds) {
+    if (isScheduling()) {
+        // Move the schedule; wait only while more than the lead ahead of it
+        catchUpSchedule(static_cast<uint32_t>(micros()));
+        m_scheduleUs += static_cast<uint32_t>(milliseconds * 1000UL);
+
+        uint32_t leadUs = static_cast<uint32_t>(m_scheduleLeadMs) * 1000UL;
+        for (;;) {
+            poll();
+            int32_t aheadUs = static_cast<int32_t>(m_scheduleUs - static_cast<uint32_t>(micros()));
+            if (aheadUs <= static_cast<int32_t>(leadUs)) {
+                return;
+            }
+            idleFor(static_cast<uint32_t>(aheadUs) - leadUs);
+        }
+    }
+
+    // Keep reading while waiting, so answers are timestamped promptly.
+    // micros() wraps after 71 minutes, so long delays wait in parts.
+    do {
+        unsigned long partMs = milliseconds < 1000000UL ? milliseconds : 1000000UL;
+        milliseconds -= partMs;
+
+        uint32_t start  = static_cast<uint32_t>(micros());
+        uint32_t waitUs = static_cast<uint32_t>(partMs * 1000UL);
+        for (;;) {
+            poll();
+            uint32_t elapsedUs = static_cast<uint32_t>(micros()) - start;
+            if (elapsedUs >= waitUs) {
+                break;
+            }
+            idleFor(waitUs - elapsedUs);
+        }
+    } while (milliseconds > 0);
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::idleFor(uint32_t waitUs) {
+    if (m_idleHook == nullptr) {
+        yield();
+        return;
+    }
+
+    if (m_syncIntervalMs > 0) {
+        unsigned long sincePingMs = millis() - m_syncPingMs;
+        uint32_t      untilPingUs =
+            sincePingMs < m_syncIntervalMs ? static_cast<uint32_t>(m_syncIntervalMs - sincePingMs) * 1000UL : 0;
+        waitUs = untilPingUs < waitUs ? untilPingUs : waitUs;
+    }
+    if (waitUs > 0) {
+        m_idleHook(waitUs);
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::enableClockSync(uint16_t intervalMs) {
+    m_syncIntervalMs = intervalMs;
+    m_syncPingMs     = millis() - intervalMs;
+    m_syncPending    = false;
+    m_syncStamping   = false;
+    m_syncRxLength   = 0;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::enableScheduledPlayback(uint16_t leadMs) {
+    m_scheduleLeadMs = leadMs;
+    m_scheduleValid  = false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::catchUpSchedule(uint32_t now) {
+    // Events due in the past would run late: start over one lead ahead
+    if (!m_scheduleValid || static_cast<int32_t>(m_scheduleUs - now) < 0) {
+        m_scheduleUs    = now + static_cast<uint32_t>(m_scheduleLeadMs) * 1000UL;
+        m_scheduleValid = true;
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::poll() {
+    if (m_txQueue && !m_sending) {
+        m_sending = true;
+        m_txQueue->pump();
+        m_sending = false;
+    }
+#if SIM_HAS_DMA_TX
+    if (serialInputDmaTx && !m_sending) {
+        m_sending = true;
+        serialInputDmaTx->service();
+        m_sending = false;
+    }
+#endif
+    // Stages that hold events back: none in a pass-through pipeline
+    if (!IsPassThrough<Filter>::value && !m_sending) {
+        m_sending        = true;
+        uint32_t stampUs = m_syncStamping ? static_cast<uint32_t>(micros()) : 0;
+        Filter::release([this, stampUs](const InputEvent &event) { writeCommand(event, STAMP_PREFIX, stampUs); });
+        m_sending = false;
+    }
+    if (m_syncIntervalMs == 0 && !m_programBuffer) {
+        return;
+    }
+
+    while (serialInputLink->available() > 0) {
+        char c = static_cast<char>(serialInputLink->read());
+        if (m_programBuffer && m_programBuffer->receive(c)) {
+            continue;
+        }
+        if (c == '\r' || c == '\n') {
+            if (m_syncRxLength > 0) {
+                handleSyncLine();
+            }
+            m_syncRxLength = 0;
+            continue;
+        }
+        if (m_syncRxLength == 0) {
+            m_syncAnswerUs = static_cast<uint32_t>(micros());
+        }
+        if (m_syncRxLength < sizeof(m_syncRx)) {
+            m_syncRx[m_syncRxLength] = c;
+        }
+        if (m_syncRxLength <= sizeof(m_syncRx)) {
+            m_syncRxLength++; // sizeof + 1 marks an overlong line
+        }
+    }
+
+    if (m_syncIntervalMs > 0 && millis() - m_syncPingMs >= m_syncIntervalMs) {
+        sendPing();
+    }
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::sendPing() {
+    // Behind a queue, ping only with nothing in flight: the line neither
+    // waits behind events nor stalls on a held link
+    if (m_txQueue && (m_txQueue->pending() > 0 || !serialTxEmpty())) {
+        return;
+    }
+
+    m_sending = true;
+    m_syncSeq++;
+    uint32_t seq = m_syncSeq;
+    char     line[SYNC_LINE_MAX];
+    writeSerial(line, formatSyncLine(line, SyncMessage::PING, &seq, 1, m_framing));
+    m_syncPingMs = millis();
+
+    // T1 is taken once the line has left, like T4 when the answer arrives
+    if (m_txQueue) {
+        uint32_t startUs = static_cast<uint32_t>(micros());
+        while (!serialTxEmpty()) {
+            if (static_cast<uint32_t>(micros()) - startUs > SYNC_PING_WAIT_US) {
+                m_syncPending = false; // The link stalled: drop this sample
+                m_sending     = false;
+                return;
+            }
+        }
+    } else {
+        flushSerial();
+    }
+    m_syncPingUs  = static_cast<uint32_t>(micros());
+    m_syncPending = true;
+    m_sending     = false;
+}
+
+template <typename Filter>
+void BasicSerialInputMonitor<Filter>::handleSyncLine() {
+    if (m_syncRxLength < 4 || m_syncRxLength > sizeof(m_syncRx) || m_syncRx[0] != SYNC_PREFIX ||
+        m_syncRx[1] != static_cast<char>(SyncMessage::ANSWER) || m_syncRx[2] != ' ') {
+        return;
+    }
+
+    uint8_t seq = 0;
+    for (uint8_t i = 3; i < m_syncRxLength; i++) {
+        char c = m_syncRx[i];
+        if (c >= '0' && c <= '9') {
+            seq = static_cast<uint8_t>(seq * 16 + (c - '0'));
+        } else if (c >= 'A' && c <= 'F') {
+            seq = static_cast<uint8_t>(seq * 16 + (c - 'A' + 10));
+        } else {
+            return;
+        }
+    }
+    if (!m_syncPending || seq != m_syncSeq) {
+        return;
+    }
+
+    m_sending = true;
+    uint32_t values[3] = {m_syncSeq, m_syncPingUs, m_syncAnswerUs};
+    char     line[SYNC_LINE_MAX];
+    writeSerial(line, formatSyncLine(line, SyncMessage::REPORT, values, 3, m_framing));
+    m_sending = false;
+
+    m_syncPending  = false;
+    m_syncStamping = true;
+}
@@ -0,0 +1,281 @@
+/**
+ * @file SerialInputPath.h
+ * @brief Non-blocking playback of precomputed mouse paths
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Signatures, circles and drag-and-drop gestures are computed on the
+ * host (serial-input-path converts SVG polylines) and stored in PROGMEM
+ * as one pair of int8 deltas per tick, with button edges and pauses in
+ * between (see PATH_ESCAPE in SerialInputProtocol.h). A 1,000-point
+ * signature takes 2 KB of flash and no floating point.
+ *
+ * PathPlayer never blocks: call update() from loop(). It adds up the
+ * ticks that are due and sends them as one relative move once the link
+ * has room for the line (BasicSerialInputMonitor::canSend()). A fast
+ * link gets one move per tick; a slow or busy one gets fewer, larger
+ * moves along the same path, so the path keeps its timing and ends
+ * exactly where it should. Button edges wait for the moves before them.
+ *
+ * As in SerialInputKeymap.h, all timing methods take an explicit `now`
+ * so the player can be driven by a virtual clock; the overloads without
+ * it use millis().
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_PATH_H
+#define SERIAL_INPUT_PATH_H
+
+#include "SerialInputMonitor.h"
+
+/**
+ * @brief A mouse path, as generated by serial-input-path
+ */
+struct MousePath {
+    const int8_t *points;  ///< Byte pairs, see PATH_ESCAPE
+    uint16_t      length;  ///< Bytes in points
+    uint8_t       tickMs;  ///< Time per tick, 0 to play as fast as the link allows
+    int16_t       startX;  ///< Absolute start position, -1 to start where the pointer is
+    int16_t       startY;  ///< Absolute start position (with startX)
+    bool          inFlash; ///< points is in PROGMEM
+};
+
+/**
+ * @brief What a PathPlayer sent for its current path
+ */
+struct PathStats {
+    uint16_t ticks; ///< Ticks of movement played
+    uint16_t moves; ///< Move events sent
+    uint16_t held;  ///< Updates that held events back for the link (saturates)
+};
+
+/**
+ * @brief Plays MousePaths through a monitor without blocking
+ * @tparam Monitor Monitor type (any BasicSerialInputMonitor)
+ */
+template <typename Monitor> class PathPlayer {
+  private:
+    static const int PENDING_MAX = 32767 - PATH_DELTA_MAX; ///< Largest held-back move per axis
+
+    Monitor      &m_monitor;    ///< Output monitor
+    MousePath     m_path;       ///< Path being played
+    uint16_t      m_offset;     ///< Next pair in m_path.points
+    unsigned long m_startMs;    ///< Time of tick 0
+    uint32_t      m_tick;       ///< Ticks consumed
+    int           m_pendingX;   ///< Movement due but not sent yet
+    int           m_pendingY;   ///< Movement due but not sent yet
+    uint8_t       m_buttons;    ///< Buttons pressed by the path, bit MouseEvent / 2
+    bool          m_positioned; ///< Absolute start sent (or not needed)
+    bool          m_playing;    ///< A path is being played
+    PathStats     m_stats;      ///< Counters of the current path
+
+    /**
+     * @brief Count an update that waits for the link
+     * @return true, still playing
+     */
+    bool hold() {
+        if (m_stats.held < 0xFFFF) {
+            m_stats.held++;
+        }
+        return true;
+    }
+
+    int8_t read(uint16_t offset) const {
+        return static_cast<int8_t>(m_path.inFlash ? pgm_read_byte(m_path.points + offset) : m_path.points[offset]);
+    }
+
+    /**
+     * @brief Send the held-back movement
+     * @return false if the link has no room for it yet
+     */
+    bool flush() {
+        if (m_pendingX == 0 && m_pendingY == 0) {
+            return true;
+        }
+        InputEvent move = {Device::MOUSE, static_cast<uint8_t>(MouseEvent::MOVE), m_pendingX, m_pendingY};
+        if (!m_monitor.canSend(move)) {
+            return false;
+        }
+        m_monitor.moveMouseRelative(m_pendingX, m_pendingY);
+        m_pendingX = 0;
+        m_pendingY = 0;
+        m_stats.moves++;
+        return true;
+    }
+
+    /**
+     * @brief Send a button edge
+     * @return false if the link has no room for it yet
+     */
+    bool button(uint8_t event) {
+        InputEvent edge = {Device::MOUSE, event, 0, 0};
+        if (event > static_cast<uint8_t>(MouseEvent::MIDDLE_RELEASE)) {
+            return true;
+        }
+        if (!m_monitor.canSend(edge)) {
+            return false;
+        }
+
+        // Through the button methods, so isLeftButtonPressed() and friends stay right
+        switch (static_cast<MouseEvent>(event)) {
+            case MouseEvent::RIGHT_PRESS: m_monitor.pressRightButton(); break;
+            case MouseEvent::RIGHT_RELEASE: m_monitor.releaseRightButton(); break;
+            case MouseEvent::LEFT_PRESS: m_monitor.pressLeftButton(); break;
+            case MouseEvent::LEFT_RELEASE: m_monitor.releaseLeftButton(); break;
+            case MouseEvent::MIDDLE_PRESS: m_monitor.pressMiddleButton(); break;
+            case MouseEvent::MIDDLE_RELEASE: m_monitor.releaseMiddleButton(); break;
+            default: break;
+        }
+        uint8_t bit = static_cast<uint8_t>(1u << (event / 2));
+        m_buttons   = (event & 1) ? (m_buttons & ~bit) : (m_buttons | bit);
+        return true;
+    }
+
+  public:
+    /**
+     * @brief Create a player
+     * @param monitor Monitor receiving the mouse events
+     */
+    explicit PathPlayer(Monitor &monitor)
+        : m_monitor(monitor)
+        , m_path()
+        , m_offset(0)
+        , m_startMs(0)
+        , m_tick(0)
+        , m_pendingX(0)
+        , m_pendingY(0)
+        , m_buttons(0)
+        , m_positioned(true)
+        , m_playing(false)
+        , m_stats() {
+    }
+
+    /**
+     * @brief Start playing a path, replacing the current one
+     * @param path Path to play (copied; its points must stay valid)
+     * @param now Time of the first tick in ms: now, or later to start after a while
+     */
+    void start(const MousePath &path, unsigned long now) {
+        stop();
+        m_path       = path;
+        m_offset     = 0;
+        m_startMs    = now;
+        m_tick       = 0;
+        m_positioned = path.startX < 0;
+        m_playing    = true;
+        m_stats      = PathStats();
+    }
+
+    /**
+     * @brief Start playing a path at millis()
+     * @param path Path to play
+     */
+    void start(const MousePath &path) {
+        start(path, millis());
+    }
+
+    /**
+     * @brief Send what is due; call from loop()
+     * @param now Current time in ms
+     * @return true while the path is playing
+     */
+    bool update(unsigned long now) {
+        if (!m_playing) {
+            return false;
+        }
+        long elapsed = static_cast<long>(now - m_startMs);
+        if (elapsed < 0) {
+            return true;
+        }
+
+        if (!m_positioned) {
+            InputEvent position = {Device::MOUSE, static_cast<uint8_t>(MouseEvent::POSITION), m_path.startX,
+                                   m_path.startY};
+            if (!m_monitor.canSend(position)) {
+                return hold();
+            }
+            m_monitor.setMousePosition(m_path.startX, m_path.startY);
+            m_positioned = true;
+        }
+
+        uint32_t due = m_path.tickMs > 0 ? static_cast<uint32_t>(elapsed) / m_path.tickMs : UINT32_MAX;
+        while (m_offset + 1 < m_path.length) {
+            int8_t first  = read(m_offset);
+            int8_t second = read(m_offset + 1);
+
+            if (first != PATH_ESCAPE) {
+                if (m_tick >= due || abs(m_pendingX) > PENDING_MAX || abs(m_pendingY) > PENDING_MAX) {
+                    break;
+                }
+                m_pendingX += first;
+                m_pendingY += second;
+                m_tick++;
+                m_stats.ticks++;
+            } else if (static_cast<uint8_t>(second) & PATH_PAUSE) {
+                if (m_tick >= due) {
+                    break;
+                }
+                m_tick += (static_cast<uint8_t>(second) & ~PATH_PAUSE) + 1u;
+            } else if (static_cast<uint8_t>(second) & PATH_BUTTON) {
+                if (!flush() || !button(static_cast<uint8_t>(second) & ~PATH_BUTTON)) {
+                    return hold();
+                }
+            } else {
+                break; // PATH_END
+            }
+            m_offset += 2;
+        }
+
+        if (!flush()) {
+            return hold();
+        }
+        if (m_offset + 1 >= m_path.length || (read(m_offset) == PATH_ESCAPE && read(m_offset + 1) == PATH_END)) {
+            m_playing = false;
+        }
+        return m_playing;
+    }
+
+    /**
+     * @brief Send what is due at millis()
+     * @return true while the path is playing
+     */
+    bool update() {
+        return update(millis());
+    }
+
+    /**
+     * @brief Stop playing; releases the buttons the path holds and drops unsent movement
+     */
+    void stop() {
+        for (uint8_t event = static_cast<uint8_t>(MouseEvent::RIGHT_RELEASE);
+             event <= static_cast<uint8_t>(MouseEvent::MIDDLE_RELEASE); event += 2) {
+            if (m_buttons & (1u << (event / 2))) {
+                while (!button(event)) {
+                    // The release must not be lost; it waits for the link
+                }
+            }
+        }
+        m_pendingX = 0;
+        m_pendingY = 0;
+        m_playing  = false;
+    }
+
+    /**
+     * @brief Check if a path is playing
+     * @return true from start() until the path has been sent
+     */
+    inline bool playing() const {
+        return m_playing;
+    }
+
+    /**
+     * @brief Get the counters of the current (or last) path
+     * @return Ticks, moves and held-back updates
+     */
+    inline const PathStats &stats() const {
+        return m_stats;
+    }
+};
+
+#endif // SERIAL_INPUT_PATH_H
@@ -0,0 +1,418 @@
+/**
+ * @file SerialInputPipeline.h
+ * @brief Dual-core event pipeline: scanning on one core, encoding on the other
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * On dual-core boards the front end (scanning, debouncing, motion
+ * planning) posts events from one core, and the back end encodes and
+ * writes them through the monitor from the other:
+ *
+ *   SerialInputMonitor                           monitor;
+ *   EventPipeline<SerialInputMonitor, 64>        pipeline(monitor);
+ *
+ *   front end:  pipeline.postMove(dx, dy);  pipeline.postKey(key, true);
+ *   back end:   pipeline.pump();  monitor.poll();
+ *
+ * Between them sits EventQueue, a lock-free single-producer,
+ * single-consumer ring of 6-byte EventRecords. Neither side ever waits
+ * for the other. A full queue makes the front end fold mouse motion
+ * into one held-back move or position (as the TX queue's MERGE does)
+ * and refuse other events, which it may post again later. pump()
+ * writes only the events the link has room for (see canSend()), so the
+ * back end never blocks on the UART either.
+ *
+ * The platform glue stays in the sketch (see example_dual_core.ino):
+ *
+ *   RP2040 (Philhower core)  loop() is the front end, loop1() the back end
+ *   ESP32                    a task pinned to core 0 is the front end,
+ *                            loop() on core 1 the back end
+ *   native build (host/sim)  a std::thread is the front end
+ *
+ * Only the back end may use the monitor and Serial. Not for AVR boards:
+ * they have one core, and TimedDispatcher (SerialInputTimer.h) covers
+ * interrupt-driven sending there.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_PIPELINE_H
+#define SERIAL_INPUT_PIPELINE_H
+
+#ifdef __AVR__
+#error "SerialInputPipeline.h needs two cores and <atomic>: RP2040, ESP32 or the native build"
+#endif
+
+#include <atomic>
+
+#include "SerialInputMonitor.h"
+
+#ifndef SIM_PIPELINE_ALIGN
+#if defined(ARDUINO_ARCH_RP2040) || defined(ESP32)
+#define SIM_PIPELINE_ALIGN 4 // No data cache to share lines of
+#else
+#define SIM_PIPELINE_ALIGN 64 // Cache line: the two cores' indexes stay apart
+#endif
+#endif
+
+/**
+ * @brief Event as queued between the cores
+ */
+struct EventRecord {
+    uint8_t device; ///< Device
+    uint8_t event;  ///< MouseEvent or KeyboardEvent code
+    int16_t param1; ///< First parameter
+    int16_t param2; ///< Second parameter
+};
+
+/**
+ * @brief Clamp a parameter to what a record holds
+ * @param value Parameter
+ * @return value, limited to -32767..32767
+ */
+inline int16_t clamp16(int32_t value) {
+    return static_cast<int16_t>(value > 32767 ? 32767 : value < -32767 ? -32767 : value);
+}
+
+/**
+ * @brief Check if a parameter fits in a record unchanged
+ */
+inline bool fits16(int32_t value) {
+    return value >= -32767 && value <= 32767;
+}
+
+/**
+ * @brief Convert an event to a record
+ * @param event Event to convert
+ * @return Record, parameters clamped with clamp16()
+ */
+inline EventRecord toRecord(const InputEvent &event) {
+    EventRecord record = {static_cast<uint8_t>(event.device), event.event, clamp16(event.param1),
+                          clamp16(event.param2)};
+    return record;
+}
+
+/**
+ * @brief Convert a record back to an event
+ * @param record Record
+ * @return Event
+ */
+inline InputEvent toEvent(const EventRecord &record) {
+    InputEvent event = {static_cast<Device>(record.device), record.event, record.param1, record.param2};
+    return event;
+}
+
+/**
+ * @brief Lock-free ring for one producer and one consumer
+ * @tparam Capacity Records at most, a power of two
+ *
+ * Each side owns one index and keeps a copy of the other side's, which
+ * it reloads only when the ring looks full (or empty): most push() and
+ * pop() calls touch no memory the other core writes.
+ */
+template <uint16_t Capacity> class EventQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "EventQueue capacity must be a power of two");
+
+  private:
+    static const uint16_t MASK = Capacity - 1;
+
+    alignas(SIM_PIPELINE_ALIGN) std::atomic<uint16_t> m_head; ///< Next record to write, producer's
+    uint16_t                                          m_tailCopy; ///< Last m_tail seen by the producer
+    alignas(SIM_PIPELINE_ALIGN) std::atomic<uint16_t> m_tail; ///< Next record to read, consumer's
+    uint16_t                                          m_headCopy; ///< Last m_head seen by the consumer
+    alignas(SIM_PIPELINE_ALIGN) EventRecord m_records[Capacity]; ///< Storage
+
+  public:
+    EventQueue() : m_head(0), m_tailCopy(0), m_tail(0), m_headCopy(0) {
+    }
+
+    /**
+     * @brief Add a record; producer only
+     * @param record Record to add
+     * @return false if the ring is full
+     */
+    bool push(const EventRecord &record) {
+        uint16_t head = m_head.load(std::memory_order_relaxed);
+        if (static_cast<uint16_t>(head - m_tailCopy) == Capacity) {
+            m_tailCopy = m_tail.load(std::memory_order_acquire);
+            if (static_cast<uint16_t>(head - m_tailCopy) == Capacity) {
+                return false;
+            }
+        }
+        m_records[head & MASK] = record;
+        m_head.store(static_cast<uint16_t>(head + 1), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Read the oldest record without removing it; consumer only
+     * @param record Receives the record
+     * @return false if the ring is empty
+     */
+    bool peek(EventRecord &record) {
+        uint16_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_headCopy) {
+            m_headCopy = m_head.load(std::memory_order_acquire);
+            if (tail == m_headCopy) {
+                return false;
+            }
+        }
+        record = m_records[tail & MASK];
+        return true;
+    }
+
+    /**
+     * @brief Remove the record peek() returned; consumer only
+     */
+    void drop() {
+        m_tail.store(static_cast<uint16_t>(m_tail.load(std::memory_order_relaxed) + 1), std::memory_order_release);
+    }
+
+    /**
+     * @brief Remove the oldest record; consumer only
+     * @param record Receives the record
+     * @return false if the ring is empty
+     */
+    bool pop(EventRecord &record) {
+        if (!peek(record)) {
+            return false;
+        }
+        drop();
+        return true;
+    }
+
+    /**
+     * @brief Number of queued records, from either side
+     * @return A value that was right at some point during the call
+     */
+    uint16_t size() const {
+        uint16_t tail = m_tail.load(std::memory_order_acquire);
+        return static_cast<uint16_t>(m_head.load(std::memory_order_acquire) - tail);
+    }
+};
+
+/**
+ * @brief Front end and back end of a dual-core monitor
+ * @tparam Monitor Monitor type (any BasicSerialInputMonitor)
+ * @tparam Capacity Records queued at most, a power of two
+ */
+template <typename Monitor, uint16_t Capacity = 64> class EventPipeline {
+  private:
+    /**
+     * @brief Motion the front end could not queue yet
+     */
+    enum class Held : uint8_t {
+        NONE,     ///< Nothing held
+        MOVE,     ///< Relative move of m_heldX/Y
+        POSITION, ///< Absolute position m_heldX/Y
+    };
+
+    Monitor              &m_monitor; ///< Back end output
+    EventQueue<Capacity>  m_queue;   ///< Records between the cores
+
+    // Written by the front end only
+    Held                  m_held;    ///< Motion held back
+    int32_t               m_heldX;   ///< Held move or position
+    int32_t               m_heldY;   ///< Held move or position
+    std::atomic<uint16_t> m_merged;  ///< Motion events folded into held motion
+    std::atomic<uint16_t> m_refused; ///< Other events refused on a full queue
+
+    // Written by the back end only
+    alignas(SIM_PIPELINE_ALIGN) uint32_t m_sent; ///< Events written through the monitor
+
+    /**
+     * @brief Add one to a front end counter, saturating; the back end may read it meanwhile
+     */
+    static void bump(std::atomic<uint16_t> &counter) {
+        uint16_t value = counter.load(std::memory_order_relaxed);
+        if (value < 0xFFFF) {
+            counter.store(static_cast<uint16_t>(value + 1), std::memory_order_relaxed);
+        }
+    }
+
+  public:
+    /**
+     * @brief Create a pipeline
+     * @param monitor Monitor the back end writes through
+     */
+    explicit EventPipeline(Monitor &monitor)
+        : m_monitor(monitor), m_held(Held::NONE), m_heldX(0), m_heldY(0), m_merged(0), m_refused(0), m_sent(0) {
+    }
+
+    // ==================== FRONT END ====================
+
+    /**
+     * @brief Queue the held-back motion; front end only
+     * @return true if nothing is held back any more
+     *
+     * post() calls this first; call it when the front end is idle so
+     * the last motion is not kept waiting for the next event.
+     */
+    bool flush() {
+        while (m_held != Held::NONE) {
+            MouseEvent  kind   = m_held == Held::MOVE ? MouseEvent::MOVE : MouseEvent::POSITION;
+            int16_t     x      = clamp16(m_heldX);
+            int16_t     y      = clamp16(m_heldY);
+            EventRecord record = {static_cast<uint8_t>(Device::MOUSE), static_cast<uint8_t>(kind), x, y};
+            if (!m_queue.push(record)) {
+                return false;
+            }
+            // A move too long for one record goes out in parts
+            if (m_held == Held::MOVE && (m_heldX != x || m_heldY != y)) {
+                m_heldX -= x;
+                m_heldY -= y;
+            } else {
+                m_held = Held::NONE;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Queue an event for the back end; front end only
+     * @param event Event to send
+     * @return true if queued or folded into held-back motion, false if
+     *         refused because the queue is full (post it again later)
+     *
+     * Records hold 16-bit parameters: positions and scrolls are clamped
+     * to -32767..32767, and longer moves go out in parts, as flush()
+     * sends them.
+     */
+    bool post(const InputEvent &event) {
+        bool flushed = flush();
+        bool motion  = event.device == Device::MOUSE && (event.event == static_cast<uint8_t>(MouseEvent::MOVE) ||
+                                                        event.event == static_cast<uint8_t>(MouseEvent::POSITION));
+        bool split   = motion && event.event == static_cast<uint8_t>(MouseEvent::MOVE) &&
+                     !(fits16(event.param1) && fits16(event.param2));
+        if (flushed && !split && m_queue.push(toRecord(event))) {
+            return true;
+        }
+        if (!motion) {
+            bump(m_refused);
+            return false;
+        }
+
+        // A position replaces whatever motion was held; a move adds to it
+        if (event.event == static_cast<uint8_t>(MouseEvent::POSITION)) {
+            m_held  = Held::POSITION;
+            m_heldX = event.param1;
+            m_heldY = event.param2;
+        } else if (m_held == Held::NONE) {
+            m_held  = Held::MOVE;
+            m_heldX = event.param1;
+            m_heldY = event.param2;
+        } else {
+            m_heldX += event.param1;
+            m_heldY += event.param2;
+        }
+        if (flushed && split) {
+            // Nothing was held: the parts go out now, as far as the queue has room
+            flush();
+            return true;
+        }
+        bump(m_merged);
+        return true;
+    }
+
+    /**
+     * @brief Queue a key press or release; see post()
+     */
+    bool postKey(VirtualKey key, bool pressed) {
+        InputEvent event = {Device::KEYBOARD,
+                            static_cast<uint8_t>(pressed ? KeyboardEvent::PRESS : KeyboardEvent::RELEASE),
+                            static_cast<int>(key), 0};
+        return post(event);
+    }
+
+    /**
+     * @brief Queue a mouse button press or release; see post()
+     */
+    bool postButton(MouseEvent edge) {
+        InputEvent event = {Device::MOUSE, static_cast<uint8_t>(edge), 0, 0};
+        return post(event);
+    }
+
+    /**
+     * @brief Queue a relative move; see post()
+     */
+    bool postMove(int deltaX, int deltaY) {
+        InputEvent event = {Device::MOUSE, static_cast<uint8_t>(MouseEvent::MOVE), deltaX, deltaY};
+        return post(event);
+    }
+
+    /**
+     * @brief Queue an absolute position; see post()
+     */
+    bool postPosition(int x, int y) {
+        InputEvent event = {Device::MOUSE, static_cast<uint8_t>(MouseEvent::POSITION), x, y};
+        return post(event);
+    }
+
+    /**
+     * @brief Queue a wheel scroll; see post()
+     */
+    bool postScroll(int amount) {
+        InputEvent event = {Device::MOUSE, static_cast<uint8_t>(MouseEvent::SCROLL), amount, 0};
+        return post(event);
+    }
+
+    /**
+     * @brief Motion events folded into held-back motion, from either side
+     * @return Count since the start (saturates at 65535)
+     */
+    inline uint16_t merged() const {
+        return m_merged.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Events refused on a full queue, from either side
+     * @return Count since the start (saturates at 65535)
+     */
+    inline uint16_t refused() const {
+        return m_refused.load(std::memory_order_relaxed);
+    }
+
+    // ==================== BACK END ====================
+
+    /**
+     * @brief Write queued events the link has room for; back end only
+     * @param max Events to write at most
+     * @return Events written
+     *
+     * Events go through monitor.sendEvent(): filters and redundant
+     * event elimination apply, button states are not tracked.
+     */
+    uint16_t pump(uint16_t max = Capacity) {
+        uint16_t    count = 0;
+        EventRecord record;
+        while (count < max && m_queue.peek(record)) {
+            InputEvent event = toEvent(record);
+            if (!m_monitor.canSend(event)) {
+                break;
+            }
+            m_monitor.sendEvent(event);
+            m_queue.drop();
+            count++;
+        }
+        m_sent += count;
+        return count;
+    }
+
+    /**
+     * @brief Events written by pump(); back end only
+     * @return Count since the start
+     */
+    inline uint32_t sent() const {
+        return m_sent;
+    }
+
+    /**
+     * @brief Records waiting between the cores, from either side
+     * @return Queue size
+     */
+    inline uint16_t pending() const {
+        return m_queue.size();
+    }
+};
+
+#endif // SERIAL_INPUT_PIPELINE_H
@@ -0,0 +1,619 @@
+/**
+ * @file SerialInputProtocol.h
+ * @brief Wire protocol definitions shared by the library and host tools
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Plain C++ with no Arduino dependency, so host-side decoders and
+ * tools can include it directly.
+ *
+ * Frame format (one ASCII line per event):
+ * DEVICE EVENT [PARAM1] [PARAM2]
+ *
+ * Mouse parameters are signed decimal; keyboard key codes are
+ * hexadecimal virtual key codes (an optional 0x prefix is accepted).
+ *
+ * Clock synchronisation (optional, all numbers hexadecimal):
+ * ~P SEQ          device ping
+ * ~A SEQ          host answer, written as soon as the ping arrives
+ * ~R SEQ T1 T4    device report: micros() once the ping was sent (T1)
+ *                 and when the answer started to arrive (T4)
+ *
+ * Once a ping has been answered, events end with the micros() of their
+ * generation: DEVICE EVENT [PARAM1] [PARAM2] @TIME. Hosts that never
+ * answer never see the extra token. In scheduled playback the token is
+ * the micros() at which the host should execute the event instead:
+ * DEVICE EVENT [PARAM1] [PARAM2] !TIME.
+ *
+ * Framing (optional, for noisy links; see Framing):
+ * LINE %CCCC      CRC: any event or sync line followed by the CRC-16 of
+ *                 LINE as four hex digits
+ * $BYTES          FEC: '$', then LINE and its CRC-16 (high byte first)
+ *                 with every nibble as one extended Hamming(8,4)
+ *                 codeword, then '\n' alone
+ *
+ * Text lines (optional, see TextWindow):
+ * >POS PAYLOAD    characters the host types as key events; POS is the
+ *                 window position of the first one (1-4 hex digits),
+ *                 PAYLOAD literals and back-references into the text
+ *                 sent before
+ *
+ * Event programs (optional, see ProgramStep) are uploaded by the host:
+ * &HEX            bytes to append to the program being received
+ * &               end of the program
+ *
+ * Mouse paths (see PATH_ESCAPE) never go on the wire: the device plays
+ * them as relative moves.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_PROTOCOL_H
+#define SERIAL_INPUT_PROTOCOL_H
+
+#include <stdint.h>
+
+/**
+ * @brief constexpr for functions with loops/switches (C++14 and later)
+ *
+ * The AVR core still builds with -std=gnu++11, where these helpers
+ * stay ordinary inline functions.
+ */
+#if __cplusplus >= 201402L
+#define SIM_CONSTEXPR14 constexpr
+#else
+#define SIM_CONSTEXPR14
+#endif
+
+/**
+ * @brief Supported device types
+ */
+enum class Device : uint8_t {
+    MOUSE    = 0, ///< Mouse device
+    KEYBOARD = 1  ///< Keyboard device
+};
+
+/**
+ * @brief Mouse events
+ */
+enum class MouseEvent : uint8_t {
+    RIGHT_PRESS    = 0, ///< Press right button
+    RIGHT_RELEASE  = 1, ///< Release right button
+    LEFT_PRESS     = 2, ///< Press left button
+    LEFT_RELEASE   = 3, ///< Release left button
+    MIDDLE_PRESS   = 4, ///< Press middle button
+    MIDDLE_RELEASE = 5, ///< Release middle button
+    SCROLL         = 6, ///< Scroll wheel
+    POSITION       = 7, ///< Set absolute position
+    MOVE           = 8  ///< Move relatively
+};
+
+/**
+ * @brief Keyboard events
+ */
+enum class KeyboardEvent : uint8_t {
+    PRESS   = 1, ///< Press key
+    RELEASE = 0  ///< Release key
+};
+
+const char SYNC_PREFIX  = '~'; ///< First character of clock sync lines
+const char STAMP_PREFIX = '@'; ///< First character of an event timestamp token
+const char DUE_PREFIX   = '!'; ///< First character of an event due time token
+
+/**
+ * @brief Clock sync message types (second character of a sync line)
+ */
+enum class SyncMessage : char {
+    PING   = 'P', ///< Device -> host: ~P SEQ
+    ANSWER = 'A', ///< Host -> device: ~A SEQ
+    REPORT = 'R'  ///< Device -> host: ~R SEQ T1 T4
+};
+
+// ==================== FRAMING ====================
+
+/**
+ * @brief How the device frames its event lines
+ *
+ * Bit errors turn a plain line into a different valid one. CRC lets the
+ * host drop damaged lines; FEC also repairs one flipped bit per byte on
+ * the wire, at twice the length. Comments stay plain; sync lines carry
+ * the CRC token in both modes.
+ */
+enum class Framing : uint8_t {
+    PLAIN = 0, ///< DEVICE EVENT [PARAM1] [PARAM2] [@TIME] (default)
+    CRC   = 1, ///< Plain line, then " %CCCC"
+    FEC   = 2  ///< '$', Hamming-coded line and CRC, '\n'
+};
+
+const char     CRC_PREFIX = '%';    ///< First character of the CRC token
+const char     FEC_PREFIX = '$';    ///< First byte of a FEC frame
+const uint16_t CRC_INIT   = 0xFFFF; ///< Initial CRC-16 value
+
+/**
+ * @brief Add one byte to a CRC-16/CCITT-FALSE (polynomial 0x1021)
+ * @param crc CRC so far, CRC_INIT for none
+ * @param byte Next byte
+ * @return Updated CRC
+ */
+inline uint16_t crc16Update(uint16_t crc, uint8_t byte) {
+    crc ^= static_cast<uint16_t>(byte) << 8;
+    for (uint8_t bit = 0; bit < 8; bit++) {
+        crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+/**
+ * @brief Extended Hamming(8,4) codeword of a nibble
+ * @param nibble Value 0-15
+ * @return Nibble in the high half, parity in the low half
+ *
+ * Parity bit i is the XOR of the data bits other than bit i, so any two
+ * codewords differ in at least 4 bits. '\n' is 2 bits away from every
+ * codeword: one flipped bit never ends a frame early.
+ */
+inline uint8_t fecEncodeNibble(uint8_t nibble) {
+    nibble &= 0x0F;
+    uint8_t odd = static_cast<uint8_t>((nibble ^ (nibble >> 1) ^ (nibble >> 2) ^ (nibble >> 3)) & 1);
+    return static_cast<uint8_t>(nibble << 4 | (odd ? nibble ^ 0x0F : nibble));
+}
+
+/**
+ * @brief Decode a codeword, correcting one flipped bit
+ * @param code Received byte
+ * @param flips Receives the number of corrected bits (0 or 1)
+ * @return Nibble, or -1 if 2 or more bits are wrong
+ */
+inline int fecDecodeByte(uint8_t code, uint8_t &flips) {
+    for (uint8_t nibble = 0; nibble < 16; nibble++) {
+        uint8_t diff = static_cast<uint8_t>(code ^ fecEncodeNibble(nibble));
+        if ((diff & (diff - 1)) == 0) {
+            flips = diff != 0 ? 1 : 0;
+            return nibble;
+        }
+    }
+    return -1;
+}
+
+// ==================== TEXT LINES ====================
+
+/*
+ * Payload bytes of a text line:
+ *   0x20-0x7E except '%'   the character itself
+ *   0x7F X                 the character X ^ 0x40 (control characters, '%')
+ *   1LLLLLDD 1DDDDDDD      copy L + TEXT_MATCH_MIN characters starting
+ *                          D + 1 characters back; copies may overlap
+ *                          the characters they produce
+ *
+ * No payload byte is '\n' or '\r', and without a raw '%' no text line
+ * ends in something that looks like a CRC token.
+ */
+
+const char     TEXT_PREFIX       = '>';  ///< First character of text lines
+const uint8_t  TEXT_ESCAPE       = 0x7F; ///< Payload byte before an escaped character
+const uint8_t  TEXT_MATCH_MIN    = 3;    ///< Shortest back-reference
+const uint8_t  TEXT_MATCH_MAX    = 34;   ///< Longest back-reference
+const uint16_t TEXT_DISTANCE_MAX = 512;  ///< Farthest back-reference, and the host window size
+const uint8_t  TEXT_PAYLOAD_MAX  = 32;   ///< Payload bytes per line the library sends at most
+
+/**
+ * @brief Check if a character goes into a text payload as itself
+ * @param character Character of the text
+ * @return false if it needs TEXT_ESCAPE
+ */
+inline bool textIsLiteral(uint8_t character) {
+    return character >= 0x20 && character < TEXT_ESCAPE && character != static_cast<uint8_t>(CRC_PREFIX);
+}
+
+// ==================== EVENT PROGRAMS ====================
+
+/*
+ * An event program is a string of steps, each an event and the wait
+ * before it, ending with ProgramOp::END:
+ *   OOOWWWWW [WAIT] [ARGS]
+ * OOO is the ProgramOp, WWWWW the wait in ms; 31 means the wait follows
+ * as a varint. Arguments: a key code byte (KEY_PRESS, KEY_RELEASE), a
+ * MouseEvent byte (MOUSE_BUTTON), two varints (MOUSE_POSITION) or two
+ * (MOUSE_MOVE) or one (MOUSE_SCROLL) zigzag varint. Varints hold 7 bits
+ * per byte, low bits first, with the high bit set on all but the last.
+ */
+
+/**
+ * @brief Operation of a program step
+ */
+enum class ProgramOp : uint8_t {
+    END            = 0, ///< Wait, then stop
+    KEY_PRESS      = 1, ///< Press a key
+    KEY_RELEASE    = 2, ///< Release a key
+    MOUSE_BUTTON   = 3, ///< Press or release a mouse button
+    MOUSE_POSITION = 4, ///< Set the absolute position
+    MOUSE_MOVE     = 5, ///< Move relatively
+    MOUSE_SCROLL   = 6  ///< Scroll wheel
+};
+
+const char    PROGRAM_PREFIX    = '&'; ///< First character of program upload lines
+const uint8_t PROGRAM_WAIT_LONG = 31;  ///< Wait field value: the wait follows as a varint
+const uint8_t PROGRAM_STEP_MAX  = 16;  ///< Longest encoded step
+
+/**
+ * @brief One step of an event program
+ */
+struct ProgramStep {
+    uint32_t  waitMs; ///< Wait before the event
+    ProgramOp op;     ///< Operation
+    uint8_t   code;   ///< Key code or MouseEvent (KEY_*, MOUSE_BUTTON)
+    int32_t   x;      ///< X, dx or scroll amount (MOUSE_POSITION, MOUSE_MOVE, MOUSE_SCROLL)
+    int32_t   y;      ///< Y or dy (MOUSE_POSITION, MOUSE_MOVE)
+};
+
+/**
+ * @brief Encode a program step
+ * @param out Buffer of PROGRAM_STEP_MAX bytes
+ * @param step Step to encode
+ * @return Bytes written
+ */
+inline uint8_t encodeProgramStep(uint8_t *out, const ProgramStep &step) {
+    uint8_t length = 0;
+    auto    varint = [&](uint32_t value) {
+        while (value >= 0x80) {
+            out[length++] = static_cast<uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        out[length++] = static_cast<uint8_t>(value);
+    };
+    auto zigzag = [&](int32_t value) {
+        varint(static_cast<uint32_t>(value) << 1 ^ static_cast<uint32_t>(value >> 31));
+    };
+
+    uint8_t op    = static_cast<uint8_t>(static_cast<uint8_t>(step.op) << 5);
+    out[length++] = static_cast<uint8_t>(op | (step.waitMs < PROGRAM_WAIT_LONG ? step.waitMs : PROGRAM_WAIT_LONG));
+    if (step.waitMs >= PROGRAM_WAIT_LONG) {
+        varint(step.waitMs);
+    }
+
+    switch (step.op) {
+        case ProgramOp::KEY_PRESS:
+        case ProgramOp::KEY_RELEASE:
+        case ProgramOp::MOUSE_BUTTON: out[length++] = step.code; break;
+        case ProgramOp::MOUSE_POSITION:
+            varint(static_cast<uint32_t>(step.x));
+            varint(static_cast<uint32_t>(step.y));
+            break;
+        case ProgramOp::MOUSE_MOVE:
+            zigzag(step.x);
+            zigzag(step.y);
+            break;
+        case ProgramOp::MOUSE_SCROLL: zigzag(step.x); break;
+        case ProgramOp::END: break;
+    }
+    return length;
+}
+
+/**
+ * @brief Decode the next program step
+ * @param next Called as bool next(uint8_t &byte), false past the end
+ * @param step Receives the step
+ * @return false if the program ends before the step does or the step is malformed
+ */
+template <typename Next> bool readProgramStep(Next &&next, ProgramStep &step) {
+    bool ok     = true;
+    auto varint = [&]() -> uint32_t {
+        uint32_t value = 0;
+        uint8_t  byte  = 0x80;
+        for (uint8_t shift = 0; ok && (byte & 0x80); shift += 7) {
+            ok = shift < 32 && next(byte);
+            value |= static_cast<uint32_t>(byte & 0x7F) << (shift < 32 ? shift : 0);
+        }
+        return value;
+    };
+    auto zigzag = [&]() -> int32_t {
+        uint32_t value = varint();
+        return static_cast<int32_t>(value >> 1 ^ (0U - (value & 1)));
+    };
+
+    uint8_t head;
+    if (!next(head) || (head >> 5) > static_cast<uint8_t>(ProgramOp::MOUSE_SCROLL)) {
+        return false;
+    }
+    step.op     = static_cast<ProgramOp>(head >> 5);
+    step.waitMs = head & PROGRAM_WAIT_LONG;
+    step.code   = 0;
+    step.x      = 0;
+    step.y      = 0;
+    if (step.waitMs == PROGRAM_WAIT_LONG) {
+        step.waitMs = varint();
+    }
+
+    switch (step.op) {
+        case ProgramOp::KEY_PRESS:
+        case ProgramOp::KEY_RELEASE:
+        case ProgramOp::MOUSE_BUTTON: ok = ok && next(step.code); break;
+        case ProgramOp::MOUSE_POSITION:
+            step.x = static_cast<int32_t>(varint());
+            step.y = static_cast<int32_t>(varint());
+            break;
+        case ProgramOp::MOUSE_MOVE:
+            step.x = zigzag();
+            step.y = zigzag();
+            break;
+        case ProgramOp::MOUSE_SCROLL: step.x = zigzag(); break;
+        case ProgramOp::END: break;
+    }
+    return ok;
+}
+
+// ==================== MOUSE PATHS ====================
+
+/*
+ * A mouse path is a string of signed byte pairs, one per tick:
+ *   DX DY        move by (DX, DY), each -127 to 127; 0 0 stays put
+ *   -128 OP      PATH_END, PATH_BUTTON | MouseEvent (a button edge,
+ *                taking no tick) or PATH_PAUSE | N (N + 1 ticks still)
+ * Paths are played relative to where they start; see PathPlayer.
+ */
+
+const int8_t  PATH_ESCAPE    = -128; ///< First byte of a control pair
+const uint8_t PATH_END       = 0x00; ///< End of the path
+const uint8_t PATH_BUTTON    = 0x40; ///< Button edge, ORed with a MouseEvent press or release
+const uint8_t PATH_PAUSE     = 0x80; ///< Pause, ORed with the ticks minus one (0-127)
+const int8_t  PATH_DELTA_MAX = 127;  ///< Largest move per axis and tick
+
+/**
+ * @brief Key codes based on Windows Virtual Key Codes standard
+ *
+ * This enumeration contains standardized hexadecimal codes for keys,
+ * compatible with Windows system and widely used in embedded systems.
+ */
+enum class VirtualKey : uint16_t {
+    // Basic control keys
+    BACKSPACE = 0x08, ///< BACKSPACE key
+    TAB       = 0x09, ///< TAB key
+    CLEAR     = 0x0C, ///< CLEAR key
+    ENTER     = 0x0D, ///< ENTER key
+
+    // Modifier keys
+    SHIFT     = 0x10, ///< SHIFT key (generic)
+    CONTROL   = 0x11, ///< CTRL key (generic)
+    ALT       = 0x12, ///< ALT key (generic)
+    PAUSE     = 0x13, ///< PAUSE key
+    CAPS_LOCK = 0x14, ///< CAPS LOCK key
+
+    // IME keys
+    KANA    = 0x15, ///< Kana IME mode
+    HANGEUL = 0x15, ///< Hangeul IME mode (alias)
+    HANGUL  = 0x15, ///< Hangul IME mode (alias)
+    IME_ON  = 0x16, ///< IME enabled
+    JUNJA   = 0x17, ///< Junja IME mode
+    FINAL   = 0x18, ///< Final IME mode
+    HANJA   = 0x19, ///< Hanja IME mode
+    KANJI   = 0x19, ///< Kanji IME mode (alias)
+    IME_OFF = 0x1A, ///< IME disabled
+
+    // Navigation keys
+    ESCAPE     = 0x1B, ///< ESC key
+    CONVERT    = 0x1C, ///< IME conversion
+    NONCONVERT = 0x1D, ///< IME non-conversion
+    ACCEPT     = 0x1E, ///< IME accept
+    MODECHANGE = 0x1F, ///< IME mode change
+
+    // Special keys
+    SPACE     = 0x20, ///< Space bar
+    PAGE_UP   = 0x21, ///< PAGE UP key
+    PAGE_DOWN = 0x22, ///< PAGE DOWN key
+    END       = 0x23, ///< END key
+    HOME      = 0x24, ///< HOME key
+
+    // Arrow keys
+    ARROW_LEFT  = 0x25, ///< Left arrow
+    ARROW_UP    = 0x26, ///< Up arrow
+    ARROW_RIGHT = 0x27, ///< Right arrow
+    ARROW_DOWN  = 0x28, ///< Down arrow
+
+    // Special function keys
+    SELECT       = 0x29, ///< SELECT key
+    PRINT        = 0x2A, ///< PRINT key
+    EXECUTE      = 0x2B, ///< EXECUTE key
+    PRINT_SCREEN = 0x2C, ///< PRINT SCREEN key
+    INSERT       = 0x2D, ///< INSERT key
+    DELETE       = 0x2E, ///< DELETE key
+    HELP         = 0x2F, ///< HELP key
+
+    // Numbers (0-9)
+    NUM_0 = 0x30, NUM_1 = 0x31, NUM_2 = 0x32, NUM_3 = 0x33, NUM_4 = 0x34,
+    NUM_5 = 0x35, NUM_6 = 0x36, NUM_7 = 0x37, NUM_8 = 0x38, NUM_9 = 0x39,
+
+    // Letters (A-Z)
+    A = 0x41, B = 0x42, C = 0x43, D = 0x44, E = 0x45, F = 0x46,
+    G = 0x47, H = 0x48, I = 0x49, J = 0x4A, K = 0x4B, L = 0x4C,
+    M = 0x4D, N = 0x4E, O = 0x4F, P = 0x50, Q = 0x51, R = 0x52,
+    S = 0x53, T = 0x54, U = 0x55, V = 0x56, W = 0x57, X = 0x58,
+    Y = 0x59, Z = 0x5A,
+
+    // Windows keys
+    LEFT_WIN  = 0x5B, ///< Left Windows key
+    RIGHT_WIN = 0x5C, ///< Right Windows key
+    APPS      = 0x5D, ///< Applications key
+
+    // Special key
+    SLEEP = 0x5F, ///< Computer sleep key
+
+    // Numeric keypad
+    NUMPAD_0 = 0x60, NUMPAD_1 = 0x61, NUMPAD_2 = 0x62, NUMPAD_3 = 0x63, NUMPAD_4 = 0x64,
+    NUMPAD_5 = 0x65, NUMPAD_6 = 0x66, NUMPAD_7 = 0x67, NUMPAD_8 = 0x68, NUMPAD_9 = 0x69,
+
+    MULTIPLY  = 0x6A, ///< * (multiply)
+    ADD       = 0x6B, ///< + (add)
+    SEPARATOR = 0x6C, ///< Separator
+    SUBTRACT  = 0x6D, ///< - (subtract)
+    DECIMAL   = 0x6E, ///< . (decimal)
+    DIVIDE    = 0x6F, ///< / (divide)
+
+    // Function keys (F1-F24)
+    F1 = 0x70, F2 = 0x71, F3 = 0x72, F4 = 0x73, F5 = 0x74, F6 = 0x75,
+    F7 = 0x76, F8 = 0x77, F9 = 0x78, F10 = 0x79, F11 = 0x7A, F12 = 0x7B,
+    F13 = 0x7C, F14 = 0x7D, F15 = 0x7E, F16 = 0x7F, F17 = 0x80, F18 = 0x81,
+    F19 = 0x82, F20 = 0x83, F21 = 0x84, F22 = 0x85, F23 = 0x86, F24 = 0x87,
+
+    // Lock keys
+    NUM_LOCK    = 0x90, ///< NUM LOCK
+    SCROLL_LOCK = 0x91, ///< SCROLL LOCK
+
+    // Specific modifiers
+    LEFT_SHIFT    = 0xA0, ///< Left SHIFT
+    RIGHT_SHIFT   = 0xA1, ///< Right SHIFT
+    LEFT_CONTROL  = 0xA2, ///< Left CTRL
+    RIGHT_CONTROL = 0xA3, ///< Right CTRL
+    LEFT_ALT      = 0xA4, ///< Left ALT
+    RIGHT_ALT     = 0xA5, ///< Right ALT
+
+    // Browser keys
+    BROWSER_BACK      = 0xA6, ///< Browser back
+    BROWSER_FORWARD   = 0xA7, ///< Browser forward
+    BROWSER_REFRESH   = 0xA8, ///< Browser refresh
+    BROWSER_STOP      = 0xA9, ///< Browser stop
+    BROWSER_SEARCH    = 0xAA, ///< Browser search
+    BROWSER_FAVORITES = 0xAB, ///< Browser favorites
+    BROWSER_HOME      = 0xAC, ///< Browser home
+
+    // Volume controls
+    VOLUME_MUTE = 0xAD, ///< Mute
+    VOLUME_DOWN = 0xAE, ///< Volume down
+    VOLUME_UP   = 0xAF, ///< Volume up
+
+    // Media controls
+    MEDIA_NEXT_TRACK = 0xB0, ///< Next track
+    MEDIA_PREV_TRACK = 0xB1, ///< Previous track
+    MEDIA_STOP       = 0xB2, ///< Stop media
+    MEDIA_PLAY_PAUSE = 0xB3, ///< Play/Pause
+
+    // Launch keys
+    LAUNCH_MAIL         = 0xB4, ///< Launch mail
+    LAUNCH_MEDIA_SELECT = 0xB5, ///< Media selector
+    LAUNCH_APP1         = 0xB6, ///< Application 1
+    LAUNCH_APP2         = 0xB7, ///< Application 2
+
+    // OEM keys (keyboard specific)
+    OEM_1      = 0xBA, ///< Misc characters (;: in US)
+    OEM_PLUS   = 0xBB, ///< + key for any country
+    OEM_COMMA  = 0xBC, ///< , key for any country
+    OEM_MINUS  = 0xBD, ///< - key for any country
+    OEM_PERIOD = 0xBE, ///< . key for any country
+    OEM_2      = 0xBF, ///< Misc characters (/? in US)
+    OEM_3      = 0xC0, ///< Misc characters (`~ in US)
+
+    OEM_4 = 0xDB, ///< Misc characters ([{ in US)
+    OEM_5 = 0xDC, ///< Misc characters (\\| in US)
+    OEM_6 = 0xDD, ///< Misc characters (]} in US)
+    OEM_7 = 0xDE, ///< Misc characters ('" in US)
+    OEM_8 = 0xDF, ///< Misc characters
+
+    // Advanced special keys
+    OEM_102     = 0xE2, ///< <> or \\| key on RT 102
+    PROCESS_KEY = 0xE5, ///< IME process key
+    PACKET      = 0xE7, ///< Direct Unicode sending
+
+    // Final control keys
+    ATTN      = 0xF6, ///< ATTN key
+    CRSEL     = 0xF7, ///< CrSel key
+    EXSEL     = 0xF8, ///< ExSel key
+    EREOF     = 0xF9, ///< EOF erase key
+    PLAY      = 0xFA, ///< PLAY key
+    ZOOM      = 0xFB, ///< ZOOM key
+    PA1       = 0xFD, ///< PA1 key
+    OEM_CLEAR = 0xFE  ///< CLEAR key
+};
+
+// ==================== CHARACTERS ====================
+
+/**
+ * @brief Key that types a character on a US layout
+ * @param character Character to type
+ * @return Virtual key, SPACE for characters without one
+ */
+inline SIM_CONSTEXPR14 VirtualKey characterKey(char character) {
+    // Numbers 0-9
+    if (character >= '0' && character <= '9') {
+        return static_cast<VirtualKey>(static_cast<uint16_t>(VirtualKey::NUM_0) + (character - '0'));
+    }
+
+    // Lowercase letters a-z
+    if (character >= 'a' && character <= 'z') {
+        return static_cast<VirtualKey>(static_cast<uint16_t>(VirtualKey::A) + (character - 'a'));
+    }
+
+    // Uppercase letters A-Z
+    if (character >= 'A' && character <= 'Z') {
+        return static_cast<VirtualKey>(static_cast<uint16_t>(VirtualKey::A) + (character - 'A'));
+    }
+
+    // Common special characters
+    switch (character) {
+        case ' ': return VirtualKey::SPACE;
+        case '\t': return VirtualKey::TAB;
+        case '\r':
+        case '\n': return VirtualKey::ENTER;
+        case '\b': return VirtualKey::BACKSPACE;
+
+        // Punctuation that doesn't require Shift
+        case ',': return VirtualKey::OEM_COMMA;
+        case '.': return VirtualKey::OEM_PERIOD;
+        case '/': return VirtualKey::OEM_2;
+        case ';': return VirtualKey::OEM_1;
+        case '\'': return VirtualKey::OEM_7;
+        case '[': return VirtualKey::OEM_4;
+        case ']': return VirtualKey::OEM_6;
+        case '\\': return VirtualKey::OEM_5;
+        case '`': return VirtualKey::OEM_3;
+        case '-': return VirtualKey::OEM_MINUS;
+        case '=': return VirtualKey::OEM_PLUS;
+
+        case '!': return VirtualKey::NUM_1;
+        case '@': return VirtualKey::NUM_2;
+        case '#': return VirtualKey::NUM_3;
+        case '$': return VirtualKey::NUM_4;
+        case '%': return VirtualKey::NUM_5;
+        case '^': return VirtualKey::NUM_6;
+        case '&': return VirtualKey::NUM_7;
+        case '*': return VirtualKey::NUM_8;
+        case '(': return VirtualKey::NUM_9;
+        case ')': return VirtualKey::NUM_0;
+        case '_': return VirtualKey::OEM_MINUS;
+        case '+': return VirtualKey::OEM_PLUS;
+        case '{': return VirtualKey::OEM_4;
+        case '}': return VirtualKey::OEM_6;
+        case '|': return VirtualKey::OEM_5;
+        case ':': return VirtualKey::OEM_1;
+        case '"': return VirtualKey::OEM_7;
+        case '<': return VirtualKey::OEM_COMMA;
+        case '>': return VirtualKey::OEM_PERIOD;
+        case '?': return VirtualKey::OEM_2;
+        case '~': return VirtualKey::OEM_3;
+
+        default:
+            return VirtualKey::SPACE;
+    }
+}
+
+/**
+ * @brief Check if a character is typed with Shift held on a US layout
+ * @param character Character to type
+ * @return true for capitals and shifted symbols
+ */
+inline SIM_CONSTEXPR14 bool characterNeedsShift(char character) {
+    if (character >= 'A' && character <= 'Z') {
+        return true;
+    }
+
+    switch (character) {
+        case '!': case '@': case '#': case '$': case '%':
+        case '^': case '&': case '*': case '(': case ')':
+        case '_': case '+': case '{': case '}': case '|':
+        case ':': case '"': case '<': case '>': case '?':
+        case '~':
+            return true;
+        default:
+            return false;
+    }
+}
+
+#endif // SERIAL_INPUT_PROTOCOL_H
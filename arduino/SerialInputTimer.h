@@ -0,0 +1,319 @@
+/**
+ * @file SerialInputTimer.h
+ * @brief Timer interrupt driven event dispatch for BasicSerialInputMonitor
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Events sent from loop() leave when loop() gets to them, so their timing
+ * jitters by whatever else loop() is doing. TimedDispatcher instead keeps
+ * a small queue of events with due times, arms a timer compare interrupt
+ * for the earliest one, and sends it from the interrupt:
+ *
+ *   SerialInputMonitor monitor;
+ *   TimedDispatcher<SerialInputMonitor, DispatchTimer> dispatcher(monitor);
+ *   SIM_DISPATCH_ISR(dispatcher)
+ *
+ *   void setup() { Serial.begin(115200); dispatcher.begin(); }
+ *   ...
+ *   uint32_t now = micros();
+ *   dispatcher.scheduleKey(now + 1000, VirtualKey::A, true);
+ *   dispatcher.scheduleKey(now + 51000, VirtualKey::A, false);
+ *
+ * The timer is a template parameter with three static functions:
+ * `begin()` sets it up, `arm(delayUs)` requests one interrupt after at
+ * most delayUs (called with interrupts disabled), and `cancel()` stops
+ * it. DispatchTimer is Timer1 on AVR boards (Uno: 0.5 us resolution; it
+ * takes Timer1 from Servo, tone() and PWM on pins 9 and 10) and the
+ * simulated timer of host/sim in the native build; on other boards the
+ * header stops with an #error rather than leaving them undefined.
+ *
+ * An interrupt never writes while the monitor is in the middle of a
+ * line (isSending()); it tries again RETRY_US later, so an event is late
+ * by at most the rest of that line. Sketches that print their own lines
+ * while events are queued should do so between noInterrupts() and
+ * interrupts().
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_INPUT_TIMER_H
+#define SERIAL_INPUT_TIMER_H
+
+#include "SerialInputMonitor.h"
+
+/**
+ * @brief Queue of events sent from a timer interrupt at their due time
+ * @tparam Monitor Monitor type the events are sent through
+ * @tparam Timer Compare-match timer (see the file comment)
+ * @tparam Capacity Events queued at most
+ */
+template <typename Monitor, typename Timer, uint8_t Capacity = 8> class TimedDispatcher {
+  public:
+    static const uint16_t RETRY_US = 20; ///< Retry delay while the monitor is writing
+
+    /**
+     * @brief Create a dispatcher
+     * @param monitor Monitor that writes the events
+     */
+    explicit TimedDispatcher(Monitor &monitor)
+        : m_monitor(monitor), m_count(0), m_dispatched(0), m_maxLatenessUs(0) {
+    }
+
+    /**
+     * @brief Set up the timer; call from setup()
+     */
+    void begin() {
+        Timer::begin();
+    }
+
+    /**
+     * @brief Queue an event
+     * @param dueUs micros() at which to send it (past times send at once)
+     * @param event Event to send
+     * @return false if the queue is full
+     *
+     * Events due at the same time leave in the order they were queued.
+     * Call from loop(), not from another interrupt.
+     */
+    bool schedule(uint32_t dueUs, const InputEvent &event) {
+        noInterrupts();
+        bool added = m_count < Capacity;
+        if (added) {
+            uint8_t index = m_count++;
+            while (index > 0 && static_cast<int32_t>(dueUs - m_queue[index - 1].dueUs) < 0) {
+                m_queue[index] = m_queue[index - 1];
+                index--;
+            }
+            m_queue[index].dueUs = dueUs;
+            m_queue[index].event = event;
+            if (index == 0) {
+                armNext(static_cast<uint32_t>(micros()));
+            }
+        }
+        interrupts();
+        return added;
+    }
+
+    /**
+     * @brief Queue a key press or release
+     * @param dueUs micros() at which to send it
+     * @param key Virtual key code
+     * @param pressed true for a press, false for a release
+     * @return false if the queue is full
+     */
+    bool scheduleKey(uint32_t dueUs, VirtualKey key, bool pressed) {
+        KeyboardEvent event = pressed ? KeyboardEvent::PRESS : KeyboardEvent::RELEASE;
+        InputEvent    input = {Device::KEYBOARD, static_cast<uint8_t>(event), static_cast<int>(key), 0};
+        return schedule(dueUs, input);
+    }
+
+    /**
+     * @brief Number of queued events
+     * @return Events not sent yet
+     */
+    inline uint8_t pending() const {
+        return m_count;
+    }
+
+    /**
+     * @brief Time until the next queued event is due
+     * @return Microseconds, 0 if one is overdue, 0xFFFFFFFF if none is queued
+     *
+     * loop() can sleep this long, e.g. serialInputIdle(untilNextUs());
+     * the timer interrupt wakes the CPU for the event in any case.
+     */
+    uint32_t untilNextUs() const {
+        noInterrupts();
+        uint32_t leftUs = 0xFFFFFFFFUL;
+        if (m_count > 0) {
+            int32_t aheadUs = static_cast<int32_t>(m_queue[0].dueUs - static_cast<uint32_t>(micros()));
+            leftUs          = aheadUs > 0 ? static_cast<uint32_t>(aheadUs) : 0;
+        }
+        interrupts();
+        return leftUs;
+    }
+
+    /**
+     * @brief Events sent so far
+     * @return Count since the last resetStats()
+     */
+    uint32_t dispatched() const {
+        noInterrupts();
+        uint32_t count = m_dispatched;
+        interrupts();
+        return count;
+    }
+
+    /**
+     * @brief Largest delay between an event's due time and its sending
+     * @return Microseconds since the last resetStats()
+     */
+    uint32_t maxLatenessUs() const {
+        noInterrupts();
+        uint32_t lateness = m_maxLatenessUs;
+        interrupts();
+        return lateness;
+    }
+
+    /**
+     * @brief Clear dispatched() and maxLatenessUs()
+     */
+    void resetStats() {
+        noInterrupts();
+        m_dispatched    = 0;
+        m_maxLatenessUs = 0;
+        interrupts();
+    }
+
+    /**
+     * @brief Send the due events; call from the timer interrupt only
+     *
+     * Use SIM_DISPATCH_ISR() to bind it to the interrupt of DispatchTimer.
+     */
+    void onTimer() {
+        if (m_monitor.isSending()) {
+            Timer::arm(RETRY_US);
+            return;
+        }
+
+        uint32_t now = static_cast<uint32_t>(micros());
+        while (m_count > 0 && static_cast<int32_t>(now - m_queue[0].dueUs) >= 0) {
+            uint32_t   latenessUs = now - m_queue[0].dueUs;
+            InputEvent event      = m_queue[0].event;
+            for (uint8_t i = 1; i < m_count; i++) {
+                m_queue[i - 1] = m_queue[i];
+            }
+            m_count--;
+
+            m_monitor.sendEvent(event);
+            m_dispatched++;
+            if (latenessUs > m_maxLatenessUs) {
+                m_maxLatenessUs = latenessUs;
+            }
+            now = static_cast<uint32_t>(micros());
+        }
+
+        if (m_count > 0) {
+            armNext(now);
+        } else {
+            Timer::cancel();
+        }
+    }
+
+  private:
+    /**
+     * @brief Queued event
+     */
+    struct Entry {
+        uint32_t   dueUs; ///< micros() at which to send
+        InputEvent event; ///< Event to send
+    };
+
+    Monitor          &m_monitor;         ///< Writes the events
+    Entry             m_queue[Capacity]; ///< Sorted by due time
+    volatile uint8_t  m_count;           ///< Entries in m_queue
+    volatile uint32_t m_dispatched;      ///< Events sent
+    volatile uint32_t m_maxLatenessUs;   ///< Worst due-to-send delay
+
+    /**
+     * @brief Arm the timer for the head of the queue (interrupts disabled)
+     * @param now Current micros()
+     */
+    void armNext(uint32_t now) {
+        int32_t leftUs = static_cast<int32_t>(m_queue[0].dueUs - now);
+        Timer::arm(leftUs > 0 ? static_cast<uint32_t>(leftUs) : 0);
+    }
+};
+
+// ==================== TIMERS ====================
+
+#if defined(SERIAL_INPUT_SIMULATOR)
+
+/**
+ * @brief Simulated timer of the native device simulator (host/sim)
+ */
+struct SimulatedDispatchTimer {
+    static inline void begin() {
+    }
+
+    static inline void arm(uint32_t delayUs) {
+        simTimerArm(delayUs);
+    }
+
+    static inline void cancel() {
+        simTimerCancel();
+    }
+};
+
+typedef SimulatedDispatchTimer DispatchTimer;
+
+/**
+ * @brief Bind a dispatcher to the simulated timer interrupt (file scope, once)
+ */
+#define SIM_DISPATCH_ISR(dispatcher)                                                                                   \
+    static void simDispatchIsr() {                                                                                     \
+        (dispatcher).onTimer();                                                                                        \
+    }                                                                                                                  \
+    static struct SimDispatchIsrAttach {                                                                               \
+        SimDispatchIsrAttach() {                                                                                       \
+            simTimerAttach(simDispatchIsr);                                                                            \
+        }                                                                                                              \
+    } simDispatchIsrAttach;
+
+#elif defined(__AVR__) && defined(TIMSK1)
+
+#include <avr/interrupt.h>
+
+/**
+ * @brief 16-bit Timer1 in normal mode at clk/8, compare channel A
+ *
+ * The counter runs freely; each arm() moves OCR1A relative to it, so
+ * one wrap (32 ms at 16 MHz) is the longest single wait and longer
+ * delays take several interrupts.
+ */
+struct AvrTimer1 {
+    static const uint32_t TICKS_PER_US = F_CPU / 8000000UL; ///< 2 at 16 MHz, 1 at 8 MHz
+    static const uint16_t MIN_TICKS    = 8;                 ///< Enough to write OCR1A before TCNT1 passes it
+    static const uint16_t MAX_TICKS    = 0xF000;            ///< Leaves headroom below one wrap
+
+    static_assert(F_CPU >= 8000000UL, "AvrTimer1 needs a clock of at least 8 MHz");
+
+    static void begin() {
+        uint8_t oldSREG = SREG;
+        cli();
+        TCCR1A = 0;
+        TCCR1B = _BV(CS11);
+        TIMSK1 &= static_cast<uint8_t>(~_BV(OCIE1A));
+        SREG = oldSREG;
+    }
+
+    static void arm(uint32_t delayUs) {
+        uint32_t ticks = delayUs < MAX_TICKS / TICKS_PER_US ? delayUs * TICKS_PER_US : MAX_TICKS;
+        if (ticks < MIN_TICKS) {
+            ticks = MIN_TICKS;
+        }
+        OCR1A = static_cast<uint16_t>(TCNT1 + ticks);
+        TIFR1 = _BV(OCF1A); // Drop a match from the previous setting
+        TIMSK1 |= _BV(OCIE1A);
+    }
+
+    static void cancel() {
+        TIMSK1 &= static_cast<uint8_t>(~_BV(OCIE1A));
+    }
+};
+
+typedef AvrTimer1 DispatchTimer;
+
+/**
+ * @brief Bind a dispatcher to the Timer1 compare interrupt (file scope, once)
+ */
+#define SIM_DISPATCH_ISR(dispatcher)                                                                                   \
+    ISR(TIMER1_COMPA_vect) {                                                                                           \
+        (dispatcher).onTimer();                                                                                        \
+    }
+
+#else
+#error "TimedDispatcher needs Timer1 (AVR) or the simulator"
+#endif
+
+#endif // SERIAL_INPUT_TIMER_H
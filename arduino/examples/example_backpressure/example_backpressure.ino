@@ -0,0 +1,103 @@
+/**
+ * @file example_backpressure.ino
+ * @brief Mouse motion, clicks and text through a bounded TX queue
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ * 
+ * When the link or the host stops reading, a sketch writing straight to
+ * Serial stalls in Serial.write(). Through a TxQueue it keeps running:
+ * motion and scrolling are merged or dropped instead of piling up,
+ * presses and releases are always delivered in order, and a text that
+ * does not fit is cut between two characters.
+ * 
+ * Features:
+ * - Mouse motion every 5 ms, a scroll step every 100 ms
+ * - Left button pressed and released in turn every 500 ms
+ * - "ok" typed every 3 s (cut short while the link is stalled)
+ * - Queue counters and the slowest loop() reported as a comment every second
+ * 
+ * Try it in the simulator with a 3 s stall: -z 4,3 (see host/README.md).
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+
+SerialInputMonitor monitor;
+TxQueueBuffer<16> queue;
+
+unsigned long lastMoveMs;
+unsigned long lastScrollMs;
+unsigned long lastClickMs;
+unsigned long lastTextMs;
+unsigned long lastReportMs;
+bool buttonDown = false;
+uint32_t worstLoopUs = 0;
+
+void setup() {
+  Serial.begin(115200);
+  monitor.enableClockSync(200);
+  monitor.attachTxQueue(&queue);
+  queue.setPolicy(TxClass::TEXT, TxPolicy::FAIL);
+  queue.setMaxAgeMs(250);
+
+  delay(2000);
+
+  Serial.println("# Backpressure example");
+}
+
+void loop() {
+  uint32_t start = micros();
+  monitor.poll();
+
+  unsigned long now = millis();
+
+  if (now - lastMoveMs >= 5) {
+    lastMoveMs = now;
+    monitor.moveMouseRelative(2, -1);
+  }
+  if (now - lastScrollMs >= 100) {
+    lastScrollMs = now;
+    monitor.scrollMouse(1);
+  }
+  if (now - lastClickMs >= 500) {
+    lastClickMs = now;
+    buttonDown = !buttonDown;
+    if (buttonDown) {
+      monitor.pressLeftButton();
+    } else {
+      monitor.releaseLeftButton();
+    }
+  }
+
+  if (now - lastTextMs >= 3000) {
+    lastTextMs = now;
+    monitor.typeText("ok");
+  }
+
+  uint32_t loopUs = micros() - start;
+  if (loopUs > worstLoopUs) {
+    worstLoopUs = loopUs;
+  }
+
+  // Report only when the whole line fits, so the comment never waits
+  if (now - lastReportMs >= 1000 && queue.pending() == 0 && Serial.availableForWrite() >= 60) {
+    lastReportMs = now;
+    const TxStats &stats = queue.stats();
+    Serial.print("# tx max ");
+    Serial.print(stats.maxPending);
+    Serial.print(" drop ");
+    Serial.print(stats.dropped[static_cast<uint8_t>(TxClass::MOTION)]);
+    Serial.print("/");
+    Serial.print(stats.dropped[static_cast<uint8_t>(TxClass::SCROLL)]);
+    Serial.print("/");
+    Serial.print(stats.dropped[static_cast<uint8_t>(TxClass::TEXT)]);
+    Serial.print(" merge ");
+    Serial.print(stats.merged);
+    Serial.print(" block ");
+    Serial.print(stats.blocked);
+    Serial.print(" us ");
+    Serial.println(worstLoopUs);
+    queue.resetStats();
+    worstLoopUs = 0;
+  }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file example_dma_tx.ino
+ * @brief Event lines sent from two buffers drained by DMA
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ *
+ * Every line the monitor writes is appended to one of two 128-byte
+ * buffers while a DMA channel sends the other; the CPU takes one
+ * completion per transfer instead of one interrupt per byte. While the
+ * link keeps up, each line leaves at once in a transfer of its own;
+ * once it falls behind, the lines written meanwhile leave together in
+ * the next transfer.
+ *
+ * Features:
+ * - A mouse move every 2 ms and a burst of 8 moves every 100 ms
+ * - Left button pressed and released in turn every 500 ms
+ * - "dma" typed every 3 s
+ * - "# lines L, transfers T, waits W" every 2 s, printed after a flush
+ *   so it stays in order with the events
+ *
+ * Runs on the RP2040 and in the native simulator; try it there with a
+ * 1 s stall: -z 3,1 (see host/README.md). The link is SERIAL_TX_DMA_LINK,
+ * the stream the DMA engine feeds: Serial1 (UART0, GP0/GP1) on the
+ * RP2040, not the USB Serial.
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+
+#if !SIM_HAS_SERIAL_TX_DMA
+#error "example_dma_tx needs a board with SERIAL_TX_DMA: the RP2040 or the native simulator"
+#endif
+
+SerialInputMonitor monitor;
+DmaTxBuffer<128>   tx(SERIAL_TX_DMA);
+
+unsigned long lastMoveMs;
+unsigned long lastBurstMs;
+unsigned long lastClickMs;
+unsigned long lastTextMs;
+unsigned long lastReportMs;
+bool          buttonDown = false;
+
+void setup() {
+  SERIAL_TX_DMA_LINK.begin(115200);
+  monitor.attachLink(SERIAL_TX_DMA_LINK);
+  monitor.attachDmaTx(&tx);
+
+  delay(2000);
+
+  monitor.link().println("# DMA transmit example");
+}
+
+void loop() {
+  monitor.poll();
+
+  unsigned long now = millis();
+
+  if (now - lastMoveMs >= 2) {
+    lastMoveMs = now;
+    monitor.moveMouseRelative(1, 0);
+  }
+  if (now - lastBurstMs >= 100) {
+    lastBurstMs = now;
+    for (uint8_t i = 0; i < 8; i++) {
+      monitor.moveMouseRelative(0, 1);
+    }
+  }
+  if (now - lastClickMs >= 500) {
+    lastClickMs = now;
+    buttonDown  = !buttonDown;
+    if (buttonDown) {
+      monitor.pressLeftButton();
+    } else {
+      monitor.releaseLeftButton();
+    }
+  }
+  if (now - lastTextMs >= 3000) {
+    lastTextMs = now;
+    monitor.typeText("dma");
+  }
+
+  if (now - lastReportMs >= 2000) {
+    lastReportMs = now;
+    tx.flush();
+    const DmaTxStats &stats = tx.stats();
+    Stream           &link  = monitor.link();
+    link.print("# lines ");
+    link.print(stats.lines);
+    link.print(", transfers ");
+    link.print(stats.transfers);
+    link.print(", waits ");
+    link.println(stats.waits);
+  }
+}
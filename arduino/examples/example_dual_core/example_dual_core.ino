@@ -0,0 +1,151 @@
+/**
+ * @file example_dual_core.ino
+ * @brief Scanning on one core, encoding and sending on the other
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ *
+ * The front end debounces a button on pin 2 (to GND) and plans a
+ * square mouse path, one step every 4 ms. It posts events into an
+ * EventPipeline. The back end pumps them through the monitor to Serial.
+ * Neither side waits for the other: a slow link makes the front end
+ * merge its moves, and a busy front end never delays a line.
+ *
+ * The platform glue is the only part that differs:
+ * - RP2040 (Earle Philhower core): loop() on core 0 is the front end,
+ *   loop1() on core 1 the back end
+ * - ESP32: a task pinned to core 0 is the front end, loop() on core 1
+ *   the back end
+ * - Native simulator (host/sim): a std::thread is the front end
+ *
+ * Features:
+ * - "# sent N, merged M, refused R" every 2 s
+ * - Button edges are never lost: a refused edge is posted again
+ *
+ * SerialInputMonitor library REQUIRED for this example (dual-core
+ * boards or the simulator; not for the Uno).
+ */
+
+#include "SerialInputMonitor.h"
+#include "SerialInputPipeline.h"
+
+#if !defined(ARDUINO_ARCH_RP2040) && !defined(ESP32)
+#include <chrono>
+#include <thread>
+#endif
+
+const uint8_t       BUTTON_PIN  = 2;
+const unsigned long DEBOUNCE_MS = 5;
+const unsigned long STEP_MS     = 4;
+const uint16_t      SIDE_STEPS  = 25;
+const int           STEP_PIXELS = 4;
+const unsigned long REPORT_MS   = 2000;
+
+SerialInputMonitor                    monitor;
+EventPipeline<SerialInputMonitor, 64> pipeline(monitor);
+
+// Front end state
+bool          buttonDown  = false; // Debounced state, as sent
+bool          buttonLevel = false; // Last level read
+unsigned long levelSince  = 0;
+unsigned long lastStep    = 0;
+uint16_t      step        = 0;
+
+// Back end state
+unsigned long lastReport = 0;
+
+void frontEnd(unsigned long now) {
+  // Debounce: a new level counts once it has held for DEBOUNCE_MS
+  bool level = digitalRead(BUTTON_PIN) == LOW;
+  if (level != buttonLevel) {
+    buttonLevel = level;
+    levelSince  = now;
+  }
+  if (buttonLevel != buttonDown && now - levelSince >= DEBOUNCE_MS &&
+      pipeline.postButton(buttonLevel ? MouseEvent::LEFT_PRESS : MouseEvent::LEFT_RELEASE)) {
+    buttonDown = buttonLevel;
+  }
+
+  // Motion planning: a square, one step every STEP_MS
+  if (now - lastStep >= STEP_MS) {
+    static const int8_t DX[] = {1, 0, -1, 0};
+    static const int8_t DY[] = {0, 1, 0, -1};
+    uint8_t             side = (step / SIDE_STEPS) % 4;
+    pipeline.postMove(DX[side] * STEP_PIXELS, DY[side] * STEP_PIXELS);
+    lastStep = now;
+    step     = (step + 1) % (4 * SIDE_STEPS);
+  }
+  pipeline.flush();
+}
+
+void backEnd() {
+  pipeline.pump();
+  monitor.poll();
+
+  if (millis() - lastReport >= REPORT_MS) {
+    lastReport = millis();
+    Serial.print("# sent ");
+    Serial.print(pipeline.sent());
+    Serial.print(", merged ");
+    Serial.print(pipeline.merged());
+    Serial.print(", refused ");
+    Serial.println(pipeline.refused());
+  }
+}
+
+#if defined(ARDUINO_ARCH_RP2040)
+
+void setup() {
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+}
+
+void loop() {
+  frontEnd(millis());
+}
+
+void setup1() {
+  Serial.begin(115200);
+}
+
+void loop1() {
+  backEnd();
+}
+
+#elif defined(ESP32)
+
+void frontEndTask(void *) {
+  for (;;) {
+    frontEnd(millis());
+    vTaskDelay(1);
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  xTaskCreatePinnedToCore(frontEndTask, "front end", 4096, nullptr, 1, nullptr, 0);
+}
+
+void loop() {
+  backEnd();
+}
+
+#else
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(BUTTON_PIN, INPUT_PULLUP);
+  std::thread([] {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (;;) {
+      std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+      frontEnd(static_cast<unsigned long>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()));
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+  }).detach();
+}
+
+void loop() {
+  backEnd();
+}
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file example_key_names.ino
+ * @brief Pressing keys named in serial commands
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ *
+ * Lets a host script or a terminal drive the keyboard by VirtualKey
+ * name. Each command line is one key or a chord joined with '+':
+ *
+ *   ENTER
+ *   CONTROL+ALT+DELETE
+ *   LEFT_WIN+NUM_5
+ *
+ * The keys are pressed in order and released in reverse. Names are
+ * looked up with keyFromName() in the PROGMEM tables of
+ * SerialInputKeyNames.h: one hash and one compare per name.
+ *
+ * Features:
+ * - Every VirtualKey name, aliases included (HANGUL, KANJI...)
+ * - "# tap NAME+NAME" echo with the names read back through keyName()
+ * - "# unknown key NAME" for names that are not VirtualKeys
+ *
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+#include "SerialInputKeyNames.h"
+
+const uint8_t MAX_CHORD = 6;
+
+SerialInputMonitor monitor;
+char               line[64];
+uint8_t            lineLength = 0;
+
+void printKeyName(VirtualKey key) {
+  Serial.print(reinterpret_cast<const __FlashStringHelper *>(keyName(key)));
+}
+
+void runCommand() {
+  VirtualKey keys[MAX_CHORD];
+  uint8_t    count = 0;
+  uint8_t    start = 0;
+
+  for (uint8_t i = 0; i <= lineLength; i++) {
+    if (i < lineLength && line[i] != '+') {
+      continue;
+    }
+    if (count == MAX_CHORD || !keyFromName(line + start, i - start, keys[count])) {
+      Serial.print("# unknown key ");
+      Serial.write(reinterpret_cast<const uint8_t *>(line + start), i - start);
+      Serial.println();
+      return;
+    }
+    count++;
+    start = i + 1;
+  }
+
+  Serial.print("# tap ");
+  for (uint8_t i = 0; i < count; i++) {
+    if (i > 0) {
+      Serial.print('+');
+    }
+    printKeyName(keys[i]);
+  }
+  Serial.println();
+
+  for (uint8_t i = 0; i < count; i++) {
+    monitor.pressKey(keys[i]);
+    monitor.delay(i + 1 < count ? 10 : 50);
+  }
+  for (uint8_t i = count; i-- > 0;) {
+    monitor.releaseKey(keys[i]);
+    monitor.delay(10);
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  Serial.println("# Key names example: send ENTER or CONTROL+ALT+DELETE");
+}
+
+void loop() {
+  while (Serial.available()) {
+    char character = static_cast<char>(Serial.read());
+    if (character == '\n' || character == '\r') {
+      if (lineLength > 0) {
+        runCommand();
+      }
+      lineLength = 0;
+    } else if (lineLength < sizeof(line)) {
+      line[lineLength++] = character;
+    }
+  }
+}
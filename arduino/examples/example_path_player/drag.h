@@ -0,0 +1,19 @@
+// Generated by serial-input-path from drag.svg
+
+const int8_t DRAG_POINTS[] PROGMEM = {
+    -128, 66, -128, -128, 6, 0, 7, 1, 6, 0, 7, 1, 6, 0, 6, 1,
+    7, 0, 6, 0, 6, 1, 7, 0, 6, 1, 7, 0, 6, 1, 6, 0,
+    7, 0, 6, 1, 7, 0, 6, 1, 6, 0, 7, 1, 6, 0, 6, 0,
+    7, 1, 6, 0, 7, 1, 6, 0, 6, 0, 7, 1, 6, 0, 6, 1,
+    7, 0, 6, 1, 7, 0, 6, 0, 6, 1, 7, 0, 6, 1, 7, 0,
+    6, 1, 6, 0, 7, 0, 6, 1, 6, 0, 7, 1, 6, 0, 7, 1,
+    6, 0, 6, 0, 7, 1, 6, 0, 7, 1, 6, 0, 6, 1, 7, 0,
+    6, 0, 6, 1, 7, 0, 6, 1, 7, 0, 6, 1, 6, 0, 7, 0,
+    6, 1, 7, 0, 6, 1, 6, 0, 7, 1, 6, 0, 6, 0, 7, 1,
+    6, 0, 7, 1, 6, 0, 6, 0, 7, 1, 6, 0, 6, 1, 7, 0,
+    6, 1, 7, 0, 6, 0, 6, 1, 7, 0, 6, 1, 7, 0, 6, 1,
+    6, 0, 7, 0, 6, 1, 6, 0, 7, 1, 6, 0, 7, 1, 6, 0,
+    -128, -128, -128, 67, -128, 0,
+};
+
+const MousePath DRAG = {DRAG_POINTS, sizeof(DRAG_POINTS), 8, 200, 300, true};
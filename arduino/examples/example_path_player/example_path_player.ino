@@ -0,0 +1,70 @@
+/**
+ * @file example_path_player.ino
+ * @brief Drawing a signature and dragging from precomputed paths
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ *
+ * signature.svg and drag.svg are SVG drawings; signature.h and drag.h
+ * are their mouse paths, compiled on the host with
+ *
+ *   serial-input-path -d -n SIGNATURE -o signature.h signature.svg
+ *   serial-input-path -d -x 200 -y 300 -n DRAG -o drag.h drag.svg
+ *
+ * SIGNATURE draws four strokes with the left button held, starting
+ * where the pointer is (open a paint program first). DRAG presses at
+ * (200, 300), drags 600 pixels right and releases. The paths take 596
+ * and 198 bytes of flash and no floating point on the board.
+ *
+ * Features:
+ * - PathPlayer plays from loop() without blocking; the LED keeps
+ *   blinking while the pointer moves
+ * - Moves are sent as the link has room for them, so they arrive on
+ *   time and add up to the drawing at any baud rate
+ * - "# ticks T, moves M, held H" after each path
+ *
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+#include "SerialInputPath.h"
+#include "drag.h"
+#include "signature.h"
+
+const unsigned long BLINK_MS = 250;
+
+SerialInputMonitor             monitor;
+PathPlayer<SerialInputMonitor> player(monitor);
+uint8_t                        played = 0;
+unsigned long                  lastBlink;
+
+void setup() {
+  Serial.begin(115200);
+  pinMode(LED_BUILTIN, OUTPUT);
+  delay(2000);
+
+  Serial.println("# Path player example");
+  player.start(SIGNATURE);
+}
+
+void loop() {
+  unsigned long now = millis();
+
+  if (now - lastBlink >= BLINK_MS) {
+    lastBlink = now;
+    digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+  }
+
+  if (played < 2 && !player.update(now)) {
+    const PathStats &stats = player.stats();
+    Serial.print("# ticks ");
+    Serial.print(stats.ticks);
+    Serial.print(", moves ");
+    Serial.print(stats.moves);
+    Serial.print(", held ");
+    Serial.println(stats.held);
+
+    if (++played == 1) {
+      player.start(DRAG, now + 1000);
+    }
+  }
+}
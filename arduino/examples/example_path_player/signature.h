@@ -0,0 +1,44 @@
+// Generated by serial-input-path from signature.svg
+
+const int8_t SIGNATURE_POINTS[] PROGMEM = {
+    -128, 66, -128, -128, 2, 0, 2, 0, 2, -1, 3, -4, 2, -5, 2, -6,
+    2, -6, 2, -6, 3, -5, 2, -3, 2, -1, 2, 2, 2, 4, 2, 5,
+    2, 5, 2, 3, 1, 3, 2, 4, 2, 3, 2, 1, 2, -1, 3, -1,
+    2, -1, 2, 0, 2, 0, 2, 3, 2, 5, 2, 6, 2, 4, 1, 3,
+    1, 4, 1, 3, 2, 6, 2, 4, 2, 2, 3, 0, 2, -3, 2, -3,
+    2, -5, 2, -4, 2, -3, 2, -2, 3, 0, 2, 1, 2, 2, 2, 3,
+    2, 1, 3, 0, 2, -2, 2, -4, 2, -5, 1, -3, 1, -4, 1, -3,
+    1, -4, 2, -6, 3, -5, 2, -3, 2, 0, 2, 1, 2, 3, 3, 3,
+    2, 3, 2, 3, 2, 1, 2, -1, 2, -2, 2, -3, 3, -3, 2, -3,
+    2, -1, 2, 1, 2, 2, 3, 5, 2, 6, 1, 4, 1, 3, 2, 6,
+    2, 5, 2, 3, 2, 1, 3, 0, 2, -3, 2, -2, 2, -3, 2, -2,
+    3, -1, 2, 1, 2, 3, 2, 4, 2, 4, 2, 4, 2, 2, 3, 0,
+    2, -1, 2, -4, 2, -5, 2, -6, 2, -3, 1, -3, 2, -5, 2, -3,
+    2, -2, 2, 1, 2, 2, 2, 3, 3, 2, 2, 2, 2, 1, 2, -2,
+    2, -2, 3, -5, 2, -5, 2, -4, 2, -3, 2, -2, 2, 1, 2, 2,
+    3, 5, 2, 5, 2, 5, 2, 5, 2, 3, 3, 1, 2, 0, 2, -2,
+    2, -3, -128, -128, -128, 67, -6, 1, -6, 2, -6, 1, -7, 1, -6, 1,
+    -6, 2, -6, 1, -6, 1, -6, 2, -7, 1, -6, 1, -6, 1, -6, 2,
+    -6, 1, -6, 1, -6, 2, -7, 1, -6, 1, -6, 1, -6, 2, -6, 1,
+    -6, 1, -7, 1, -6, 2, -6, 1, -6, 1, -6, 2, -6, 1, -6, 1,
+    -7, 1, -6, 2, -6, 1, -6, 1, -6, 2, -6, 1, -7, 1, -6, 1,
+    -6, 2, -6, 1, -128, 66, -128, -128, 3, -5, 2, -6, 3, -5, 3, -6,
+    3, -5, 2, -6, 3, -5, 3, -6, 3, -5, 2, -6, 3, -5, 1, 6,
+    1, 6, 1, 6, 1, 6, 1, 6, 1, 6, 1, 6, 1, 6, 1, 6,
+    1, 6, -128, -128, -128, 67, 3, -5, 4, -5, 3, -5, 3, -5, 4, -5,
+    3, -5, -128, 66, -128, -128, 6, 0, 5, 0, 6, 0, 6, 0, 6, 0,
+    5, 0, 6, 0, 0, 5, 0, 5, 0, 5, 0, 5, -6, 0, -5, 0,
+    -6, 0, -6, 0, -6, 0, -5, 0, -6, 0, 0, -5, 0, -5, 0, -5,
+    0, -5, -128, -128, -128, 67, 5, 4, 5, 4, 5, 4, 5, 4, 5, 3,
+    5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4, 5, 4,
+    5, 3, 5, 4, 5, 4, 5, 4, 5, 4, -128, 66, -128, -128, 0, 5,
+    -1, 5, -2, 5, -2, 5, -3, 4, -4, 4, -4, 4, -4, 3, -5, 2,
+    -5, 2, -5, 1, -5, 0, -5, 0, -5, -1, -5, -2, -5, -2, -4, -3,
+    -4, -4, -4, -4, -3, -4, -2, -5, -2, -5, -1, -5, 0, -5, 0, -5,
+    1, -5, 2, -5, 2, -5, 3, -4, 4, -4, 4, -4, 4, -3, 5, -2,
+    5, -2, 5, -1, 5, 0, 5, 0, 5, 1, 5, 2, 5, 2, 4, 3,
+    4, 4, 4, 4, 3, 4, 2, 5, 2, 5, 1, 5, 0, 5, -128, -128,
+    -128, 67, -128, 0,
+};
+
+const MousePath SIGNATURE = {SIGNATURE_POINTS, sizeof(SIGNATURE_POINTS), 8, -1, -1, true};
@@ -0,0 +1,57 @@
+/**
+ * @file example_script_player.ino
+ * @brief Playing compiled scripts from flash and from the serial port
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ *
+ * greeting.txt is a DuckyScript-style script; greeting.h is its event
+ * program, compiled on the host with
+ *
+ *   serial-input-script -n GREETING -o greeting.h greeting.txt
+ *
+ * The program sits in flash: its 183 events take 461 bytes and no RAM,
+ * where the same calls in the sketch would take several KB of code.
+ *
+ * Features:
+ * - Plays GREETING once at startup
+ * - Accepts uploaded programs (serial-input-script -u PORT SCRIPT) of up
+ *   to 256 bytes and plays each one as soon as it is complete
+ * - "# played N" after each program, "# upload failed" for a bad one
+ *
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+#include "greeting.h"
+
+SerialInputMonitor        monitor;
+ProgramBufferStorage<256> upload;
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  monitor.attachProgramBuffer(&upload);
+
+  Serial.println("# Script player example");
+  if (monitor.play(GREETING)) {
+    Serial.print("# played ");
+    Serial.println(GREETING.length);
+  }
+}
+
+void loop() {
+  monitor.poll();
+
+  if (upload.ready()) {
+    EventProgram program = upload.program();
+    if (monitor.play(program)) {
+      Serial.print("# played ");
+      Serial.println(program.length);
+    }
+    upload.clear();
+  } else if (upload.failed()) {
+    Serial.println("# upload failed");
+    upload.clear();
+  }
+}
@@ -0,0 +1,45 @@
+// Generated by serial-input-script from greeting.txt
+
+const uint8_t GREETING_STEPS[] PROGMEM = {
+    0x20, 0x5B, 0x2A, 0x52, 0x5F, 0x32, 0x52, 0x4A, 0x5B, 0x3F, 0x92, 0x04,
+    0x4E, 0x5F, 0x32, 0x4E, 0x2A, 0x4F, 0x5F, 0x32, 0x4F, 0x2A, 0x54, 0x5F,
+    0x32, 0x54, 0x2A, 0x45, 0x5F, 0x32, 0x45, 0x2A, 0x50, 0x5F, 0x32, 0x50,
+    0x2A, 0x41, 0x5F, 0x32, 0x41, 0x2A, 0x44, 0x5F, 0x32, 0x44, 0x2A, 0x0D,
+    0x5F, 0x32, 0x0D, 0x3F, 0x86, 0x08, 0xA0, 0x2A, 0x48, 0x5F, 0x32, 0x48,
+    0x4A, 0xA0, 0x2A, 0x45, 0x5F, 0x32, 0x45, 0x2A, 0x4C, 0x5F, 0x32, 0x4C,
+    0x2A, 0x4C, 0x5F, 0x32, 0x4C, 0x2A, 0x4F, 0x5F, 0x32, 0x4F, 0x2A, 0x20,
+    0x5F, 0x32, 0x20, 0x2A, 0x46, 0x5F, 0x32, 0x46, 0x2A, 0x52, 0x5F, 0x32,
+    0x52, 0x2A, 0x4F, 0x5F, 0x32, 0x4F, 0x2A, 0x4D, 0x5F, 0x32, 0x4D, 0x2A,
+    0x20, 0x5F, 0x32, 0x20, 0x2A, 0x41, 0x5F, 0x32, 0x41, 0x2A, 0x20, 0x5F,
+    0x32, 0x20, 0x2A, 0x43, 0x5F, 0x32, 0x43, 0x2A, 0x4F, 0x5F, 0x32, 0x4F,
+    0x2A, 0x4D, 0x5F, 0x32, 0x4D, 0x2A, 0x50, 0x5F, 0x32, 0x50, 0x2A, 0x49,
+    0x5F, 0x32, 0x49, 0x2A, 0x4C, 0x5F, 0x32, 0x4C, 0x2A, 0x45, 0x5F, 0x32,
+    0x45, 0x2A, 0x44, 0x5F, 0x32, 0x44, 0x2A, 0x20, 0x5F, 0x32, 0x20, 0x2A,
+    0x53, 0x5F, 0x32, 0x53, 0x2A, 0x43, 0x5F, 0x32, 0x43, 0x2A, 0x52, 0x5F,
+    0x32, 0x52, 0x2A, 0x49, 0x5F, 0x32, 0x49, 0x2A, 0x50, 0x5F, 0x32, 0x50,
+    0x2A, 0x54, 0x5F, 0x32, 0x54, 0x2A, 0xA0, 0x2A, 0x31, 0x5F, 0x32, 0x31,
+    0x4A, 0xA0, 0x3E, 0x0D, 0x5F, 0x32, 0x0D, 0x3E, 0xA0, 0x2A, 0x52, 0x5F,
+    0x32, 0x52, 0x4A, 0xA0, 0x2A, 0x49, 0x5F, 0x32, 0x49, 0x2A, 0x47, 0x5F,
+    0x32, 0x47, 0x2A, 0x48, 0x5F, 0x32, 0x48, 0x2A, 0x54, 0x5F, 0x32, 0x54,
+    0x2A, 0xBD, 0x5F, 0x32, 0xBD, 0x2A, 0x43, 0x5F, 0x32, 0x43, 0x2A, 0x4C,
+    0x5F, 0x32, 0x4C, 0x2A, 0x49, 0x5F, 0x32, 0x49, 0x2A, 0x43, 0x5F, 0x32,
+    0x43, 0x2A, 0x4B, 0x5F, 0x32, 0x4B, 0x2A, 0x49, 0x5F, 0x32, 0x49, 0x2A,
+    0x4E, 0x5F, 0x32, 0x4E, 0x2A, 0x47, 0x5F, 0x32, 0x47, 0x2A, 0x20, 0x5F,
+    0x32, 0x20, 0x2A, 0x54, 0x5F, 0x32, 0x54, 0x2A, 0x48, 0x5F, 0x32, 0x48,
+    0x2A, 0x45, 0x5F, 0x32, 0x45, 0x2A, 0x20, 0x5F, 0x32, 0x20, 0x2A, 0x4D,
+    0x5F, 0x32, 0x4D, 0x2A, 0x49, 0x5F, 0x32, 0x49, 0x2A, 0x44, 0x5F, 0x32,
+    0x44, 0x2A, 0x44, 0x5F, 0x32, 0x44, 0x2A, 0x4C, 0x5F, 0x32, 0x4C, 0x2A,
+    0x45, 0x5F, 0x32, 0x45, 0x2A, 0x20, 0x5F, 0x32, 0x20, 0x2A, 0x4F, 0x5F,
+    0x32, 0x4F, 0x2A, 0x46, 0x5F, 0x32, 0x46, 0x2A, 0x20, 0x5F, 0x32, 0x20,
+    0x2A, 0x54, 0x5F, 0x32, 0x54, 0x2A, 0x48, 0x5F, 0x32, 0x48, 0x2A, 0x45,
+    0x5F, 0x32, 0x45, 0x2A, 0x20, 0x5F, 0x32, 0x20, 0x2A, 0x53, 0x5F, 0x32,
+    0x53, 0x2A, 0x43, 0x5F, 0x32, 0x43, 0x2A, 0x52, 0x5F, 0x32, 0x52, 0x2A,
+    0x45, 0x5F, 0x32, 0x45, 0x2A, 0x45, 0x5F, 0x32, 0x45, 0x2A, 0x4E, 0x5F,
+    0x32, 0x4E, 0x2A, 0xBE, 0x5F, 0x32, 0xBE, 0x2A, 0xBE, 0x5F, 0x32, 0xBE,
+    0x2A, 0xBE, 0x5F, 0x32, 0xBE, 0x9E, 0xC0, 0x07, 0x9C, 0x04, 0x74, 0x00,
+    0x7F, 0x32, 0x01, 0x3F, 0xC0, 0x02, 0x1B, 0x5F, 0x32, 0x1B, 0x3E, 0xA2,
+    0x2A, 0x41, 0x5F, 0x32, 0x41, 0x4A, 0xA2, 0x3E, 0xA2, 0x2A, 0x43, 0x5F,
+    0x32, 0x43, 0x4A, 0xA2, 0x1E,
+};
+
+const EventProgram GREETING = {GREETING_STEPS, sizeof(GREETING_STEPS), true};
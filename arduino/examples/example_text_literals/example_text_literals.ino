@@ -0,0 +1,41 @@
+/**
+ * @file example_text_literals.ino
+ * @brief Typing fixed strings with compile-time encoded key events
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ * 
+ * SIM_TEXT() turns a string literal into key events while compiling,
+ * so typeText() only streams bytes from flash at runtime.
+ * 
+ * Features:
+ * - Compile-time character to virtual key conversion
+ * - Shift coalescing for runs of uppercase/symbol characters
+ * - Types the same keys as the runtime typeText() overload, with the
+ *   same Shift state; the lines differ, since runs of shifted
+ *   characters share one Shift press and release
+ * 
+ * Requires C++14 or later (on AVR add -std=gnu++17 to the build flags).
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+
+SerialInputMonitor monitor;
+
+void setup() {
+  Serial.begin(9600);
+  
+  delay(2000);
+  
+  Serial.println("# Compile-time text example");
+}
+
+void loop() {
+  Serial.println("# Login sequence");
+  
+  monitor.typeText(SIM_TEXT("admin"));
+  monitor.tapKey(VirtualKey::TAB);
+  monitor.typeTextLine(SIM_TEXT("P@SSWORD"));
+  
+  delay(5000);
+}
@@ -0,0 +1,120 @@
+/**
+ * @file example_text_window.ino
+ * @brief Typing a small vocabulary as compressed text lines
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ *
+ * A help desk macro pad types the same user names, SKU prefixes and
+ * canned replies over and over. With a text window attached, each
+ * typeTextLine() goes out as one text line, and any stretch typed
+ * before as a two-byte back-reference.
+ *
+ * Features:
+ * - 150 entries "user: SKU-PREFIX-NNNN reply" typed as key events, then
+ *   again through a 128, 256 and 512 byte window
+ * - "# window N" before each pass, "# stats N CHARACTERS PAYLOAD BYTES COMPARES" after it
+ * - "# done" every second once all passes are sent
+ *
+ * The three windows take 896 bytes of RAM together, more than an Uno
+ * can spare next to the rest: on a board, keep the one you need.
+ *
+ * Compare the passes in the simulator with host/sim/bench_text.py.
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+
+const uint16_t ENTRIES = 150;
+
+const char *const USERS[] = {"jsmith", "mgarcia", "ops-admin", "lchen", "warehouse2"};
+const char *const SKUS[]  = {"SKU-ACME-", "SKU-ACME-XL-", "SKU-GLOBEX-", "SKU-INITECH-"};
+const char *const REPLIES[] = {
+    "Thanks for reaching out! Your order has shipped.",
+    "Thanks for reaching out! We are looking into it.",
+    "Your refund has been processed.",
+    "Please confirm your shipping address.",
+};
+
+SerialInputMonitor     monitor;
+TextWindowBuffer<128>  window128;
+TextWindowBuffer<256>  window256;
+TextWindowBuffer<512>  window512;
+TextWindow *const      WINDOWS[] = {nullptr, &window128, &window256, &window512};
+const uint16_t         SIZES[]   = {0, 128, 256, 512};
+
+uint8_t       pass  = 0;
+uint16_t      entry = 0;
+unsigned long lastDoneMs = 0;
+
+char *append(char *out, const char *text) {
+  while (*text) {
+    *out++ = *text++;
+  }
+  return out;
+}
+
+/**
+ * Entry n: a user, a SKU with a 4-digit number and a reply, picked by a
+ * fixed pseudo-random sequence so every pass types the same text
+ */
+void composeEntry(uint16_t n, char *line) {
+  uint16_t pick = static_cast<uint16_t>(n * 7919UL % 1021);
+  char *out = append(line, USERS[pick % 5]);
+  out = append(out, ": ");
+  out = append(out, SKUS[pick / 5 % 4]);
+  uint16_t number = static_cast<uint16_t>(n * 37UL % 10000);
+  for (uint16_t digit = 1000; digit > 0; digit /= 10) {
+    *out++ = static_cast<char>('0' + number / digit % 10);
+  }
+  *out++ = ' ';
+  out = append(out, REPLIES[pick / 20 % 4]);
+  *out = '\0';
+}
+
+void printStats() {
+  Serial.print("# stats ");
+  Serial.print(SIZES[pass]);
+  if (WINDOWS[pass]) {
+    const TextStats &stats = WINDOWS[pass]->stats();
+    Serial.print(' ');
+    Serial.print(stats.characters);
+    Serial.print(' ');
+    Serial.print(stats.payload);
+    Serial.print(' ');
+    Serial.print(stats.bytes);
+    Serial.print(' ');
+    Serial.print(stats.compares);
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(115200);
+  delay(2000);
+
+  Serial.println("# Text window example");
+  Serial.println("# window 0");
+}
+
+void loop() {
+  if (pass < 4) {
+    char line[96];
+    composeEntry(entry, line);
+    monitor.typeTextLine(line);
+    monitor.delay(100);
+
+    if (++entry == ENTRIES) {
+      printStats();
+      entry = 0;
+      pass++;
+      if (pass < 4) {
+        monitor.attachTextWindow(WINDOWS[pass]);
+        Serial.print("# window ");
+        Serial.println(SIZES[pass]);
+      }
+    }
+  } else if (millis() - lastDoneMs >= 1000) {
+    lastDoneMs = millis();
+    Serial.println("# done");
+  }
+}
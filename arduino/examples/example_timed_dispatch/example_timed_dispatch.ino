@@ -0,0 +1,64 @@
+/**
+ * @file example_timed_dispatch.ino
+ * @brief Precisely timed key taps from a timer interrupt, next to a busy loop()
+ * @author Leonardo Klein
+ * @date 2025-09-05
+ * 
+ * loop() spends a random 0-30 ms on other work between iterations. Taps
+ * sent from loop() would start whenever that work ends; the dispatcher
+ * sends each press and release from the Timer1 interrupt at the time it
+ * was scheduled for instead.
+ * 
+ * Features:
+ * - One tap every 100 ms, held for 30 ms, independent of loop() timing
+ * - Worst lateness of the interrupt reported as a comment every 5 s
+ * 
+ * Uses Timer1 (no Servo, tone() or PWM on pins 9 and 10).
+ * SerialInputMonitor library REQUIRED for this example.
+ */
+
+#include "SerialInputMonitor.h"
+#include "SerialInputTimer.h"
+
+SerialInputMonitor monitor;
+TimedDispatcher<SerialInputMonitor, DispatchTimer> dispatcher(monitor);
+SIM_DISPATCH_ISR(dispatcher)
+
+uint32_t nextTapUs;
+unsigned long lastReportMs;
+
+void setup() {
+  Serial.begin(115200);
+  dispatcher.begin();
+
+  delay(2000);
+
+  Serial.println("# Timed dispatch example");
+  nextTapUs = micros() + 100000UL;
+  lastReportMs = millis();
+}
+
+void loop() {
+  // Keep two taps queued ahead
+  while (static_cast<int32_t>(nextTapUs - micros()) < 200000L && dispatcher.pending() <= 2) {
+    dispatcher.scheduleKey(nextTapUs, VirtualKey::SPACE, true);
+    dispatcher.scheduleKey(nextTapUs + 30000UL, VirtualKey::SPACE, false);
+    nextTapUs += 100000UL;
+  }
+
+  // Other work that would delay taps sent from here
+  unsigned long busyUntil = micros() + random(0, 30000);
+  while (static_cast<long>(micros() - busyUntil) < 0) {
+  }
+
+  if (millis() - lastReportMs >= 5000) {
+    lastReportMs = millis();
+    uint32_t lateness = dispatcher.maxLatenessUs();
+    dispatcher.resetStats();
+
+    noInterrupts();
+    Serial.print("# max lateness us: ");
+    Serial.println(lateness);
+    interrupts();
+  }
+}
@@ -0,0 +1,322 @@
+/**
+ * @file BenchDmaTx.cpp
+ * @brief DMA double buffer against Serial's byte ring on a simulated UART
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-dma-tx [LINES]
+ *
+ * Writes LINES event lines through DmaTx (SerialInputDma.h) to an
+ * engine that sends one byte per tick of a virtual clock, as a UART
+ * fed by DMA would, with a random completion latency of 0-3 byte
+ * times. The engine reads each buffer only
+ * when its transfer completes, so a buffer touched while in flight
+ * shows up as damaged output; the output must equal the lines written,
+ * in order. Lines are produced at a fixed share of the link's rate
+ * (load); above 1 the writer has to wait.
+ *
+ * The same lines go through a model of Serial: a 64-byte ring emptied
+ * by one interrupt per byte. For each, the table gives the interrupts
+ * per line (transfer completions for DMA), the bytes per transfer, how
+ * busy the link was while lines kept coming, the writes that had to
+ * wait, and the host CPU time per line of the write path alone
+ * (encoding excluded), with a transfer or interrupt handler that
+ * completes at once.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "SerialInputDma.h"
+
+namespace {
+
+const size_t SERIAL_RING = 64; ///< Serial's transmit ring, as on the Uno
+
+uint64_t    g_now;        ///< Virtual clock, in byte times
+uint64_t    g_random = 1; ///< xorshift state
+std::string g_output;     ///< Bytes as the host received them
+
+// Transfer in flight
+const uint8_t *g_data   = nullptr;
+uint16_t       g_length = 0;
+uint64_t       g_doneAt = 0; ///< Tick at which it completes
+
+uint64_t nextRandom() {
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 7;
+    g_random ^= g_random << 17;
+    return g_random;
+}
+
+/**
+ * @brief Read the buffer of a transfer once it has completed
+ */
+void complete() {
+    if (g_data != nullptr && g_now >= g_doneAt) {
+        g_output.append(reinterpret_cast<const char *>(g_data), g_length);
+        g_data = nullptr;
+    }
+}
+
+void uartStart(const uint8_t *data, uint16_t length) {
+    complete();
+    if (g_data != nullptr) {
+        fprintf(stderr, "transfer started while busy\n");
+        exit(1);
+    }
+    g_data   = data;
+    g_length = length;
+    g_doneAt = g_now + length + nextRandom() % 4;
+}
+
+bool uartBusy() {
+    complete();
+    return g_data != nullptr;
+}
+
+void uartWait() {
+    if (g_data != nullptr && g_now < g_doneAt) {
+        g_now = g_doneAt;
+    }
+    complete();
+}
+
+const TxDmaEngine UART_DMA = {uartStart, uartBusy, uartWait};
+
+// The same engine without a clock: transfers complete at once
+void instantStart(const uint8_t *data, uint16_t length) {
+    g_random += data[length - 1];
+}
+
+bool instantBusy() {
+    return false;
+}
+
+void instantWait() {
+}
+
+const TxDmaEngine INSTANT_DMA = {instantStart, instantBusy, instantWait};
+
+/**
+ * @brief Model of Serial: a byte ring emptied by one interrupt per byte
+ */
+struct SerialModel {
+    uint8_t  ring[SERIAL_RING];
+    size_t   head       = 0;
+    size_t   count      = 0;
+    uint64_t interrupts = 0;
+    uint64_t lastTick   = 0; ///< Clock at the last interrupt
+    uint64_t stalls     = 0; ///< Writes that found the ring full
+
+    /**
+     * @brief The TX-empty interrupt: one byte to the UART
+     */
+    void interrupt() {
+        g_output.push_back(static_cast<char>(ring[head]));
+        head = (head + 1) % SERIAL_RING;
+        count--;
+        interrupts++;
+    }
+
+    /**
+     * @brief Run the interrupts due by the virtual clock
+     */
+    void catchUp() {
+        while (count > 0 && lastTick < g_now) {
+            lastTick++;
+            interrupt();
+        }
+        if (count == 0) {
+            lastTick = g_now;
+        }
+    }
+
+    void write(const uint8_t *data, size_t length, bool clocked) {
+        bool stalled = false;
+        for (size_t i = 0; i < length; i++) {
+            if (clocked) {
+                catchUp();
+                if (count == SERIAL_RING) {
+                    stalled = true;
+                    g_now++;
+                    catchUp();
+                }
+            } else if (count == SERIAL_RING) {
+                interrupt();
+            }
+            ring[(head + count) % SERIAL_RING] = data[i];
+            count++;
+        }
+        stalls += stalled ? 1 : 0;
+    }
+
+    void flush(bool clocked) {
+        while (count > 0) {
+            if (clocked) {
+                g_now++;
+                catchUp();
+            } else {
+                interrupt();
+            }
+        }
+    }
+};
+
+/**
+ * @brief Event lines of varied length, numbered so any reordering shows
+ */
+std::vector<std::string> makeLines(uint32_t count) {
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    char text[48];
+    for (uint32_t i = 0; i < count; i++) {
+        int i7 = static_cast<int>(i % 7) - 3;
+        int i5 = static_cast<int>(i % 5);
+        switch (i % 4) {
+            case 0: snprintf(text, sizeof(text), "0 8 %d %d\n", i7, i5); break;
+            case 1: snprintf(text, sizeof(text), "0 7 %u %u\n", i % 1920, (i / 3) % 1080); break;
+            case 2: snprintf(text, sizeof(text), "1 0 %u @%lX\n", 65 + i % 26, i * 997UL); break;
+            default: snprintf(text, sizeof(text), "1 1 %u\n", 65 + i % 26); break;
+        }
+        lines.push_back(text);
+    }
+    return lines;
+}
+
+struct Result {
+    double   interruptsPerLine;
+    double   bytesPerTransfer;
+    double   linkBusy;  ///< Share of the ticks until the last line was written that the link was sending
+    uint64_t waits;     ///< Writes that had to wait for the link
+    double   nsPerLine; ///< Host CPU time of the write path
+    bool     ok;
+};
+
+/**
+ * @brief Bytes the link had sent by the time the last line was written, over the ticks that took
+ */
+double linkBusy(size_t expectedBytes, size_t unsent, uint64_t ticks) {
+    return ticks > 0 ? static_cast<double>(expectedBytes - unsent) / ticks : 0.0;
+}
+
+/**
+ * @brief Advance the clock to when the next line is due
+ * @param dueMilli Due tick of the last line, in thousandths of a byte time; updated
+ * @param length Length of the next line
+ * @param load Share of the link's rate the lines are produced at
+ */
+void produceAt(uint64_t &dueMilli, size_t length, double load) {
+    dueMilli += static_cast<uint64_t>(length * 1000 / load);
+    uint64_t due = dueMilli / 1000;
+    g_now        = due > g_now ? due : g_now;
+}
+
+template <uint16_t Size>
+Result runDma(const std::vector<std::string> &lines, const std::string &expected, double load) {
+    static DmaTxBuffer<Size> tx(UART_DMA);
+    Result                   result = {0, 0, 0, 0, 0, true};
+
+    g_now = 0;
+    g_output.clear();
+    tx.resetStats();
+    uint64_t dueMilli = 0;
+    for (const std::string &line : lines) {
+        produceAt(dueMilli, line.size(), load);
+        tx.write(reinterpret_cast<const uint8_t *>(line.data()), static_cast<uint16_t>(line.size()));
+    }
+    result.linkBusy = linkBusy(expected.size(), tx.pending(), g_now);
+    tx.flush();
+
+    const DmaTxStats &stats  = tx.stats();
+    result.interruptsPerLine = static_cast<double>(stats.transfers) / lines.size();
+    result.bytesPerTransfer  = static_cast<double>(stats.bytes) / stats.transfers;
+    result.waits             = stats.waits;
+    result.ok                = g_output == expected && stats.lines == lines.size();
+
+    // Write path alone
+    static DmaTxBuffer<Size> instant(INSTANT_DMA);
+    auto                     start = std::chrono::steady_clock::now();
+    for (const std::string &line : lines) {
+        instant.write(reinterpret_cast<const uint8_t *>(line.data()), static_cast<uint16_t>(line.size()));
+    }
+    result.nsPerLine = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 /
+                       lines.size();
+    return result;
+}
+
+Result runSerial(const std::vector<std::string> &lines, const std::string &expected, double load) {
+    SerialModel serial;
+    Result      result = {0, 0, 0, 0, 0, true};
+
+    g_now = 0;
+    g_output.clear();
+    uint64_t dueMilli = 0;
+    for (const std::string &line : lines) {
+        produceAt(dueMilli, line.size(), load);
+        serial.write(reinterpret_cast<const uint8_t *>(line.data()), line.size(), true);
+    }
+    result.linkBusy = linkBusy(expected.size(), serial.count, g_now);
+    serial.flush(true);
+
+    result.interruptsPerLine = static_cast<double>(serial.interrupts) / lines.size();
+    result.bytesPerTransfer  = 1;
+    result.waits             = serial.stalls;
+    result.ok                = g_output == expected;
+
+    SerialModel instant;
+    g_output.clear();
+    g_output.reserve(expected.size());
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string &line : lines) {
+        instant.write(reinterpret_cast<const uint8_t *>(line.data()), line.size(), false);
+    }
+    instant.flush(false);
+    result.nsPerLine = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 /
+                       lines.size();
+    return result;
+}
+
+void report(const char *label, double load, const Result &result) {
+    printf("%-10s %5.2f %10.3f %10.1f %8.1f%% %8llu %8.1f ns  %s\n", label, load, result.interruptsPerLine,
+           result.bytesPerTransfer, 100.0 * result.linkBusy, static_cast<unsigned long long>(result.waits),
+           result.nsPerLine,
+           result.ok ? "ok" : "FAILED");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long count = argc > 1 ? atol(argv[1]) : 1000000;
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [LINES]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> lines = makeLines(static_cast<uint32_t>(count));
+    std::string              expected;
+    for (const std::string &line : lines) {
+        expected += line;
+    }
+    printf("%ld lines, %.1f bytes/line\n", count, static_cast<double>(expected.size()) / count);
+    printf("%-10s %5s %10s %10s %9s %8s %11s\n", "path", "load", "irq/line", "B/transfer", "link busy", "waits",
+           "write");
+
+    bool         ok      = true;
+    const double LOADS[] = {0.25, 0.9, 1.5};
+    for (double load : LOADS) {
+        Result serial = runSerial(lines, expected, load);
+        report("serial", load, serial);
+        Result dma128 = runDma<128>(lines, expected, load);
+        report("dma 2x128", load, dma128);
+        Result dma512 = runDma<512>(lines, expected, load);
+        report("dma 2x512", load, dma512);
+        ok = ok && serial.ok && dma128.ok && dma512.ok;
+    }
+    return ok ? 0 : 1;
+}
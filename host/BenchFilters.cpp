@@ -0,0 +1,320 @@
+/**
+ * @file BenchFilters.cpp
+ * @brief Filter stages of SerialInputFilters.h: behaviour checks and cost per event
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-filters [EVENTS]
+ *
+ * Checks each stage on hand-made event sequences:
+ *
+ *   Remap       mapped keys rewritten, others and mouse events unchanged
+ *   Block       listed keys dropped, in a pipeline that lists it twice
+ *   BlockCombo  the key dropped while the modifier is held, and its
+ *               release with it even after the modifier went up
+ *   Suppress    every event of the class dropped, nothing else
+ *   RateLimit   one scroll or motion per interval, the dropped deltas
+ *               added to the next one that passes, a dropped position
+ *               kept, what is held released once the interval expires,
+ *               also through the stages after it, presses and releases
+ *               never dropped, carries beyond int not lost
+ *   Transform   the function's rewrite and drops
+ *   Pipeline<>  an empty class that adds no storage to a monitor
+ *
+ * then runs EVENTS mixed events (moves, positions, scrolls, buttons,
+ * keys) through each stage alone and through a pipeline of all of them,
+ * with a virtual millis() advancing 1 ms every 4 events, and prints ns
+ * per event. Each run goes through a noinline runStage<Stage>(), so
+ * `nm -C -S bench-filters | grep runStage` gives the host code size of
+ * every stage. The exit status is 1 if a check fails.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <type_traits>
+#include <vector>
+
+#include "SerialInputFilters.h"
+
+namespace {
+
+unsigned long g_now; ///< Virtual millis()
+
+} // namespace
+
+unsigned long millis() {
+    return g_now;
+}
+
+namespace {
+
+typedef KeyTable<KeyMapping<VirtualKey::Y, VirtualKey::Z>, KeyMapping<VirtualKey::Z, VirtualKey::Y> > SwapYZ;
+
+bool doubleMoves(InputEvent &event) {
+    if (event.device == Device::MOUSE && event.event == static_cast<uint8_t>(MouseEvent::MOVE)) {
+        event.param1 *= 2;
+        event.param2 *= 2;
+    }
+    return !(event.device == Device::MOUSE && event.event == static_cast<uint8_t>(MouseEvent::MIDDLE_PRESS));
+}
+
+typedef Remap<SwapYZ>                                       RemapStage;
+typedef Block<VirtualKey::LEFT_WIN, VirtualKey::RIGHT_WIN>  BlockStage;
+typedef BlockCombo<VirtualKey::LEFT_ALT, VirtualKey::F4>    BlockComboStage;
+typedef Suppress<Scroll>                                    SuppressStage;
+typedef RateLimit<Scroll, 50>                               RateLimitStage;
+typedef RateLimit<Motion, 8>                                MotionLimitStage;
+typedef RateLimit<AnyEvent, 50>                             AnyLimitStage;
+typedef Transform<doubleMoves>                              TransformStage;
+typedef Pipeline<RemapStage, BlockStage, BlockComboStage, SuppressStage, MotionLimitStage, TransformStage> AllStages;
+
+// Empty stages and pipelines, the default one included, add nothing to a monitor
+static_assert(std::is_empty<Pipeline<> >::value, "Pipeline<> must be empty");
+static_assert(std::is_empty<Pipeline<BlockStage, BlockStage> >::value, "a pipeline of empty stages must be empty");
+static_assert(sizeof(BasicSerialInputMonitor<Pipeline<> >) ==
+                  sizeof(BasicSerialInputMonitor<Pipeline<RemapStage, BlockStage, BlockStage> >),
+              "empty stages must not grow the monitor");
+
+InputEvent key(bool press, VirtualKey code) {
+    InputEvent event = {Device::KEYBOARD, static_cast<uint8_t>(press ? KeyboardEvent::PRESS : KeyboardEvent::RELEASE),
+                        static_cast<int>(code), 0};
+    return event;
+}
+
+InputEvent mouse(MouseEvent code, int param1 = 0, int param2 = 0) {
+    InputEvent event = {Device::MOUSE, static_cast<uint8_t>(code), param1, param2};
+    return event;
+}
+
+bool same(const InputEvent &a, const InputEvent &b) {
+    return a.device == b.device && a.event == b.event && a.param1 == b.param1 && a.param2 == b.param2;
+}
+
+struct Expect {
+    unsigned long time;    ///< millis() when applied
+    bool          release; ///< Ask for a held event instead of applying one
+    InputEvent    in;      ///< Event given to the stage
+    bool          passes;  ///< apply() or release() must return this
+    InputEvent    out;     ///< and leave this event when it does
+};
+
+Expect keep(unsigned long time, const InputEvent &event) {
+    Expect expect = {time, false, event, true, event};
+    return expect;
+}
+
+Expect drop(unsigned long time, const InputEvent &event) {
+    Expect expect = {time, false, event, false, event};
+    return expect;
+}
+
+Expect change(unsigned long time, const InputEvent &in, const InputEvent &out) {
+    Expect expect = {time, false, in, true, out};
+    return expect;
+}
+
+Expect released(unsigned long time, const InputEvent &out) {
+    Expect expect = {time, true, out, true, out};
+    return expect;
+}
+
+Expect nothingHeld(unsigned long time) {
+    Expect expect = {time, true, InputEvent(), false, InputEvent()};
+    return expect;
+}
+
+/**
+ * @brief One held event of a stage, or of a pipeline after its later stages
+ */
+template <typename Stage> bool releaseOne(Stage &stage, InputEvent &event) {
+    return StageRelease<Stage>::release(stage, event);
+}
+
+template <typename... Stages> bool releaseOne(Pipeline<Stages...> &pipeline, InputEvent &event) {
+    bool any = false;
+    pipeline.release([&](const InputEvent &held) {
+        if (!any) {
+            event = held;
+        }
+        any = true;
+    });
+    return any;
+}
+
+template <typename Stage> bool check(const char *name, const std::vector<Expect> &sequence) {
+    Stage  stage;
+    size_t failed = sequence.size();
+    for (size_t i = 0; i < sequence.size() && failed == sequence.size(); i++) {
+        g_now             = sequence[i].time;
+        InputEvent event  = sequence[i].in;
+        bool       passes = sequence[i].release ? releaseOne(stage, event) : stage.apply(event);
+        if (passes != sequence[i].passes || (passes && !same(event, sequence[i].out))) {
+            failed = i;
+        }
+    }
+    bool ok = failed == sequence.size();
+    printf("%-12s %2zu events  %s", name, sequence.size(), ok ? "ok" : "FAILED");
+    if (!ok) {
+        printf(" at event %zu", failed);
+    }
+    printf("\n");
+    return ok;
+}
+
+bool runChecks() {
+    bool ok = true;
+    ok      = check<RemapStage>("Remap", {change(0, key(true, VirtualKey::Y), key(true, VirtualKey::Z)),
+                                          change(0, key(false, VirtualKey::Z), key(false, VirtualKey::Y)),
+                                          keep(0, key(true, VirtualKey::A)),
+                                          keep(0, mouse(MouseEvent::MOVE, 89, 90))}) &&
+         ok;
+    ok = check<Pipeline<BlockStage, BlockStage> >("Block", {drop(0, key(true, VirtualKey::LEFT_WIN)),
+                                                            drop(0, key(false, VirtualKey::LEFT_WIN)),
+                                                            drop(0, key(true, VirtualKey::RIGHT_WIN)),
+                                                            keep(0, key(true, VirtualKey::A)),
+                                                            keep(0, mouse(MouseEvent::POSITION, 0x5B, 0x5C))}) &&
+         ok;
+    ok = check<BlockComboStage>("BlockCombo", {keep(0, key(true, VirtualKey::F4)), keep(0, key(false, VirtualKey::F4)),
+                                               keep(0, key(true, VirtualKey::LEFT_ALT)),
+                                               drop(0, key(true, VirtualKey::F4)),
+                                               keep(0, key(false, VirtualKey::LEFT_ALT)),
+                                               drop(0, key(false, VirtualKey::F4)),
+                                               keep(0, key(true, VirtualKey::F4))}) &&
+         ok;
+    ok = check<SuppressStage>("Suppress", {drop(0, mouse(MouseEvent::SCROLL, 3)),
+                                           keep(0, mouse(MouseEvent::MOVE, 1, 1)),
+                                           keep(0, mouse(MouseEvent::LEFT_PRESS)), keep(0, key(true, VirtualKey::A))}) &&
+         ok;
+    ok = check<RateLimitStage>("RateLimit", {keep(0, mouse(MouseEvent::SCROLL, 1)), drop(10, mouse(MouseEvent::SCROLL, 2)),
+                                             drop(20, mouse(MouseEvent::SCROLL, -1)),
+                                             keep(30, mouse(MouseEvent::MOVE, 5, 5)),
+                                             change(60, mouse(MouseEvent::SCROLL, 4), mouse(MouseEvent::SCROLL, 5)),
+                                             drop(70, mouse(MouseEvent::SCROLL, 7)),
+                                             change(200, mouse(MouseEvent::SCROLL, 0), mouse(MouseEvent::SCROLL, 7)),
+                                             nothingHeld(210), drop(220, mouse(MouseEvent::SCROLL, 3)),
+                                             nothingHeld(240), released(250, mouse(MouseEvent::SCROLL, 3)),
+                                             nothingHeld(400)}) &&
+         ok;
+    ok = check<MotionLimitStage>("RateLimit/m", {keep(0, mouse(MouseEvent::MOVE, 1, 2)),
+                                                 drop(1, mouse(MouseEvent::MOVE, 3, 4)),
+                                                 change(8, mouse(MouseEvent::MOVE, 5, 6), mouse(MouseEvent::MOVE, 8, 10)),
+                                                 drop(9, mouse(MouseEvent::MOVE, 7, 7)),
+                                                 keep(16, mouse(MouseEvent::POSITION, 100, 100)),
+                                                 keep(24, mouse(MouseEvent::MOVE, 1, 1)),
+                                                 drop(25, mouse(MouseEvent::POSITION, 300, 300)),
+                                                 drop(26, mouse(MouseEvent::MOVE, 2, 3)),
+                                                 change(32, mouse(MouseEvent::MOVE, 1, 1),
+                                                        mouse(MouseEvent::POSITION, 303, 304)),
+                                                 drop(33, mouse(MouseEvent::MOVE, 9, 9)),
+                                                 drop(34, mouse(MouseEvent::POSITION, 500, 500)),
+                                                 nothingHeld(39), released(40, mouse(MouseEvent::POSITION, 500, 500)),
+                                                 keep(60, mouse(MouseEvent::MOVE, 1, 0)),
+                                                 drop(61, mouse(MouseEvent::MOVE, 4, -4)),
+                                                 released(68, mouse(MouseEvent::MOVE, 4, -4))}) &&
+         ok;
+    ok = check<AnyLimitStage>("RateLimit/a", {keep(0, key(true, VirtualKey::A)), keep(20, key(false, VirtualKey::A)),
+                                              keep(21, mouse(MouseEvent::LEFT_PRESS)),
+                                              keep(22, mouse(MouseEvent::LEFT_RELEASE)),
+                                              keep(23, mouse(MouseEvent::SCROLL, 1)),
+                                              drop(30, mouse(MouseEvent::SCROLL, 2)),
+                                              keep(31, key(true, VirtualKey::B)), keep(32, key(false, VirtualKey::B)),
+                                              released(73, mouse(MouseEvent::SCROLL, 2))}) &&
+         ok;
+    ok = check<MotionLimitStage>("RateLimit/o", {keep(0, mouse(MouseEvent::MOVE, 0, 0)),
+                                                 drop(1, mouse(MouseEvent::MOVE, INT_MAX, 0)),
+                                                 drop(2, mouse(MouseEvent::MOVE, INT_MAX, -1)),
+                                                 released(8, mouse(MouseEvent::MOVE, INT_MAX, -1)),
+                                                 nothingHeld(9), released(16, mouse(MouseEvent::MOVE, INT_MAX, 0)),
+                                                 nothingHeld(24)}) &&
+         ok;
+    ok = check<Pipeline<MotionLimitStage, TransformStage> >(
+             "RateLimit/p", {change(0, mouse(MouseEvent::MOVE, 1, 1), mouse(MouseEvent::MOVE, 2, 2)),
+                             drop(1, mouse(MouseEvent::MOVE, 3, 4)),
+                             released(8, mouse(MouseEvent::MOVE, 6, 8))}) &&
+         ok;
+    ok = check<TransformStage>("Transform", {change(0, mouse(MouseEvent::MOVE, 3, -4), mouse(MouseEvent::MOVE, 6, -8)),
+                                             drop(0, mouse(MouseEvent::MIDDLE_PRESS)),
+                                             keep(0, mouse(MouseEvent::MIDDLE_RELEASE)),
+                                             keep(0, key(true, VirtualKey::A))}) &&
+         ok;
+    ok = check<Pipeline<> >("Pipeline<>", {keep(0, key(true, VirtualKey::Y)), keep(0, mouse(MouseEvent::SCROLL, 1))}) &&
+         ok;
+    return ok;
+}
+
+/**
+ * @brief A mixed event stream
+ */
+std::vector<InputEvent> makeEvents(long count) {
+    static const VirtualKey KEYS[] = {VirtualKey::A,        VirtualKey::Y,        VirtualKey::Z, VirtualKey::F4,
+                                      VirtualKey::LEFT_ALT, VirtualKey::LEFT_WIN, VirtualKey::SPACE};
+    std::vector<InputEvent> events;
+    events.reserve(count);
+    uint32_t state = 1;
+    for (long i = 0; i < count; i++) {
+        state          = state * 1103515245u + 12345u;
+        uint32_t value = state >> 8;
+        switch (value % 10) {
+            case 0:
+            case 1:
+            case 2:
+            case 3: events.push_back(mouse(MouseEvent::MOVE, value % 7 - 3, value % 5 - 2)); break;
+            case 4: events.push_back(mouse(MouseEvent::POSITION, value % 1920, value % 1080)); break;
+            case 5: events.push_back(mouse(MouseEvent::SCROLL, value % 2 ? 1 : -1)); break;
+            case 6: events.push_back(mouse(static_cast<MouseEvent>(value % 6))); break;
+            default: events.push_back(key(value % 2 == 0, KEYS[value / 2 % 7])); break;
+        }
+    }
+    return events;
+}
+
+template <typename Stage> __attribute__((noinline)) bool runStage(Stage &stage, InputEvent &event) {
+    return stage.apply(event);
+}
+
+template <typename Stage> void bench(const char *name, const std::vector<InputEvent> &events) {
+    Stage   stage;
+    size_t  passed = 0;
+    int64_t sum    = 0;
+    g_now          = 0;
+    auto start     = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < events.size(); i++) {
+        g_now            = i / 4;
+        InputEvent event = events[i];
+        if (runStage(stage, event)) {
+            passed++;
+            sum += event.param1;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%-12s %8.2f ns/event  %5.1f%% passed  (sum %lld)\n", name, seconds * 1e9 / events.size(),
+           100.0 * passed / events.size(), static_cast<long long>(sum));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long count = argc > 1 ? atol(argv[1]) : 10000000;
+    if (count <= 0) {
+        fprintf(stderr, "Usage: %s [EVENTS]\n", argv[0]);
+        return 2;
+    }
+
+    bool ok = runChecks();
+
+    std::vector<InputEvent> events = makeEvents(count);
+    printf("%ld events\n", count);
+    bench<Pipeline<> >("Pipeline<>", events);
+    bench<RemapStage>("Remap", events);
+    bench<BlockStage>("Block", events);
+    bench<BlockComboStage>("BlockCombo", events);
+    bench<SuppressStage>("Suppress", events);
+    bench<RateLimitStage>("RateLimit", events);
+    bench<TransformStage>("Transform", events);
+    bench<AllStages>("all six", events);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file BenchKeyNames.cpp
+ * @brief Key name lookups: perfect hash and offset table vs linear strcmp scans
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-key-names [ROUNDS]
+ *
+ * Looks up every VirtualKey name (hits) and its lowercase spelling
+ * (misses) ROUNDS times each way:
+ *
+ *   hash    keyFromName()
+ *   scan    strcmp() against every name of the blob until one matches
+ *
+ * and every code 0-255 with keyName() against a scan for the first name
+ * with that code. Besides ns/lookup it counts the name bytes read per
+ * lookup from the tables (flash on an AVR), which bounds both there;
+ * the bytes are counted in a first, untimed pass.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "SerialInputKeyNames.h"
+
+namespace {
+
+struct Entry {
+    const char *name;
+    VirtualKey  key;
+};
+
+std::vector<Entry> g_entries;  ///< Names in enum order, for the scans
+size_t             g_bytes;    ///< Name bytes read by the last lookups
+bool               g_counting; ///< Count bytes instead of timing
+
+/**
+ * @brief strcmp(), counting the characters it reads from the stored name when g_counting
+ */
+int countedCompare(const char *stored, const char *name) {
+    if (!g_counting) {
+        return strcmp(stored, name);
+    }
+    size_t i = 0;
+    while (stored[i] != '\0' && stored[i] == name[i]) {
+        i++;
+    }
+    g_bytes += i + 1;
+    return static_cast<unsigned char>(stored[i]) - static_cast<unsigned char>(name[i]);
+}
+
+bool scanName(const char *name, VirtualKey &key) {
+    for (const Entry &entry : g_entries) {
+        if (countedCompare(entry.name, name) == 0) {
+            key = entry.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool hashName(const char *name, VirtualKey &key) {
+    // Seed, slot offset and code, then at most the stored name
+    size_t length = strlen(name);
+    g_bytes += g_counting ? 4 + length + 1 : 0;
+    return keyFromName(name, length, key);
+}
+
+const char *scanCode(VirtualKey key) {
+    for (const Entry &entry : g_entries) {
+        g_bytes += g_counting ? 1 : 0;
+        if (entry.key == key) {
+            return entry.name;
+        }
+    }
+    return nullptr;
+}
+
+const char *tableCode(VirtualKey key) {
+    g_bytes += g_counting ? 2 : 0;
+    return keyName(key);
+}
+
+/**
+ * @brief Time ROUNDS passes of a lookup over the inputs
+ * @return ns per lookup; g_bytes holds the bytes read in one pass
+ */
+template <typename Input, typename Lookup>
+double timeLookups(const std::vector<Input> &inputs, int rounds, Lookup &&lookup, size_t &found) {
+    found      = 0;
+    g_bytes    = 0;
+    g_counting = true;
+    for (const Input &input : inputs) {
+        found += lookup(input) ? 1 : 0;
+    }
+    g_counting = false;
+
+    volatile size_t sink  = 0;
+    auto            start = std::chrono::steady_clock::now();
+    for (int round = 0; round < rounds; round++) {
+        for (const Input &input : inputs) {
+            sink += lookup(input) ? 1 : 0;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (static_cast<double>(rounds) * inputs.size());
+}
+
+void report(const char *label, double ns, size_t found, size_t lookups) {
+    printf("%-22s %8.1f ns %10.1f bytes %6zu/%zu found\n", label, ns, static_cast<double>(g_bytes) / lookups, found,
+           lookups);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int rounds = argc > 1 ? atoi(argv[1]) : 20000;
+    if (rounds <= 0) {
+        fprintf(stderr, "Usage: %s [ROUNDS]\n", argv[0]);
+        return 2;
+    }
+
+    for (const char *name = KEY_NAME_BLOB; *name; name += strlen(name) + 1) {
+        VirtualKey key;
+        if (!keyFromName(name, strlen(name), key)) {
+            fprintf(stderr, "%s is not in the hash\n", name);
+            return 1;
+        }
+        g_entries.push_back({name, key});
+    }
+
+    std::vector<std::string> hits;
+    std::vector<std::string> misses;
+    for (const Entry &entry : g_entries) {
+        hits.push_back(entry.name);
+        std::string lower(entry.name);
+        for (char &character : lower) {
+            character = static_cast<char>(character >= 'A' && character <= 'Z' ? character + 32 : character);
+        }
+        misses.push_back(lower == entry.name ? lower + "_" : lower);
+    }
+    std::vector<VirtualKey> codes;
+    for (int code = 0; code < 256; code++) {
+        codes.push_back(static_cast<VirtualKey>(code));
+    }
+
+    std::vector<const char *> hitNames;
+    std::vector<const char *> missNames;
+    for (const std::string &name : hits) {
+        hitNames.push_back(name.c_str());
+    }
+    for (const std::string &name : misses) {
+        missNames.push_back(name.c_str());
+    }
+
+    printf("%zu names, %d rounds\n", g_entries.size(), rounds);
+    printf("%-22s %11s %16s\n", "lookup", "time", "read/lookup");
+
+    size_t     found;
+    double     ns;
+    VirtualKey key;
+    ns = timeLookups(hitNames, rounds, [&](const char *name) { return hashName(name, key); }, found);
+    report("name -> key, hash", ns, found, hitNames.size());
+    ns = timeLookups(hitNames, rounds, [&](const char *name) { return scanName(name, key); }, found);
+    report("name -> key, scan", ns, found, hitNames.size());
+    ns = timeLookups(missNames, rounds, [&](const char *name) { return hashName(name, key); }, found);
+    report("miss, hash", ns, found, missNames.size());
+    ns = timeLookups(missNames, rounds, [&](const char *name) { return scanName(name, key); }, found);
+    report("miss, scan", ns, found, missNames.size());
+    ns = timeLookups(codes, rounds, [&](VirtualKey code) { return tableCode(code) != nullptr; }, found);
+    report("key -> name, table", ns, found, codes.size());
+    ns = timeLookups(codes, rounds, [&](VirtualKey code) { return scanCode(code) != nullptr; }, found);
+    report("key -> name, scan", ns, found, codes.size());
+    return 0;
+}
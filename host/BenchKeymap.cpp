@@ -0,0 +1,262 @@
+/**
+ * @file BenchKeymap.cpp
+ * @brief Keymap engine on a virtual clock: decisions, their latency and cost
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-keymap [EDGES]
+ *
+ * Drives SerialInputKeymap.h with a virtual millisecond clock, calling
+ * update() every tick as loop() would and keyEvent() at scripted times,
+ * into a monitor stand-in that records pressKey() and releaseKey():
+ *
+ *   cases   Tap, hold by tapping term, hold by another key, layer-tap
+ *           tap and hold, combos (together, timed out, released early,
+ *           another key pressed meanwhile, a held key released
+ *           meanwhile) against the press/release sequence they must
+ *           produce and the lastDecisionLatency() they must report
+ *   random  EDGES random edges on every position, with a check that the
+ *           monitor never sees a key released that is not down or
+ *           pressed twice, and that everything is up once all positions
+ *           are; ns per keyEvent() and update() call
+ *
+ * The exit status is 1 if a case or the random run fails.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "SerialInputKeyNames.h"
+#include "SerialInputKeymap.h"
+
+namespace {
+
+/**
+ * @brief Monitor stand-in: the key calls of SerialInputMonitor, recorded
+ */
+class RecordingMonitor {
+  public:
+    std::string output;           ///< "+KEY" and "-KEY", space separated
+    bool        record    = true; ///< Append to output
+    bool        down[256] = {};   ///< Keys down
+    uint64_t    errors    = 0;    ///< Presses of keys down, releases of keys up
+
+    void pressKey(VirtualKey key) {
+        edge(key, true);
+    }
+
+    void releaseKey(VirtualKey key) {
+        edge(key, false);
+    }
+
+    bool anyDown() const {
+        for (bool key : down) {
+            if (key) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+  private:
+    void edge(VirtualKey key, bool press) {
+        uint8_t code = static_cast<uint8_t>(key);
+        if (down[code] == press) {
+            errors++;
+        }
+        down[code] = press;
+        if (record) {
+            const char *name = keyName(key);
+            output += output.empty() ? "" : " ";
+            output += press ? '+' : '-';
+            output += name ? name : "?";
+        }
+    }
+};
+
+typedef SerialInputKeymap<RecordingMonitor, 8> Keymap;
+
+// Positions
+const uint8_t P_A      = 0; ///< A
+const uint8_t P_CTRL   = 1; ///< Tap S, hold Left Control
+const uint8_t P_LAYER  = 2; ///< Tap SPACE, hold layer 1
+const uint8_t P_J      = 3; ///< J, ARROW_DOWN on layer 1
+const uint8_t P_K      = 4; ///< K, with L: ESCAPE
+const uint8_t P_L      = 5; ///< L
+const uint8_t P_SHIFT  = 6; ///< Left Shift
+const uint8_t P_TOGGLE = 7; ///< Toggle layer 1
+
+const uint16_t T = KeymapAction::TRANSPARENT;
+
+const uint16_t LAYERS[2][8] PROGMEM = {
+    {KeymapAction::key(VirtualKey::A), KeymapAction::modTap(VirtualKey::LEFT_CONTROL, VirtualKey::S),
+     KeymapAction::layerTap(1, VirtualKey::SPACE), KeymapAction::key(VirtualKey::J), KeymapAction::key(VirtualKey::K),
+     KeymapAction::key(VirtualKey::L), KeymapAction::key(VirtualKey::LEFT_SHIFT), KeymapAction::layerToggle(1)},
+    {T, T, T, KeymapAction::key(VirtualKey::ARROW_DOWN), T, T, T, T},
+};
+
+const KeyCombo COMBOS[] PROGMEM = {
+    {P_K, P_L, KeymapAction::key(VirtualKey::ESCAPE)},
+};
+
+const uint16_t TAPPING_TERM = 200;
+const uint16_t COMBO_TERM   = 30;
+
+/**
+ * @brief Engine, monitor and virtual clock
+ */
+struct Rig {
+    RecordingMonitor monitor;
+    Keymap           keymap;
+    unsigned long    now   = 0;
+    uint64_t         calls = 0; ///< keyEvent() and update() calls
+
+    Rig() : keymap(monitor, &LAYERS[0][0], 2, 8) {
+        keymap.setCombos(COMBOS, sizeof(COMBOS) / sizeof(COMBOS[0]));
+        keymap.setTappingTerm(TAPPING_TERM);
+        keymap.setComboTerm(COMBO_TERM);
+    }
+
+    /**
+     * @brief Tick the clock to a time, calling update() every millisecond
+     */
+    void runTo(unsigned long time) {
+        while (now < time) {
+            now++;
+            keymap.update(now);
+            calls++;
+        }
+    }
+
+    void edge(unsigned long time, uint8_t position, bool pressed) {
+        runTo(time);
+        keymap.keyEvent(position, pressed, now);
+        calls++;
+    }
+};
+
+struct Step {
+    unsigned long time;
+    uint8_t       position;
+    bool          pressed;
+};
+
+struct Case {
+    const char       *name;
+    std::vector<Step> steps;
+    const char       *expected; ///< Monitor calls
+    long              latency;  ///< lastDecisionLatency() at the end
+};
+
+const std::vector<Case> &cases() {
+    static const std::vector<Case> CASES = {
+        {"tap", {{0, P_CTRL, true}, {50, P_CTRL, false}}, "+S -S", 50},
+        {"hold by term", {{0, P_CTRL, true}, {300, P_CTRL, false}}, "+LEFT_CONTROL -LEFT_CONTROL", TAPPING_TERM},
+        {"hold by key",
+         {{0, P_CTRL, true}, {30, P_A, true}, {60, P_A, false}, {90, P_CTRL, false}},
+         "+LEFT_CONTROL +A -A -LEFT_CONTROL",
+         0}, // A settled last, without a decision
+        {"hold by key, decided", {{0, P_CTRL, true}, {30, P_K, true}}, "+LEFT_CONTROL", 30}, // K waits for L
+        {"layer-tap tap", {{0, P_LAYER, true}, {100, P_LAYER, false}}, "+SPACE -SPACE", 100},
+        {"layer-tap hold",
+         {{0, P_LAYER, true}, {40, P_J, true}, {60, P_J, false}, {80, P_LAYER, false}, {100, P_J, true},
+          {110, P_J, false}},
+         "+ARROW_DOWN -ARROW_DOWN +J -J",
+         0},
+        {"combo", {{0, P_K, true}, {10, P_L, true}, {50, P_K, false}, {55, P_L, false}}, "+ESCAPE -ESCAPE", 10},
+        {"combo timed out", {{0, P_K, true}, {80, P_K, false}}, "+K -K", COMBO_TERM},
+        {"combo key tapped", {{0, P_K, true}, {10, P_K, false}}, "+K -K", 10},
+        {"combo, other key",
+         {{0, P_K, true}, {10, P_A, true}, {20, P_A, false}, {25, P_K, false}},
+         "+K +A -A -K",
+         0},
+        {"combo, held key released",
+         {{0, P_SHIFT, true}, {10, P_K, true}, {15, P_SHIFT, false}, {40, P_K, false}},
+         "+LEFT_SHIFT +K -LEFT_SHIFT -K",
+         5},
+        {"combo, tap/hold released",
+         {{0, P_CTRL, true}, {300, P_K, true}, {305, P_CTRL, false}, {320, P_K, false}},
+         "+LEFT_CONTROL +K -LEFT_CONTROL -K",
+         5},
+    };
+    return CASES;
+}
+
+/**
+ * @brief Run the scripted cases
+ * @return true if all produced their sequence and latency
+ */
+bool runCases() {
+    bool ok = true;
+    printf("%-26s %-36s %8s  %s\n", "case", "monitor calls", "latency", "");
+    for (const Case &test : cases()) {
+        Rig rig;
+        for (const Step &step : test.steps) {
+            rig.edge(step.time, step.position, step.pressed);
+        }
+        long latency = static_cast<long>(rig.keymap.lastDecisionLatency());
+        bool pass    = rig.monitor.output == test.expected && latency == test.latency && rig.monitor.errors == 0;
+        printf("%-26s %-36s %6ld ms  %s\n", test.name, rig.monitor.output.c_str(), latency, pass ? "ok" : "FAILED");
+        if (!pass) {
+            printf("  expected \"%s\", %ld ms\n", test.expected, test.latency);
+        }
+        ok = ok && pass;
+    }
+    return ok;
+}
+
+/**
+ * @brief Random edges on every position, checked for consistent output
+ */
+bool runRandom(long edges) {
+    Rig      rig;
+    bool     held[8] = {};
+    uint64_t state   = 0x9E3779B97F4A7C15ULL;
+    auto     next    = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    rig.monitor.record = false;
+    auto start         = std::chrono::steady_clock::now();
+    for (long i = 0; i < edges; i++) {
+        uint8_t position = static_cast<uint8_t>(next() % 8);
+        rig.edge(rig.now + next() % 60, position, !held[position]);
+        held[position] = !held[position];
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (uint8_t position = 0; position < 8; position++) {
+        if (held[position]) {
+            rig.edge(rig.now + 1, position, false);
+        }
+    }
+    rig.runTo(rig.now + TAPPING_TERM + COMBO_TERM);
+
+    bool ok = rig.monitor.errors == 0 && !rig.monitor.anyDown();
+    printf("random %ld edges, %.1f s virtual: %llu inconsistent calls, %s up at the end, %.1f ns/call  %s\n",
+           edges, rig.now / 1000.0, static_cast<unsigned long long>(rig.monitor.errors),
+           rig.monitor.anyDown() ? "not all keys" : "all keys", seconds * 1e9 / rig.calls, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long edges = argc > 1 ? atol(argv[1]) : 1000000;
+    if (edges <= 0) {
+        fprintf(stderr, "Usage: %s [EDGES]\n", argv[0]);
+        return 2;
+    }
+
+    bool ok = runCases();
+    ok      = runRandom(edges) && ok;
+    return ok ? 0 : 1;
+}
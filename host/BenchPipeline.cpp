@@ -0,0 +1,297 @@
+/**
+ * @file BenchPipeline.cpp
+ * @brief Dual-core pipeline on two std::threads: correctness under contention and throughput
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-pipeline [EVENTS]
+ *
+ * Runs the two halves of SerialInputPipeline.h on two threads, as on
+ * the two cores of an RP2040 or ESP32:
+ *
+ *   queue   EventQueue alone: the producer pushes EVENTS numbered
+ *           records, retrying on a full ring; the consumer checks that
+ *           each arrives once, whole and in order
+ *   mutex   The same through a std::mutex-guarded ring, for comparison
+ *   pipe    EventPipeline: the front end posts moves and key presses
+ *           and releases as fast as it can, never retrying a move; the
+ *           back end writes them to a monitor stand-in that checks the
+ *           keys arrive in order and the moves add up
+ *
+ * for several capacities, with events/s and how often each side found
+ * the ring full or empty. A side that finds it so yields its thread, so
+ * the run also makes progress on a single CPU. Beforehand, on one
+ * thread, it checks that parameters too large for a record arrive
+ * clamped (positions, scrolls) or split (moves).
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <mutex>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+#include "SerialInputPipeline.h"
+
+namespace {
+
+EventRecord numbered(uint32_t i) {
+    EventRecord record = {static_cast<uint8_t>(i & 1), static_cast<uint8_t>(i >> 1), static_cast<int16_t>(i),
+                          static_cast<int16_t>(i >> 16)};
+    return record;
+}
+
+bool isNumbered(const EventRecord &record, uint32_t i) {
+    EventRecord expected = numbered(i);
+    return record.device == expected.device && record.event == expected.event &&
+           record.param1 == expected.param1 && record.param2 == expected.param2;
+}
+
+/**
+ * @brief Ring guarded by a mutex, the interface of EventQueue
+ */
+template <uint16_t Capacity> class MutexQueue {
+  public:
+    bool push(const EventRecord &record) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_count == Capacity) {
+            return false;
+        }
+        m_records[(m_first + m_count++) % Capacity] = record;
+        return true;
+    }
+
+    bool pop(EventRecord &record) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_count == 0) {
+            return false;
+        }
+        record  = m_records[m_first];
+        m_first = (m_first + 1) % Capacity;
+        m_count--;
+        return true;
+    }
+
+  private:
+    std::mutex  m_mutex;
+    EventRecord m_records[Capacity];
+    uint16_t    m_first = 0;
+    uint16_t    m_count = 0;
+};
+
+struct Result {
+    double   seconds;
+    uint64_t full;  ///< Producer attempts on a full ring
+    uint64_t empty; ///< Consumer attempts on an empty ring
+    bool     ok;
+};
+
+template <typename Queue> Result runQueue(uint32_t events) {
+    static Queue queue; // Large rings stay off the stack
+    Result       result = {0, 0, 0, true};
+
+    auto        start = std::chrono::steady_clock::now();
+    std::thread producer([&] {
+        for (uint32_t i = 0; i < events; i++) {
+            while (!queue.push(numbered(i))) {
+                result.full++;
+                std::this_thread::yield();
+            }
+        }
+    });
+    EventRecord record;
+    for (uint32_t i = 0; i < events; i++) {
+        while (!queue.pop(record)) {
+            result.empty++;
+            std::this_thread::yield();
+        }
+        result.ok = result.ok && isNumbered(record, i);
+    }
+    producer.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+/**
+ * @brief Back end stand-in for BasicSerialInputMonitor: checks what the pipeline writes
+ */
+struct CheckingMonitor {
+    int64_t  movedX   = 0;
+    int64_t  movedY   = 0;
+    uint32_t keys     = 0; ///< Key events seen
+    uint32_t nextKey  = 0; ///< Number of the next key event expected
+    bool     ordered  = true;
+    uint32_t events   = 0;
+
+    bool canSend(const InputEvent &) {
+        return true;
+    }
+
+    void sendEvent(const InputEvent &event) {
+        events++;
+        if (event.device == Device::MOUSE) {
+            movedX += event.param1;
+            movedY += event.param2;
+            return;
+        }
+        // Key events are numbered by code and alternate press and release
+        bool press = event.event == static_cast<uint8_t>(KeyboardEvent::PRESS);
+        ordered    = ordered && event.param1 == static_cast<int>(0x41 + (nextKey / 2) % 26) && press == (nextKey % 2 == 0);
+        nextKey++;
+        keys++;
+    }
+};
+
+/**
+ * @brief Back end stand-in that keeps every event written
+ */
+struct RecordingMonitor {
+    InputEvent events[64];
+    uint16_t   count = 0;
+
+    bool canSend(const InputEvent &) {
+        return count < 64;
+    }
+
+    void sendEvent(const InputEvent &event) {
+        events[count++] = event;
+    }
+};
+
+/**
+ * @brief Post parameters too large for a record through a 4-slot queue
+ * @return false if one arrived wrapped
+ */
+bool checkLimits() {
+    RecordingMonitor                   monitor;
+    EventPipeline<RecordingMonitor, 4> pipeline(monitor);
+
+    pipeline.postPosition(40000, -40000);
+    pipeline.postScroll(70000);
+    pipeline.postMove(100000, -5);
+    while (!pipeline.flush()) {
+        pipeline.pump();
+    }
+    pipeline.pump();
+
+    long movedX = 0;
+    long movedY = 0;
+    bool ok     = monitor.count == 6;
+    for (uint16_t i = 0; i < monitor.count; i++) {
+        const InputEvent &event = monitor.events[i];
+        switch (static_cast<MouseEvent>(event.event)) {
+            case MouseEvent::POSITION: ok = ok && i == 0 && event.param1 == 32767 && event.param2 == -32767; break;
+            case MouseEvent::SCROLL: ok = ok && i == 1 && event.param1 == 32767; break;
+            case MouseEvent::MOVE:
+                movedX += event.param1;
+                movedY += event.param2;
+                ok = ok && event.param1 > 0 && event.param1 <= 32767;
+                break;
+            default: ok = false; break;
+        }
+    }
+    ok = ok && movedX == 100000 && movedY == -5;
+    printf("limits: %u events, position, scroll and a 100000-pixel move in %u parts  %s\n", monitor.count,
+           monitor.count - 2, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+template <uint16_t Capacity> Result runPipeline(uint32_t events, uint16_t &merged, uint16_t &refused, uint32_t &sent) {
+    static CheckingMonitor                               monitor;
+    static EventPipeline<CheckingMonitor, Capacity>     *pipeline;
+    std::atomic<bool>                                    done(false);
+    Result                                               result  = {0, 0, 0, true};
+    int64_t                                              postedX = 0;
+    int64_t                                              postedY = 0;
+
+    monitor  = CheckingMonitor();
+    pipeline = new EventPipeline<CheckingMonitor, Capacity>(monitor);
+
+    auto        start = std::chrono::steady_clock::now();
+    std::thread frontEnd([&] {
+        uint32_t key = 0;
+        for (uint32_t i = 0; i < events; i++) {
+            // Seven moves, then a key edge, which is posted again while refused
+            if (i % 8 != 7) {
+                int dx = static_cast<int>(i % 5) - 2;
+                int dy = static_cast<int>(i % 3) + 1;
+                pipeline->postMove(dx, dy);
+                postedX += dx;
+                postedY += dy;
+                continue;
+            }
+            VirtualKey code = static_cast<VirtualKey>(0x41 + (key / 2) % 26);
+            while (!pipeline->postKey(code, key % 2 == 0)) {
+                result.full++;
+                std::this_thread::yield();
+            }
+            key++;
+        }
+        while (!pipeline->flush()) {
+            result.full++;
+            std::this_thread::yield();
+        }
+        done.store(true, std::memory_order_release);
+    });
+    for (;;) {
+        bool finished = done.load(std::memory_order_acquire);
+        if (pipeline->pump() == 0) {
+            if (finished) {
+                break;
+            }
+            result.empty++;
+            std::this_thread::yield();
+        }
+    }
+    frontEnd.join();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.ok = monitor.ordered && monitor.movedX == postedX && monitor.movedY == postedY && monitor.keys == events / 8;
+
+    merged  = pipeline->merged();
+    refused = pipeline->refused();
+    sent    = pipeline->sent();
+    delete pipeline;
+    return result;
+}
+
+void report(const char *label, unsigned capacity, uint32_t events, const Result &result) {
+    printf("%-6s %6u %8.1f M/s %7.1f ns %12llu %12llu  %s\n", label, capacity, events / result.seconds / 1e6,
+           result.seconds * 1e9 / events, static_cast<unsigned long long>(result.full),
+           static_cast<unsigned long long>(result.empty), result.ok ? "ok" : "FAILED");
+}
+
+template <uint16_t Capacity> bool runAll(uint32_t events) {
+    Result queue = runQueue<EventQueue<Capacity> >(events);
+    report("queue", Capacity, events, queue);
+    Result mutex = runQueue<MutexQueue<Capacity> >(events);
+    report("mutex", Capacity, events, mutex);
+
+    uint16_t merged;
+    uint16_t refused;
+    uint32_t sent;
+    Result   pipe = runPipeline<Capacity>(events, merged, refused, sent);
+    report("pipe", Capacity, events, pipe);
+    printf("       %u events written, %u moves merged, %u key edges refused (saturating)\n", sent, merged, refused);
+    return queue.ok && mutex.ok && pipe.ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long events = argc > 1 ? atol(argv[1]) : 20000000;
+    if (events <= 0) {
+        fprintf(stderr, "Usage: %s [EVENTS]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%ld events, %u-byte records, %u hardware threads\n", events, static_cast<unsigned>(sizeof(EventRecord)),
+           std::thread::hardware_concurrency());
+    bool ok = checkLimits();
+    printf("%-6s %6s %12s %10s %12s %12s\n", "test", "slots", "rate", "per event", "full", "empty");
+    ok      = runAll<16>(static_cast<uint32_t>(events)) && ok;
+    ok      = runAll<64>(static_cast<uint32_t>(events)) && ok;
+    ok      = runAll<1024>(static_cast<uint32_t>(events)) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,264 @@
+/**
+ * @file BenchPortService.cpp
+ * @brief PortService load test: many pseudo-terminals, events/s and latency
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-port-service [-p PORTS] [-j THREADS] [-n FRAMES] [-r RATE] [-b BURST]
+ *
+ * Opens PORTS pseudo-terminals (default 64) in raw mode and serves their
+ * slave ends with THREADS PortService loops (default 4), spread
+ * round-robin as `serial-input-daemon -j` does, each with its own sink.
+ * The main thread writes FRAMES mouse frames to every master end
+ * (default 10000), BURST frames per write() (default 1):
+ *
+ *   -r 0     as fast as the loops drain the terminals (default); the
+ *            latency then includes the time frames queue in the pty
+ *   -r RATE  paced at RATE frames/s over all ports, as devices would
+ *
+ * Every frame is `0 7 T PORT`, T being the microseconds since the start
+ * when it was written. The sinks turn T into a write-to-sink latency and
+ * check that each port's frames arrive in order. Prints events/s, the
+ * latency percentiles and the frames lost or out of order; the exit
+ * status is 1 if any were.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "EventSink.h"
+#include "PortService.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Clock::time_point g_start; ///< Time 0 of the frame stamps
+
+int32_t microsNow() {
+    return static_cast<int32_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_start).count());
+}
+
+/**
+ * @brief Sink of one loop: latencies and per-port order
+ */
+class LatencySink : public EventSink {
+  public:
+    std::vector<int32_t>   latencies;            ///< Microseconds, one per event
+    std::vector<int32_t>   lastStamp;            ///< Last stamp per port
+    uint64_t               outOfOrder = 0;       ///< Events older than their port's previous one
+    std::atomic<uint64_t> *received   = nullptr; ///< Events over all loops
+
+    void event(const ProtocolFrame &frame) override {
+        int32_t now = microsNow();
+        latencies.push_back(now - frame.param1);
+        size_t port = static_cast<size_t>(frame.param2);
+        if (port < lastStamp.size()) {
+            if (frame.param1 < lastStamp[port]) {
+                outOfOrder++;
+            }
+            lastStamp[port] = frame.param1;
+        }
+        m_batch++;
+    }
+
+    void flush() override {
+        received->fetch_add(m_batch, std::memory_order_relaxed);
+        m_batch = 0;
+    }
+
+  private:
+    uint64_t m_batch = 0; ///< Events since the last flush()
+};
+
+struct Shard {
+    PortService service;
+    LatencySink sink;
+};
+
+/**
+ * @brief Open a pty pair, the slave end raw and non-blocking
+ * @return false if the system ran out of terminals
+ */
+bool openPair(int &master, int &slave) {
+    master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) {
+        perror("posix_openpt");
+        return false;
+    }
+
+    const char *path = ptsname(master);
+    slave            = path ? open(path, O_RDWR | O_NOCTTY | O_CLOEXEC | O_NONBLOCK) : -1;
+    if (slave < 0) {
+        perror("open pty slave");
+        return false;
+    }
+
+    termios tty;
+    tcgetattr(slave, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(slave, TCSANOW, &tty);
+    return true;
+}
+
+bool writeAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length);
+        if (written < 0) {
+            perror("write");
+            return false;
+        }
+        data += written;
+        length -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+int32_t percentile(const std::vector<int32_t> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    int  ports   = 64;
+    int  threads = 4;
+    long frames  = 10000;
+    long rate    = 0;
+    int  burst   = 1;
+
+    int option;
+    while ((option = getopt(argc, argv, "p:j:n:r:b:")) != -1) {
+        switch (option) {
+            case 'p': ports = atoi(optarg); break;
+            case 'j': threads = atoi(optarg); break;
+            case 'n': frames = atol(optarg); break;
+            case 'r': rate = atol(optarg); break;
+            case 'b': burst = atoi(optarg); break;
+            default: ports = 0; break;
+        }
+    }
+    if (ports < 1 || threads < 1 || frames < 1 || rate < 0 || burst < 1 || optind != argc) {
+        fprintf(stderr, "Usage: %s [-p PORTS] [-j THREADS] [-n FRAMES] [-r RATE] [-b BURST]\n", argv[0]);
+        return 2;
+    }
+    threads = std::min(threads, ports);
+
+    std::atomic<uint64_t> received(0);
+    std::vector<Shard *>  shards;
+    for (int i = 0; i < threads; i++) {
+        Shard *shard = new Shard();
+        shard->sink.lastStamp.assign(ports, -1);
+        shard->sink.latencies.reserve(static_cast<size_t>(frames) * (ports / threads + 1));
+        shard->sink.received = &received;
+        shards.push_back(shard);
+    }
+
+    std::vector<int> masters;
+    for (int i = 0; i < ports; i++) {
+        int master, slave;
+        if (!openPair(master, slave)) {
+            return 1;
+        }
+        masters.push_back(master);
+        Shard *shard = shards[i % threads];
+        if (shard->service.addDescriptor(slave, "pty", &shard->sink) < 0) {
+            fprintf(stderr, "%s\n", shard->service.lastError().c_str());
+            return 1;
+        }
+    }
+
+    volatile sig_atomic_t    running = 1;
+    std::vector<std::thread> loops;
+    for (Shard *shard : shards) {
+        loops.emplace_back([shard, &running]() { shard->service.run(running); });
+    }
+
+    // Frames are written in rounds, BURST frames to every port per round
+    g_start                       = Clock::now();
+    uint64_t          total       = static_cast<uint64_t>(frames) * ports;
+    long              rounds      = (frames + burst - 1) / burst;
+    double            roundPeriod = rate ? static_cast<double>(burst) * ports / rate : 0.0;
+    std::vector<char> text;
+    bool              ok = true;
+    for (long round = 0; round < rounds && ok; round++) {
+        if (rate) {
+            std::this_thread::sleep_until(g_start + std::chrono::duration_cast<Clock::duration>(
+                                                        std::chrono::duration<double>(round * roundPeriod)));
+        }
+        long count = std::min<long>(burst, frames - round * burst);
+        for (int port = 0; port < ports && ok; port++) {
+            text.clear();
+            for (long i = 0; i < count; i++) {
+                char line[32];
+                int  length = snprintf(line, sizeof(line), "0 7 %d %d\r\n", static_cast<int>(microsNow()), port);
+                text.insert(text.end(), line, line + length);
+            }
+            ok = writeAll(masters[port], text.data(), text.size());
+        }
+    }
+    double writeSeconds = std::chrono::duration<double>(Clock::now() - g_start).count();
+
+    // Wait for the loops to drain the terminals, a second at most once input stops
+    uint64_t          seen = received.load();
+    Clock::time_point idle = Clock::now();
+    while (seen < total && Clock::now() - idle < std::chrono::seconds(1)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        uint64_t now = received.load();
+        if (now != seen) {
+            seen = now;
+            idle = Clock::now();
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - g_start).count();
+
+    for (Shard *shard : shards) {
+        shard->service.stop();
+    }
+    for (std::thread &loop : loops) {
+        loop.join();
+    }
+
+    std::vector<int32_t> latencies;
+    uint64_t             outOfOrder = 0;
+    for (Shard *shard : shards) {
+        latencies.insert(latencies.end(), shard->sink.latencies.begin(), shard->sink.latencies.end());
+        outOfOrder += shard->sink.outOfOrder;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    uint64_t lost = total - latencies.size();
+
+    printf("%d ports, %d threads, %ld frames/port, %s, burst %d\n", ports, threads, frames,
+           rate ? "paced" : "flood", burst);
+    if (rate) {
+        printf("rate      %ld frames/s requested, written in %.2f s\n", rate, writeSeconds);
+    }
+    printf("received  %zu/%llu events in %.2f s, %.0f events/s\n", latencies.size(),
+           static_cast<unsigned long long>(total), seconds, latencies.size() / seconds);
+    printf("latency   p50 %d us  p99 %d us  p99.9 %d us  max %d us\n", percentile(latencies, 0.50),
+           percentile(latencies, 0.99), percentile(latencies, 0.999), latencies.empty() ? 0 : latencies.back());
+    printf("lost      %llu  out of order %llu  %s\n", static_cast<unsigned long long>(lost),
+           static_cast<unsigned long long>(outOfOrder), lost || outOfOrder || !ok ? "FAILED" : "ok");
+
+    for (int master : masters) {
+        ::close(master);
+    }
+    for (Shard *shard : shards) {
+        delete shard;
+    }
+    return lost || outOfOrder || !ok ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file BenchSerialReader.cpp
+ * @brief SerialReader read latency over a pseudo-terminal pair
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-serial-reader [-n LINES] [-i MICROSECONDS] [-s MILLISECONDS]
+ *
+ * Opens a pty pair and reads the slave end through SerialReader, as the
+ * daemon reads a device. A writer thread writes LINES event lines
+ * (default 10000) to the master end, one every MICROSECONDS (default
+ * 1000, a 1 kHz mouse), each stamped with the microseconds since the
+ * start when it was written and numbered. Two readers are measured on
+ * the same schedule:
+ *
+ *   poll   SerialReader::poll() waiting for the data
+ *   sleep  a sleep of MILLISECONDS (default 10) between non-blocking
+ *          SerialReader::poll(0) calls, the pyserial loop it replaced
+ *
+ * Prints the write-to-decode latency percentiles and lines per read of
+ * each, and the exit status is 1 if a line was lost or came out of order.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "SerialReader.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+Clock::time_point g_start; ///< Time 0 of the line stamps
+
+int32_t microsNow() {
+    return static_cast<int32_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - g_start).count());
+}
+
+/**
+ * @brief Write numbered, stamped lines to the master end on a schedule
+ */
+void writeLines(int master, long lines, long intervalUs) {
+    for (long i = 0; i < lines; i++) {
+        std::this_thread::sleep_until(g_start + std::chrono::microseconds(i * intervalUs));
+        char line[32];
+        int  length = snprintf(line, sizeof(line), "0 7 %d %ld\r\n", static_cast<int>(microsNow()), i);
+        if (::write(master, line, static_cast<size_t>(length)) != length) {
+            perror("write");
+            return;
+        }
+    }
+}
+
+int32_t percentile(const std::vector<int32_t> &sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+/**
+ * @brief Read one run of lines through a fresh pty pair
+ * @param sleepMs 0 to wait in poll(), else the sleep between reads
+ * @return false if lines were lost or out of order
+ */
+bool run(const char *name, long lines, long intervalUs, int sleepMs) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (master < 0 || grantpt(master) < 0 || unlockpt(master) < 0) {
+        perror("posix_openpt");
+        return false;
+    }
+
+    SerialReader reader;
+    const char  *path = ptsname(master);
+    if (!path || !reader.open(path, 115200)) {
+        fprintf(stderr, "%s\n", path ? reader.lastError().c_str() : "ptsname failed");
+        ::close(master);
+        return false;
+    }
+
+    std::vector<int32_t> latencies;
+    latencies.reserve(static_cast<size_t>(lines));
+    long     expected   = 0;
+    uint64_t outOfOrder = 0;
+    uint64_t reads      = 0;
+    auto     handler    = [&](const ProtocolFrame &frame) {
+        if (frame.kind != FrameKind::EVENT) {
+            return;
+        }
+        latencies.push_back(microsNow() - frame.param1);
+        if (frame.param2 != expected) {
+            outOfOrder++;
+        }
+        expected = frame.param2 + 1;
+    };
+
+    g_start = Clock::now();
+    std::thread writer(writeLines, master, lines, intervalUs);
+
+    // Until every line arrived, or none did for a second after the schedule ended
+    Clock::time_point last = g_start + std::chrono::microseconds(lines * intervalUs);
+    while (static_cast<long>(latencies.size()) < lines && Clock::now() - last < std::chrono::seconds(1)) {
+        int result;
+        if (sleepMs) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+            result = reader.poll(0, handler);
+        } else {
+            result = reader.poll(100, handler);
+        }
+        if (result < 0) {
+            fprintf(stderr, "%s\n", reader.lastError().c_str());
+            break;
+        }
+        if (result > 0) {
+            reads++;
+            last = std::max(last, Clock::now());
+        }
+    }
+
+    writer.join();
+    reader.close();
+    ::close(master);
+
+    std::sort(latencies.begin(), latencies.end());
+    long lost = lines - static_cast<long>(latencies.size());
+    bool ok   = lost == 0 && outOfOrder == 0;
+    printf("%-6s p50 %6d us  p99 %6d us  max %6d us  %.2f lines/read  lost %ld  out of order %llu  %s\n", name,
+           percentile(latencies, 0.50), percentile(latencies, 0.99), latencies.empty() ? 0 : latencies.back(),
+           reads ? static_cast<double>(latencies.size()) / reads : 0.0, lost,
+           static_cast<unsigned long long>(outOfOrder), ok ? "ok" : "FAILED");
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long lines      = 10000;
+    long intervalUs = 1000;
+    int  sleepMs    = 10;
+
+    int option;
+    while ((option = getopt(argc, argv, "n:i:s:")) != -1) {
+        switch (option) {
+            case 'n': lines = atol(optarg); break;
+            case 'i': intervalUs = atol(optarg); break;
+            case 's': sleepMs = atoi(optarg); break;
+            default: lines = 0; break;
+        }
+    }
+    if (lines < 1 || intervalUs < 0 || sleepMs < 1 || optind != argc) {
+        fprintf(stderr, "Usage: %s [-n LINES] [-i MICROSECONDS] [-s MILLISECONDS]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%ld lines, one every %ld us\n", lines, intervalUs);
+    bool ok = run("poll", lines, intervalUs, 0);
+    ok      = run("sleep", lines, intervalUs, sleepMs) && ok;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file BenchSimText.cpp
+ * @brief SIM_TEXT() tables against the per-character switch of typeText()
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: bench-sim-text [CHARACTERS]
+ *
+ * Produces the key events of a few literal texts two ways, as the
+ * monitor does before sending them:
+ *
+ *   switch  typeText(const char *): characterKey() and
+ *           characterNeedsShift() per character, Shift pressed and
+ *           released around each shifted one
+ *   table   typeText(SIM_TEXT(...)): the events encoded at compile time,
+ *           read back as key/flags byte pairs with pgm_read_byte(), Shift
+ *           held across runs of shifted characters
+ *
+ * Checks that both type the same keys with the same Shift state and
+ * leave every key up, then prints for each text the ns per character of
+ * each way over about CHARACTERS characters, the events per character
+ * and the flash bytes of the text or of its table. The exit status is 1
+ * if a check fails.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "SerialInputMonitor.h"
+
+namespace {
+
+/**
+ * @brief Key events as they would be sent
+ */
+struct Recorder {
+    uint8_t keys[1024];  ///< Key of each event
+    bool    press[1024]; ///< Press or release
+    size_t  count = 0;   ///< Events recorded
+
+    void event(uint8_t key, bool isPress) {
+        keys[count]  = key;
+        press[count] = isPress;
+        count++;
+    }
+};
+
+__attribute__((noinline)) void switchPath(const char *text, Recorder &out) {
+    out.count     = 0;
+    uint8_t shift = static_cast<uint8_t>(VirtualKey::LEFT_SHIFT);
+    for (; *text; text++) {
+        uint8_t key     = static_cast<uint8_t>(characterKey(*text));
+        bool    shifted = characterNeedsShift(*text);
+        if (shifted) {
+            out.event(shift, true);
+        }
+        out.event(key, true);
+        out.event(key, false);
+        if (shifted) {
+            out.event(shift, false);
+        }
+    }
+}
+
+__attribute__((noinline)) void tablePath(const EncodedText &text, Recorder &out) {
+    out.count = 0;
+    for (uint16_t i = 0; i < text.count; i++) {
+        uint8_t key   = pgm_read_byte(text.events + 2 * i);
+        uint8_t flags = pgm_read_byte(text.events + 2 * i + 1);
+        out.event(key, (flags & SimText::PRESS) != 0);
+    }
+}
+
+/**
+ * @brief Keys pressed, each with whether Shift was down, and keys left down
+ */
+std::vector<int> typed(const Recorder &events, bool &allUp) {
+    std::vector<int> keys;
+    bool             down[256] = {};
+    uint8_t          shift     = static_cast<uint8_t>(VirtualKey::LEFT_SHIFT);
+    for (size_t i = 0; i < events.count; i++) {
+        if (events.press[i] && events.keys[i] != shift) {
+            keys.push_back(events.keys[i] | (down[shift] ? 0x100 : 0));
+        }
+        down[events.keys[i]] = events.press[i];
+    }
+    allUp = true;
+    for (bool key : down) {
+        allUp = allUp && !key;
+    }
+    return keys;
+}
+
+struct Text {
+    const char *name;
+    const char *text;
+    EncodedText encoded;
+};
+
+const Text *texts(size_t &count) {
+    static const Text TEXTS[] = {
+        {"user name", "admin", SIM_TEXT("admin")},
+        {"password", "P@ssw0rd-2025!", SIM_TEXT("P@ssw0rd-2025!")},
+        {"capitals", "SKU-ABC-1234", SIM_TEXT("SKU-ABC-1234")},
+        {"sentence", "Thanks for your order, we will ship it today.",
+         SIM_TEXT("Thanks for your order, we will ship it today.")},
+    };
+    count = sizeof(TEXTS) / sizeof(TEXTS[0]);
+    return TEXTS;
+}
+
+template <typename Run> double nsPerCharacter(Run run, size_t length, long characters, uint64_t &sum) {
+    long rounds = characters / static_cast<long>(length) + 1;
+    auto start  = std::chrono::steady_clock::now();
+    for (long i = 0; i < rounds; i++) {
+        sum += run();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return seconds * 1e9 / (static_cast<double>(rounds) * length);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long characters = argc > 1 ? atol(argv[1]) : 20000000;
+    if (characters <= 0) {
+        fprintf(stderr, "Usage: %s [CHARACTERS]\n", argv[0]);
+        return 2;
+    }
+
+    size_t      count;
+    const Text *list = texts(count);
+    bool        ok   = true;
+    uint64_t    sum  = 0;
+    Recorder    bySwitch;
+    Recorder    byTable;
+
+    printf("%-10s %5s  %-6s %9s %10s %12s  %s\n", "text", "chars", "path", "ns/char", "events/ch", "flash bytes", "");
+    for (size_t i = 0; i < count; i++) {
+        const Text &text   = list[i];
+        size_t      length = strlen(text.text);
+
+        switchPath(text.text, bySwitch);
+        tablePath(text.encoded, byTable);
+        bool switchUp, tableUp;
+        bool same = typed(bySwitch, switchUp) == typed(byTable, tableUp) && switchUp && tableUp;
+        ok        = ok && same;
+
+        double switchNs = nsPerCharacter(
+            [&]() {
+                switchPath(text.text, bySwitch);
+                return bySwitch.count;
+            },
+            length, characters, sum);
+        double tableNs = nsPerCharacter(
+            [&]() {
+                tablePath(text.encoded, byTable);
+                return byTable.count;
+            },
+            length, characters, sum);
+
+        printf("%-10s %5zu  %-6s %9.2f %10.2f %12zu  %s\n", text.name, length, "switch", switchNs,
+               static_cast<double>(bySwitch.count) / length, length + 1, same ? "ok" : "FAILED");
+        printf("%-10s %5s  %-6s %9.2f %10.2f %12u\n", "", "", "table", tableNs,
+               static_cast<double>(byTable.count) / length, 2u * text.encoded.count);
+    }
+    printf("(sum %llu)\n", static_cast<unsigned long long>(sum));
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,239 @@
+/**
+ * @file CaptureAnalysis.cpp
+ * @brief Implementation of the capture aggregates
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "CaptureAnalysis.h"
+
+#include <algorithm>
+
+#include "CaptureFormat.h"
+
+namespace {
+
+const uint64_t MAX_SERIES_SPAN = 100000000; ///< Buckets; wider jumps are treated as bad timestamps
+
+void addSeries(std::vector<uint32_t> &series, uint64_t &seriesStart, uint64_t bucket, uint32_t count) {
+    if (series.empty()) {
+        seriesStart = bucket;
+        series.push_back(count);
+        return;
+    }
+    if (bucket >= seriesStart) {
+        uint64_t offset = bucket - seriesStart;
+        if (offset >= MAX_SERIES_SPAN) {
+            return;
+        }
+        if (offset >= series.size()) {
+            series.resize(offset + 1, 0);
+        }
+        series[offset] += count;
+        return;
+    }
+
+    uint64_t shift = seriesStart - bucket;
+    if (shift + series.size() > MAX_SERIES_SPAN) {
+        return;
+    }
+    series.insert(series.begin(), shift, 0);
+    seriesStart = bucket;
+    series[0] += count;
+}
+
+} // namespace
+
+void CaptureStats::analyze(const char *data, size_t size, const AnalysisOptions &options) {
+    bytes += size;
+    forEachCaptureLine(data, size, [this, &options](const CaptureRecord &record) {
+        lines++;
+        switch (record.frame.kind) {
+            case FrameKind::EVENT:
+                addEvent(record.timeUs, record.frame.device, record.frame.event, record.frame.param1, options);
+                break;
+            case FrameKind::COMMENT: comments++; break;
+            default: invalid++; break;
+        }
+    });
+}
+
+void CaptureStats::addEvent(uint64_t timeUs, uint8_t device, uint8_t event, int32_t param1,
+                            const AnalysisOptions &options) {
+    if (events == 0) {
+        firstUs = timeUs;
+    } else if (timeUs < lastUs) {
+        backward++;
+    }
+    events++;
+    lastUs = timeUs;
+
+    eventCounts[device & 1][event < 15 ? event : 15]++;
+    addSeries(series, seriesStart, timeUs / options.bucketUs, 1);
+
+    if (sessions.empty() || timeUs > sessions.back().endUs + options.sessionGapUs) {
+        Session session = {timeUs, timeUs, 0, 0};
+        sessions.push_back(session);
+    }
+    Session &session = sessions.back();
+    session.endUs    = std::max(session.endUs, timeUs);
+    session.events++;
+
+    if (device == static_cast<uint8_t>(Device::KEYBOARD)) {
+        uint8_t key     = static_cast<uint8_t>(param1);
+        bool    pressed = event == static_cast<uint8_t>(KeyboardEvent::PRESS);
+        if (pressed) {
+            keyPresses[key]++;
+            session.keyPresses++;
+        }
+        if (pressed || event == static_cast<uint8_t>(KeyboardEvent::RELEASE)) {
+            keyEdge(key, pressed, timeUs, options);
+        }
+    }
+}
+
+void CaptureStats::keyEdge(uint8_t key, bool pressed, uint64_t timeUs, const AnalysisOptions &options) {
+    KeyRuns &runs = keys[key];
+
+    if (runs.headKind == KeyRuns::NONE) {
+        runs.headKind    = pressed ? KeyRuns::PRESS : KeyRuns::RELEASE;
+        runs.headUs      = timeUs;
+        runs.headEndUs   = pressed ? NEVER_RELEASED : timeUs;
+        runs.tailHeld    = pressed;
+        runs.tailSinceUs = timeUs;
+        return;
+    }
+
+    if (pressed) {
+        // A repeated press keeps the original press time
+        if (!runs.tailHeld) {
+            runs.tailHeld    = true;
+            runs.tailSinceUs = timeUs;
+        }
+        return;
+    }
+
+    if (runs.tailHeld) {
+        if (runs.headKind == KeyRuns::PRESS && runs.headEndUs == NEVER_RELEASED) {
+            runs.headEndUs = timeUs; // Head run: judged once the previous range is known
+        } else {
+            addStuck(key, runs.tailSinceUs, timeUs, options);
+        }
+        runs.tailHeld = false;
+    }
+}
+
+void CaptureStats::addStuck(uint8_t key, uint64_t pressedUs, uint64_t releasedUs, const AnalysisOptions &options) {
+    uint64_t end = releasedUs == NEVER_RELEASED ? lastUs : releasedUs;
+    if (end > pressedUs && end - pressedUs > options.stuckUs) {
+        StuckKey entry = {key, pressedUs, releasedUs};
+        stuck.push_back(entry);
+    }
+}
+
+void CaptureStats::merge(CaptureStats &later, const AnalysisOptions &options) {
+    bytes += later.bytes;
+    lines += later.lines;
+    comments += later.comments;
+    invalid += later.invalid;
+    backward += later.backward;
+
+    if (later.events > 0) {
+        if (events == 0) {
+            firstUs = later.firstUs;
+        } else if (later.firstUs < lastUs) {
+            backward++;
+        }
+        lastUs = later.lastUs;
+    }
+    events += later.events;
+
+    for (int device = 0; device < 2; device++) {
+        for (int event = 0; event < 16; event++) {
+            eventCounts[device][event] += later.eventCounts[device][event];
+        }
+    }
+    for (int key = 0; key < 256; key++) {
+        keyPresses[key] += later.keyPresses[key];
+    }
+
+    if (series.empty()) {
+        series.swap(later.series);
+        seriesStart = later.seriesStart;
+    } else {
+        for (size_t i = 0; i < later.series.size(); i++) {
+            if (later.series[i]) {
+                addSeries(series, seriesStart, later.seriesStart + i, later.series[i]);
+            }
+        }
+    }
+
+    size_t joinedFirst = 0;
+    if (!sessions.empty() && !later.sessions.empty() &&
+        later.sessions.front().startUs <= sessions.back().endUs + options.sessionGapUs) {
+        Session &joined = sessions.back();
+        joined.endUs    = std::max(joined.endUs, later.sessions.front().endUs);
+        joined.events += later.sessions.front().events;
+        joined.keyPresses += later.sessions.front().keyPresses;
+        joinedFirst = 1;
+    }
+    sessions.insert(sessions.end(), later.sessions.begin() + joinedFirst, later.sessions.end());
+
+    stuck.insert(stuck.end(), later.stuck.begin(), later.stuck.end());
+
+    for (int key = 0; key < 256; key++) {
+        KeyRuns       &runs = keys[key];
+        const KeyRuns &next = later.keys[key];
+
+        if (next.headKind == KeyRuns::NONE) {
+            continue;
+        }
+        if (runs.headKind == KeyRuns::NONE) {
+            runs = next;
+            continue;
+        }
+
+        bool headOpen = runs.headKind == KeyRuns::PRESS && runs.headEndUs == NEVER_RELEASED;
+
+        if (runs.tailHeld) {
+            // Still held from this range: the first release over there ends the run
+            if (next.headEndUs == NEVER_RELEASED) {
+                continue;
+            }
+            if (headOpen) {
+                runs.headEndUs = next.headEndUs;
+            } else {
+                addStuck(static_cast<uint8_t>(key), runs.tailSinceUs, next.headEndUs, options);
+            }
+        } else if (next.headKind == KeyRuns::PRESS) {
+            if (next.headEndUs == NEVER_RELEASED) {
+                runs.tailHeld    = true;
+                runs.tailSinceUs = next.headUs;
+                continue;
+            }
+            addStuck(static_cast<uint8_t>(key), next.headUs, next.headEndUs, options);
+        }
+
+        runs.tailHeld    = next.tailHeld;
+        runs.tailSinceUs = next.tailSinceUs;
+    }
+}
+
+void CaptureStats::finish(const AnalysisOptions &options) {
+    for (int key = 0; key < 256; key++) {
+        KeyRuns &runs = keys[key];
+        if (runs.headKind == KeyRuns::PRESS && runs.headEndUs != NEVER_RELEASED) {
+            addStuck(static_cast<uint8_t>(key), runs.headUs, runs.headEndUs, options);
+        }
+        if (runs.tailHeld) {
+            addStuck(static_cast<uint8_t>(key), runs.tailSinceUs, NEVER_RELEASED, options);
+        }
+        runs = KeyRuns();
+    }
+
+    std::sort(stuck.begin(), stuck.end(), [](const StuckKey &left, const StuckKey &right) {
+        return left.pressedUs < right.pressedUs;
+    });
+}
@@ -0,0 +1,131 @@
+/**
+ * @file CaptureAnalysis.h
+ * @brief Mergeable aggregates over capture files
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * A capture is cut into chunks at line boundaries. Every chunk is
+ * analysed on its own into a CaptureStats; stats of neighbouring chunks
+ * are combined with merge(), which is associative, so the chunks can be
+ * reduced pairwise in parallel as long as their order is kept.
+ *
+ * Order matters for what crosses chunk boundaries: sessions that span
+ * two chunks, rate buckets shared by both, and keys pressed in one chunk
+ * and released in a later one. For the latter every key keeps a summary
+ * of its first and last press run so the junction can be resolved later.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef CAPTURE_ANALYSIS_H
+#define CAPTURE_ANALYSIS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Analysis parameters
+ */
+struct AnalysisOptions {
+    uint64_t bucketUs     = 1000000;   ///< Rate series bucket width
+    uint64_t sessionGapUs = 300000000; ///< Idle time that ends a session
+    uint64_t stuckUs      = 10000000;  ///< Hold time reported as a stuck key
+};
+
+/**
+ * @brief Period of activity without a gap longer than sessionGapUs
+ */
+struct Session {
+    uint64_t startUs;    ///< First event
+    uint64_t endUs;      ///< Last event
+    uint64_t events;     ///< Events in the session
+    uint64_t keyPresses; ///< Key presses in the session
+};
+
+/**
+ * @brief Key held longer than stuckUs
+ */
+struct StuckKey {
+    uint8_t  key;        ///< Virtual key code
+    uint64_t pressedUs;  ///< Press time
+    uint64_t releasedUs; ///< Release time, NEVER_RELEASED if none
+};
+
+const uint64_t NEVER_RELEASED = ~static_cast<uint64_t>(0);
+
+/**
+ * @brief Press/release history of one key within a range of the capture
+ *
+ * The head is the first run of the key in the range, evaluated as if the
+ * key were released at the start; it is only judged once the preceding
+ * range is known. Everything after the head is final, except the tail
+ * (the key's state at the end of the range).
+ */
+struct KeyRuns {
+    enum Kind : uint8_t {
+        NONE    = 0, ///< No event for this key
+        PRESS   = 1, ///< Range starts with a press at headUs
+        RELEASE = 2  ///< Range starts with a release at headUs
+    };
+
+    uint8_t  headKind;    ///< Kind of the first event
+    bool     tailHeld;    ///< Key is down at the end of the range
+    uint64_t headUs;      ///< Time of the first event
+    uint64_t headEndUs;   ///< Release ending the head run, NEVER_RELEASED if open
+    uint64_t tailSinceUs; ///< Press time of the tail run (when tailHeld)
+};
+
+/**
+ * @brief Aggregates for one range of a capture
+ */
+class CaptureStats {
+  public:
+    uint64_t bytes    = 0; ///< Bytes analysed
+    uint64_t lines    = 0; ///< Non-empty lines
+    uint64_t events   = 0; ///< EVENT lines
+    uint64_t comments = 0; ///< Comment lines
+    uint64_t invalid  = 0; ///< Malformed lines
+    uint64_t backward = 0; ///< Events older than their predecessor
+
+    uint64_t firstUs = 0; ///< First event time (valid when events > 0)
+    uint64_t lastUs  = 0; ///< Last event time (valid when events > 0)
+
+    uint64_t eventCounts[2][16] = {}; ///< Per device and event (events >= 15 share the last slot)
+    uint64_t keyPresses[256]    = {}; ///< Presses per virtual key
+
+    uint64_t              seriesStart = 0; ///< Bucket index of series[0]
+    std::vector<uint32_t> series;          ///< Events per bucket
+
+    std::vector<Session>  sessions; ///< Sessions in time order
+    std::vector<StuckKey> stuck;    ///< Stuck keys resolved so far
+    KeyRuns               keys[256] = {}; ///< Per-key run summaries
+
+    /**
+     * @brief Analyse one chunk of a capture
+     * @param data Chunk bytes (whole lines)
+     * @param size Number of bytes
+     * @param options Analysis parameters
+     */
+    void analyze(const char *data, size_t size, const AnalysisOptions &options);
+
+    /**
+     * @brief Append the stats of the range directly after this one
+     * @param later Stats of the following range (left unusable)
+     * @param options Analysis parameters (same as for analyze())
+     */
+    void merge(CaptureStats &later, const AnalysisOptions &options);
+
+    /**
+     * @brief Resolve open key runs once the whole capture is merged
+     * @param options Analysis parameters
+     */
+    void finish(const AnalysisOptions &options);
+
+  private:
+    void addEvent(uint64_t timeUs, uint8_t device, uint8_t event, int32_t param1, const AnalysisOptions &options);
+    void keyEdge(uint8_t key, bool pressed, uint64_t timeUs, const AnalysisOptions &options);
+    void addStuck(uint8_t key, uint64_t pressedUs, uint64_t releasedUs, const AnalysisOptions &options);
+};
+
+#endif // CAPTURE_ANALYSIS_H
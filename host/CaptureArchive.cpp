@@ -0,0 +1,636 @@
+/**
+ * @file CaptureArchive.cpp
+ * @brief Implementation of the columnar capture archive
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "CaptureArchive.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const size_t BLOCK_ALIGNMENT = 8;   ///< Block headers start at multiples of this
+const size_t FRAME_VALUES    = 128; ///< Values sharing one bit width
+
+constexpr size_t alignBlock(size_t size) {
+    return (size + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+}
+
+inline uint64_t zigzag64(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag64(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline uint32_t zigzag32(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+inline int32_t unzigzag32(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+void putVarint(std::vector<uint8_t> &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline bool getVarint(const uint8_t *&cursor, const uint8_t *end, uint64_t &value) {
+    uint64_t result = 0;
+    unsigned shift  = 0;
+    while (cursor < end && shift < 64) {
+        uint8_t byte = *cursor++;
+        result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (byte < 0x80) {
+            value = result;
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+inline bool getVarint32(const uint8_t *&cursor, const uint8_t *end, uint32_t &value) {
+    uint64_t wide;
+    if (!getVarint(cursor, end, wide) || wide > 0xFFFFFFFFu) {
+        return false;
+    }
+    value = static_cast<uint32_t>(wide);
+    return true;
+}
+
+
+/**
+ * @brief Append values as frames of FRAME_VALUES, each one width byte
+ *        followed by the values packed LSB first in that many bits
+ */
+void putFrames(std::vector<uint8_t> &out, const uint64_t *values, size_t count) {
+    for (size_t first = 0; first < count; first += FRAME_VALUES) {
+        size_t   frame = count - first < FRAME_VALUES ? count - first : FRAME_VALUES;
+        uint64_t any   = 0;
+        for (size_t i = 0; i < frame; i++) {
+            any |= values[first + i];
+        }
+        unsigned width = any ? 64 - static_cast<unsigned>(__builtin_clzll(any)) : 0;
+        out.push_back(static_cast<uint8_t>(width));
+
+        size_t start = out.size();
+        out.resize(start + (frame * width + 7) / 8, 0);
+        uint8_t *bytes = out.data() + start;
+        size_t   bit   = 0;
+        for (size_t i = 0; i < frame; i++) {
+            uint64_t value = values[first + i];
+            for (unsigned done = 0; done < width;) {
+                unsigned shift = bit % 8;
+                unsigned take  = 8 - shift < width - done ? 8 - shift : width - done;
+                bytes[bit / 8] |= static_cast<uint8_t>(((value >> done) & ((1u << take) - 1)) << shift);
+                bit += take;
+                done += take;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decode count values written by putFrames()
+ * @param readable End of the mapping: whole 8-byte loads are allowed up to here
+ */
+bool getFrames(const uint8_t *&cursor, const uint8_t *end, const uint8_t *readable, uint64_t *values,
+               size_t count) {
+    for (size_t first = 0; first < count; first += FRAME_VALUES) {
+        size_t frame = count - first < FRAME_VALUES ? count - first : FRAME_VALUES;
+        if (cursor >= end || *cursor > 64) {
+            return false;
+        }
+        unsigned width = *cursor++;
+        size_t   bytes = (frame * width + 7) / 8;
+        if (static_cast<size_t>(end - cursor) < bytes) {
+            return false;
+        }
+
+        uint64_t *out = values + first;
+        if (width == 0) {
+            memset(out, 0, frame * sizeof(uint64_t));
+        } else if (width <= 56 && static_cast<size_t>(readable - cursor) >= bytes + 8) {
+            // One unaligned load per value, no dependency between values
+            const uint64_t mask = (static_cast<uint64_t>(1) << width) - 1;
+            for (size_t i = 0; i < frame; i++) {
+                size_t   bit = i * width;
+                uint64_t word;
+                memcpy(&word, cursor + bit / 8, sizeof(word));
+                out[i] = (word >> (bit % 8)) & mask;
+            }
+        } else {
+            size_t bit = 0;
+            for (size_t i = 0; i < frame; i++) {
+                uint64_t value = 0;
+                for (unsigned done = 0; done < width;) {
+                    unsigned shift = bit % 8;
+                    unsigned take  = 8 - shift < width - done ? 8 - shift : width - done;
+                    value |= static_cast<uint64_t>((cursor[bit / 8] >> shift) & ((1u << take) - 1)) << done;
+                    bit += take;
+                    done += take;
+                }
+                out[i] = value;
+            }
+        }
+        cursor += bytes;
+    }
+    return true;
+}
+
+} // namespace
+
+// ==================== ArchiveBlock ====================
+
+void ArchiveBlock::clear() {
+    timeUs.clear();
+    device.clear();
+    event.clear();
+    paramCount.clear();
+    param1.clear();
+    param2.clear();
+    texts.clear();
+}
+
+// ==================== CaptureArchiveWriter ====================
+
+CaptureArchiveWriter::CaptureArchiveWriter() : m_file(nullptr), m_lookup(), m_written(0), m_texts(0), m_flags(0) {
+}
+
+CaptureArchiveWriter::~CaptureArchiveWriter() {
+    if (m_file) {
+        fclose(m_file);
+    }
+}
+
+bool CaptureArchiveWriter::open(const char *path) {
+    m_file = fopen(path, "wb");
+    if (!m_file) {
+        m_lastError = std::string("Cannot create ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    uint8_t       first[alignBlock(sizeof(ArchiveHeader))] = {};
+    ArchiveHeader header = {ARCHIVE_MAGIC, ARCHIVE_VERSION, 0, ARCHIVE_BLOCK_EVENTS};
+    memcpy(first, &header, sizeof(header));
+    if (fwrite(first, sizeof(first), 1, m_file) != 1) {
+        m_lastError = std::string("Cannot write ") + path + ": " + strerror(errno);
+        return false;
+    }
+    m_written = sizeof(first);
+    return true;
+}
+
+bool CaptureArchiveWriter::add(const CaptureRecord &record, const char *line, size_t length) {
+    const ProtocolFrame &frame = record.frame;
+
+    // Only lines the columns give back byte for byte are stored as events
+    bool verbatim = frame.kind != FrameKind::EVENT;
+    if (!verbatim) {
+        char   formatted[MAX_CAPTURE_LINE];
+        size_t formattedLength = formatCaptureLine(formatted, record.timeUs, frame.device, frame.event,
+                                                   frame.paramCount, frame.param1, frame.param2);
+        verbatim = formattedLength != length + 1 || memcmp(formatted, line, length) != 0;
+    }
+    if (verbatim) {
+        ArchiveText text = {static_cast<uint32_t>(m_block.size()), std::string(line, length)};
+        m_block.texts.push_back(std::move(text));
+        m_texts++;
+        return true;
+    }
+
+    uint32_t &slot = m_lookup[frame.device & 1][frame.event][frame.paramCount < 2 ? frame.paramCount : 2];
+    if (slot == 0) {
+        if (m_dictionary.size() / 3 == ARCHIVE_MAX_OPCODES) {
+            if (!flushBlock()) {
+                return false;
+            }
+        }
+        m_dictionary.push_back(frame.device);
+        m_dictionary.push_back(frame.event);
+        m_dictionary.push_back(frame.paramCount);
+        slot = static_cast<uint32_t>(m_dictionary.size() / 3);
+    }
+
+    m_block.timeUs.push_back(record.timeUs);
+    m_block.device.push_back(frame.device);
+    m_block.event.push_back(frame.event);
+    m_block.paramCount.push_back(frame.paramCount);
+    m_block.param1.push_back(frame.param1);
+    m_block.param2.push_back(frame.param2);
+    m_opcodes.push_back(static_cast<uint8_t>(slot - 1));
+
+    if (m_block.size() == ARCHIVE_BLOCK_EVENTS) {
+        return flushBlock();
+    }
+    return true;
+}
+
+bool CaptureArchiveWriter::flushBlock() {
+    const size_t events = m_block.size();
+    if (events == 0 && m_block.texts.empty()) {
+        return true;
+    }
+
+    ArchiveBlockHeader header = {};
+    header.magic              = ARCHIVE_BLOCK_MAGIC;
+    header.events             = static_cast<uint32_t>(events);
+    header.texts              = static_cast<uint32_t>(m_block.texts.size());
+    header.minUs              = events ? m_block.timeUs[0] : 0;
+    header.maxUs              = header.minUs;
+    header.minParam1 = header.minParam2 = INT32_MAX;
+    header.maxParam1 = header.maxParam2 = INT32_MIN;
+
+    for (std::vector<uint8_t> &column : m_columns) {
+        column.clear();
+    }
+
+    // Time: first value, then delta-of-delta
+    m_values.clear();
+    uint64_t last = 0;
+    int64_t  step = 0;
+    for (size_t i = 0; i < events; i++) {
+        uint64_t value = m_block.timeUs[i];
+        if (i == 0) {
+            putVarint(m_columns[COLUMN_TIME], value);
+        } else {
+            int64_t delta = static_cast<int64_t>(value - last);
+            m_values.push_back(zigzag64(delta - step));
+            step = delta;
+        }
+        last         = value;
+        header.minUs = value < header.minUs ? value : header.minUs;
+        header.maxUs = value > header.maxUs ? value : header.maxUs;
+    }
+    putFrames(m_columns[COLUMN_TIME], m_values.data(), m_values.size());
+
+    // Opcodes: dictionary, events per entry, then one index per event
+    std::vector<uint8_t> &opcode  = m_columns[COLUMN_OPCODE];
+    const size_t          entries = m_dictionary.size() / 3;
+    std::vector<uint32_t> start(entries + 1, 0);
+    for (size_t i = 0; i < events; i++) {
+        start[m_opcodes[i] + 1]++;
+    }
+    opcode.push_back(static_cast<uint8_t>(entries));
+    opcode.insert(opcode.end(), m_dictionary.begin(), m_dictionary.end());
+    for (size_t entry = 0; entry < entries; entry++) {
+        putVarint(opcode, start[entry + 1]);
+        start[entry + 1] += start[entry];
+        header.opcodeMask |= archiveOpcodeBit(m_dictionary[entry * 3], m_dictionary[entry * 3 + 1]);
+    }
+    opcode.insert(opcode.end(), m_opcodes.begin(), m_opcodes.end());
+
+    // Parameters: grouped by opcode, each group delta coded on its own
+    std::vector<uint32_t> order(events);
+    std::vector<uint32_t> next(start.begin(), start.end() - 1);
+    for (size_t i = 0; i < events; i++) {
+        order[next[m_opcodes[i]]++] = static_cast<uint32_t>(i);
+    }
+    for (int column = COLUMN_PARAM1; column <= COLUMN_PARAM2; column++) {
+        const uint8_t  needed  = column == COLUMN_PARAM1 ? 1 : 2;
+        const int32_t *params  = column == COLUMN_PARAM1 ? m_block.param1.data() : m_block.param2.data();
+        int32_t       &minimum = column == COLUMN_PARAM1 ? header.minParam1 : header.minParam2;
+        int32_t       &maximum = column == COLUMN_PARAM1 ? header.maxParam1 : header.maxParam2;
+
+        for (size_t entry = 0; entry < entries; entry++) {
+            if (m_dictionary[entry * 3 + 2] < needed) {
+                continue;
+            }
+            int32_t previous = 0;
+            m_values.clear();
+            for (uint32_t rank = start[entry]; rank < start[entry + 1]; rank++) {
+                int32_t value = params[order[rank]];
+                m_values.push_back(zigzag32(static_cast<int32_t>(static_cast<uint32_t>(value) - previous)));
+                previous = value;
+                minimum  = value < minimum ? value : minimum;
+                maximum  = value > maximum ? value : maximum;
+            }
+            putFrames(m_columns[column], m_values.data(), m_values.size());
+        }
+    }
+
+    // Text lines: position delta, length, bytes
+    std::vector<uint8_t> &text     = m_columns[COLUMN_TEXT];
+    uint32_t              position = 0;
+    for (const ArchiveText &entry : m_block.texts) {
+        putVarint(text, entry.position - position);
+        putVarint(text, entry.line.size());
+        text.insert(text.end(), entry.line.begin(), entry.line.end());
+        position = entry.position;
+    }
+
+    size_t total = sizeof(header);
+    for (int column = 0; column < COLUMN_COUNT; column++) {
+        header.columnSize[column] = static_cast<uint32_t>(m_columns[column].size());
+        total += m_columns[column].size();
+    }
+
+    static const uint8_t padding[BLOCK_ALIGNMENT] = {};
+    bool                 ok = fwrite(&header, sizeof(header), 1, m_file) == 1;
+    for (int column = 0; ok && column < COLUMN_COUNT; column++) {
+        const std::vector<uint8_t> &bytes = m_columns[column];
+        ok = bytes.empty() || fwrite(bytes.data(), 1, bytes.size(), m_file) == bytes.size();
+    }
+    if (ok && alignBlock(total) != total) {
+        ok = fwrite(padding, 1, alignBlock(total) - total, m_file) == alignBlock(total) - total;
+    }
+    if (!ok) {
+        m_lastError = std::string("Write failed: ") + strerror(errno);
+        return false;
+    }
+    m_written += alignBlock(total);
+
+    m_block.clear();
+    m_opcodes.clear();
+    m_dictionary.clear();
+    memset(m_lookup, 0, sizeof(m_lookup));
+    return true;
+}
+
+bool CaptureArchiveWriter::close() {
+    if (!m_file) {
+        return true;
+    }
+
+    bool ok = flushBlock();
+    if (ok && m_flags) {
+        // The header went out before the lines were seen
+        if (fseek(m_file, offsetof(ArchiveHeader, flags), SEEK_SET) != 0 ||
+            fwrite(&m_flags, sizeof(m_flags), 1, m_file) != 1) {
+            m_lastError = std::string("Cannot write the header flags: ") + strerror(errno);
+            ok          = false;
+        }
+    }
+    if (fclose(m_file) != 0 && ok) {
+        m_lastError = std::string("Close failed: ") + strerror(errno);
+        ok          = false;
+    }
+    m_file = nullptr;
+    return ok;
+}
+
+// ==================== CaptureArchiveReader ====================
+
+CaptureArchiveReader::CaptureArchiveReader() : m_data(nullptr), m_size(0) {
+}
+
+CaptureArchiveReader::~CaptureArchiveReader() {
+    close();
+}
+
+bool CaptureArchiveReader::open(const char *path) {
+    close();
+
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        m_lastError = std::string("Cannot open ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < sizeof(ArchiveHeader)) {
+        m_lastError = std::string(path) + ": not an archive";
+        ::close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        m_lastError = std::string("Cannot map ") + path + ": " + strerror(errno);
+        return false;
+    }
+    m_data = static_cast<const uint8_t *>(mapping);
+    m_size = static_cast<size_t>(info.st_size);
+
+    const ArchiveHeader *header = reinterpret_cast<const ArchiveHeader *>(m_data);
+    if (header->magic != ARCHIVE_MAGIC || header->version != ARCHIVE_VERSION) {
+        m_lastError = std::string(path) + ": not an archive or unsupported version";
+        close();
+        return false;
+    }
+
+    size_t offset = alignBlock(sizeof(ArchiveHeader));
+    while (offset < m_size) {
+        if (m_size - offset < sizeof(ArchiveBlockHeader)) {
+            m_lastError = std::string(path) + ": truncated block header";
+            close();
+            return false;
+        }
+
+        const ArchiveBlockHeader *block = reinterpret_cast<const ArchiveBlockHeader *>(m_data + offset);
+        uint64_t                  total = sizeof(ArchiveBlockHeader);
+        for (int column = 0; column < COLUMN_COUNT; column++) {
+            total += block->columnSize[column];
+        }
+        if (block->magic != ARCHIVE_BLOCK_MAGIC || total > m_size - offset) {
+            m_lastError = std::string(path) + ": corrupt block at offset " + std::to_string(offset);
+            close();
+            return false;
+        }
+
+        m_blocks.push_back(block);
+        offset += alignBlock(static_cast<size_t>(total));
+    }
+    return true;
+}
+
+void CaptureArchiveReader::close() {
+    if (m_data) {
+        munmap(const_cast<uint8_t *>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    m_blocks.clear();
+}
+
+bool CaptureArchiveReader::decode(size_t index, ArchiveBlock &block) {
+    const ArchiveBlockHeader &header = *m_blocks[index];
+    const size_t              events = header.events;
+
+    const uint8_t *columns[COLUMN_COUNT + 1];
+    columns[0] = reinterpret_cast<const uint8_t *>(&header + 1);
+    for (int column = 0; column < COLUMN_COUNT; column++) {
+        columns[column + 1] = columns[column] + header.columnSize[column];
+    }
+
+    block.timeUs.resize(events);
+    block.device.resize(events);
+    block.event.resize(events);
+    block.paramCount.resize(events);
+    block.param1.resize(events);
+    block.param2.resize(events);
+    block.texts.clear();
+
+    // The columns are written through local pointers: stores through the
+    // uint8_t arrays would otherwise force the compiler to reload every
+    // vector's data pointer after each store
+    uint64_t *times  = block.timeUs.data();
+    uint8_t  *device = block.device.data();
+    uint8_t  *event  = block.event.data();
+    uint8_t  *counts = block.paramCount.data();
+
+    // Time
+    const uint8_t *readable = m_data + m_size;
+    const uint8_t *cursor   = columns[COLUMN_TIME];
+    const uint8_t *end      = columns[COLUMN_TIME + 1];
+    m_values.resize(events);
+    m_grouped[0].resize(events);
+    m_grouped[1].resize(events);
+    if (events > 0) {
+        uint64_t *steps = m_values.data();
+        uint64_t  value = 0;
+        if (!getVarint(cursor, end, value) || !getFrames(cursor, end, readable, steps, events - 1) ||
+            cursor != end) {
+            m_lastError = "Corrupt time column in block " + std::to_string(index);
+            return false;
+        }
+        int64_t step = 0;
+        times[0]     = value;
+        for (size_t i = 1; i < events; i++) {
+            step += unzigzag64(steps[i - 1]);
+            value += static_cast<uint64_t>(step);
+            times[i] = value;
+        }
+    }
+
+    // Opcodes
+    cursor         = columns[COLUMN_OPCODE];
+    end            = columns[COLUMN_OPCODE + 1];
+    size_t entries = cursor < end ? *cursor++ : 0;
+    if (static_cast<size_t>(end - cursor) < entries * 3) {
+        m_lastError = "Corrupt opcode column in block " + std::to_string(index);
+        return false;
+    }
+    const uint8_t *dictionary = cursor;
+    cursor += entries * 3;
+
+    uint32_t start[ARCHIVE_MAX_OPCODES + 1] = {};
+    for (size_t entry = 0; entry < entries; entry++) {
+        uint32_t used;
+        if (!getVarint32(cursor, end, used) || used > events - start[entry]) {
+            m_lastError = "Corrupt opcode column in block " + std::to_string(index);
+            return false;
+        }
+        start[entry + 1] = start[entry] + used;
+    }
+    if (start[entries] != events || static_cast<size_t>(end - cursor) != events) {
+        m_lastError = "Corrupt opcode column in block " + std::to_string(index);
+        return false;
+    }
+
+    const uint8_t *opcodes = cursor;
+    for (size_t i = 0; i < events; i++) {
+        uint8_t op = opcodes[i];
+        if (op >= entries) {
+            m_lastError = "Corrupt opcode index in block " + std::to_string(index);
+            return false;
+        }
+        device[i] = dictionary[op * 3];
+        event[i]  = dictionary[op * 3 + 1];
+        counts[i] = dictionary[op * 3 + 2];
+    }
+
+    // Parameters: every opcode group is unpacked and prefix-summed on its
+    // own, so the running value stays in a register; opcodes without the
+    // parameter get zeros
+    for (int column = COLUMN_PARAM1; column <= COLUMN_PARAM2; column++) {
+        const uint8_t needed = column == COLUMN_PARAM1 ? 1 : 2;
+        int32_t      *dense  = m_grouped[column - COLUMN_PARAM1].data();
+
+        cursor = columns[column];
+        end    = columns[column + 1];
+        for (size_t entry = 0; entry < entries; entry++) {
+            size_t used = start[entry + 1] - start[entry];
+            if (dictionary[entry * 3 + 2] < needed) {
+                memset(dense + start[entry], 0, used * sizeof(int32_t));
+                continue;
+            }
+            if (!getFrames(cursor, end, readable, m_values.data(), used)) {
+                m_lastError = "Corrupt parameter column in block " + std::to_string(index);
+                return false;
+            }
+            uint32_t value = 0;
+            for (size_t rank = 0; rank < used; rank++) {
+                value += static_cast<uint32_t>(unzigzag32(static_cast<uint32_t>(m_values[rank])));
+                dense[start[entry] + rank] = static_cast<int32_t>(value);
+            }
+        }
+        if (cursor != end) {
+            m_lastError = "Corrupt parameter column in block " + std::to_string(index);
+            return false;
+        }
+    }
+
+    // Back to event order: each event takes the next value of its group
+    const int32_t *grouped1 = m_grouped[0].data();
+    const int32_t *grouped2 = m_grouped[1].data();
+    int32_t       *param1   = block.param1.data();
+    int32_t       *param2   = block.param2.data();
+    uint32_t       next[ARCHIVE_MAX_OPCODES];
+    memcpy(next, start, sizeof(next));
+    for (size_t i = 0; i < events; i++) {
+        uint32_t rank = next[opcodes[i]]++;
+        if (rank >= events) {
+            m_lastError = "Corrupt opcode index in block " + std::to_string(index);
+            return false;
+        }
+        param1[i] = grouped1[rank];
+        param2[i] = grouped2[rank];
+    }
+
+    // Text lines
+    cursor            = columns[COLUMN_TEXT];
+    end               = columns[COLUMN_TEXT + 1];
+    uint32_t position = 0;
+    for (uint32_t i = 0; i < header.texts; i++) {
+        uint32_t delta;
+        uint32_t length;
+        if (!getVarint32(cursor, end, delta) || !getVarint32(cursor, end, length) ||
+            static_cast<size_t>(end - cursor) < length || position + delta > events) {
+            m_lastError = "Corrupt text column in block " + std::to_string(index);
+            return false;
+        }
+        position += delta;
+        ArchiveText text = {position, std::string(reinterpret_cast<const char *>(cursor), length)};
+        block.texts.push_back(std::move(text));
+        cursor += length;
+    }
+    return true;
+}
+
+// ==================== Text output ====================
+
+void appendCaptureText(const ArchiveBlock &block, std::string &output) {
+    char   line[MAX_CAPTURE_LINE];
+    size_t text = 0;
+
+    for (size_t i = 0; i <= block.size(); i++) {
+        while (text < block.texts.size() && block.texts[text].position == i) {
+            output += block.texts[text].line;
+            output += '\n';
+            text++;
+        }
+        if (i == block.size()) {
+            break;
+        }
+        size_t length = formatCaptureLine(line, block.timeUs[i], block.device[i], block.event[i],
+                                          block.paramCount[i], block.param1[i], block.param2[i]);
+        output.append(line, length);
+    }
+}
@@ -0,0 +1,290 @@
+/**
+ * @file CaptureArchive.h
+ * @brief Columnar compressed archive of capture files
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * An archive is a file header followed by independent blocks of up to
+ * ARCHIVE_BLOCK_EVENTS events. Every block stores its events column by
+ * column:
+ *
+ * - time:   first timestamp (varint), then zig-zag delta-of-deltas
+ * - opcode: block dictionary of (device, event, paramCount) triples,
+ *           event count per entry, then one dictionary index byte per event
+ * - param1: per opcode (dictionary order), zig-zag deltas between the
+ *           param1 values of that opcode's events
+ * - param2: same for param2
+ * - text:   every other line with its position (varints): comments,
+ *           malformed lines and events that formatCaptureLine() would
+ *           not write back byte for byte (time tokens, hex case, signs,
+ *           leading zeros, extra blanks, "\r")
+ *
+ * Deltas are bit-packed in frames of 128 values. Each frame is one byte
+ * holding the bit width of its largest value, followed by the values at
+ * that width. A frame decodes without branching on individual values,
+ * which byte varints cannot do.
+ *
+ * The block header carries the time range, a mask of the opcodes that
+ * occur and the parameter ranges, so readers can skip blocks without
+ * decoding them. Blocks are written in host byte order (little endian
+ * on all supported hosts).
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef CAPTURE_ARCHIVE_H
+#define CAPTURE_ARCHIVE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "CaptureFormat.h"
+
+const uint32_t ARCHIVE_MAGIC        = 0x414D4953; ///< "SIMA"
+const uint32_t ARCHIVE_BLOCK_MAGIC  = 0x424D4953; ///< "SIMB"
+const uint16_t ARCHIVE_VERSION      = 1;
+const uint32_t ARCHIVE_BLOCK_EVENTS = 65536; ///< Events per block
+const size_t   ARCHIVE_MAX_OPCODES  = 255;   ///< Dictionary entries per block
+
+const uint16_t ARCHIVE_FLAG_UNTERMINATED = 1; ///< The capture's last line had no "\n"
+
+/**
+ * @brief Archive file header
+ */
+struct ArchiveHeader {
+    uint32_t magic;       ///< ARCHIVE_MAGIC
+    uint16_t version;     ///< ARCHIVE_VERSION
+    uint16_t flags;       ///< ARCHIVE_FLAG_* bits
+    uint32_t blockEvents; ///< Maximum events per block
+};
+
+/**
+ * @brief Column indices of a block
+ */
+enum ArchiveColumn : uint8_t {
+    COLUMN_TIME   = 0,
+    COLUMN_OPCODE = 1,
+    COLUMN_PARAM1 = 2,
+    COLUMN_PARAM2 = 3,
+    COLUMN_TEXT   = 4,
+    COLUMN_COUNT  = 5
+};
+
+/**
+ * @brief Block header with the statistics used for skipping
+ */
+struct ArchiveBlockHeader {
+    uint32_t magic;                    ///< ARCHIVE_BLOCK_MAGIC
+    uint32_t events;                   ///< Events in the block
+    uint32_t texts;                    ///< Text lines in the block
+    uint32_t opcodeMask;               ///< Bit device * 16 + min(event, 15) per opcode present
+    uint64_t minUs;                    ///< Earliest event time
+    uint64_t maxUs;                    ///< Latest event time
+    int32_t  minParam1;                ///< Smallest param1 (events with parameters)
+    int32_t  maxParam1;                ///< Largest param1
+    int32_t  minParam2;                ///< Smallest param2
+    int32_t  maxParam2;                ///< Largest param2
+    uint32_t columnSize[COLUMN_COUNT]; ///< Bytes per column, in column order
+    uint32_t reserved;                 ///< Zero
+};
+
+/**
+ * @brief Opcode bit for ArchiveBlockHeader::opcodeMask
+ */
+inline uint32_t archiveOpcodeBit(uint8_t device, uint8_t event) {
+    return 1u << ((device & 1) * 16 + (event < 15 ? event : 15));
+}
+
+/**
+ * @brief Line kept verbatim in a block
+ */
+struct ArchiveText {
+    uint32_t    position; ///< Number of block events before the line
+    std::string line;     ///< Line without terminator
+};
+
+/**
+ * @brief Decoded block, one array per column
+ */
+struct ArchiveBlock {
+    std::vector<uint64_t>    timeUs;
+    std::vector<uint8_t>     device;
+    std::vector<uint8_t>     event;
+    std::vector<uint8_t>     paramCount;
+    std::vector<int32_t>     param1;
+    std::vector<int32_t>     param2;
+    std::vector<ArchiveText> texts;
+
+    inline size_t size() const {
+        return timeUs.size();
+    }
+
+    void clear();
+};
+
+/**
+ * @brief Appends capture lines to a new archive
+ */
+class CaptureArchiveWriter {
+  public:
+    CaptureArchiveWriter();
+    ~CaptureArchiveWriter();
+
+    CaptureArchiveWriter(const CaptureArchiveWriter &)            = delete;
+    CaptureArchiveWriter &operator=(const CaptureArchiveWriter &) = delete;
+
+    /**
+     * @brief Create the archive file
+     * @param path Archive path (truncated)
+     * @return false on failure, see lastError()
+     */
+    bool open(const char *path);
+
+    /**
+     * @brief Append one decoded capture line
+     * @param record Event, comment or malformed line
+     * @param line Original line text, without "\n"
+     * @param length Line length
+     * @return false on write failure
+     *
+     * Events go to the columns only if formatCaptureLine() writes them
+     * back as line; the rest is kept as text.
+     */
+    bool add(const CaptureRecord &record, const char *line, size_t length);
+
+    /**
+     * @brief Record that the last line added had no "\n" (see close())
+     */
+    inline void setUnterminated() {
+        m_flags |= ARCHIVE_FLAG_UNTERMINATED;
+    }
+
+    /**
+     * @brief Flush the last block, write the header flags and close the file
+     * @return false on failure, see lastError()
+     */
+    bool close();
+
+    /**
+     * @brief Bytes written so far
+     * @return Archive size
+     */
+    inline uint64_t bytesWritten() const {
+        return m_written;
+    }
+
+    /**
+     * @brief Lines kept as text so far
+     * @return Comments, malformed lines and events that were not written back verbatim
+     */
+    inline uint64_t textLines() const {
+        return m_texts;
+    }
+
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    FILE                 *m_file;                  ///< Archive file, nullptr when closed
+    ArchiveBlock          m_block;                 ///< Events of the block being filled
+    std::vector<uint8_t>  m_opcodes;               ///< Dictionary index per event
+    uint32_t              m_lookup[2][256][3];     ///< Opcode -> dictionary index + 1, 0 when absent
+    std::vector<uint8_t>  m_dictionary;            ///< (device, event, paramCount) triples
+    std::vector<uint8_t>  m_columns[COLUMN_COUNT]; ///< Encoding buffers
+    std::vector<uint64_t> m_values;                ///< Column being encoded
+    uint64_t              m_written;               ///< Bytes written
+    uint64_t              m_texts;                 ///< Lines kept as text
+    uint16_t              m_flags;                 ///< ARCHIVE_FLAG_* bits for the header
+    std::string           m_lastError;             ///< Last failure description
+
+    bool flushBlock();
+};
+
+/**
+ * @brief Random access to the blocks of a mapped archive
+ */
+class CaptureArchiveReader {
+  public:
+    CaptureArchiveReader();
+    ~CaptureArchiveReader();
+
+    CaptureArchiveReader(const CaptureArchiveReader &)            = delete;
+    CaptureArchiveReader &operator=(const CaptureArchiveReader &) = delete;
+
+    /**
+     * @brief Map an archive and index its blocks
+     * @param path Archive path
+     * @return false on failure, see lastError()
+     */
+    bool open(const char *path);
+
+    /**
+     * @brief Unmap the archive
+     */
+    void close();
+
+    inline size_t blockCount() const {
+        return m_blocks.size();
+    }
+
+    /**
+     * @brief Header flags of the archive
+     * @return ARCHIVE_FLAG_* bits
+     */
+    inline uint16_t flags() const {
+        return reinterpret_cast<const ArchiveHeader *>(m_data)->flags;
+    }
+
+    /**
+     * @brief Header of one block (no decoding)
+     * @param index Block index
+     * @return Block header
+     */
+    inline const ArchiveBlockHeader &header(size_t index) const {
+        return *m_blocks[index];
+    }
+
+    /**
+     * @brief Decode one block
+     * @param index Block index
+     * @param block Receives the columns (storage is reused)
+     * @return false if the block is corrupt, see lastError()
+     */
+    bool decode(size_t index, ArchiveBlock &block);
+
+    /**
+     * @brief Size of the mapped archive
+     * @return Bytes
+     */
+    inline size_t size() const {
+        return m_size;
+    }
+
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    const uint8_t                          *m_data;       ///< Mapped archive
+    size_t                                  m_size;       ///< Mapped bytes
+    std::vector<const ArchiveBlockHeader *> m_blocks;     ///< Block headers in file order
+    std::vector<uint64_t>                   m_values;     ///< Unpacked column of the block being decoded
+    std::vector<int32_t>                    m_grouped[2]; ///< Parameters in opcode group order
+    std::string                             m_lastError;  ///< Last failure description
+};
+
+/**
+ * @brief Write the capture lines of a decoded block
+ * @param block Decoded block
+ * @param output Receives the lines (appended)
+ *
+ * Events are written with formatCaptureLine(), text lines as stored,
+ * each terminated by "\n".
+ */
+void appendCaptureText(const ArchiveBlock &block, std::string &output);
+
+#endif // CAPTURE_ARCHIVE_H
@@ -0,0 +1,90 @@
+/**
+ * @file CaptureFormat.cpp
+ * @brief Implementation of the capture line format
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "CaptureFormat.h"
+
+namespace {
+
+/**
+ * @brief Append a number in a base, upper-case digits, as printf's %llu and %X
+ * @return Position after the digits
+ */
+char *appendUnsigned(char *out, uint64_t value, unsigned base) {
+    char   digits[20];
+    size_t count = 0;
+    do {
+        unsigned digit  = static_cast<unsigned>(value % base);
+        digits[count++] = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= base;
+    } while (value > 0);
+    while (count > 0) {
+        *out++ = digits[--count];
+    }
+    return out;
+}
+
+char *appendSigned(char *out, int32_t value) {
+    if (value < 0) {
+        *out++ = '-';
+        return appendUnsigned(out, 0ULL - static_cast<uint64_t>(static_cast<int64_t>(value)), 10);
+    }
+    return appendUnsigned(out, static_cast<uint64_t>(value), 10);
+}
+
+} // namespace
+
+void parseCaptureLine(const char *line, size_t length, CaptureRecord &record) {
+    const char *cursor = line;
+    const char *end    = line + length;
+    uint64_t    timeUs = 0;
+
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+        cursor++;
+    }
+
+    const char *digits = cursor;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        timeUs = timeUs * 10 + static_cast<uint64_t>(*cursor - '0');
+        cursor++;
+    }
+
+    if (cursor == digits || cursor == end || (*cursor != ' ' && *cursor != '\t')) {
+        // No timestamp: comments are kept as such, anything else is malformed
+        ProtocolDecoder::decodeLine(line, length, record.frame);
+        if (record.frame.kind == FrameKind::EVENT) {
+            record.frame.kind = FrameKind::INVALID;
+        }
+        record.timeUs = 0;
+        return;
+    }
+
+    record.timeUs = timeUs;
+    ProtocolDecoder::decodeLine(cursor, static_cast<size_t>(end - cursor), record.frame);
+}
+
+size_t formatCaptureLine(char *buffer, uint64_t timeUs, uint8_t device, uint8_t event, uint8_t paramCount,
+                         int32_t param1, int32_t param2) {
+    const bool keyboard = device == static_cast<uint8_t>(Device::KEYBOARD);
+    char      *out      = appendUnsigned(buffer, timeUs, 10);
+
+    *out++ = ' ';
+    out    = appendUnsigned(out, device, 10);
+    *out++ = ' ';
+    out    = appendUnsigned(out, event, 10);
+    if (paramCount >= 1) {
+        *out++ = ' ';
+        out    = keyboard ? appendUnsigned(out, static_cast<uint32_t>(param1), 16) : appendSigned(out, param1);
+    }
+    if (paramCount >= 2) {
+        *out++ = ' ';
+        out    = appendSigned(out, param2);
+    }
+    *out++ = '\n';
+    return static_cast<size_t>(out - buffer);
+}
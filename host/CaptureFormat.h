@@ -0,0 +1,86 @@
+/**
+ * @file CaptureFormat.h
+ * @brief Recorded event streams: one timestamped protocol frame per line
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Capture line format:
+ * TIME_US DEVICE EVENT [PARAM1] [PARAM2]
+ *
+ * TIME_US is a decimal timestamp in microseconds (serial-input-tap -r
+ * writes CLOCK_MONOTONIC time); the rest is the wire frame unchanged, so
+ * keyboard key codes stay hexadecimal. Comment lines ('#') are kept.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef CAPTURE_FORMAT_H
+#define CAPTURE_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ProtocolDecoder.h"
+
+/**
+ * @brief One decoded capture line
+ */
+struct CaptureRecord {
+    uint64_t      timeUs; ///< Timestamp (0 for lines without one)
+    ProtocolFrame frame;  ///< Decoded frame; INVALID when malformed
+};
+
+/**
+ * @brief Decode one capture line (without terminator)
+ * @param line Line text
+ * @param length Line length
+ * @param record Receives the decoded line
+ */
+void parseCaptureLine(const char *line, size_t length, CaptureRecord &record);
+
+/**
+ * @brief Format one capture line (with "\n")
+ * @param buffer Destination, at least MAX_CAPTURE_LINE bytes
+ * @param timeUs Timestamp
+ * @param device Device code
+ * @param event Event code
+ * @param paramCount Parameters to write (0-2)
+ * @param param1 First parameter
+ * @param param2 Second parameter
+ * @return Line length
+ */
+size_t formatCaptureLine(char *buffer, uint64_t timeUs, uint8_t device, uint8_t event, uint8_t paramCount,
+                         int32_t param1, int32_t param2);
+
+const size_t MAX_CAPTURE_LINE = 64; ///< Longest line formatCaptureLine() writes
+
+/**
+ * @brief Decode every line of a capture buffer
+ * @param data Capture bytes
+ * @param size Number of bytes
+ * @param handler Called as handler(const CaptureRecord &) for each non-empty line
+ *
+ * A final line without terminator is decoded as well.
+ */
+template <typename Handler> void forEachCaptureLine(const char *data, size_t size, Handler &&handler) {
+    const char   *end = data + size;
+    CaptureRecord record;
+
+    while (data < end) {
+        const char *newline = static_cast<const char *>(memchr(data, '\n', end - data));
+        const char *lineEnd = newline ? newline : end;
+        size_t      length  = lineEnd - data;
+
+        if (length > 0 && data[length - 1] == '\r') {
+            length--;
+        }
+        if (length > 0) {
+            parseCaptureLine(data, length, record);
+            handler(static_cast<const CaptureRecord &>(record));
+        }
+        data = lineEnd + 1;
+    }
+}
+
+#endif // CAPTURE_FORMAT_H
@@ -0,0 +1,195 @@
+/**
+ * @file ClockSync.cpp
+ * @brief Implementation of the device/host clock mapping
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "ClockSync.h"
+
+#include <stdio.h>
+#include <time.h>
+
+#include "SerialInputProtocol.h"
+
+namespace {
+
+const int64_t MIN_DRIFT_SPAN_US = 2000000; ///< Shorter baselines give too noisy a slope
+const int64_t MAX_DRIFT_DIVISOR = 50;       ///< Clocks disagreeing by over 1/50 (2 %): the device restarted
+const int64_t RESTART_SLACK_NS  = 20000000; ///< Allowed disagreement on top of the 2 %
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+/**
+ * @brief Parse the next hexadecimal field of a sync line
+ * @param cursor Current position, advanced past the field
+ * @param end End of line
+ * @param value Receives the value
+ * @return false if no field follows
+ */
+bool parseHex(const char *&cursor, const char *end, uint32_t &value) {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+        cursor++;
+    }
+
+    const char *start  = cursor;
+    uint32_t    result = 0;
+    while (cursor < end && cursor - start < 8) {
+        char c = *cursor;
+        if (c >= '0' && c <= '9') {
+            result = result * 16 + static_cast<uint32_t>(c - '0');
+        } else if (c >= 'A' && c <= 'F') {
+            result = result * 16 + static_cast<uint32_t>(c - 'A' + 10);
+        } else if (c >= 'a' && c <= 'f') {
+            result = result * 16 + static_cast<uint32_t>(c - 'a' + 10);
+        } else {
+            break;
+        }
+        cursor++;
+    }
+
+    value = result;
+    return cursor > start && (cursor == end || *cursor == ' ' || *cursor == '\t');
+}
+
+/**
+ * @brief Index of the lowest-delay sample in a range of the window
+ */
+size_t bestSample(const ClockSample *window, size_t capacity, size_t first, size_t count) {
+    size_t best = first % capacity;
+    for (size_t i = 1; i < count; i++) {
+        size_t index = (first + i) % capacity;
+        if (window[index].delayNs <= window[best].delayNs) {
+            best = index; // Ties go to the newer sample
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+ClockSync::ClockSync() {
+    reset();
+}
+
+void ClockSync::reset() {
+    for (Pending &pending : m_pending) {
+        pending = Pending();
+    }
+    m_count    = 0;
+    m_next     = 0;
+    m_anchor   = ClockSample();
+    m_driftPpb = 0;
+    m_samples  = 0;
+}
+
+size_t ClockSync::handleLine(const char *line, size_t length, uint64_t receivedNs, char *answer) {
+    const char *end = line + length;
+    while (line < end && (*line == ' ' || *line == '\t')) {
+        line++;
+    }
+    if (end - line < 2 || line[0] != SYNC_PREFIX) {
+        return 0;
+    }
+
+    char        type   = line[1];
+    const char *cursor = line + 2;
+    uint32_t    seq;
+    if (!parseHex(cursor, end, seq) || seq > 0xFF) {
+        return 0;
+    }
+
+    if (type == static_cast<char>(SyncMessage::PING)) {
+        int written = snprintf(answer, CLOCK_SYNC_MAX_ANSWER, "%c%c %X\n", SYNC_PREFIX,
+                               static_cast<char>(SyncMessage::ANSWER), static_cast<unsigned>(seq));
+
+        Pending &pending   = m_pending[seq & 3];
+        pending.valid      = true;
+        pending.seq        = static_cast<uint8_t>(seq);
+        pending.receivedNs = receivedNs;
+        pending.answeredNs = monotonicNs();
+        return written > 0 ? static_cast<size_t>(written) : 0;
+    }
+
+    uint32_t pingUs, answerUs;
+    if (type == static_cast<char>(SyncMessage::REPORT) && parseHex(cursor, end, pingUs) &&
+        parseHex(cursor, end, answerUs)) {
+        Pending &pending = m_pending[seq & 3];
+        if (pending.valid && pending.seq == seq) {
+            pending.valid = false;
+            addSample(pending, pingUs, answerUs);
+        }
+    }
+    return 0;
+}
+
+void ClockSync::addSample(const Pending &pending, uint32_t pingUs, uint32_t answerUs) {
+    uint32_t roundTripUs = answerUs - pingUs;
+    uint64_t turnaround  = pending.answeredNs - pending.receivedNs;
+
+    ClockSample sample;
+    sample.hostNs  = pending.receivedNs + turnaround / 2;
+    sample.delayNs = static_cast<uint64_t>(roundTripUs) * 1000 > turnaround
+                         ? static_cast<uint64_t>(roundTripUs) * 1000 - turnaround
+                         : 0;
+    sample.deviceUs = static_cast<int64_t>(pingUs) + roundTripUs / 2;
+
+    if (m_count > 0) {
+        const ClockSample &last = m_window[(m_next + CLOCK_SYNC_WINDOW - 1) % CLOCK_SYNC_WINDOW];
+
+        // Unwrap against the previous sample, then check both clocks advanced
+        // alike, up to the error a slow exchange can add to either sample
+        int64_t elapsedUs = static_cast<int32_t>(static_cast<uint32_t>(sample.deviceUs) -
+                                                 static_cast<uint32_t>(last.deviceUs));
+        sample.deviceUs   = last.deviceUs + elapsedUs;
+
+        int64_t hostElapsedNs = static_cast<int64_t>(sample.hostNs - last.hostNs);
+        int64_t disagreement  = hostElapsedNs - elapsedUs * 1000;
+        if (disagreement < 0) {
+            disagreement = -disagreement;
+        }
+        int64_t tolerance = RESTART_SLACK_NS + hostElapsedNs / MAX_DRIFT_DIVISOR +
+                            static_cast<int64_t>(sample.delayNs + last.delayNs);
+        if (elapsedUs < 0 || disagreement > tolerance) {
+            reset();
+            sample.deviceUs = static_cast<int64_t>(pingUs) + roundTripUs / 2;
+        }
+    }
+
+    m_window[m_next] = sample;
+    m_next           = (m_next + 1) % CLOCK_SYNC_WINDOW;
+    if (m_count < CLOCK_SYNC_WINDOW) {
+        m_count++;
+    }
+    m_samples++;
+    update();
+}
+
+void ClockSync::update() {
+    size_t first   = (m_next + CLOCK_SYNC_WINDOW - m_count) % CLOCK_SYNC_WINDOW;
+    size_t quarter = m_count >= 4 ? m_count / 4 : 1;
+    m_anchor       = m_window[bestSample(m_window, CLOCK_SYNC_WINDOW, first + m_count - quarter, quarter)];
+
+    if (m_count < 2) {
+        return;
+    }
+
+    const ClockSample &base = m_window[bestSample(m_window, CLOCK_SYNC_WINDOW, first, quarter)];
+    int64_t            span = m_anchor.deviceUs - base.deviceUs;
+    if (span < MIN_DRIFT_SPAN_US) {
+        return;
+    }
+    int64_t error = static_cast<int64_t>(m_anchor.hostNs - base.hostNs) - span * 1000;
+    m_driftPpb    = error * 1000000 / span;
+}
+
+uint64_t ClockSync::toHostNs(uint32_t deviceUs) const {
+    int64_t elapsedUs = static_cast<int32_t>(deviceUs - static_cast<uint32_t>(m_anchor.deviceUs));
+    return m_anchor.hostNs + elapsedUs * 1000 + elapsedUs * m_driftPpb / 1000000;
+}
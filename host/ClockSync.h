@@ -0,0 +1,133 @@
+/**
+ * @file ClockSync.h
+ * @brief Maps device micros() timestamps to host CLOCK_MONOTONIC time
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * The device pings periodically (~P SEQ), the host answers at once
+ * (~A SEQ) and the device reports when its ping had left and when the
+ * answer arrived (~R SEQ T1 T4). With the host receive and answer times
+ * T2 and T3, each exchange gives one sample:
+ *
+ *   device midpoint (T1 + T4) / 2  <->  host midpoint (T2 + T3) / 2
+ *   delay = (T4 - T1) - (T3 - T2)
+ *
+ * The midpoints coincide when both directions take equally long, so
+ * samples with the smallest delay are the most trustworthy. Of the last
+ * CLOCK_SYNC_WINDOW samples, the lowest-delay one of the newest quarter
+ * anchors the mapping, and its slope to the lowest-delay one of the
+ * oldest quarter gives the drift (at least half a window apart).
+ * Everything is integer arithmetic (ns, us and parts per billion).
+ *
+ * Device times are 32 bit and wrap every 71 minutes; they are unwrapped
+ * against the anchor sample, so events within 35 minutes of it map
+ * correctly. A device restart is detected from samples whose device and
+ * host elapsed times disagree by more than their delays explain, and
+ * starts over.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef CLOCK_SYNC_H
+#define CLOCK_SYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+const size_t CLOCK_SYNC_WINDOW     = 32; ///< Samples kept (32 s at the default ping interval)
+const size_t CLOCK_SYNC_MAX_ANSWER = 16; ///< Buffer size for ClockSync::handleLine()
+
+/**
+ * @brief One ping exchange
+ */
+struct ClockSample {
+    int64_t  deviceUs; ///< Unwrapped device time at the midpoint of the exchange
+    uint64_t hostNs;   ///< Host time at the midpoint
+    uint64_t delayNs;  ///< Round trip minus the host's turnaround
+};
+
+/**
+ * @brief Clock offset and drift estimator for one device
+ */
+class ClockSync {
+  public:
+    ClockSync();
+
+    /**
+     * @brief Forget all samples (e.g. when the port is reopened)
+     */
+    void reset();
+
+    /**
+     * @brief Handle a sync line from the device
+     * @param line Line text (FrameKind::SYNC)
+     * @param length Line length
+     * @param receivedNs CLOCK_MONOTONIC time the line was read
+     * @param answer Receives the answer, at least CLOCK_SYNC_MAX_ANSWER bytes
+     * @return Answer length (write it to the port right away), 0 if none
+     */
+    size_t handleLine(const char *line, size_t length, uint64_t receivedNs, char *answer);
+
+    /**
+     * @brief Check if device times can be mapped
+     * @return true once an exchange has completed
+     */
+    inline bool synced() const {
+        return m_count > 0;
+    }
+
+    /**
+     * @brief Map a device timestamp to host time
+     * @param deviceUs Device micros() from an event's @TIME token
+     * @return CLOCK_MONOTONIC time in ns (meaningless before synced())
+     */
+    uint64_t toHostNs(uint32_t deviceUs) const;
+
+    /**
+     * @brief Estimated device clock error
+     * @return Parts per billion the host clock runs faster than the device's
+     */
+    inline int64_t driftPpb() const {
+        return m_driftPpb;
+    }
+
+    /**
+     * @brief Delay of the sample anchoring the mapping
+     * @return Round trip in ns; the mapping error is at most half of it
+     */
+    inline uint64_t delayNs() const {
+        return m_anchor.delayNs;
+    }
+
+    /**
+     * @brief Completed exchanges since the last reset
+     * @return Sample count
+     */
+    inline uint64_t samples() const {
+        return m_samples;
+    }
+
+  private:
+    /**
+     * @brief Host side of a ping waiting for its report
+     */
+    struct Pending {
+        bool     valid;      ///< Slot in use
+        uint8_t  seq;        ///< Ping sequence number
+        uint64_t receivedNs; ///< T2
+        uint64_t answeredNs; ///< T3
+    };
+
+    Pending     m_pending[4];                ///< Indexed by seq & 3
+    ClockSample m_window[CLOCK_SYNC_WINDOW]; ///< Ring of recent samples
+    size_t      m_count;                     ///< Samples in m_window
+    size_t      m_next;                      ///< Next m_window slot
+    ClockSample m_anchor;                    ///< Sample the mapping starts from
+    int64_t     m_driftPpb;                  ///< Host ns per device us, minus 1000, in ppb
+    uint64_t    m_samples;                   ///< Completed exchanges
+
+    void addSample(const Pending &pending, uint32_t pingUs, uint32_t answerUs);
+    void update();
+};
+
+#endif // CLOCK_SYNC_H
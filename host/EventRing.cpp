@@ -0,0 +1,280 @@
+/**
+ * @file EventRing.cpp
+ * @brief Implementation of the shared-memory event ring
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "EventRing.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <new>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+
+const uint32_t EVENT_RING_MAGIC   = 0x53494D52; ///< "SIMR"
+const uint32_t EVENT_RING_VERSION = 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring needs lock-free 64-bit atomics");
+static_assert(sizeof(RingEvent) == 24, "RingEvent layout is shared between processes");
+
+/**
+ * @brief Offset of the first slot (header rounded up to a cache line)
+ */
+size_t slotOffset() {
+    return (sizeof(EventRingHeader) + 63) & ~static_cast<size_t>(63);
+}
+
+size_t mappingSize(uint32_t capacity) {
+    return slotOffset() + static_cast<size_t>(capacity) * sizeof(EventRingSlot);
+}
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+long futex(const std::atomic<uint32_t> *word, int op, uint32_t value, const timespec *timeout) {
+    // The word is shared between processes, so the non-private futex ops are used
+    return syscall(SYS_futex, reinterpret_cast<const uint32_t *>(word), op, value, timeout, nullptr, 0);
+}
+
+} // namespace
+
+// ==================== WRITER ====================
+
+EventRingWriter::EventRingWriter() : m_header(nullptr), m_slots(nullptr), m_size(0), m_next(0), m_mask(0) {
+}
+
+EventRingWriter::~EventRingWriter() {
+    close();
+}
+
+bool EventRingWriter::create(const char *name, uint32_t capacity) {
+    close();
+
+    uint32_t slots = 1;
+    while (slots < capacity && slots < (1u << 30)) {
+        slots <<= 1;
+    }
+
+    shm_unlink(name);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        m_lastError = std::string("shm_open failed for ") + name + ": " + strerror(errno);
+        return false;
+    }
+
+    size_t size = mappingSize(slots);
+    if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+        m_lastError = std::string("ftruncate failed: ") + strerror(errno);
+        ::close(fd);
+        shm_unlink(name);
+        return false;
+    }
+
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        m_lastError = std::string("mmap failed: ") + strerror(errno);
+        shm_unlink(name);
+        return false;
+    }
+
+    // ftruncate zero-fills, so every slot starts with sequence 0 (never written)
+    m_header = new (memory) EventRingHeader();
+    m_slots  = reinterpret_cast<EventRingSlot *>(static_cast<char *>(memory) + slotOffset());
+    m_size   = size;
+    m_next   = 0;
+    m_mask   = slots - 1;
+    m_name   = name;
+
+    m_header->capacity = slots;
+    m_header->version  = EVENT_RING_VERSION;
+    m_header->head.store(0, std::memory_order_relaxed);
+    // Readers check the magic last; publish it after the rest of the header
+    std::atomic_thread_fence(std::memory_order_release);
+    m_header->magic = EVENT_RING_MAGIC;
+    return true;
+}
+
+void EventRingWriter::close() {
+    if (m_header) {
+        munmap(m_header, m_size);
+        shm_unlink(m_name.c_str());
+        m_header = nullptr;
+        m_slots  = nullptr;
+    }
+}
+
+void EventRingWriter::publish(const RingEvent &event) {
+    if (!m_header) {
+        return;
+    }
+
+    EventRingSlot &slot = m_slots[m_next & m_mask];
+    slot.sequence.store(2 * m_next + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.event = event;
+    slot.sequence.store(2 * m_next + 2, std::memory_order_release);
+
+    m_next++;
+    m_header->head.store(m_next, std::memory_order_release);
+}
+
+void EventRingWriter::notify() {
+    if (!m_header) {
+        return;
+    }
+
+    // Readers map the ring read-only and cannot announce themselves, so
+    // every batch wakes unconditionally (one syscall per flush)
+    m_header->wake.fetch_add(1, std::memory_order_release);
+    futex(&m_header->wake, FUTEX_WAKE, INT32_MAX, nullptr);
+}
+
+// ==================== READER ====================
+
+EventRingReader::EventRingReader()
+    : m_header(nullptr), m_slots(nullptr), m_size(0), m_next(0), m_lost(0), m_mask(0) {
+}
+
+EventRingReader::~EventRingReader() {
+    close();
+}
+
+bool EventRingReader::open(const char *name, bool fromStart) {
+    close();
+
+    int fd = shm_open(name, O_RDONLY | O_CLOEXEC, 0);
+    if (fd < 0) {
+        m_lastError = std::string("shm_open failed for ") + name + ": " + strerror(errno);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || static_cast<size_t>(info.st_size) < slotOffset()) {
+        m_lastError = std::string(name) + " is not an event ring";
+        ::close(fd);
+        return false;
+    }
+
+    // Read-only mapping: readers can never disturb the writer or each other
+    size_t size   = static_cast<size_t>(info.st_size);
+    void  *memory = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        m_lastError = std::string("mmap failed: ") + strerror(errno);
+        return false;
+    }
+
+    const EventRingHeader *header = static_cast<const EventRingHeader *>(memory);
+    if (header->magic != EVENT_RING_MAGIC || header->version != EVENT_RING_VERSION ||
+        mappingSize(header->capacity) > size) {
+        m_lastError = std::string(name) + " is not a compatible event ring";
+        munmap(memory, size);
+        return false;
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    m_header = header;
+    m_slots  = reinterpret_cast<const EventRingSlot *>(static_cast<const char *>(memory) + slotOffset());
+    m_size   = size;
+    m_mask   = header->capacity - 1;
+    m_lost   = 0;
+
+    uint64_t head = header->head.load(std::memory_order_acquire);
+    m_next        = head;
+    if (fromStart) {
+        m_next = head > header->capacity ? head - header->capacity : 0;
+    }
+    return true;
+}
+
+void EventRingReader::close() {
+    if (m_header) {
+        munmap(const_cast<EventRingHeader *>(m_header), m_size);
+        m_header = nullptr;
+        m_slots  = nullptr;
+    }
+}
+
+RingRead EventRingReader::next(RingEvent &event) {
+    if (!m_header) {
+        return RingRead::EMPTY;
+    }
+
+    const EventRingSlot &slot     = m_slots[m_next & m_mask];
+    uint64_t             expected = 2 * m_next + 2;
+    uint64_t             before   = slot.sequence.load(std::memory_order_acquire);
+
+    if (before == expected) {
+        event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == expected) {
+            m_next++;
+            return RingRead::EVENT;
+        }
+    } else if (before < expected) {
+        return RingRead::EMPTY;
+    }
+
+    // The slot was reused for a later event: resume at the oldest one left
+    uint64_t head   = m_header->head.load(std::memory_order_acquire);
+    uint64_t oldest = head > m_header->capacity ? head - m_header->capacity : 0;
+    if (oldest <= m_next) {
+        oldest = m_next + 1;
+    }
+    m_lost += oldest - m_next;
+    m_next = oldest;
+    return RingRead::OVERRUN;
+}
+
+void EventRingReader::wait(int timeoutMs) {
+    if (!m_header) {
+        return;
+    }
+
+    std::atomic<uint32_t> &wake    = const_cast<EventRingHeader *>(m_header)->wake;
+    uint32_t               current = wake.load(std::memory_order_acquire);
+    if (m_header->head.load(std::memory_order_acquire) > m_next) {
+        return;
+    }
+
+    timespec  timeout;
+    timespec *limit = nullptr;
+    if (timeoutMs >= 0) {
+        timeout.tv_sec  = timeoutMs / 1000;
+        timeout.tv_nsec = (timeoutMs % 1000) * 1000000L;
+        limit           = &timeout;
+    }
+
+    // Returns at once if the writer bumped the word after it was read above
+    futex(&wake, FUTEX_WAIT, current, limit);
+}
+
+// ==================== SINK ====================
+
+void RingSink::event(const ProtocolFrame &frame) {
+    RingEvent event;
+    memset(&event, 0, sizeof(event));
+    event.timestampNs = frame.stamped && m_clock && m_clock->synced() ? m_clock->toHostNs(frame.deviceUs)
+                                                                      : monotonicNs();
+    event.device      = frame.device;
+    event.event       = frame.event;
+    event.paramCount  = frame.paramCount;
+    event.param1      = frame.param1;
+    event.param2      = frame.param2;
+    m_writer.publish(event);
+}
@@ -0,0 +1,218 @@
+/**
+ * @file EventRing.h
+ * @brief Shared-memory event ring: one writer, any number of readers
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * The daemon publishes decoded events into a POSIX shared memory object
+ * (shm_open). Other processes map it read-only and follow the stream at
+ * their own pace; the writer never waits for them.
+ *
+ * Every slot carries a sequence word: 2n+1 while event n is written,
+ * 2n+2 once it is complete. A reader copies the slot and re-checks the
+ * word, so a slot overwritten under it is reported as an overrun and the
+ * reader skips ahead to the oldest event still in the ring.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef EVENT_RING_H
+#define EVENT_RING_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+#include "ClockSync.h"
+#include "EventSink.h"
+
+/**
+ * @brief Event as stored in the ring
+ */
+struct RingEvent {
+    uint64_t timestampNs; ///< CLOCK_MONOTONIC time of the event (see RingSink)
+    uint8_t  device;      ///< Device
+    uint8_t  event;       ///< Event
+    uint8_t  paramCount;  ///< Parameters present on the wire
+    uint8_t  reserved;    ///< Padding, zero
+    int32_t  param1;      ///< First parameter
+    int32_t  param2;      ///< Second parameter
+    uint32_t reserved2;   ///< Padding, zero
+};
+
+/**
+ * @brief Shared memory layout (header followed by the slots)
+ */
+struct EventRingHeader {
+    uint32_t              magic;     ///< EVENT_RING_MAGIC
+    uint32_t              version;   ///< Layout version
+    uint32_t              capacity;  ///< Slot count (power of two)
+    uint32_t              reserved;  ///< Padding, zero
+    std::atomic<uint64_t> head;      ///< Sequence of the next event to write
+    std::atomic<uint32_t> wake;      ///< Futex word, bumped per published batch
+    uint32_t              reserved2; ///< Padding, zero
+};
+
+/**
+ * @brief One ring slot
+ */
+struct alignas(32) EventRingSlot {
+    std::atomic<uint64_t> sequence; ///< 2n+1 while writing event n, 2n+2 when done
+    RingEvent             event;    ///< Payload
+};
+
+/**
+ * @brief Publishing side, owned by the daemon
+ */
+class EventRingWriter {
+  public:
+    EventRingWriter();
+    ~EventRingWriter();
+
+    EventRingWriter(const EventRingWriter &)            = delete;
+    EventRingWriter &operator=(const EventRingWriter &) = delete;
+
+    /**
+     * @brief Create (or replace) the shared memory ring
+     * @param name Object name, e.g. "/serial-input"
+     * @param capacity Slot count, rounded up to a power of two
+     * @return false on failure, see lastError()
+     */
+    bool create(const char *name, uint32_t capacity = 4096);
+
+    /**
+     * @brief Unmap and unlink the ring
+     */
+    void close();
+
+    /**
+     * @brief Append one event
+     * @param event Event to publish
+     */
+    void publish(const RingEvent &event);
+
+    /**
+     * @brief Wake readers waiting in EventRingReader::wait()
+     */
+    void notify();
+
+    /**
+     * @brief Get the last error message
+     * @return Description of the last failure
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    EventRingHeader *m_header;    ///< Mapped header
+    EventRingSlot   *m_slots;     ///< Mapped slots
+    size_t           m_size;      ///< Mapping size
+    uint64_t         m_next;      ///< Sequence of the next event
+    uint32_t         m_mask;      ///< capacity - 1
+    std::string      m_name;      ///< Object name (for unlink)
+    std::string      m_lastError; ///< Last failure description
+};
+
+/**
+ * @brief Result of EventRingReader::next()
+ */
+enum class RingRead : uint8_t {
+    EVENT   = 0, ///< An event was copied out
+    EMPTY   = 1, ///< Caught up with the writer
+    OVERRUN = 2  ///< Events were lost; the reader skipped ahead
+};
+
+/**
+ * @brief Consuming side, one per process (or thread)
+ */
+class EventRingReader {
+  public:
+    EventRingReader();
+    ~EventRingReader();
+
+    EventRingReader(const EventRingReader &)            = delete;
+    EventRingReader &operator=(const EventRingReader &) = delete;
+
+    /**
+     * @brief Map an existing ring
+     * @param name Object name used by the writer
+     * @param fromStart Start with the oldest event still in the ring
+     *                  instead of only new ones
+     * @return false on failure, see lastError()
+     */
+    bool open(const char *name, bool fromStart = false);
+
+    /**
+     * @brief Unmap the ring
+     */
+    void close();
+
+    /**
+     * @brief Copy out the next event
+     * @param event Receives the event when EVENT is returned
+     * @return EVENT, EMPTY, or OVERRUN (see lost())
+     */
+    RingRead next(RingEvent &event);
+
+    /**
+     * @brief Sleep until the writer publishes or the timeout expires
+     * @param timeoutMs Maximum wait in ms, -1 to wait forever
+     */
+    void wait(int timeoutMs);
+
+    /**
+     * @brief Events skipped because of overruns so far
+     * @return Lost event count
+     */
+    inline uint64_t lost() const {
+        return m_lost;
+    }
+
+    /**
+     * @brief Get the last error message
+     * @return Description of the last failure
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    const EventRingHeader *m_header;    ///< Mapped header
+    const EventRingSlot   *m_slots;     ///< Mapped slots
+    size_t                 m_size;      ///< Mapping size
+    uint64_t               m_next;      ///< Sequence to read next
+    uint64_t               m_lost;      ///< Events lost to overruns
+    uint32_t               m_mask;      ///< capacity - 1
+    std::string            m_lastError; ///< Last failure description
+};
+
+/**
+ * @brief Sink publishing every event into an EventRingWriter
+ */
+class RingSink : public EventSink {
+  public:
+    /**
+     * @brief Create a sink
+     * @param writer Destination ring
+     * @param clock Mapping for stamped events, or nullptr
+     *
+     * Stamped events get their device time mapped through a synced
+     * clock; all others are timestamped when they are decoded.
+     */
+    explicit RingSink(EventRingWriter &writer, const ClockSync *clock = nullptr) : m_writer(writer), m_clock(clock) {
+    }
+
+    void event(const ProtocolFrame &frame) override;
+
+    void flush() override {
+        m_writer.notify();
+    }
+
+  private:
+    EventRingWriter &m_writer; ///< Destination ring
+    const ClockSync *m_clock;  ///< Device clock mapping, nullptr if none
+};
+
+#endif // EVENT_RING_H
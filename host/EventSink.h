@@ -0,0 +1,123 @@
+/**
+ * @file EventSink.h
+ * @brief Destination interface for decoded SerialInputMonitor events
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * The daemon hands every EVENT frame to a sink and calls flush() once
+ * per received chunk, so sinks can batch their output.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef EVENT_SINK_H
+#define EVENT_SINK_H
+
+#include <stdio.h>
+#include <vector>
+
+#include "ProtocolDecoder.h"
+
+/**
+ * @brief Receives decoded events
+ */
+class EventSink {
+  public:
+    virtual ~EventSink() {
+    }
+
+    /**
+     * @brief Handle one EVENT frame
+     * @param frame Decoded frame (its text is not kept)
+     */
+    virtual void event(const ProtocolFrame &frame) = 0;
+
+    /**
+     * @brief End of a batch; deliver everything queued so far
+     */
+    virtual void flush() {
+    }
+};
+
+/**
+ * @brief Sink that records events in memory (tests, uinput-less hosts)
+ */
+class MemorySink : public EventSink {
+  public:
+    std::vector<ProtocolFrame> frames;     ///< Received events, text cleared
+    size_t                     flushes = 0; ///< Number of flush() calls
+
+    void event(const ProtocolFrame &frame) override {
+        frames.push_back(frame);
+        frames.back().text   = nullptr;
+        frames.back().length = 0;
+    }
+
+    void flush() override {
+        flushes++;
+    }
+};
+
+/**
+ * @brief Sink that prints events, one line each (dry runs)
+ */
+class LogSink : public EventSink {
+  public:
+    explicit LogSink(FILE *stream = stdout) : m_stream(stream) {
+    }
+
+    void event(const ProtocolFrame &frame) override {
+        fprintf(m_stream, "device=%u event=%u param1=%d param2=%d\n", frame.device, frame.event,
+                static_cast<int>(frame.param1), static_cast<int>(frame.param2));
+    }
+
+    void flush() override {
+        fflush(m_stream);
+    }
+
+  private:
+    FILE *m_stream; ///< Output stream
+};
+
+/**
+ * @brief Sink forwarding every event to up to two sinks
+ */
+class TeeSink : public EventSink {
+  public:
+    TeeSink(EventSink *first = nullptr, EventSink *second = nullptr) : m_first(first), m_second(second) {
+    }
+
+    /**
+     * @brief Replace the destinations
+     * @param first First sink, or nullptr
+     * @param second Second sink, or nullptr
+     */
+    void set(EventSink *first, EventSink *second) {
+        m_first  = first;
+        m_second = second;
+    }
+
+    void event(const ProtocolFrame &frame) override {
+        if (m_first) {
+            m_first->event(frame);
+        }
+        if (m_second) {
+            m_second->event(frame);
+        }
+    }
+
+    void flush() override {
+        if (m_first) {
+            m_first->flush();
+        }
+        if (m_second) {
+            m_second->flush();
+        }
+    }
+
+  private:
+    EventSink *m_first;  ///< First destination
+    EventSink *m_second; ///< Second destination
+};
+
+#endif // EVENT_SINK_H
@@ -0,0 +1,976 @@
+/**
+ * @file FuzzEncoder.cpp
+ * @brief Differential fuzzing of the device library against a frozen reference encoder
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: fuzz-encoder [-g COUNT] [-r SEED] [-w DIR] [-v] [FILE|DIR...]
+ *
+ *   -g  Also run COUNT generated cases
+ *   -r  Seed of the generated cases (default 1)
+ *   -w  Write the generated cases to DIR as corpus files
+ *   -v  Print the host effects of every case
+ *
+ * Each case is a byte string: a configuration byte, a DMA timing byte,
+ * then API calls with their arguments. The case runs through two
+ * encoders:
+ *
+ *   library     BasicSerialInputMonitor as built for the boards, with the
+ *               framing, text window, TX queue and DMA double buffer
+ *               the configuration byte selects and redundant events
+ *               skipped or not; its bytes are decoded by ProtocolDecoder
+ *   reference   ReferenceMonitor below: one plain event per key or button
+ *               edge, a US layout table of its own, nothing skipped,
+ *               merged or compressed; frozen, never optimized
+ *
+ * Both event streams go through HostModel, which keeps what the host
+ * would do with them: key and button edges (a press of a key already
+ * down is no edge), modifiers held at each key press, summed moves and
+ * scrolls, and changed positions. The effects and the final state must
+ * match, and every line must decode. A fast path that changes what the
+ * host does fails here however it encodes; one that only changes the
+ * bytes (coalescing Shift, merging moves, compressing text) passes.
+ *
+ * Replaying files and directories makes a corpus a regression check.
+ * With -DSIM_FUZZ_LIBFUZZER and -fsanitize=fuzzer (clang) the file is a
+ * libFuzzer target instead; an AFL build uses the replay main on its
+ * input file. The exit status is the number of failing cases, capped
+ * at 100.
+ *
+ * The Arduino core is a capture stand-in: Serial collects the bytes,
+ * time is virtual and advances with every call, and SERIAL_TX_DMA
+ * completes a transfer after a number of polls taken from the DMA
+ * timing byte, reading its buffer only then.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <algorithm>
+#include <dirent.h>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "ProtocolDecoder.h"
+#include "SerialInputMonitor.h"
+
+// ==================== ARDUINO STAND-IN ====================
+
+HardwareSerial Serial;
+
+namespace {
+
+uint64_t       g_clockUs;        ///< Virtual time
+std::string    g_wire;           ///< Bytes written by the library
+const uint8_t *g_dmaData;        ///< Transfer in flight, nullptr when idle
+uint16_t       g_dmaLength;      ///< Its length
+uint8_t        g_dmaPolls;       ///< busy() calls left until it completes
+uint32_t       g_dmaTiming;      ///< Polls per transfer, two bits per transfer
+uint32_t       g_dmaTransfers;   ///< Transfers started in this case
+
+void completeDma() {
+    g_wire.append(reinterpret_cast<const char *>(g_dmaData), g_dmaLength);
+    g_dmaData = nullptr;
+}
+
+} // namespace
+
+unsigned long millis() {
+    return static_cast<unsigned long>(g_clockUs++ / 1000);
+}
+
+unsigned long micros() {
+    return static_cast<unsigned long>(g_clockUs++);
+}
+
+void delay(unsigned long ms) {
+    g_clockUs += static_cast<uint64_t>(ms) * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    g_clockUs += us;
+}
+
+void yield() {
+    g_clockUs += 1000;
+}
+
+void noInterrupts() {
+}
+
+void interrupts() {
+}
+
+void simIdle(uint32_t maxUs) {
+    g_clockUs += maxUs > 0 ? maxUs : 1;
+}
+
+void simTxDmaStart(const uint8_t *data, uint16_t length) {
+    if (g_dmaData != nullptr) {
+        fprintf(stderr, "fuzz-encoder: DMA transfer started while busy\n");
+        abort();
+    }
+    g_dmaData   = data;
+    g_dmaLength = length;
+    g_dmaPolls  = static_cast<uint8_t>((g_dmaTiming >> (2 * (g_dmaTransfers++ % 16))) & 3);
+}
+
+bool simTxDmaBusy() {
+    if (g_dmaData != nullptr && g_dmaPolls-- == 0) {
+        completeDma();
+    }
+    return g_dmaData != nullptr;
+}
+
+void simTxDmaWait() {
+    if (g_dmaData != nullptr) {
+        completeDma();
+    }
+}
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    return size;
+}
+
+void HardwareSerial::begin(unsigned long) {
+}
+
+void HardwareSerial::end() {
+}
+
+int HardwareSerial::available() {
+    return 0;
+}
+
+int HardwareSerial::read() {
+    return -1;
+}
+
+int HardwareSerial::peek() {
+    return -1;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    g_wire.push_back(static_cast<char>(c));
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    g_wire.append(reinterpret_cast<const char *>(buffer), size);
+    return size;
+}
+
+int HardwareSerial::availableForWrite() {
+    return SERIAL_TX_BUFFER_SIZE - 1; // Always room: lines leave at once, the TX queue never fills
+}
+
+void HardwareSerial::flush() {
+}
+
+namespace {
+
+// ==================== CASES ====================
+
+/**
+ * @brief Configuration byte of a case
+ */
+enum ConfigBits : uint8_t {
+    CONFIG_FRAMING     = 0x03, ///< 0 PLAIN, 1 CRC, 2 FEC, 3 PLAIN
+    CONFIG_TEXT_WINDOW = 0x04, ///< Attach a 256-byte TextWindow
+    CONFIG_TX_QUEUE    = 0x08, ///< Attach a 16-entry TxQueue
+    CONFIG_DMA         = 0x10, ///< Attach a 2x96-byte DmaTx
+    CONFIG_SEND_ALL    = 0x20  ///< Start with setSkipRedundant(false)
+};
+
+/**
+ * @brief API calls, one byte each (bit 7 selects 32-bit parameters)
+ */
+enum Op : uint8_t {
+    OP_POSITION,
+    OP_MOVE,
+    OP_PRESS_LEFT,
+    OP_RELEASE_LEFT,
+    OP_PRESS_RIGHT,
+    OP_RELEASE_RIGHT,
+    OP_PRESS_MIDDLE,
+    OP_RELEASE_MIDDLE,
+    OP_CLICK_LEFT,
+    OP_CLICK_RIGHT,
+    OP_DOUBLE_CLICK,
+    OP_SCROLL,
+    OP_PRESS_KEY,       ///< Virtual key byte
+    OP_RELEASE_KEY,     ///< Virtual key byte
+    OP_TAP_KEY,         ///< Virtual key byte
+    OP_PRESS_CHAR,      ///< Character byte
+    OP_RELEASE_CHAR,    ///< Character byte
+    OP_TYPE_CHAR,       ///< Character byte
+    OP_TYPE_TEXT,       ///< Length byte, characters
+    OP_TYPE_TEXT_LINE,  ///< Length byte, characters
+    OP_SHORTCUT,        ///< copy, paste, cut, undo, redo, selectAll, altTab, altF4
+    OP_SEND_EVENT,      ///< Device and event byte, parameters
+    OP_SKIP_REDUNDANT,  ///< On/off byte
+    OP_FORGET_HOST,
+    OP_COUNT
+};
+
+const size_t TEXT_MAX = 24; ///< Longest typed text
+
+/**
+ * @brief Reads a case's arguments, with zeros once the bytes run out
+ */
+class CaseReader {
+  public:
+    CaseReader(const uint8_t *data, size_t size) : m_data(data), m_size(size), m_offset(0) {
+    }
+
+    bool atEnd() const {
+        return m_offset >= m_size;
+    }
+
+    uint8_t byte() {
+        return m_offset < m_size ? m_data[m_offset++] : 0;
+    }
+
+    int param(bool wide) {
+        uint32_t value = byte();
+        value |= static_cast<uint32_t>(byte()) << 8;
+        if (!wide) {
+            return static_cast<int16_t>(value);
+        }
+        value |= static_cast<uint32_t>(byte()) << 16;
+        value |= static_cast<uint32_t>(byte()) << 24;
+        return static_cast<int32_t>(value);
+    }
+
+    /**
+     * @brief Text of up to TEXT_MAX characters; NUL, which would end it, becomes a space
+     */
+    std::string text() {
+        size_t      length = byte() % (TEXT_MAX + 1);
+        std::string text;
+        for (size_t i = 0; i < length; i++) {
+            char character = static_cast<char>(byte());
+            text.push_back(character == '\0' ? ' ' : character);
+        }
+        return text;
+    }
+
+  private:
+    const uint8_t *m_data;
+    size_t         m_size;
+    size_t         m_offset;
+};
+
+struct Event {
+    uint8_t device;
+    uint8_t event;
+    int32_t param1;
+    int32_t param2;
+};
+
+// ==================== REFERENCE ENCODER ====================
+
+/**
+ * @brief Frozen reference: the API as plain events, one per edge
+ *
+ * Written from the protocol description and kept simple on purpose.
+ * Do not optimize it; it is what optimized paths are checked against.
+ */
+class ReferenceMonitor {
+  public:
+    std::vector<Event> events;
+
+    ReferenceMonitor() {
+        // US layout, unshifted and shifted, by key
+        static const struct {
+            uint8_t     key;
+            const char *characters;
+        } ROWS[] = {
+            {0xC0, "`~"}, {0x31, "1!"}, {0x32, "2@"}, {0x33, "3#"}, {0x34, "4$"}, {0x35, "5%"}, {0x36, "6^"},
+            {0x37, "7&"}, {0x38, "8*"}, {0x39, "9("}, {0x30, "0)"}, {0xBD, "-_"}, {0xBB, "=+"}, {0xDB, "[{"},
+            {0xDD, "]}"}, {0xDC, "\\|"}, {0xBA, ";:"}, {0xDE, "'\""}, {0xBC, ",<"}, {0xBE, ".>"}, {0xBF, "/?"},
+        };
+        for (int i = 0; i < 256; i++) {
+            m_key[i]   = 0x20; // Anything without a key types a space
+            m_shift[i] = false;
+        }
+        for (const auto &row : ROWS) {
+            set(row.characters[0], row.key, false);
+            set(row.characters[1], row.key, true);
+        }
+        for (char c = 'a'; c <= 'z'; c++) {
+            set(c, static_cast<uint8_t>(0x41 + (c - 'a')), false);
+            set(static_cast<char>(c - 'a' + 'A'), static_cast<uint8_t>(0x41 + (c - 'a')), true);
+        }
+        set(' ', 0x20, false);
+        set('\t', 0x09, false);
+        set('\r', 0x0D, false);
+        set('\n', 0x0D, false);
+        set('\b', 0x08, false);
+    }
+
+    void send(uint8_t device, uint8_t event, int32_t param1 = 0, int32_t param2 = 0) {
+        events.push_back(Event{device, event, param1, param2});
+    }
+
+    void mouse(uint8_t event, int32_t param1 = 0, int32_t param2 = 0) {
+        send(0, event, param1, param2);
+    }
+
+    void key(bool press, uint8_t code) {
+        send(1, press ? 1 : 0, code);
+    }
+
+    void button(bool &down, bool press, uint8_t pressEvent) {
+        if (down != press) {
+            mouse(press ? pressEvent : pressEvent + 1);
+            down = press;
+        }
+    }
+
+    void click(bool &down, uint8_t pressEvent) {
+        button(down, true, pressEvent);
+        button(down, false, pressEvent);
+    }
+
+    void character(char c, bool press, bool release) {
+        uint8_t index = static_cast<uint8_t>(c);
+        if (press) {
+            if (m_shift[index]) {
+                key(true, 0xA0);
+            }
+            key(true, m_key[index]);
+        }
+        if (release) {
+            key(false, m_key[index]);
+            if (m_shift[index]) {
+                key(false, 0xA0);
+            }
+        }
+    }
+
+    void text(const std::string &text, bool newLine) {
+        for (char c : text) {
+            character(c, true, true);
+        }
+        if (newLine) {
+            key(true, 0x0D);
+            key(false, 0x0D);
+        }
+    }
+
+    void shortcut(uint8_t which) {
+        static const uint8_t MODIFIER[] = {0xA2, 0xA2, 0xA2, 0xA2, 0xA2, 0xA2, 0xA4, 0xA4};
+        static const uint8_t KEY[]      = {'C', 'V', 'X', 'Z', 'Y', 'A', 0x09, 0x73};
+        key(true, MODIFIER[which]);
+        key(true, KEY[which]);
+        key(false, KEY[which]);
+        key(false, MODIFIER[which]);
+    }
+
+    bool left   = false;
+    bool right  = false;
+    bool middle = false;
+
+  private:
+    uint8_t m_key[256];
+    bool    m_shift[256];
+
+    void set(char c, uint8_t key, bool shift) {
+        m_key[static_cast<uint8_t>(c)]   = key;
+        m_shift[static_cast<uint8_t>(c)] = shift;
+    }
+};
+
+// ==================== HOST MODEL ====================
+
+/**
+ * @brief What the host does with an event stream, as comparable lines
+ */
+class HostModel {
+  public:
+    std::vector<std::string> effects;
+
+    void apply(const Event &event) {
+        if (event.device == 1) {
+            applyKey(event.event == 1, event.param1);
+            return;
+        }
+        switch (event.event) {
+            case 0:
+            case 1:
+            case 2:
+            case 3:
+            case 4:
+            case 5: {
+                int  button = event.event / 2;
+                bool press  = event.event % 2 == 0;
+                if (m_buttons[button] != press) {
+                    flushMotion();
+                    m_buttons[button] = press;
+                    add("button %c %s", "RLM"[button], press ? "down" : "up");
+                }
+                break;
+            }
+            case 6:
+                if (event.param1 == 0) {
+                    break;
+                }
+                if (m_moveX != 0 || m_moveY != 0) {
+                    flushMotion();
+                }
+                m_scroll += event.param1;
+                break;
+            case 7:
+                if (m_positionKnown && !m_movedSince && event.param1 == m_x && event.param2 == m_y) {
+                    break;
+                }
+                flushMotion();
+                m_positionKnown = true;
+                m_movedSince    = false;
+                m_x             = event.param1;
+                m_y             = event.param2;
+                add("position %d %d", m_x, m_y);
+                break;
+            case 8:
+                if (event.param1 == 0 && event.param2 == 0) {
+                    break;
+                }
+                if (m_scroll != 0) {
+                    flushMotion();
+                }
+                m_movedSince = true;
+                m_moveX += event.param1;
+                m_moveY += event.param2;
+                break;
+            default: add("mouse %u %d %d", event.event, event.param1, event.param2); break;
+        }
+    }
+
+    /**
+     * @brief End the stream: pending motion and what is still held
+     */
+    void finish() {
+        flushMotion();
+        std::string held = "held";
+        char        item[24];
+        for (int key = 0; key < 256; key++) {
+            if (m_keys[key]) {
+                snprintf(item, sizeof(item), " key %d", key);
+                held += item;
+            }
+        }
+        for (int button = 0; button < 3; button++) {
+            if (m_buttons[button]) {
+                held += " button ";
+                held += "RLM"[button];
+            }
+        }
+        effects.push_back(held);
+    }
+
+  private:
+    bool    m_keys[256]     = {};    ///< Keys down
+    bool    m_buttons[3]    = {};    ///< Right, left, middle button down
+    int64_t m_moveX         = 0;     ///< Moves since the last effect
+    int64_t m_moveY         = 0;
+    int64_t m_scroll        = 0;     ///< Scrolls since the last effect
+    bool    m_positionKnown = false; ///< An absolute position was set
+    bool    m_movedSince    = false; ///< A move came after it
+    int32_t m_x             = 0;     ///< That position
+    int32_t m_y             = 0;
+
+    static bool isModifier(int key) {
+        return (key >= 0x10 && key <= 0x12) || key == 0x5B || key == 0x5C || (key >= 0xA0 && key <= 0xA5);
+    }
+
+    template <typename... Args> void add(const char *format, Args... args) {
+        char line[64];
+        snprintf(line, sizeof(line), format, args...);
+        effects.push_back(line);
+    }
+
+    void applyKey(bool press, int32_t key) {
+        if (key < 0 || key > 0xFF) {
+            add("key %d %s", key, press ? "press" : "release");
+            return;
+        }
+        if (m_keys[key] == press) {
+            return;
+        }
+        m_keys[key] = press;
+        if (isModifier(key)) {
+            return;
+        }
+        flushMotion();
+        std::string modifiers;
+        char        item[16];
+        for (int modifier = 0; modifier < 256; modifier++) {
+            if (m_keys[modifier] && isModifier(modifier)) {
+                snprintf(item, sizeof(item), " %d", modifier);
+                modifiers += item;
+            }
+        }
+        add("key %d %s%s", key, press ? "down" : "up", modifiers.c_str());
+    }
+
+    void flushMotion() {
+        if (m_moveX != 0 || m_moveY != 0) {
+            add("move %lld %lld", static_cast<long long>(m_moveX), static_cast<long long>(m_moveY));
+        }
+        if (m_scroll != 0) {
+            add("scroll %lld", static_cast<long long>(m_scroll));
+        }
+        m_moveX = m_moveY = m_scroll = 0;
+    }
+};
+
+// ==================== RUNNING A CASE ====================
+
+/**
+ * @brief Run one API call on the library and the reference
+ * @return Description of the call, for failure reports
+ */
+std::string runOp(CaseReader &reader, SerialInputMonitor &monitor, ReferenceMonitor &reference) {
+    uint8_t opByte = reader.byte();
+    bool    wide   = opByte & 0x80;
+    Op      op     = static_cast<Op>((opByte & 0x7F) % OP_COUNT);
+    char    call[96];
+    snprintf(call, sizeof(call), "op %d", op);
+
+    switch (op) {
+        case OP_POSITION:
+        case OP_MOVE: {
+            int x = reader.param(wide);
+            int y = reader.param(wide);
+            if (op == OP_POSITION) {
+                monitor.setMousePosition(x, y);
+                reference.mouse(7, x, y);
+            } else {
+                monitor.moveMouseRelative(x, y);
+                reference.mouse(8, x, y);
+            }
+            snprintf(call, sizeof(call), "%s(%d, %d)", op == OP_POSITION ? "setMousePosition" : "moveMouseRelative",
+                     x, y);
+            break;
+        }
+        case OP_PRESS_LEFT: monitor.pressLeftButton(); reference.button(reference.left, true, 2); break;
+        case OP_RELEASE_LEFT: monitor.releaseLeftButton(); reference.button(reference.left, false, 2); break;
+        case OP_PRESS_RIGHT: monitor.pressRightButton(); reference.button(reference.right, true, 0); break;
+        case OP_RELEASE_RIGHT: monitor.releaseRightButton(); reference.button(reference.right, false, 0); break;
+        case OP_PRESS_MIDDLE: monitor.pressMiddleButton(); reference.button(reference.middle, true, 4); break;
+        case OP_RELEASE_MIDDLE: monitor.releaseMiddleButton(); reference.button(reference.middle, false, 4); break;
+        case OP_CLICK_LEFT: monitor.clickLeft(); reference.click(reference.left, 2); break;
+        case OP_CLICK_RIGHT: monitor.clickRight(); reference.click(reference.right, 0); break;
+        case OP_DOUBLE_CLICK:
+            monitor.doubleClickLeft();
+            reference.click(reference.left, 2);
+            reference.click(reference.left, 2);
+            break;
+        case OP_SCROLL: {
+            int amount = reader.param(wide);
+            monitor.scrollMouse(amount);
+            reference.mouse(6, amount);
+            snprintf(call, sizeof(call), "scrollMouse(%d)", amount);
+            break;
+        }
+        case OP_PRESS_KEY:
+        case OP_RELEASE_KEY:
+        case OP_TAP_KEY: {
+            uint8_t    code = reader.byte();
+            VirtualKey key  = static_cast<VirtualKey>(code);
+            if (op != OP_RELEASE_KEY) {
+                op == OP_PRESS_KEY ? monitor.pressKey(key) : monitor.tapKey(key);
+                reference.key(true, code);
+            }
+            if (op != OP_PRESS_KEY) {
+                if (op == OP_RELEASE_KEY) {
+                    monitor.releaseKey(key);
+                }
+                reference.key(false, code);
+            }
+            snprintf(call, sizeof(call), "%sKey(0x%02X)",
+                     op == OP_PRESS_KEY ? "press" : op == OP_TAP_KEY ? "tap" : "release", code);
+            break;
+        }
+        case OP_PRESS_CHAR:
+        case OP_RELEASE_CHAR:
+        case OP_TYPE_CHAR: {
+            char c = static_cast<char>(reader.byte());
+            if (op == OP_PRESS_CHAR) {
+                monitor.pressKey(c);
+            } else if (op == OP_RELEASE_CHAR) {
+                monitor.releaseKey(c);
+            } else {
+                monitor.typeCharacter(c);
+            }
+            reference.character(c, op != OP_RELEASE_CHAR, op != OP_PRESS_CHAR);
+            snprintf(call, sizeof(call), "%s('\\x%02X')",
+                     op == OP_PRESS_CHAR ? "pressKey" : op == OP_RELEASE_CHAR ? "releaseKey" : "typeCharacter",
+                     static_cast<uint8_t>(c));
+            break;
+        }
+        case OP_TYPE_TEXT:
+        case OP_TYPE_TEXT_LINE: {
+            std::string text    = reader.text();
+            bool        newLine = op == OP_TYPE_TEXT_LINE;
+            newLine ? monitor.typeTextLine(text.c_str()) : monitor.typeText(text.c_str());
+            reference.text(text, newLine);
+            std::string shown;
+            for (char c : text) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), c >= 0x20 && c < 0x7F && c != '\\' ? "%c" : "\\x%02X",
+                         static_cast<uint8_t>(c));
+                shown += escaped;
+            }
+            snprintf(call, sizeof(call), "%s(\"%s\")", newLine ? "typeTextLine" : "typeText", shown.c_str());
+            break;
+        }
+        case OP_SHORTCUT: {
+            uint8_t which = reader.byte() % 8;
+            switch (which) {
+                case 0: monitor.copy(); break;
+                case 1: monitor.paste(); break;
+                case 2: monitor.cut(); break;
+                case 3: monitor.undo(); break;
+                case 4: monitor.redo(); break;
+                case 5: monitor.selectAll(); break;
+                case 6: monitor.altTab(); break;
+                default: monitor.altF4(); break;
+            }
+            reference.shortcut(which);
+            snprintf(call, sizeof(call), "shortcut %u", which);
+            break;
+        }
+        case OP_SEND_EVENT: {
+            uint8_t    kind  = reader.byte();
+            InputEvent event = {Device::MOUSE, 0, 0, 0};
+            if (kind & 0x80) {
+                event.device = Device::KEYBOARD;
+                event.event  = kind & 1;
+                event.param1 = reader.byte();
+            } else {
+                event.event  = kind % 9;
+                event.param1 = reader.param(wide);
+                event.param2 = reader.param(wide);
+            }
+            monitor.sendEvent(event);
+            reference.send(static_cast<uint8_t>(event.device), event.event, event.param1, event.param2);
+            snprintf(call, sizeof(call), "sendEvent(%u, %u, %d, %d)", static_cast<uint8_t>(event.device), event.event,
+                     event.param1, event.param2);
+            break;
+        }
+        case OP_SKIP_REDUNDANT: {
+            bool enabled = reader.byte() & 1;
+            monitor.setSkipRedundant(enabled);
+            snprintf(call, sizeof(call), "setSkipRedundant(%d)", enabled);
+            break;
+        }
+        case OP_FORGET_HOST:
+            monitor.forgetHostState();
+            snprintf(call, sizeof(call), "forgetHostState()");
+            break;
+        case OP_COUNT: break;
+    }
+    return call;
+}
+
+bool g_verbose = false;
+
+/**
+ * @brief Run a case on both encoders and compare what the host would do
+ * @return true if they agree and every line decoded
+ */
+bool runCase(const uint8_t *data, size_t size) {
+    CaseReader reader(data, size);
+    uint8_t    config = reader.byte();
+    g_dmaTiming       = reader.byte() * 0x01010101u;
+    g_dmaTransfers    = 0;
+    g_dmaData         = nullptr;
+    g_wire.clear();
+
+    SerialInputMonitor    monitor;
+    ReferenceMonitor      reference;
+    TextWindowBuffer<256> window;
+    TxQueueBuffer<16>     queue;
+    DmaTxBuffer<96>       tx(SERIAL_TX_DMA);
+
+    static const Framing FRAMINGS[] = {Framing::PLAIN, Framing::CRC, Framing::FEC, Framing::PLAIN};
+    monitor.setFraming(FRAMINGS[config & CONFIG_FRAMING]);
+    monitor.attachTextWindow(config & CONFIG_TEXT_WINDOW ? &window : nullptr);
+    monitor.attachTxQueue(config & CONFIG_TX_QUEUE ? &queue : nullptr);
+    monitor.attachDmaTx(config & CONFIG_DMA ? &tx : nullptr);
+    monitor.setSkipRedundant(!(config & CONFIG_SEND_ALL));
+
+    std::vector<std::string> calls;
+    while (!reader.atEnd()) {
+        calls.push_back(runOp(reader, monitor, reference));
+    }
+    monitor.poll();
+    tx.flush();
+    monitor.attachDmaTx(nullptr);
+
+    // Decode what the library wrote
+    HostModel       library;
+    ProtocolDecoder decoder;
+    std::string     failure;
+    decoder.feed(g_wire.data(), g_wire.size(), [&](const ProtocolFrame &frame) {
+        if (frame.kind != FrameKind::EVENT) {
+            if (failure.empty()) {
+                failure = "undecodable line: " + std::string(frame.text, frame.length);
+            }
+            return;
+        }
+        library.apply(Event{frame.device, frame.event, frame.param1, frame.param2});
+    });
+    if (decoder.hasPartial() && failure.empty()) {
+        failure = "unterminated last line";
+    }
+    if (decoder.rejectedFrames() > 0 && failure.empty()) {
+        failure = std::to_string(decoder.rejectedFrames()) + " frames failed their check";
+    }
+    library.finish();
+
+    HostModel expected;
+    for (const Event &event : reference.events) {
+        expected.apply(event);
+    }
+    expected.finish();
+
+    size_t differ = 0;
+    while (differ < library.effects.size() && differ < expected.effects.size() &&
+           library.effects[differ] == expected.effects[differ]) {
+        differ++;
+    }
+    if (failure.empty() && (differ < library.effects.size() || differ < expected.effects.size())) {
+        failure = "effect " + std::to_string(differ) + ": library \"" +
+                  (differ < library.effects.size() ? library.effects[differ] : "(none)") + "\", reference \"" +
+                  (differ < expected.effects.size() ? expected.effects[differ] : "(none)") + "\"";
+    }
+
+    if (g_verbose || !failure.empty()) {
+        printf("config 0x%02X, %zu calls, %zu wire bytes, %u DMA transfers\n", config, calls.size(), g_wire.size(),
+               g_dmaTransfers);
+        for (const std::string &call : calls) {
+            printf("  call   %s\n", call.c_str());
+        }
+        for (const std::string &effect : library.effects) {
+            printf("  effect %s\n", effect.c_str());
+        }
+    }
+    if (!failure.empty()) {
+        printf("FAILED: %s\n", failure.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+#if defined(SIM_FUZZ_LIBFUZZER)
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    if (!runCase(data, size)) {
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+namespace {
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-g COUNT] [-r SEED] [-w DIR] [-v] [FILE|DIR...]\n"
+            "  -g  Also run COUNT generated cases\n"
+            "  -r  Seed of the generated cases (default 1)\n"
+            "  -w  Write the generated cases to DIR as corpus files\n"
+            "  -v  Print the host effects of every case\n",
+            program);
+}
+
+bool readFile(const std::string &path, std::vector<uint8_t> &bytes) {
+    FILE *file = fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        perror(path.c_str());
+        return false;
+    }
+    bytes.clear();
+    uint8_t chunk[4096];
+    size_t  count;
+    while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        bytes.insert(bytes.end(), chunk, chunk + count);
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Collect the files to replay: the path itself, or the files in a directory, sorted
+ */
+void listCases(const std::string &path, std::vector<std::string> &files) {
+    struct stat info;
+    if (stat(path.c_str(), &info) != 0 || !S_ISDIR(info.st_mode)) {
+        files.push_back(path);
+        return;
+    }
+    std::vector<std::string> names;
+    DIR                     *dir = opendir(path.c_str());
+    if (dir == nullptr) {
+        perror(path.c_str());
+        return;
+    }
+    while (dirent *entry = readdir(dir)) {
+        if (entry->d_name[0] != '.') {
+            names.push_back(path + "/" + entry->d_name);
+        }
+    }
+    closedir(dir);
+    std::sort(names.begin(), names.end());
+    files.insert(files.end(), names.begin(), names.end());
+}
+
+/**
+ * @brief A random argument byte: often an edge or a small value
+ */
+uint8_t randomByte(std::mt19937 &random) {
+    switch (random() % 4) {
+        case 0: return static_cast<uint8_t>(random());
+        case 1: return random() % 2 ? 0x00 : 0xFF;
+        default: return static_cast<uint8_t>(random() % 64);
+    }
+}
+
+void randomParam(std::mt19937 &random, bool wide, std::vector<uint8_t> &bytes) {
+    for (int i = 0; i < (wide ? 4 : 2); i++) {
+        bytes.push_back(randomByte(random));
+    }
+}
+
+/**
+ * @brief A random case of up to 48 calls, each with the arguments it reads
+ */
+std::vector<uint8_t> generateCase(std::mt19937 &random) {
+    std::vector<uint8_t> bytes;
+    bytes.push_back(static_cast<uint8_t>(random()));
+    bytes.push_back(static_cast<uint8_t>(random()));
+    size_t calls = 1 + random() % 48;
+    for (size_t i = 0; i < calls; i++) {
+        Op   op   = static_cast<Op>(random() % OP_COUNT);
+        bool wide = random() % 8 == 0;
+        bytes.push_back(static_cast<uint8_t>(op | (wide ? 0x80 : 0)));
+        switch (op) {
+            case OP_POSITION:
+            case OP_MOVE:
+                randomParam(random, wide, bytes);
+                randomParam(random, wide, bytes);
+                break;
+            case OP_SCROLL: randomParam(random, wide, bytes); break;
+            case OP_TYPE_TEXT:
+            case OP_TYPE_TEXT_LINE: {
+                // Mostly printable, with repeats for the text window to find
+                size_t length = random() % (TEXT_MAX + 1);
+                bytes.push_back(static_cast<uint8_t>(length));
+                for (size_t k = 0; k < length; k++) {
+                    uint8_t character = random() % 4 == 0 ? randomByte(random) : 0x20 + random() % 0x5F;
+                    bytes.push_back(k >= 4 && random() % 3 == 0 ? bytes[bytes.size() - 4] : character);
+                }
+                break;
+            }
+            case OP_SEND_EVENT: {
+                uint8_t kind = static_cast<uint8_t>(random());
+                bytes.push_back(kind);
+                if (kind & 0x80) {
+                    bytes.push_back(randomByte(random));
+                } else {
+                    randomParam(random, wide, bytes);
+                    randomParam(random, wide, bytes);
+                }
+                break;
+            }
+            case OP_PRESS_KEY:
+            case OP_RELEASE_KEY:
+            case OP_TAP_KEY:
+            case OP_PRESS_CHAR:
+            case OP_RELEASE_CHAR:
+            case OP_TYPE_CHAR:
+            case OP_SHORTCUT:
+            case OP_SKIP_REDUNDANT: bytes.push_back(randomByte(random)); break;
+            default: break;
+        }
+    }
+    return bytes;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    long        generated = 0;
+    unsigned    seed      = 1;
+    const char *writeDir  = nullptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "g:r:w:vh")) != -1) {
+        switch (option) {
+            case 'g': generated = atol(optarg); break;
+            case 'r': seed = static_cast<unsigned>(strtoul(optarg, nullptr, 10)); break;
+            case 'w': writeDir = optarg; break;
+            case 'v': g_verbose = true; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind == argc && generated <= 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> files;
+    for (int i = optind; i < argc; i++) {
+        listCases(argv[i], files);
+    }
+
+    int                  failures = 0;
+    std::vector<uint8_t> bytes;
+    for (const std::string &file : files) {
+        if (!readFile(file, bytes)) {
+            failures++;
+            continue;
+        }
+        if (!runCase(bytes.data(), bytes.size())) {
+            printf("  in %s\n", file.c_str());
+            failures++;
+        }
+    }
+
+    std::mt19937 random(seed);
+    for (long i = 0; i < generated; i++) {
+        bytes = generateCase(random);
+        if (writeDir) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/gen-%u-%05ld", writeDir, seed, i);
+            FILE *file = fopen(path, "wb");
+            if (file == nullptr || fwrite(bytes.data(), 1, bytes.size(), file) != bytes.size()) {
+                perror(path);
+                return 2;
+            }
+            fclose(file);
+        }
+        if (!runCase(bytes.data(), bytes.size())) {
+            printf("  generated case %ld, seed %u\n", i, seed);
+            failures++;
+        }
+    }
+
+    printf("%zu files, %ld generated cases, %d failed\n", files.size(), generated, failures);
+    return failures < 100 ? failures : 100;
+}
+
+#endif
@@ -0,0 +1,374 @@
+/**
+ * @file PathCompiler.cpp
+ * @brief Implementation of the SVG path compiler
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "PathCompiler.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+const uint32_t PAUSE_MAX_TICKS = 128; ///< Ticks of one pause pair
+
+bool isBlank(char character) {
+    return character == ' ' || character == '\t' || character == '\r' || character == '\n' || character == ',';
+}
+
+bool isNameChar(char character) {
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+           (character >= '0' && character <= '9') || character == '-' || character == '_' || character == ':';
+}
+
+/**
+ * @brief Find an attribute of an element
+ * @param element Element text from '<' to '>'
+ * @param length Element length
+ * @param name Attribute name
+ * @param value Receives the value, without quotes
+ * @return false if the element has no such attribute
+ */
+bool attribute(const char *element, size_t length, const char *name, std::string &value) {
+    size_t nameLength = strlen(name);
+    for (size_t i = 1; i + nameLength < length; i++) {
+        if (isNameChar(element[i - 1]) || strncmp(element + i, name, nameLength) != 0 ||
+            isNameChar(element[i + nameLength])) {
+            continue;
+        }
+        size_t j = i + nameLength;
+        while (j < length && isBlank(element[j])) {
+            j++;
+        }
+        if (j == length || element[j] != '=') {
+            continue;
+        }
+        j++;
+        while (j < length && isBlank(element[j])) {
+            j++;
+        }
+        if (j == length || (element[j] != '"' && element[j] != '\'')) {
+            continue;
+        }
+        const char *end = static_cast<const char *>(memchr(element + j + 1, element[j], length - j - 1));
+        if (end == nullptr) {
+            return false;
+        }
+        value.assign(element + j + 1, end);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Read the next number of a list
+ * @param cursor Position in a NUL-terminated list; moved past the number
+ * @param number Receives the number
+ * @return false at the end of the list or on something else than a number
+ */
+bool nextNumber(const char *&cursor, double &number) {
+    while (isBlank(*cursor)) {
+        cursor++;
+    }
+    char *end;
+    number = strtod(cursor, &end);
+    if (end == cursor) {
+        return false;
+    }
+    cursor = end;
+    return true;
+}
+
+} // namespace
+
+PathCompiler::PathCompiler()
+    : m_path(nullptr)
+    , m_cursorX(0)
+    , m_cursorY(0)
+    , m_still(0)
+    , m_ticks(0)
+    , m_startX(-1)
+    , m_startY(-1) {
+}
+
+bool PathCompiler::compile(const char *svg, size_t length, const Options &options, std::vector<int8_t> &path) {
+    m_strokes.clear();
+    m_path   = &path;
+    m_still  = 0;
+    m_ticks  = 0;
+    m_startX = -1;
+    m_startY = -1;
+    path.clear();
+
+    if (!(options.scale > 0) || !(options.speed > 0) || options.tickMs == 0) {
+        m_lastError = "scale, speed and tick must be positive";
+        return false;
+    }
+
+    size_t line     = 1;
+    size_t lineFrom = 0;
+    for (size_t position = 0; position < length; position++) {
+        if (svg[position] != '<') {
+            continue;
+        }
+        for (; lineFrom < position; lineFrom++) {
+            line += svg[lineFrom] == '\n' ? 1 : 0;
+        }
+
+        if (length - position >= 4 && strncmp(svg + position, "<!--", 4) == 0) {
+            while (position + 3 <= length && strncmp(svg + position, "-->", 3) != 0) {
+                position++;
+            }
+            continue;
+        }
+        const char *close = static_cast<const char *>(memchr(svg + position, '>', length - position));
+        if (close == nullptr) {
+            m_lastError = "line " + std::to_string(line) + ": unterminated element";
+            return false;
+        }
+
+        const char *element       = svg + position;
+        size_t      elementLength = close - element + 1;
+        size_t      nameLength    = 1;
+        while (nameLength < elementLength && isNameChar(element[nameLength])) {
+            nameLength++;
+        }
+        std::string name(element + 1, nameLength - 1);
+        std::string value;
+        bool        ok = true;
+
+        if (name == "polyline" || name == "polygon") {
+            if (!attribute(element, elementLength, "points", value)) {
+                m_lastError = name + " without points";
+                ok          = false;
+            } else if ((ok = parsePoints(value.data(), value.size())) && name == "polygon" &&
+                       !m_strokes.back().empty()) {
+                m_strokes.back().push_back(m_strokes.back().front());
+            }
+        } else if (name == "line") {
+            ok = parseLine(element, elementLength);
+        } else if (name == "path") {
+            if (!attribute(element, elementLength, "d", value)) {
+                m_lastError = "path without d";
+                ok          = false;
+            } else {
+                ok = parsePathData(value.data(), value.size());
+            }
+        }
+        if (!ok) {
+            m_lastError = "line " + std::to_string(line) + ": " + m_lastError;
+            return false;
+        }
+        position = close - svg;
+    }
+
+    for (size_t i = m_strokes.size(); i-- > 0;) {
+        if (m_strokes[i].empty()) {
+            m_strokes.erase(m_strokes.begin() + i);
+        }
+    }
+    if (m_strokes.empty()) {
+        m_lastError = "no polyline, polygon, line or path";
+        return false;
+    }
+
+    // The pointer starts on the first point: at the origin plus that point, or wherever it is
+    bool   absolute = options.originX >= 0 && options.originY >= 0;
+    double originX  = absolute ? options.originX : 0;
+    double originY  = absolute ? options.originY : 0;
+    m_cursorX       = lround(originX + m_strokes[0][0].x * options.scale);
+    m_cursorY       = lround(originY + m_strokes[0][0].y * options.scale);
+    if (absolute) {
+        if (m_cursorX < 0 || m_cursorY < 0 || m_cursorX > 32767 || m_cursorY > 32767) {
+            m_lastError = "the first point is off the screen";
+            return false;
+        }
+        m_startX = static_cast<int16_t>(m_cursorX);
+        m_startY = static_cast<int16_t>(m_cursorY);
+    }
+
+    double stepPixels = options.speed * options.tickMs / 1000.0;
+    for (const std::vector<Point> &stroke : m_strokes) {
+        segment(originX + stroke[0].x * options.scale, originY + stroke[0].y * options.scale, stepPixels);
+        if (options.drag) {
+            // A still tick after the press and before the release, for apps that need to see them apart
+            control(PATH_BUTTON | static_cast<uint8_t>(MouseEvent::LEFT_PRESS));
+            tick(0, 0);
+        }
+        for (size_t i = 1; i < stroke.size(); i++) {
+            segment(originX + stroke[i].x * options.scale, originY + stroke[i].y * options.scale, stepPixels);
+        }
+        if (options.drag) {
+            tick(0, 0);
+            control(PATH_BUTTON | static_cast<uint8_t>(MouseEvent::LEFT_RELEASE));
+        }
+    }
+
+    // Trailing stillness is not worth a pause
+    m_ticks -= m_still;
+    m_still = 0;
+    control(PATH_END);
+    m_path = nullptr;
+    return true;
+}
+
+bool PathCompiler::parsePoints(const char *text, size_t length) {
+    std::string        list(text, length);
+    const char        *cursor = list.c_str();
+    std::vector<Point> stroke;
+    Point              point;
+
+    while (nextNumber(cursor, point.x)) {
+        if (!nextNumber(cursor, point.y)) {
+            m_lastError = "odd number of coordinates in points";
+            return false;
+        }
+        stroke.push_back(point);
+    }
+    while (isBlank(*cursor)) {
+        cursor++;
+    }
+    if (*cursor != '\0') {
+        m_lastError = std::string("bad number in points near \"") + std::string(cursor).substr(0, 10) + "\"";
+        return false;
+    }
+    m_strokes.push_back(stroke);
+    return true;
+}
+
+bool PathCompiler::parseLine(const char *element, size_t length) {
+    static const char *const NAMES[] = {"x1", "y1", "x2", "y2"};
+    double                   values[4];
+
+    for (int i = 0; i < 4; i++) {
+        std::string value;
+        const char *cursor;
+        values[i] = 0; // SVG default
+        if (attribute(element, length, NAMES[i], value) && !nextNumber(cursor = value.c_str(), values[i])) {
+            m_lastError = std::string("bad ") + NAMES[i] + " in line";
+            return false;
+        }
+    }
+    m_strokes.push_back({{values[0], values[1]}, {values[2], values[3]}});
+    return true;
+}
+
+bool PathCompiler::parsePathData(const char *text, size_t length) {
+    std::string data(text, length);
+    const char *cursor  = data.c_str();
+    char        command = 0;
+    bool        open    = false; // The current point starts no stroke yet (after Z)
+    Point       current = {0, 0};
+    Point       start   = {0, 0};
+
+    for (;;) {
+        while (isBlank(*cursor)) {
+            cursor++;
+        }
+        if (*cursor == '\0') {
+            return true;
+        }
+
+        if ((*cursor >= 'a' && *cursor <= 'z') || (*cursor >= 'A' && *cursor <= 'Z')) {
+            command = *cursor++;
+            if (strchr("CcSsQqTtAa", command) != nullptr) {
+                m_lastError = std::string("curves are not supported (") + command + "); flatten the path first";
+                return false;
+            }
+            if (command == 'Z' || command == 'z') {
+                if (!m_strokes.empty() && !m_strokes.back().empty()) {
+                    m_strokes.back().push_back(start);
+                }
+                current = start;
+                open    = true;
+                continue;
+            }
+            if (strchr("MmLlHhVv", command) == nullptr) {
+                m_lastError = std::string("unknown path command ") + command;
+                return false;
+            }
+        } else if (command == 0 || command == 'Z' || command == 'z') {
+            m_lastError = "path data must start with a command";
+            return false;
+        }
+
+        bool   relative = command >= 'a';
+        double first;
+        double second = 0;
+        if (!nextNumber(cursor, first) || (strchr("MmLl", command) != nullptr && !nextNumber(cursor, second))) {
+            m_lastError = std::string("bad number after ") + command;
+            return false;
+        }
+
+        switch (command) {
+            case 'M':
+            case 'm':
+                current = relative ? Point{current.x + first, current.y + second} : Point{first, second};
+                start   = current;
+                m_strokes.push_back({current});
+                open    = false;
+                command = relative ? 'l' : 'L'; // Further pairs are lines
+                continue;
+            case 'L':
+            case 'l': current = relative ? Point{current.x + first, current.y + second} : Point{first, second}; break;
+            case 'H':
+            case 'h': current.x = relative ? current.x + first : first; break;
+            case 'V':
+            case 'v': current.y = relative ? current.y + first : first; break;
+        }
+        if (m_strokes.empty() || open) {
+            m_strokes.push_back({start});
+            open = false;
+        }
+        m_strokes.back().push_back(current);
+    }
+}
+
+void PathCompiler::segment(double x, double y, double stepPixels) {
+    long   fromX    = m_cursorX;
+    long   fromY    = m_cursorY;
+    double dx       = x - fromX;
+    double dy       = y - fromY;
+    double byLength = ceil(hypot(dx, dy) / stepPixels);
+    double byDelta  = ceil(fmax(fabs(dx), fabs(dy)) / PATH_DELTA_MAX);
+    long   steps    = static_cast<long>(fmax(byLength, byDelta));
+
+    for (long i = 1; i <= steps; i++) {
+        long targetX = lround(fromX + dx * i / steps);
+        long targetY = lround(fromY + dy * i / steps);
+        tick(static_cast<int>(targetX - m_cursorX), static_cast<int>(targetY - m_cursorY));
+        m_cursorX = targetX;
+        m_cursorY = targetY;
+    }
+}
+
+void PathCompiler::tick(int dx, int dy) {
+    m_ticks++;
+    if (dx == 0 && dy == 0) {
+        m_still++;
+        return;
+    }
+    pause();
+    m_path->push_back(static_cast<int8_t>(dx));
+    m_path->push_back(static_cast<int8_t>(dy));
+}
+
+void PathCompiler::control(uint8_t op) {
+    pause();
+    m_path->push_back(PATH_ESCAPE);
+    m_path->push_back(static_cast<int8_t>(op));
+}
+
+void PathCompiler::pause() {
+    while (m_still > 0) {
+        uint32_t ticks = m_still < PAUSE_MAX_TICKS ? m_still : PAUSE_MAX_TICKS;
+        m_path->push_back(PATH_ESCAPE);
+        m_path->push_back(static_cast<int8_t>(PATH_PAUSE | (ticks - 1)));
+        m_still -= ticks;
+    }
+}
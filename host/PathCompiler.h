@@ -0,0 +1,149 @@
+/**
+ * @file PathCompiler.h
+ * @brief Compiles SVG polylines into mouse paths
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Reads the straight-line shapes of an SVG drawing:
+ *
+ *   <polyline points="...">  <polygon points="...">
+ *   <line x1 y1 x2 y2>       <path d="..."> with M, L, H, V and Z
+ *                            (absolute or relative)
+ *
+ * Each shape, or subpath of a <path>, is one stroke. Strokes are
+ * resampled at a constant speed into one move per tick, never more
+ * than PATH_DELTA_MAX per axis; rounding is carried from tick to tick,
+ * so the path ends exactly on the last point. Travel between strokes
+ * is played at the same speed, with the button up. Still ticks become
+ * pauses. Curves (C, S, Q, T, A) are rejected: flatten them first
+ * (Inkscape: Extensions > Modify Path > Flatten Beziers). Transforms
+ * are ignored.
+ *
+ * See PATH_ESCAPE in SerialInputProtocol.h for the format and
+ * SerialInputPath.h for the player.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef PATH_COMPILER_H
+#define PATH_COMPILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "SerialInputProtocol.h"
+
+/**
+ * @brief SVG to mouse path compiler
+ *
+ * Reusable: each compile() starts from scratch but keeps its buffers.
+ */
+class PathCompiler {
+  public:
+    /**
+     * @brief How a drawing becomes a path
+     */
+    struct Options {
+        double   scale;   ///< Screen pixels per SVG unit
+        double   speed;   ///< Pointer speed in pixels per second
+        uint8_t  tickMs;  ///< Time per tick
+        int16_t  originX; ///< Screen position of the SVG origin, -1 to play relative to the pointer
+        int16_t  originY; ///< Screen position of the SVG origin (with originX)
+        bool     drag;    ///< Hold the left button during strokes (drawing, drag and drop)
+
+        Options() : scale(1.0), speed(800.0), tickMs(8), originX(-1), originY(-1), drag(false) {
+        }
+    };
+
+    PathCompiler();
+
+    /**
+     * @brief Compile a drawing
+     * @param svg SVG text
+     * @param length SVG length
+     * @param options Scale, speed and placement
+     * @param path Receives the path, ending with PATH_END
+     * @return false on a malformed or unsupported shape, see lastError()
+     */
+    bool compile(const char *svg, size_t length, const Options &options, std::vector<int8_t> &path);
+
+    /**
+     * @brief Absolute start of the last compiled path
+     * @return Screen position of its first point, -1 for relative paths
+     */
+    inline int16_t startX() const {
+        return m_startX;
+    }
+
+    /**
+     * @brief Absolute start of the last compiled path
+     * @return Screen position of its first point, -1 for relative paths
+     */
+    inline int16_t startY() const {
+        return m_startY;
+    }
+
+    /**
+     * @brief Strokes in the last compiled path
+     * @return Shapes and subpaths with at least one point
+     */
+    inline size_t strokes() const {
+        return m_strokes.size();
+    }
+
+    /**
+     * @brief Ticks of the last compiled path, pauses included
+     * @return Playing time in ticks
+     */
+    inline uint32_t ticks() const {
+        return m_ticks;
+    }
+
+    /**
+     * @brief Get the last error message
+     * @return "line N: ..." for the last failed compile()
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    /**
+     * @brief Point in SVG units
+     */
+    struct Point {
+        double x;
+        double y;
+    };
+
+    std::vector<std::vector<Point>> m_strokes;   ///< Strokes of the drawing being compiled
+    std::vector<int8_t>            *m_path;      ///< Output of the compile() in progress
+    long                            m_cursorX;   ///< Pointer position reached by the path so far
+    long                            m_cursorY;   ///< Pointer position reached by the path so far
+    uint32_t                        m_still;     ///< Still ticks not written yet
+    uint32_t                        m_ticks;     ///< Ticks written
+    int16_t                         m_startX;    ///< Absolute start, -1 for relative paths
+    int16_t                         m_startY;    ///< Absolute start, -1 for relative paths
+    std::string                     m_lastError; ///< Last failure description
+
+    bool parsePoints(const char *text, size_t length);
+    bool parsePathData(const char *text, size_t length);
+    bool parseLine(const char *element, size_t length);
+
+    /**
+     * @brief Move the pointer along a straight segment, one tick at a time
+     * @param x Target in screen pixels
+     * @param y Target in screen pixels
+     * @param stepPixels Distance covered per tick
+     */
+    void segment(double x, double y, double stepPixels);
+
+    void tick(int dx, int dy);
+    void control(uint8_t op);
+    void pause(); ///< Write the still ticks as pauses
+};
+
+#endif // PATH_COMPILER_H
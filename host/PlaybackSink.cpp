@@ -0,0 +1,99 @@
+/**
+ * @file PlaybackSink.cpp
+ * @brief Implementation of deadline playback
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "PlaybackSink.h"
+
+#include <time.h>
+
+namespace {
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+} // namespace
+
+PlaybackSink::PlaybackSink(EventSink &downstream, const ClockSync &clock)
+    : m_downstream(downstream), m_clock(clock), m_lastDueNs(0), m_pending(false), m_stats() {
+}
+
+void PlaybackSink::event(const ProtocolFrame &frame) {
+    bool scheduled = frame.due && m_clock.synced();
+    if (!scheduled && m_wheel.size() == 0) {
+        m_downstream.event(frame);
+        m_pending = true;
+        m_stats.immediate++;
+        return;
+    }
+
+    uint64_t nowNs = monotonicNs();
+    uint64_t dueNs = nowNs;
+    if (scheduled) {
+        dueNs = m_clock.toHostNs(frame.deviceUs);
+        if (dueNs < nowNs) {
+            dueNs = nowNs;
+            m_stats.lateArrivals++;
+        } else if (dueNs - nowNs > PLAYBACK_MAX_LEAD_NS) {
+            dueNs = nowNs + PLAYBACK_MAX_LEAD_NS;
+        }
+        m_stats.scheduled++;
+    } else {
+        m_stats.immediate++;
+    }
+    if (dueNs < m_lastDueNs) {
+        dueNs = m_lastDueNs;
+    }
+    m_lastDueNs = dueNs;
+
+    ProtocolFrame held = frame;
+    held.text          = nullptr;
+    held.length        = 0;
+    m_wheel.schedule(dueNs, held);
+}
+
+void PlaybackSink::flush() {
+    if (m_pending) {
+        m_downstream.flush();
+        m_pending = false;
+    }
+}
+
+size_t PlaybackSink::runDue() {
+    size_t delivered = 0;
+    for (;;) {
+        uint64_t deadlineNs = m_wheel.nextDeadline();
+        uint64_t nowNs      = monotonicNs();
+        if (deadlineNs == TIMER_WHEEL_NEVER || deadlineNs > nowNs + PLAYBACK_SPIN_NS) {
+            return delivered;
+        }
+        while (nowNs < deadlineNs) {
+            nowNs = monotonicNs();
+        }
+
+        delivered += m_wheel.expire(nowNs, [this, nowNs](uint64_t dueNs, const ProtocolFrame &frame) {
+            m_downstream.event(frame);
+            if (frame.due) {
+                uint64_t latenessNs = nowNs - dueNs;
+                m_stats.totalLatenessNs += latenessNs;
+                m_stats.delivered++;
+                if (latenessNs > m_stats.maxLatenessNs) {
+                    m_stats.maxLatenessNs = latenessNs;
+                }
+            }
+        });
+        m_downstream.flush();
+    }
+}
+
+void PlaybackSink::clear() {
+    m_wheel.clear();
+    m_lastDueNs = 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file PlaybackSink.h
+ * @brief Holds events sent ahead by the device until they are due
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * A device in scheduled playback (enableScheduledPlayback()) sends each
+ * event up to its lead time early, stamped with the device time at which
+ * it should execute (!TIME). PlaybackSink maps that time to
+ * CLOCK_MONOTONIC with ClockSync, parks the event in a TimerWheel and
+ * hands it to the downstream sink at its deadline, so UART buffering and
+ * the timing of the sketch's loop no longer show in the injected
+ * stream.
+ *
+ * The caller waits until nextDeadlineNs() (e.g. SerialReader::pollUntil()
+ * with a little slack) and then calls runDue(), which spins the last
+ * PLAYBACK_SPIN_NS on the clock before each deadline. Events keep their
+ * arrival order: one due earlier than an event already held is delayed
+ * to that event's deadline, and unscheduled events wait behind held
+ * ones.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef PLAYBACK_SINK_H
+#define PLAYBACK_SINK_H
+
+#include <stdint.h>
+
+#include "ClockSync.h"
+#include "EventSink.h"
+#include "TimerWheel.h"
+
+const uint64_t PLAYBACK_SPIN_NS     = 200000;      ///< Busy-wait this long before a deadline instead of sleeping
+const uint64_t PLAYBACK_MAX_LEAD_NS = 10000000000; ///< Deadlines further ahead are treated as this far
+
+/**
+ * @brief Delivery statistics
+ */
+struct PlaybackStats {
+    uint64_t scheduled;       ///< Events held until their due time
+    uint64_t immediate;       ///< Events without a due time (passed through or queued behind held ones)
+    uint64_t lateArrivals;    ///< Scheduled events that arrived after their due time (delivered at once)
+    uint64_t delivered;       ///< Scheduled events handed downstream
+    uint64_t maxLatenessNs;   ///< Largest delivery time minus deadline
+    uint64_t totalLatenessNs; ///< Sum of delivery time minus deadline, for the mean
+};
+
+/**
+ * @brief EventSink delaying due-stamped events until their deadline
+ */
+class PlaybackSink : public EventSink {
+  public:
+    /**
+     * @brief Create a sink
+     * @param downstream Sink receiving the events at their due time
+     * @param clock Device clock mapping (updated by the caller)
+     */
+    PlaybackSink(EventSink &downstream, const ClockSync &clock);
+
+    void event(const ProtocolFrame &frame) override;
+    void flush() override;
+
+    /**
+     * @brief Earliest deadline held
+     * @return CLOCK_MONOTONIC time in ns, TIMER_WHEEL_NEVER when idle
+     */
+    inline uint64_t nextDeadlineNs() const {
+        return m_wheel.nextDeadline();
+    }
+
+    /**
+     * @brief Deliver the events due now or within PLAYBACK_SPIN_NS
+     * @return Events delivered (downstream is flushed after each deadline)
+     */
+    size_t runDue();
+
+    /**
+     * @brief Drop every held event
+     */
+    void clear();
+
+    /**
+     * @brief Get the delivery statistics
+     * @return Counters since construction
+     */
+    inline const PlaybackStats &stats() const {
+        return m_stats;
+    }
+
+  private:
+    EventSink                 &m_downstream; ///< Destination
+    const ClockSync           &m_clock;      ///< Device time mapping
+    TimerWheel<ProtocolFrame>  m_wheel;      ///< Held events, text cleared
+    uint64_t                   m_lastDueNs;  ///< Deadline of the last event held
+    bool                       m_pending;    ///< Events passed through since the last flush()
+    PlaybackStats              m_stats;      ///< Delivery statistics
+};
+
+#endif // PLAYBACK_SINK_H
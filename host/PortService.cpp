@@ -0,0 +1,198 @@
+/**
+ * @file PortService.cpp
+ * @brief Implementation of the epoll multi-port service
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "PortService.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "SerialPort.h"
+
+namespace {
+
+const int      MAX_READY = 64;         ///< epoll events fetched per wake-up
+const uint32_t WAKE_ID   = 0xFFFFFFFF; ///< epoll tag of the stop eventfd
+
+} // namespace
+
+PortService::PortService(size_t bufferSize)
+    : m_epoll(epoll_create1(EPOLL_CLOEXEC)), m_wake(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)),
+      m_buffer(bufferSize ? bufferSize : 1), m_open(0), m_stopped(false) {
+    if (m_epoll < 0 || m_wake < 0) {
+        m_lastError = std::string("epoll setup failed: ") + strerror(errno);
+        return;
+    }
+
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events   = EPOLLIN;
+    event.data.u32 = WAKE_ID;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wake, &event);
+}
+
+PortService::~PortService() {
+    for (Port &port : m_ports) {
+        closePort(port);
+    }
+    if (m_wake >= 0) {
+        ::close(m_wake);
+    }
+    if (m_epoll >= 0) {
+        ::close(m_epoll);
+    }
+}
+
+int PortService::addPort(const char *path, unsigned long baudRate, EventSink *sink) {
+    SerialPort port;
+    if (!port.open(path, baudRate)) {
+        m_lastError = port.lastError();
+        return -1;
+    }
+
+    int fd = dup(port.fd());
+    if (fd < 0) {
+        m_lastError = std::string("dup failed: ") + strerror(errno);
+        return -1;
+    }
+    return addDescriptor(fd, path, sink);
+}
+
+int PortService::addDescriptor(int fd, const char *name, EventSink *sink) {
+    if (m_epoll < 0) {
+        ::close(fd);
+        return -1;
+    }
+
+    int id = static_cast<int>(m_ports.size());
+
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events   = EPOLLIN;
+    event.data.u32 = static_cast<uint32_t>(id);
+    if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) < 0) {
+        m_lastError = std::string("epoll_ctl failed for ") + name + ": " + strerror(errno);
+        ::close(fd);
+        return -1;
+    }
+
+    Port port;
+    port.fd    = fd;
+    port.sink  = sink;
+    port.stats = PortStats();
+    m_ports.push_back(port);
+    m_names.push_back(name);
+    m_open++;
+    return id;
+}
+
+size_t PortService::portCount() const {
+    return m_open;
+}
+
+PortStats PortService::stats(int id) const {
+    if (id < 0 || static_cast<size_t>(id) >= m_ports.size()) {
+        return PortStats();
+    }
+    return m_ports[id].stats;
+}
+
+void PortService::closePort(Port &port) {
+    if (port.fd >= 0) {
+        epoll_ctl(m_epoll, EPOLL_CTL_DEL, port.fd, nullptr);
+        ::close(port.fd);
+        port.fd = -1;
+        port.decoder.reset();
+        m_open--;
+    }
+}
+
+int PortService::service(Port &port) {
+    ssize_t count = ::read(port.fd, m_buffer.data(), m_buffer.size());
+    if (count < 0 && (errno == EINTR || errno == EAGAIN)) {
+        return 0;
+    }
+    if (count <= 0) {
+        closePort(port);
+        return 0;
+    }
+
+    port.stats.bytes += static_cast<uint64_t>(count);
+
+    EventSink *sink   = port.sink;
+    PortStats &stats  = port.stats;
+    int        events = 0;
+    port.decoder.feed(m_buffer.data(), static_cast<size_t>(count), [&](const ProtocolFrame &frame) {
+        if (frame.kind == FrameKind::EVENT) {
+            sink->event(frame);
+            events++;
+        } else if (frame.kind == FrameKind::INVALID) {
+            stats.invalid++;
+        }
+    });
+    stats.events += static_cast<uint64_t>(events);
+
+    if (events > 0 && std::find(m_dirty.begin(), m_dirty.end(), sink) == m_dirty.end()) {
+        m_dirty.push_back(sink);
+    }
+    return events;
+}
+
+int PortService::runOnce(int timeoutMs) {
+    epoll_event ready[MAX_READY];
+    int         count = epoll_wait(m_epoll, ready, MAX_READY, timeoutMs);
+    if (count < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        m_lastError = std::string("epoll_wait failed: ") + strerror(errno);
+        return -1;
+    }
+
+    int frames = 0;
+    for (int i = 0; i < count; i++) {
+        if (ready[i].data.u32 == WAKE_ID) {
+            continue;
+        }
+        Port &port = m_ports[ready[i].data.u32];
+        if (port.fd < 0) {
+            continue;
+        }
+        if (ready[i].events & EPOLLIN) {
+            frames += service(port);
+        } else if (ready[i].events & (EPOLLHUP | EPOLLERR)) {
+            closePort(port);
+        }
+    }
+
+    for (EventSink *sink : m_dirty) {
+        sink->flush();
+    }
+    m_dirty.clear();
+    return frames;
+}
+
+void PortService::run(volatile sig_atomic_t &running) {
+    while (running && !m_stopped.load(std::memory_order_acquire) && m_open > 0) {
+        if (runOnce(-1) < 0) {
+            break;
+        }
+    }
+}
+
+void PortService::stop() {
+    m_stopped.store(true, std::memory_order_release);
+    uint64_t value = 1;
+    if (::write(m_wake, &value, sizeof(value)) < 0) {
+        // Counter saturated: a wake-up is already pending
+    }
+}
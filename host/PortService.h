@@ -0,0 +1,137 @@
+/**
+ * @file PortService.h
+ * @brief epoll event loop serving many serial ports from one thread
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * One service owns an epoll instance, one shared read buffer and a
+ * small record per port (descriptor, decoder, sink, counters). Ports
+ * become readable independently; each ready port is drained with one
+ * read(), decoded in place and routed to its sink. Sinks touched during
+ * a wake-up are flushed once at its end.
+ *
+ * For many ports, run one service per core (see ShardedPortService in
+ * SerialInputDaemon.cpp) and assign ports round-robin.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef PORT_SERVICE_H
+#define PORT_SERVICE_H
+
+#include <atomic>
+#include <signal.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "EventSink.h"
+#include "ProtocolDecoder.h"
+
+/**
+ * @brief Per-port counters
+ */
+struct PortStats {
+    uint64_t bytes;   ///< Bytes received
+    uint64_t events;  ///< EVENT frames routed
+    uint64_t invalid; ///< INVALID frames seen
+};
+
+/**
+ * @brief Single-threaded multi-port reader
+ */
+class PortService {
+  public:
+    /**
+     * @brief Create a service
+     * @param bufferSize Shared read buffer size
+     */
+    explicit PortService(size_t bufferSize = 65536);
+    ~PortService();
+
+    PortService(const PortService &)            = delete;
+    PortService &operator=(const PortService &) = delete;
+
+    /**
+     * @brief Open a port and add it to the loop
+     * @param path Device path
+     * @param baudRate Baud rate
+     * @param sink Destination of the port's events (not owned)
+     * @return Port id, or -1 on failure (see lastError())
+     */
+    int addPort(const char *path, unsigned long baudRate, EventSink *sink);
+
+    /**
+     * @brief Add an already open descriptor (e.g. a pty)
+     * @param fd Readable descriptor, owned by the service afterwards
+     * @param name Name used in messages
+     * @param sink Destination of the port's events (not owned)
+     * @return Port id, or -1 on failure
+     */
+    int addDescriptor(int fd, const char *name, EventSink *sink);
+
+    /**
+     * @brief Wait for ready ports and process them once
+     * @param timeoutMs Maximum wait in ms, -1 to wait forever
+     * @return Frames routed, or -1 on error
+     */
+    int runOnce(int timeoutMs);
+
+    /**
+     * @brief Process ports until the flag clears or no port is left
+     * @param running Cleared (e.g. by a signal handler) to stop
+     */
+    void run(volatile sig_atomic_t &running);
+
+    /**
+     * @brief Make run() return; safe to call from any thread
+     */
+    void stop();
+
+    /**
+     * @brief Number of open ports
+     * @return Count of ports still in the loop
+     */
+    size_t portCount() const;
+
+    /**
+     * @brief Get a port's counters
+     * @param id Port id from addPort()
+     * @return Counters (zero for unknown ids)
+     */
+    PortStats stats(int id) const;
+
+    /**
+     * @brief Get the last error message
+     * @return Description of the last failure
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    /**
+     * @brief Hot per-port state, kept compact and contiguous
+     */
+    struct Port {
+        int             fd;      ///< Descriptor, -1 once closed
+        EventSink      *sink;    ///< Destination
+        PortStats       stats;   ///< Counters
+        ProtocolDecoder decoder; ///< Partial line state
+    };
+
+    int                      m_epoll;     ///< epoll descriptor
+    int                      m_wake;      ///< eventfd written by stop()
+    std::vector<Port>        m_ports;     ///< Ports indexed by id
+    std::vector<std::string> m_names;     ///< Port names (cold)
+    std::vector<char>        m_buffer;    ///< Shared read buffer
+    std::vector<EventSink *> m_dirty;     ///< Sinks to flush this wake-up
+    size_t                   m_open;      ///< Ports still open
+    std::atomic<bool>        m_stopped;   ///< Set by stop() from any thread
+    std::string              m_lastError; ///< Last failure description
+
+    int  service(Port &port);
+    void closePort(Port &port);
+};
+
+#endif // PORT_SERVICE_H
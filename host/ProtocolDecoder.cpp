@@ -0,0 +1,306 @@
+/**
+ * @file ProtocolDecoder.cpp
+ * @brief Implementation of the SerialInputMonitor line protocol decoder
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "ProtocolDecoder.h"
+
+namespace {
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+inline int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Parse one whitespace-delimited integer token
+ * @param cursor Current position, advanced past the token
+ * @param end End of line
+ * @param hex Parse as hexadecimal (0x prefix optional)
+ * @param value Receives the value
+ * @return false if the token is not a number or does not fit an int32_t
+ */
+bool parseToken(const char *&cursor, const char *end, bool hex, int32_t &value) {
+    const char *p        = cursor;
+    bool        negative = false;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+    if (hex && end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+        p += 2;
+    }
+
+    // Built unsigned and checked per digit: -2147483648 is the largest magnitude
+    const uint32_t limit  = negative ? 0x80000000UL : 0x7FFFFFFFUL;
+    const uint32_t base   = hex ? 16 : 10;
+    const char    *digits = p;
+    uint32_t       result = 0;
+    int            digit;
+
+    while (p < end && (digit = hex ? hexDigit(*p) : (*p >= '0' && *p <= '9' ? *p - '0' : -1)) >= 0) {
+        if (result > (limit - static_cast<uint32_t>(digit)) / base) {
+            return false;
+        }
+        result = result * base + static_cast<uint32_t>(digit);
+        p++;
+    }
+
+    if (p == digits || (p < end && !isSpace(*p))) {
+        return false;
+    }
+
+    value  = negative ? static_cast<int32_t>(0U - result) : static_cast<int32_t>(result);
+    cursor = p;
+    return true;
+}
+
+/**
+ * @brief Parse the trailing @TIME or !TIME token of a stamped event
+ * @param cursor Position after the prefix, advanced past the token
+ * @param end End of line
+ * @param value Receives the device time
+ * @return false unless 1-8 hex digits follow
+ */
+bool parseStamp(const char *&cursor, const char *end, uint32_t &value) {
+    const char *p      = cursor;
+    uint32_t    result = 0;
+    int         digit;
+
+    while (p < end && p - cursor < 8 && (digit = hexDigit(*p)) >= 0) {
+        result = result * 16 + static_cast<uint32_t>(digit);
+        p++;
+    }
+    if (p == cursor || (p < end && !isSpace(*p))) {
+        return false;
+    }
+
+    value  = result;
+    cursor = p;
+    return true;
+}
+
+} // namespace
+
+ProtocolDecoder::ProtocolDecoder()
+    : m_partialLength(0), m_overflow(false), m_framed(false), m_correctedBits(0), m_rejectedFrames(0),
+      m_textPosition(0), m_textKnown(0) {
+}
+
+void ProtocolDecoder::reset() {
+    m_partialLength = 0;
+    m_overflow      = false;
+    m_framed        = false;
+    m_textKnown     = 0;
+}
+
+bool ProtocolDecoder::unframe(const char *&line, size_t &length, bool &framed) {
+    framed = false;
+
+    // FEC: prefix with at most one flipped bit, then two codewords per
+    // byte of text and CRC. A sender's '\r' makes the length even.
+    uint8_t prefixDiff = length > 0 ? static_cast<uint8_t>(line[0] ^ FEC_PREFIX) : 0xFF;
+    if ((prefixDiff & (prefixDiff - 1)) == 0) {
+        size_t codes = length - 1;
+        if (codes % 2 == 1 && line[length - 1] == '\r') {
+            codes--;
+        }
+
+        size_t   bytes = codes / 2;
+        uint16_t crc   = CRC_INIT;
+        uint8_t  flips = prefixDiff != 0 ? 1 : 0;
+        bool     valid = codes % 2 == 0 && bytes >= 3 && bytes - 2 <= sizeof(m_unframed);
+        for (size_t i = 0; valid && i < bytes; i++) {
+            uint8_t high, low;
+            int     upper = fecDecodeByte(static_cast<uint8_t>(line[1 + 2 * i]), high);
+            int     lower = fecDecodeByte(static_cast<uint8_t>(line[2 + 2 * i]), low);
+            valid         = upper >= 0 && lower >= 0;
+            if (valid) {
+                uint8_t byte = static_cast<uint8_t>(upper << 4 | lower);
+                flips        = static_cast<uint8_t>(flips + high + low);
+                if (i < bytes - 2) {
+                    m_unframed[i] = static_cast<char>(byte);
+                    crc           = crc16Update(crc, byte);
+                } else {
+                    crc ^= static_cast<uint16_t>(byte) << (i == bytes - 2 ? 8 : 0);
+                }
+            }
+        }
+
+        if (valid && crc == 0) {
+            m_correctedBits += flips;
+            line   = m_unframed;
+            length = bytes - 2;
+            framed = true;
+            return true;
+        }
+        if (prefixDiff == 0) {
+            return false;
+        }
+        // A plain line that happens to start one bit away from the prefix
+    }
+
+    if (length > 0 && line[length - 1] == '\r') {
+        length--;
+    }
+
+    // CRC: " %CCCC" at the end of the line
+    if (length >= 6 && line[length - 6] == ' ' && line[length - 5] == CRC_PREFIX) {
+        uint32_t    expected = 0;
+        const char *token    = line + length - 4;
+        if (!parseStamp(token, line + length, expected) || token != line + length) {
+            return false;
+        }
+
+        uint16_t crc = CRC_INIT;
+        for (size_t i = 0; i < length - 6; i++) {
+            crc = crc16Update(crc, static_cast<uint8_t>(line[i]));
+        }
+        if (crc != expected) {
+            return false;
+        }
+        length -= 6;
+        framed = true;
+    }
+    return true;
+}
+
+bool ProtocolDecoder::beginText(const char *&cursor, const char *end) {
+    // Header: window position as 1-4 hex digits, then one space
+    const char *p        = cursor;
+    uint16_t    position = 0;
+    int         digit;
+    while (p < end && p - cursor < 4 && (digit = hexDigit(*p)) >= 0) {
+        position = static_cast<uint16_t>(position * 16 + digit);
+        p++;
+    }
+    if (p == cursor || p == end || *p != ' ') {
+        return false;
+    }
+    cursor = ++p;
+
+    uint16_t known = position == m_textPosition ? m_textKnown : 0;
+    while (p < end) {
+        uint16_t distance = 0;
+        int      token    = textToken(p, end, distance);
+        if (token < 0 || distance > known) {
+            return false;
+        }
+        int count = distance > 0 ? token : 1;
+        known     = known + count < TEXT_DISTANCE_MAX ? static_cast<uint16_t>(known + count) : TEXT_DISTANCE_MAX;
+    }
+
+    if (position != m_textPosition) {
+        m_textPosition = position;
+        m_textKnown    = 0;
+    }
+    return true;
+}
+
+int ProtocolDecoder::textToken(const char *&cursor, const char *end, uint16_t &distance) {
+    uint8_t byte = static_cast<uint8_t>(*cursor++);
+    distance     = 0;
+    if (textIsLiteral(byte)) {
+        return byte;
+    }
+    if (cursor == end) {
+        return -1;
+    }
+
+    uint8_t next = static_cast<uint8_t>(*cursor++);
+    if (byte == TEXT_ESCAPE) {
+        return (next ^ 0x40) < 0x80 ? next ^ 0x40 : -1;
+    }
+    if (byte < 0x80 || next < 0x80) {
+        return -1;
+    }
+    distance = static_cast<uint16_t>(((byte & 0x03) << 7 | (next & 0x7F)) + 1);
+    return ((byte >> 2) & 0x1F) + TEXT_MATCH_MIN;
+}
+
+void ProtocolDecoder::decodeLine(const char *line, size_t length, ProtocolFrame &frame) {
+    frame        = ProtocolFrame();
+    frame.kind   = FrameKind::INVALID;
+    frame.text   = line;
+    frame.length = length;
+
+    const char *cursor = line;
+    const char *end    = line + length;
+
+    while (cursor < end && isSpace(*cursor)) {
+        cursor++;
+    }
+    if (cursor < end && *cursor == '#') {
+        frame.kind = FrameKind::COMMENT;
+        return;
+    }
+    if (cursor < end && *cursor == SYNC_PREFIX) {
+        frame.kind = FrameKind::SYNC;
+        return;
+    }
+
+    int32_t  values[4];
+    int      count    = 0;
+    bool     stamped  = false;
+    bool     due      = false;
+    uint32_t deviceUs = 0;
+
+    for (;;) {
+        while (cursor < end && isSpace(*cursor)) {
+            cursor++;
+        }
+        if (cursor == end) {
+            break;
+        }
+        if ((*cursor == STAMP_PREFIX || *cursor == DUE_PREFIX) && count >= 2) {
+            due = *cursor++ == DUE_PREFIX;
+            if (!parseStamp(cursor, end, deviceUs)) {
+                return;
+            }
+            stamped = true;
+            break;
+        }
+        if (count == 4) {
+            return;
+        }
+        bool hex = count == 2 && values[0] == static_cast<int32_t>(Device::KEYBOARD);
+        if (!parseToken(cursor, end, hex, values[count])) {
+            return;
+        }
+        count++;
+    }
+
+    while (cursor < end && isSpace(*cursor)) {
+        cursor++;
+    }
+    if (cursor != end || count < 2 || values[0] < 0 || values[0] > 1 || values[1] < 0 || values[1] > 255) {
+        return;
+    }
+
+    frame.kind       = FrameKind::EVENT;
+    frame.device     = static_cast<uint8_t>(values[0]);
+    frame.event      = static_cast<uint8_t>(values[1]);
+    frame.paramCount = static_cast<uint8_t>(count - 2);
+    frame.param1     = count > 2 ? values[2] : 0;
+    frame.param2     = count > 3 ? values[3] : 0;
+    frame.stamped    = stamped;
+    frame.due        = due;
+    frame.deviceUs   = deviceUs;
+}
@@ -0,0 +1,303 @@
+/**
+ * @file ProtocolDecoder.h
+ * @brief Incremental decoder for the SerialInputMonitor line protocol
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Accepts raw bytes in chunks of any size and reports one frame per
+ * complete line. Nothing is allocated: partial lines are kept in a
+ * fixed buffer and complete lines are parsed in place.
+ *
+ * Framed lines (see Framing) are checked and unwrapped before parsing:
+ * FEC frames are corrected, and lines whose CRC does not match are
+ * reported as INVALID. Once a framed event has been seen, plain events
+ * are INVALID too, since a damaged CRC token leaves a plain line.
+ *
+ * Text lines (see TextWindow) are reported as the key events that
+ * type their characters. The decoder keeps the device's window to
+ * resolve back-references; a line that refers to text it missed is
+ * INVALID.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef PROTOCOL_DECODER_H
+#define PROTOCOL_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "SerialInputProtocol.h"
+
+/**
+ * @brief Kind of a decoded line
+ */
+enum class FrameKind : uint8_t {
+    EVENT   = 0, ///< DEVICE EVENT [PARAM1] [PARAM2]
+    COMMENT = 1, ///< Line starting with '#'
+    INVALID = 2, ///< Anything else (sensor values, text, malformed frames)
+    SYNC    = 3  ///< Clock sync line starting with '~' (see ClockSync.h)
+};
+
+/**
+ * @brief One decoded line
+ *
+ * `text` points into the decoder's or the caller's buffer and is only
+ * valid during the frame callback.
+ */
+struct ProtocolFrame {
+    FrameKind   kind;       ///< Line kind
+    uint8_t     device;     ///< Device code (EVENT only)
+    uint8_t     event;      ///< Event code (EVENT only)
+    uint8_t     paramCount; ///< Number of parameters present (0-2)
+    int32_t     param1;     ///< First parameter, 0 when absent
+    int32_t     param2;     ///< Second parameter, 0 when absent
+    bool        stamped;    ///< Event carries a device timestamp
+    bool        due;        ///< deviceUs is when to execute the event (!TIME), not when it was generated
+    uint32_t    deviceUs;   ///< Device micros() at generation or due time (stamped only)
+    const char *text;       ///< Line without terminator
+    size_t      length;     ///< Line length
+};
+
+/**
+ * @brief Streaming decoder for the line protocol
+ */
+class ProtocolDecoder {
+  public:
+    static const size_t MAX_LINE = 128; ///< Longer lines are reported as INVALID
+
+    ProtocolDecoder();
+
+    /**
+     * @brief Decode a chunk of received bytes
+     * @param data Received bytes
+     * @param size Number of bytes
+     * @param handler Called as handler(const ProtocolFrame &) per complete line
+     * @return Number of frames reported (empty lines are skipped, text lines report one per key event)
+     */
+    template <typename Handler> size_t feed(const char *data, size_t size, Handler &&handler);
+
+    /**
+     * @brief Parse a single line (without terminator)
+     *
+     * Text lines need the decoder's window and come back INVALID.
+     * @param line Line text
+     * @param length Line length
+     * @param frame Receives the decoded frame
+     */
+    static void decodeLine(const char *line, size_t length, ProtocolFrame &frame);
+
+    /**
+     * @brief Drop any partially received line
+     */
+    void reset();
+
+    /**
+     * @brief Check if a partial line is buffered
+     * @return true if bytes are waiting for a line terminator
+     */
+    inline bool hasPartial() const {
+        return m_partialLength > 0 || m_overflow;
+    }
+
+    /**
+     * @brief Bits corrected in FEC frames
+     * @return Count since construction
+     */
+    inline uint64_t correctedBits() const {
+        return m_correctedBits;
+    }
+
+    /**
+     * @brief Lines dropped by the framing checks
+     * @return Count since construction (also reported as INVALID)
+     */
+    inline uint64_t rejectedFrames() const {
+        return m_rejectedFrames;
+    }
+
+  private:
+    char     m_partial[MAX_LINE];             ///< Start of a line split across chunks
+    char     m_unframed[MAX_LINE / 2];        ///< Text of the last FEC frame
+    size_t   m_partialLength;                 ///< Bytes in m_partial
+    bool     m_overflow;                      ///< Current line exceeded MAX_LINE
+    bool     m_framed;                        ///< A framed event was seen: plain events are damaged
+    uint64_t m_correctedBits;                 ///< Bits corrected in FEC frames
+    uint64_t m_rejectedFrames;                ///< Lines dropped by the framing checks
+    char     m_textWindow[TEXT_DISTANCE_MAX]; ///< Characters of text lines by position
+    uint16_t m_textPosition;                  ///< Window position of the next character
+    uint16_t m_textKnown;                     ///< Characters before m_textPosition received intact
+
+    /**
+     * @brief Check and unwrap a framed line
+     * @param line Line with terminator removed up to '\r', set to its text
+     * @param length Line length, set to the text length
+     * @param framed Set if the line carried a CRC
+     * @return false if the line is framed but damaged beyond repair
+     */
+    bool unframe(const char *&line, size_t &length, bool &framed);
+
+    /**
+     * @brief Read the header of a text line and check its payload
+     * @param cursor Position after TEXT_PREFIX, advanced to the payload
+     * @param end End of line
+     * @return false if the line is malformed or refers to text not received
+     *
+     * Moves the window to the line's position, forgetting its contents
+     * when that is not where the last line ended.
+     */
+    bool beginText(const char *&cursor, const char *end);
+
+    /**
+     * @brief Read one payload token of a text line
+     * @param cursor Current position, advanced past the token
+     * @param end End of line
+     * @param distance Receives the back-reference distance, 0 for a character
+     * @return The character or the back-reference length, -1 if malformed
+     */
+    static int textToken(const char *&cursor, const char *end, uint16_t &distance);
+
+    template <typename Handler>
+    size_t emitText(const char *line, size_t length, const char *payload, Handler &handler);
+
+    template <typename Handler> size_t emitLine(const char *line, size_t length, Handler &handler);
+};
+
+template <typename Handler>
+size_t ProtocolDecoder::emitText(const char *line, size_t length, const char *payload, Handler &handler) {
+    const char *cursor = payload;
+    const char *end    = line + length;
+
+    ProtocolFrame frame = ProtocolFrame();
+    frame.kind          = FrameKind::EVENT;
+    frame.device        = static_cast<uint8_t>(Device::KEYBOARD);
+    frame.paramCount    = 1;
+    frame.text          = line;
+    frame.length        = length;
+
+    size_t frames = 0;
+    auto   key    = [&](KeyboardEvent event, VirtualKey code) {
+        frame.event  = static_cast<uint8_t>(event);
+        frame.param1 = static_cast<int32_t>(code);
+        handler(static_cast<const ProtocolFrame &>(frame));
+        frames++;
+    };
+
+    const uint16_t mask = TEXT_DISTANCE_MAX - 1;
+    while (cursor < end) {
+        uint16_t distance = 0;
+        int      token    = textToken(cursor, end, distance);
+        int      count    = distance > 0 ? token : 1;
+        for (int i = 0; i < count; i++) {
+            char character = distance > 0 ? m_textWindow[(m_textPosition - distance) & mask] : static_cast<char>(token);
+            m_textWindow[m_textPosition & mask] = character;
+            m_textPosition++;
+            m_textKnown = m_textKnown < TEXT_DISTANCE_MAX ? m_textKnown + 1 : TEXT_DISTANCE_MAX;
+
+            // The events of typeText(), Shift around shifted characters
+            VirtualKey code  = characterKey(character);
+            bool       shift = characterNeedsShift(character);
+            if (shift) {
+                key(KeyboardEvent::PRESS, VirtualKey::LEFT_SHIFT);
+            }
+            key(KeyboardEvent::PRESS, code);
+            key(KeyboardEvent::RELEASE, code);
+            if (shift) {
+                key(KeyboardEvent::RELEASE, VirtualKey::LEFT_SHIFT);
+            }
+        }
+    }
+    return frames;
+}
+
+template <typename Handler> size_t ProtocolDecoder::emitLine(const char *line, size_t length, Handler &handler) {
+    ProtocolFrame frame;
+    if (m_overflow) {
+        if (length > 0 && line[length - 1] == '\r') {
+            length--;
+        }
+        frame        = ProtocolFrame();
+        frame.kind   = FrameKind::INVALID;
+        frame.text   = line;
+        frame.length = length;
+        m_overflow   = false;
+    } else {
+        const char *text      = line;
+        size_t      rawLength = length;
+        bool        framed    = false;
+        if (!unframe(text, length, framed)) {
+            m_rejectedFrames++;
+            frame        = ProtocolFrame();
+            frame.kind   = FrameKind::INVALID;
+            frame.text   = line;
+            frame.length = rawLength > 0 && line[rawLength - 1] == '\r' ? rawLength - 1 : rawLength;
+        } else if (length == 0) {
+            return 0;
+        } else if (text[0] == TEXT_PREFIX) {
+            const char *payload = text + 1;
+            bool        damaged = !framed && m_framed;
+            if (!damaged && beginText(payload, text + length)) {
+                m_framed = m_framed || framed;
+                return emitText(text, length, payload, handler);
+            }
+            m_rejectedFrames += damaged ? 1 : 0;
+            m_textKnown  = 0;
+            frame        = ProtocolFrame();
+            frame.kind   = FrameKind::INVALID;
+            frame.text   = text;
+            frame.length = length;
+        } else {
+            decodeLine(text, length, frame);
+            if (frame.kind == FrameKind::EVENT && framed) {
+                m_framed = true;
+            } else if (frame.kind == FrameKind::EVENT && m_framed) {
+                m_rejectedFrames++;
+                frame.kind = FrameKind::INVALID;
+            }
+        }
+    }
+    handler(static_cast<const ProtocolFrame &>(frame));
+    return 1;
+}
+
+template <typename Handler> size_t ProtocolDecoder::feed(const char *data, size_t size, Handler &&handler) {
+    size_t      frames = 0;
+    const char *end    = data + size;
+
+    while (data < end) {
+        const char *newline = static_cast<const char *>(memchr(data, '\n', end - data));
+
+        if (!newline) {
+            size_t rest = end - data;
+            if (m_partialLength + rest > MAX_LINE) {
+                m_overflow      = true;
+                m_partialLength = 0;
+            } else if (!m_overflow) {
+                memcpy(m_partial + m_partialLength, data, rest);
+                m_partialLength += rest;
+            }
+            break;
+        }
+
+        size_t length  = newline - data;
+        size_t emitted = 0;
+        if (m_partialLength == 0 && !m_overflow) {
+            emitted = emitLine(data, length, handler);
+        } else if (!m_overflow && m_partialLength + length <= MAX_LINE) {
+            memcpy(m_partial + m_partialLength, data, length);
+            emitted = emitLine(m_partial, m_partialLength + length, handler);
+        } else {
+            m_overflow = true;
+            emitted    = emitLine(m_partial, 0, handler);
+        }
+
+        m_partialLength = 0;
+        frames += emitted;
+        data = newline + 1;
+    }
+
+    return frames;
+}
+
+#endif // PROTOCOL_DECODER_H
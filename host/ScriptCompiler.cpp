@@ -0,0 +1,477 @@
+/**
+ * @file ScriptCompiler.cpp
+ * @brief Implementation of the script compiler
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "ScriptCompiler.h"
+
+#include "SerialInputKeyNames.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief Script key name
+ */
+struct KeyName {
+    const char *name; ///< Name as written in scripts
+    VirtualKey  key;  ///< Key it presses
+};
+
+const KeyName KEY_NAMES[] = {
+    {"CTRL", VirtualKey::LEFT_CONTROL},
+    {"CONTROL", VirtualKey::LEFT_CONTROL},
+    {"SHIFT", VirtualKey::LEFT_SHIFT},
+    {"ALT", VirtualKey::LEFT_ALT},
+    {"GUI", VirtualKey::LEFT_WIN},
+    {"WINDOWS", VirtualKey::LEFT_WIN},
+    {"ENTER", VirtualKey::ENTER},
+    {"ESC", VirtualKey::ESCAPE},
+    {"ESCAPE", VirtualKey::ESCAPE},
+    {"TAB", VirtualKey::TAB},
+    {"SPACE", VirtualKey::SPACE},
+    {"BACKSPACE", VirtualKey::BACKSPACE},
+    {"DELETE", VirtualKey::DELETE},
+    {"DEL", VirtualKey::DELETE},
+    {"INSERT", VirtualKey::INSERT},
+    {"HOME", VirtualKey::HOME},
+    {"END", VirtualKey::END},
+    {"PAGEUP", VirtualKey::PAGE_UP},
+    {"PAGEDOWN", VirtualKey::PAGE_DOWN},
+    {"UP", VirtualKey::ARROW_UP},
+    {"UPARROW", VirtualKey::ARROW_UP},
+    {"DOWN", VirtualKey::ARROW_DOWN},
+    {"DOWNARROW", VirtualKey::ARROW_DOWN},
+    {"LEFT", VirtualKey::ARROW_LEFT},
+    {"LEFTARROW", VirtualKey::ARROW_LEFT},
+    {"RIGHT", VirtualKey::ARROW_RIGHT},
+    {"RIGHTARROW", VirtualKey::ARROW_RIGHT},
+    {"CAPSLOCK", VirtualKey::CAPS_LOCK},
+    {"NUMLOCK", VirtualKey::NUM_LOCK},
+    {"SCROLLLOCK", VirtualKey::SCROLL_LOCK},
+    {"PRINTSCREEN", VirtualKey::PRINT_SCREEN},
+    {"PAUSE", VirtualKey::PAUSE},
+    {"BREAK", VirtualKey::PAUSE},
+    {"MENU", VirtualKey::APPS},
+    {"APP", VirtualKey::APPS},
+};
+
+bool isShift(VirtualKey key) {
+    return key == VirtualKey::SHIFT || key == VirtualKey::LEFT_SHIFT || key == VirtualKey::RIGHT_SHIFT;
+}
+
+bool isModifier(VirtualKey key) {
+    switch (key) {
+        case VirtualKey::CONTROL:
+        case VirtualKey::ALT:
+        case VirtualKey::LEFT_CONTROL:
+        case VirtualKey::RIGHT_CONTROL:
+        case VirtualKey::LEFT_ALT:
+        case VirtualKey::RIGHT_ALT:
+        case VirtualKey::LEFT_WIN:
+        case VirtualKey::RIGHT_WIN: return true;
+        default: return isShift(key);
+    }
+}
+
+/**
+ * @brief Cut the next blank-separated word
+ * @param cursor Advanced past the word and the blanks after it
+ * @param end End of the line
+ * @param length Receives the word length
+ * @return Start of the word
+ */
+const char *nextWord(const char *&cursor, const char *end, size_t &length) {
+    const char *word = cursor;
+    while (cursor < end && *cursor != ' ' && *cursor != '\t') {
+        cursor++;
+    }
+    length = static_cast<size_t>(cursor - word);
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+        cursor++;
+    }
+    return word;
+}
+
+bool wordIs(const char *word, size_t length, const char *name) {
+    return strlen(name) == length && memcmp(word, name, length) == 0;
+}
+
+/**
+ * @brief Parse a decimal integer word
+ * @param allowSign Accept a leading '-'
+ * @return false if the word is not a number or does not fit in 31 bits
+ */
+bool parseNumber(const char *word, size_t length, bool allowSign, int32_t &value) {
+    bool negative = allowSign && length > 1 && word[0] == '-';
+    size_t start  = negative ? 1 : 0;
+    int64_t total = 0;
+
+    if (length == start) {
+        return false;
+    }
+    for (size_t i = start; i < length; i++) {
+        if (word[i] < '0' || word[i] > '9') {
+            return false;
+        }
+        total = total * 10 + (word[i] - '0');
+        if (total > INT32_MAX) {
+            return false;
+        }
+    }
+    value = static_cast<int32_t>(negative ? -total : total);
+    return true;
+}
+
+} // namespace
+
+bool scriptKey(const char *name, size_t length, VirtualKey &key, bool &shift) {
+    shift = false;
+    if (length == 1) {
+        char character = name[0];
+        if (character < 0x21 || character > 0x7E) {
+            return false;
+        }
+        key   = characterKey(character);
+        shift = characterNeedsShift(character);
+        return true;
+    }
+
+    for (const KeyName &entry : KEY_NAMES) {
+        if (wordIs(name, length, entry.name)) {
+            key = entry.key;
+            return true;
+        }
+    }
+
+    // F1 to F24
+    int32_t number;
+    if (length >= 2 && name[0] == 'F' && parseNumber(name + 1, length - 1, false, number) && number >= 1 &&
+        number <= 24 && name[1] != '0') {
+        key = static_cast<VirtualKey>(static_cast<uint16_t>(VirtualKey::F1) + number - 1);
+        return true;
+    }
+    return keyFromName(name, length, key);
+}
+
+ScriptCompiler::ScriptCompiler() : m_waitMs(0), m_defaultDelay(0), m_durationMs(0) {}
+
+bool ScriptCompiler::compile(const char *script, size_t length, std::vector<uint8_t> &program) {
+    m_steps.clear();
+    m_waitMs       = 0;
+    m_defaultDelay = 0;
+    m_durationMs   = 0;
+    m_lastError.clear();
+    program.clear();
+
+    const char *cursor  = script;
+    const char *end     = script + length;
+    const char *last    = nullptr;
+    size_t      lastLen = 0;
+    size_t      number  = 0;
+
+    while (cursor < end) {
+        const char *line = cursor;
+        while (cursor < end && *cursor != '\n') {
+            cursor++;
+        }
+        const char *lineEnd = cursor;
+        if (cursor < end) {
+            cursor++;
+        }
+        number++;
+
+        // Leading blanks go, trailing ones stay for STRING
+        if (lineEnd > line && lineEnd[-1] == '\r') {
+            lineEnd--;
+        }
+        while (line < lineEnd && (*line == ' ' || *line == '\t')) {
+            line++;
+        }
+        size_t lineLength = static_cast<size_t>(lineEnd - line);
+        if (lineLength == 0) {
+            continue;
+        }
+
+        bool ok;
+        if (lineLength >= 6 && memcmp(line, "REPEAT", 6) == 0 && (lineLength == 6 || line[6] == ' ')) {
+            const char *args = line + 6;
+            size_t      countLength;
+            int32_t     count;
+            while (args < lineEnd && *args == ' ') {
+                args++;
+            }
+            const char *word = nextWord(args, lineEnd, countLength);
+            ok = parseNumber(word, countLength, false, count) && args == lineEnd;
+            if (!ok) {
+                m_lastError = "REPEAT needs a count";
+            } else if (last == nullptr) {
+                ok          = false;
+                m_lastError = "REPEAT without a previous command";
+            }
+            for (int32_t i = 0; ok && i < count; i++) {
+                ok = command(last, lastLen);
+            }
+        } else {
+            ok = command(line, lineLength);
+            if (ok && !(lineLength >= 3 && memcmp(line, "REM", 3) == 0 && (lineLength == 3 || line[3] == ' '))) {
+                last    = line;
+                lastLen = lineLength;
+            }
+        }
+
+        if (!ok) {
+            m_lastError = "line " + std::to_string(number) + ": " + m_lastError;
+            m_steps.clear();
+            return false;
+        }
+    }
+
+    emit(ProgramOp::END, 0, 0, 0, 0);
+
+    uint8_t encoded[PROGRAM_STEP_MAX];
+    for (const ProgramStep &step : m_steps) {
+        uint8_t size = encodeProgramStep(encoded, step);
+        program.insert(program.end(), encoded, encoded + size);
+        m_durationMs += step.waitMs;
+    }
+    return true;
+}
+
+bool ScriptCompiler::command(const char *line, size_t length) {
+    const char *cursor = line;
+    const char *end    = line + length;
+    size_t      nameLength;
+    const char *name = nextWord(cursor, end, nameLength);
+    size_t      restLength = static_cast<size_t>(end - cursor);
+
+    if (wordIs(name, nameLength, "REM")) {
+        return true;
+    }
+
+    if (wordIs(name, nameLength, "STRING") || wordIs(name, nameLength, "STRINGLN")) {
+        // Exactly one separator after the command, the rest is typed as is
+        const char *text = name + nameLength < end ? name + nameLength + 1 : end;
+        if (!typeText(text, static_cast<size_t>(end - text))) {
+            return false;
+        }
+        if (nameLength == 8) {
+            emit(ProgramOp::KEY_PRESS, static_cast<uint8_t>(VirtualKey::ENTER), 0, 0, KEY_HOLD_MS);
+            emit(ProgramOp::KEY_RELEASE, static_cast<uint8_t>(VirtualKey::ENTER), 0, 0, KEY_GAP_MS);
+        }
+        m_waitMs += m_defaultDelay;
+        return true;
+    }
+
+    if (wordIs(name, nameLength, "DELAY") || wordIs(name, nameLength, "DEFAULT_DELAY") ||
+        wordIs(name, nameLength, "DEFAULTDELAY")) {
+        size_t      valueLength;
+        const char *value = nextWord(cursor, end, valueLength);
+        int32_t     ms;
+        if (!parseNumber(value, valueLength, false, ms) || cursor != end) {
+            m_lastError = std::string(name, nameLength) + " needs a time in ms";
+            return false;
+        }
+        if (nameLength == 5) {
+            m_waitMs += static_cast<uint32_t>(ms);
+        } else {
+            m_defaultDelay = static_cast<uint32_t>(ms);
+        }
+        return true;
+    }
+
+    if (wordIs(name, nameLength, "MOUSE")) {
+        if (!mouse(cursor, restLength)) {
+            return false;
+        }
+        m_waitMs += m_defaultDelay;
+        return true;
+    }
+
+    if (!keyCombo(line, length)) {
+        return false;
+    }
+    m_waitMs += m_defaultDelay;
+    return true;
+}
+
+bool ScriptCompiler::typeText(const char *text, size_t length) {
+    bool shifted = false;
+
+    for (size_t i = 0; i < length; i++) {
+        char character = text[i];
+        if (static_cast<uint8_t>(character) >= 0x7F || (character < 0x20 && character != '\t')) {
+            char code[8];
+            snprintf(code, sizeof(code), "0x%02X", static_cast<uint8_t>(character));
+            m_lastError = std::string("character ") + code + " cannot be typed";
+            return false;
+        }
+
+        bool shift = characterNeedsShift(character);
+        if (shift != shifted) {
+            emit(shift ? ProgramOp::KEY_PRESS : ProgramOp::KEY_RELEASE, static_cast<uint8_t>(VirtualKey::LEFT_SHIFT),
+                 0, 0, KEY_GAP_MS);
+            shifted = shift;
+        }
+        uint8_t key = static_cast<uint8_t>(characterKey(character));
+        emit(ProgramOp::KEY_PRESS, key, 0, 0, KEY_HOLD_MS);
+        emit(ProgramOp::KEY_RELEASE, key, 0, 0, KEY_GAP_MS);
+    }
+
+    if (shifted) {
+        emit(ProgramOp::KEY_RELEASE, static_cast<uint8_t>(VirtualKey::LEFT_SHIFT), 0, 0, KEY_GAP_MS);
+    }
+    return true;
+}
+
+bool ScriptCompiler::keyCombo(const char *line, size_t length) {
+    const char *cursor = line;
+    const char *end    = line + length;
+    VirtualKey  keys[8];
+    size_t      count = 0;
+    bool        shift = false;
+
+    while (cursor < end) {
+        size_t      nameLength;
+        const char *name = nextWord(cursor, end, nameLength);
+        bool        needsShift;
+        if (count == sizeof(keys) / sizeof(keys[0])) {
+            m_lastError = "too many keys";
+            return false;
+        }
+        if (!scriptKey(name, nameLength, keys[count], needsShift)) {
+            m_lastError = "unknown command or key " + std::string(name, nameLength);
+            return false;
+        }
+        if (cursor < end && !isModifier(keys[count])) {
+            m_lastError = std::string(name, nameLength) + " is not a modifier";
+            return false;
+        }
+        shift = needsShift;
+        count++;
+    }
+
+    // A shifted character as the last key gets Shift unless it is held already
+    for (size_t i = 0; shift && i + 1 < count; i++) {
+        shift = !isShift(keys[i]);
+    }
+    if (shift) {
+        keys[count] = keys[count - 1];
+        keys[count - 1] = VirtualKey::LEFT_SHIFT;
+        count++;
+    }
+
+    for (size_t i = 0; i + 1 < count; i++) {
+        emit(ProgramOp::KEY_PRESS, static_cast<uint8_t>(keys[i]), 0, 0, KEY_GAP_MS);
+    }
+    emit(ProgramOp::KEY_PRESS, static_cast<uint8_t>(keys[count - 1]), 0, 0, KEY_HOLD_MS);
+    emit(ProgramOp::KEY_RELEASE, static_cast<uint8_t>(keys[count - 1]), 0, 0, KEY_GAP_MS);
+    for (size_t i = count - 1; i-- > 0;) {
+        emit(ProgramOp::KEY_RELEASE, static_cast<uint8_t>(keys[i]), 0, 0, KEY_GAP_MS);
+    }
+    return true;
+}
+
+bool ScriptCompiler::mouse(const char *line, size_t length) {
+    const char *cursor = line;
+    const char *end    = line + length;
+    size_t      actionLength;
+    const char *action = nextWord(cursor, end, actionLength);
+    int32_t     values[2];
+    size_t      count = 0;
+
+    if (wordIs(action, actionLength, "CLICK") || wordIs(action, actionLength, "PRESS") ||
+        wordIs(action, actionLength, "RELEASE")) {
+        size_t      buttonLength;
+        const char *button = nextWord(cursor, end, buttonLength);
+        MouseEvent  press;
+        if (buttonLength == 0 || wordIs(button, buttonLength, "LEFT")) {
+            press = MouseEvent::LEFT_PRESS;
+        } else if (wordIs(button, buttonLength, "RIGHT")) {
+            press = MouseEvent::RIGHT_PRESS;
+        } else if (wordIs(button, buttonLength, "MIDDLE")) {
+            press = MouseEvent::MIDDLE_PRESS;
+        } else {
+            m_lastError = "unknown mouse button " + std::string(button, buttonLength);
+            return false;
+        }
+        if (cursor != end) {
+            m_lastError = "MOUSE " + std::string(action, actionLength) + " takes one button";
+            return false;
+        }
+
+        // Releases follow their press in MouseEvent
+        uint8_t release = static_cast<uint8_t>(static_cast<uint8_t>(press) + 1);
+        if (actionLength == 5 && action[0] == 'C') {
+            emit(ProgramOp::MOUSE_BUTTON, static_cast<uint8_t>(press), 0, 0, KEY_HOLD_MS);
+            emit(ProgramOp::MOUSE_BUTTON, release, 0, 0, 0);
+        } else {
+            emit(ProgramOp::MOUSE_BUTTON, action[0] == 'P' ? static_cast<uint8_t>(press) : release, 0, 0, 0);
+        }
+        return true;
+    }
+
+    size_t expected = wordIs(action, actionLength, "SCROLL") ? 1 : 2;
+    if (expected == 2 && !wordIs(action, actionLength, "MOVE") && !wordIs(action, actionLength, "POSITION")) {
+        m_lastError = "unknown mouse action " + std::string(action, actionLength);
+        return false;
+    }
+    while (cursor < end && count < expected) {
+        size_t      valueLength;
+        const char *value = nextWord(cursor, end, valueLength);
+        if (!parseNumber(value, valueLength, action[0] != 'P', values[count])) {
+            break;
+        }
+        count++;
+    }
+    if (count != expected || cursor != end) {
+        m_lastError = "MOUSE " + std::string(action, actionLength) + (expected == 1 ? " needs an amount" :
+                      action[0] == 'P' ? " needs x and y" : " needs dx and dy");
+        return false;
+    }
+
+    if (expected == 1) {
+        emit(ProgramOp::MOUSE_SCROLL, 0, values[0], 0, 0);
+    } else {
+        emit(action[0] == 'P' ? ProgramOp::MOUSE_POSITION : ProgramOp::MOUSE_MOVE, 0, values[0], values[1], 0);
+    }
+    return true;
+}
+
+void ScriptCompiler::emit(ProgramOp op, uint8_t code, int32_t x, int32_t y, uint32_t afterMs) {
+    ProgramStep *previous = m_steps.empty() ? nullptr : &m_steps.back();
+
+    // Back-to-back moves add up, back-to-back positions keep the last one
+    if (previous != nullptr && m_waitMs == 0 && previous->op == op &&
+        (op == ProgramOp::MOUSE_MOVE || op == ProgramOp::MOUSE_POSITION)) {
+        int64_t sumX = static_cast<int64_t>(previous->x) + x;
+        int64_t sumY = static_cast<int64_t>(previous->y) + y;
+        if (op == ProgramOp::MOUSE_POSITION) {
+            previous->x = x;
+            previous->y = y;
+            m_waitMs    = afterMs;
+            return;
+        }
+        if (sumX >= INT32_MIN && sumX <= INT32_MAX && sumY >= INT32_MIN && sumY <= INT32_MAX) {
+            previous->x = static_cast<int32_t>(sumX);
+            previous->y = static_cast<int32_t>(sumY);
+            m_waitMs    = afterMs;
+            return;
+        }
+    }
+
+    ProgramStep step;
+    step.waitMs = m_waitMs;
+    step.op     = op;
+    step.code   = code;
+    step.x      = x;
+    step.y      = y;
+    m_steps.push_back(step);
+    m_waitMs = afterMs;
+}
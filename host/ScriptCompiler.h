@@ -0,0 +1,128 @@
+/**
+ * @file ScriptCompiler.h
+ * @brief Compiles DuckyScript-style scripts into event programs
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * One command per line:
+ *
+ *   REM text                 comment
+ *   STRING text              type text (Shift held across shifted runs)
+ *   STRINGLN text            type text, then ENTER
+ *   DELAY ms                 wait
+ *   DEFAULT_DELAY ms         wait after every following command (also DEFAULTDELAY)
+ *   REPEAT n                 run the previous command n more times
+ *   CTRL ALT DELETE          press the modifiers, tap the last key, release
+ *   MOUSE MOVE dx dy         relative move
+ *   MOUSE POSITION x y       absolute position
+ *   MOUSE CLICK [button]     LEFT (default), RIGHT or MIDDLE
+ *   MOUSE PRESS|RELEASE [button]
+ *   MOUSE SCROLL amount
+ *
+ * Keys are DuckyScript names (ENTER, GUI, PAGEUP...), single
+ * characters or VirtualKey names (OEM_PLUS, NUMPAD_5...; see
+ * SerialInputKeyNames.h). Keys are held and spaced as the library's
+ * typeText() and copy() do. Waits are folded
+ * into the step that follows them (see ProgramStep), and consecutive
+ * mouse moves without a wait become one.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SCRIPT_COMPILER_H
+#define SCRIPT_COMPILER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "SerialInputProtocol.h"
+
+/**
+ * @brief Script to event program compiler
+ *
+ * Reusable: each compile() starts from scratch but keeps its buffers.
+ */
+class ScriptCompiler {
+  public:
+    static const uint32_t KEY_HOLD_MS = 50; ///< Press to release of a typed key, as typeText()
+    static const uint32_t KEY_GAP_MS  = 10; ///< After a release or a modifier, as typeText()
+
+    ScriptCompiler();
+
+    /**
+     * @brief Compile a script
+     * @param script Script text
+     * @param length Script length
+     * @param program Receives the encoded program, ending with ProgramOp::END
+     * @return false on a syntax error, see lastError()
+     */
+    bool compile(const char *script, size_t length, std::vector<uint8_t> &program);
+
+    /**
+     * @brief Events in the last compiled program
+     * @return Steps other than END
+     */
+    inline size_t events() const {
+        return m_steps.size() > 0 ? m_steps.size() - 1 : 0;
+    }
+
+    /**
+     * @brief Playing time of the last compiled program
+     * @return Sum of its waits in ms
+     */
+    inline uint64_t durationMs() const {
+        return m_durationMs;
+    }
+
+    /**
+     * @brief Get the last error message
+     * @return "line N: ..." for the last failed compile()
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    std::vector<ProgramStep> m_steps;        ///< Steps of the program being compiled
+    uint32_t                 m_waitMs;       ///< Wait before the next step
+    uint32_t                 m_defaultDelay; ///< DEFAULT_DELAY
+    uint64_t                 m_durationMs;   ///< Sum of the waits
+    std::string              m_lastError;    ///< Last failure description
+
+    /**
+     * @brief Compile one command
+     * @param line Line without terminator and surrounding blanks
+     * @param length Line length
+     * @return false on a syntax error, m_lastError set without the line number
+     */
+    bool command(const char *line, size_t length);
+
+    bool typeText(const char *text, size_t length);
+    bool keyCombo(const char *line, size_t length);
+    bool mouse(const char *line, size_t length);
+
+    /**
+     * @brief Add a step after the pending wait
+     * @param op Operation
+     * @param code Key code or MouseEvent
+     * @param x First coordinate or amount
+     * @param y Second coordinate
+     * @param afterMs Wait after the step
+     */
+    void emit(ProgramOp op, uint8_t code, int32_t x, int32_t y, uint32_t afterMs);
+};
+
+/**
+ * @brief Resolve a key name of a script
+ * @param name Key name (case-sensitive) or single character
+ * @param length Name length
+ * @param key Receives the key
+ * @param shift Set if a single character needs Shift
+ * @return false if the name is unknown
+ */
+bool scriptKey(const char *name, size_t length, VirtualKey &key, bool &shift);
+
+#endif // SCRIPT_COMPILER_H
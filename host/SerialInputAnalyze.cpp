@@ -0,0 +1,288 @@
+/**
+ * @file SerialInputAnalyze.cpp
+ * @brief Offline statistics over recorded capture files
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: serial-input-analyze [-j THREADS] [-c CHUNK_MB] [-g GAP_S] [-k STUCK_S] [-b BUCKET_S] [-s FILE] CAPTURE...
+ *
+ *   -j  Worker threads (default: hardware threads)
+ *   -c  Chunk size in MiB (default 8)
+ *   -g  Idle seconds that end a session (default 300)
+ *   -k  Hold seconds reported as a stuck key (default 10)
+ *   -b  Rate series bucket width in seconds (default 1)
+ *   -s  Write the rate series as CSV (bucket_start_us,events)
+ *
+ * The files are mapped and cut into chunks at line boundaries. Chunks
+ * are analysed in parallel on a work-stealing pool, then reduced
+ * pairwise, again in parallel, keeping their order. Files given
+ * together are treated as one continuous capture.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#include "CaptureAnalysis.h"
+#include "SerialInputProtocol.h"
+#include "WorkStealingPool.h"
+
+namespace {
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-j THREADS] [-c CHUNK_MB] [-g GAP_S] [-k STUCK_S] [-b BUCKET_S] [-s FILE] CAPTURE...\n",
+            program);
+}
+
+/**
+ * @brief Read-only mapping of one capture file
+ */
+struct MappedFile {
+    const char *data;
+    size_t      size;
+};
+
+/**
+ * @brief Range of a mapped file made of whole lines
+ */
+struct Chunk {
+    const char *data;
+    size_t      size;
+};
+
+bool mapFile(const char *path, MappedFile &file) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        perror(path);
+        close(fd);
+        return false;
+    }
+
+    file.size = static_cast<size_t>(info.st_size);
+    file.data = nullptr;
+    if (file.size > 0) {
+        void *mapping = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            perror(path);
+            close(fd);
+            return false;
+        }
+        madvise(mapping, file.size, MADV_SEQUENTIAL);
+        file.data = static_cast<const char *>(mapping);
+    }
+    close(fd);
+    return true;
+}
+
+void splitChunks(const MappedFile &file, size_t chunkSize, std::vector<Chunk> &chunks) {
+    const char *cursor = file.data;
+    const char *end    = file.data + file.size;
+
+    while (cursor < end) {
+        const char *cut = end;
+        if (static_cast<size_t>(end - cursor) > chunkSize) {
+            const char *newline = static_cast<const char *>(memchr(cursor + chunkSize, '\n', end - cursor - chunkSize));
+            cut                 = newline ? newline + 1 : end;
+        }
+        Chunk chunk = {cursor, static_cast<size_t>(cut - cursor)};
+        chunks.push_back(chunk);
+        cursor = cut;
+    }
+}
+
+void printDuration(uint64_t us) {
+    uint64_t seconds = us / 1000000;
+    if (seconds >= 86400) {
+        printf("%llud ", static_cast<unsigned long long>(seconds / 86400));
+    }
+    printf("%02u:%02u:%02u", static_cast<unsigned>(seconds / 3600 % 24), static_cast<unsigned>(seconds / 60 % 60),
+           static_cast<unsigned>(seconds % 60));
+}
+
+void printReport(const CaptureStats &stats, size_t topKeys) {
+    const uint64_t(&mouse)[16]    = stats.eventCounts[static_cast<uint8_t>(Device::MOUSE)];
+    const uint64_t(&keyboard)[16] = stats.eventCounts[static_cast<uint8_t>(Device::KEYBOARD)];
+
+    printf("events         %llu (comments %llu, invalid %llu, out of order %llu)\n",
+           static_cast<unsigned long long>(stats.events), static_cast<unsigned long long>(stats.comments),
+           static_cast<unsigned long long>(stats.invalid), static_cast<unsigned long long>(stats.backward));
+    if (stats.events == 0) {
+        return;
+    }
+
+    printf("span           ");
+    printDuration(stats.lastUs - stats.firstUs);
+    printf("\n");
+
+    uint64_t mouseEvents = 0;
+    for (uint64_t count : mouse) {
+        mouseEvents += count;
+    }
+    uint64_t moves     = mouse[static_cast<uint8_t>(MouseEvent::MOVE)];
+    uint64_t positions = mouse[static_cast<uint8_t>(MouseEvent::POSITION)];
+    uint64_t scrolls   = mouse[static_cast<uint8_t>(MouseEvent::SCROLL)];
+    printf("mouse          move %llu, position %llu, scroll %llu, buttons %llu\n",
+           static_cast<unsigned long long>(moves), static_cast<unsigned long long>(positions),
+           static_cast<unsigned long long>(scrolls),
+           static_cast<unsigned long long>(mouseEvents - moves - positions - scrolls));
+    printf("keyboard       press %llu, release %llu\n",
+           static_cast<unsigned long long>(keyboard[static_cast<uint8_t>(KeyboardEvent::PRESS)]),
+           static_cast<unsigned long long>(keyboard[static_cast<uint8_t>(KeyboardEvent::RELEASE)]));
+
+    std::vector<int> keys;
+    for (int key = 0; key < 256; key++) {
+        if (stats.keyPresses[key]) {
+            keys.push_back(key);
+        }
+    }
+    std::sort(keys.begin(), keys.end(), [&stats](int left, int right) {
+        return stats.keyPresses[left] > stats.keyPresses[right];
+    });
+    if (!keys.empty()) {
+        printf("top keys      ");
+        for (size_t i = 0; i < keys.size() && i < topKeys; i++) {
+            printf(" %02X:%llu", keys[i], static_cast<unsigned long long>(stats.keyPresses[keys[i]]));
+        }
+        printf("\n");
+    }
+
+    uint64_t active  = 0;
+    uint64_t longest = 0;
+    uint64_t presses = 0;
+    for (const Session &session : stats.sessions) {
+        active += session.endUs - session.startUs;
+        longest = std::max(longest, session.endUs - session.startUs);
+        presses += session.keyPresses;
+    }
+    printf("sessions       %zu, active ", stats.sessions.size());
+    printDuration(active);
+    printf(", longest ");
+    printDuration(longest);
+    printf("\n");
+    if (active >= 60000000) {
+        printf("typing rate    %.1f presses per active minute\n", presses * 60e6 / active);
+    }
+
+    printf("stuck keys     %zu\n", stats.stuck.size());
+    for (const StuckKey &entry : stats.stuck) {
+        printf("  %02X at +", entry.key);
+        printDuration(entry.pressedUs - stats.firstUs);
+        if (entry.releasedUs == NEVER_RELEASED) {
+            printf(" never released\n");
+        } else {
+            printf(" held ");
+            printDuration(entry.releasedUs - entry.pressedUs);
+            printf("\n");
+        }
+    }
+}
+
+bool writeSeries(const char *path, const CaptureStats &stats, uint64_t bucketUs) {
+    FILE *file = fopen(path, "w");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+    fprintf(file, "bucket_start_us,events\n");
+    for (size_t i = 0; i < stats.series.size(); i++) {
+        fprintf(file, "%llu,%u\n", static_cast<unsigned long long>((stats.seriesStart + i) * bucketUs),
+                stats.series[i]);
+    }
+    return fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    AnalysisOptions options;
+    size_t          threads    = 0;
+    size_t          chunkSize  = 8u << 20;
+    const char     *seriesPath = nullptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "j:c:g:k:b:s:")) != -1) {
+        switch (option) {
+            case 'j': threads = strtoul(optarg, nullptr, 10); break;
+            case 'c': chunkSize = static_cast<size_t>(strtod(optarg, nullptr) * (1 << 20)); break;
+            case 'g': options.sessionGapUs = static_cast<uint64_t>(strtod(optarg, nullptr) * 1e6); break;
+            case 'k': options.stuckUs = static_cast<uint64_t>(strtod(optarg, nullptr) * 1e6); break;
+            case 'b': options.bucketUs = static_cast<uint64_t>(strtod(optarg, nullptr) * 1e6); break;
+            case 's': seriesPath = optarg; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind >= argc || chunkSize == 0 || options.bucketUs == 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::vector<MappedFile> files;
+    std::vector<Chunk>      chunks;
+    for (int i = optind; i < argc; i++) {
+        MappedFile file;
+        if (!mapFile(argv[i], file)) {
+            return 1;
+        }
+        files.push_back(file);
+        splitChunks(file, chunkSize, chunks);
+    }
+
+    WorkStealingPool pool(threads);
+    auto             started = std::chrono::steady_clock::now();
+
+    std::vector<CaptureStats> stats(chunks.size());
+    pool.run(chunks.size(), [&](size_t index) {
+        stats[index].analyze(chunks[index].data, chunks[index].size, options);
+    });
+    size_t steals = pool.steals();
+
+    // Pairwise in-order reduction: stats[i] absorbs stats[i + stride]
+    for (size_t stride = 1; stride < stats.size(); stride *= 2) {
+        size_t pairs = (stats.size() - stride + 2 * stride - 1) / (2 * stride);
+        pool.run(pairs, [&](size_t pair) {
+            size_t left = pair * 2 * stride;
+            stats[left].merge(stats[left + stride], options);
+        });
+    }
+
+    CaptureStats total;
+    if (!stats.empty()) {
+        total = std::move(stats[0]);
+    }
+    total.finish(options);
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    printf("capture        %zu files, %.1f MiB, %llu lines, %zu chunks\n", files.size(),
+           total.bytes / 1048576.0, static_cast<unsigned long long>(total.lines), chunks.size());
+    printf("analysis       %.3f s, %.0f MiB/s, %.1fM lines/s, %zu threads, %zu steals\n", elapsed,
+           total.bytes / 1048576.0 / elapsed, total.lines / 1e6 / elapsed, pool.size(), steals);
+    printReport(total, 10);
+
+    if (seriesPath && !writeSeries(seriesPath, total, options.bucketUs)) {
+        return 1;
+    }
+
+    for (const MappedFile &file : files) {
+        if (file.size > 0) {
+            munmap(const_cast<char *>(file.data), file.size);
+        }
+    }
+    return 0;
+}
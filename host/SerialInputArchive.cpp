@@ -0,0 +1,446 @@
+/**
+ * @file SerialInputArchive.cpp
+ * @brief Pack capture files into columnar archives and read them back
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage:
+ *   serial-input-archive pack [-n] CAPTURE ARCHIVE
+ *   serial-input-archive unpack ARCHIVE
+ *   serial-input-archive info ARCHIVE
+ *   serial-input-archive bench ARCHIVE
+ *   serial-input-archive query [-f FROM_US] [-t TO_US] [-d DEVICE] [-e EVENT] ARCHIVE
+ *
+ *   pack    Write ARCHIVE, then decode it and compare it with CAPTURE
+ *           byte for byte (-n skips the comparison)
+ *   unpack  Print the capture lines
+ *   info    Print block and column sizes
+ *   bench   Decode every block repeatedly and report the throughput
+ *   query   Print the matching events; blocks whose header rules them
+ *           out are not decoded
+ *
+ * See CaptureArchive.h for the format.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CaptureArchive.h"
+
+namespace {
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s pack [-n] CAPTURE ARCHIVE\n"
+            "       %s unpack ARCHIVE\n"
+            "       %s info ARCHIVE\n"
+            "       %s bench ARCHIVE\n"
+            "       %s query [-f FROM_US] [-t TO_US] [-d DEVICE] [-e EVENT] ARCHIVE\n",
+            program, program, program, program, program);
+}
+
+/**
+ * @brief Read-only mapping of a capture file
+ */
+struct MappedFile {
+    const char *data = nullptr;
+    size_t      size = 0;
+
+    ~MappedFile() {
+        if (size > 0) {
+            munmap(const_cast<char *>(data), size);
+        }
+    }
+};
+
+bool mapFile(const char *path, MappedFile &file) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0) {
+        perror(path);
+        close(fd);
+        return false;
+    }
+    if (info.st_size > 0) {
+        void *mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            perror(path);
+            close(fd);
+            return false;
+        }
+        madvise(mapping, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+        file.data = static_cast<const char *>(mapping);
+        file.size = static_cast<size_t>(info.st_size);
+    }
+    close(fd);
+    return true;
+}
+
+/**
+ * @brief Call handler(line, length) for every line, empty ones included, without its "\n"
+ *
+ * A "\r" before the "\n" stays in the line, so that the archive keeps it.
+ */
+template <typename Handler> bool forEachLine(const MappedFile &file, Handler &&handler) {
+    const char *cursor = file.data;
+    const char *end    = file.data + file.size;
+
+    while (cursor < end) {
+        const char *newline = static_cast<const char *>(memchr(cursor, '\n', end - cursor));
+        const char *lineEnd = newline ? newline : end;
+
+        if (!handler(cursor, static_cast<size_t>(lineEnd - cursor))) {
+            return false;
+        }
+        cursor = lineEnd + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Check if a capture's last line lacks its "\n"
+ */
+bool unterminated(const MappedFile &file) {
+    return file.size > 0 && file.data[file.size - 1] != '\n';
+}
+
+/**
+ * @brief Walks the decoded archive in capture order for the comparison
+ */
+class ArchiveCursor {
+  public:
+    explicit ArchiveCursor(CaptureArchiveReader &reader)
+        : m_reader(reader), m_block(0), m_event(0), m_text(0), m_loaded(false) {
+    }
+
+    /**
+     * @brief Compare the next archived line, as unpack writes it, with one capture line
+     * @param line Capture line, without its "\n"
+     * @param length Line length
+     * @return false on mismatch or corrupt archive
+     */
+    bool matches(const char *line, size_t length) {
+        if (!ensureLine()) {
+            return false;
+        }
+
+        if (m_text < m_decoded.texts.size() && m_decoded.texts[m_text].position == m_event) {
+            const std::string &text = m_decoded.texts[m_text++].line;
+            return text.size() == length && memcmp(text.data(), line, length) == 0;
+        }
+
+        char   formatted[MAX_CAPTURE_LINE];
+        size_t i               = m_event++;
+        size_t formattedLength = formatCaptureLine(formatted, m_decoded.timeUs[i], m_decoded.device[i],
+                                                   m_decoded.event[i], m_decoded.paramCount[i], m_decoded.param1[i],
+                                                   m_decoded.param2[i]);
+        return formattedLength == length + 1 && memcmp(formatted, line, length) == 0;
+    }
+
+    /**
+     * @brief Check that every archived line was compared
+     */
+    bool exhausted() {
+        return !ensureLine();
+    }
+
+  private:
+    CaptureArchiveReader &m_reader;
+    ArchiveBlock          m_decoded;
+    size_t                m_block;
+    size_t                m_event;
+    size_t                m_text;
+    bool                  m_loaded;
+
+    bool ensureLine() {
+        for (;;) {
+            if (m_loaded && (m_event < m_decoded.size() || m_text < m_decoded.texts.size())) {
+                return true;
+            }
+            if (m_block == m_reader.blockCount() || !m_reader.decode(m_block++, m_decoded)) {
+                return false;
+            }
+            m_loaded = true;
+            m_event  = 0;
+            m_text   = 0;
+        }
+    }
+};
+
+int pack(int argc, char **argv) {
+    bool verify = true;
+
+    int option;
+    while ((option = getopt(argc, argv, "n")) != -1) {
+        switch (option) {
+            case 'n': verify = false; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind != argc - 2) {
+        usage(argv[0]);
+        return 2;
+    }
+    const char *capturePath = argv[optind];
+    const char *archivePath = argv[optind + 1];
+
+    MappedFile capture;
+    if (!mapFile(capturePath, capture)) {
+        return 1;
+    }
+
+    auto                 started = std::chrono::steady_clock::now();
+    CaptureArchiveWriter writer;
+    if (!writer.open(archivePath)) {
+        fprintf(stderr, "%s\n", writer.lastError().c_str());
+        return 1;
+    }
+
+    uint64_t lines = 0;
+    bool     ok    = forEachLine(capture, [&](const char *line, size_t length) {
+        CaptureRecord record;
+        parseCaptureLine(line, length, record);
+        lines++;
+        return writer.add(record, line, length);
+    });
+    if (unterminated(capture)) {
+        writer.setUnterminated();
+    }
+    if (!writer.close() || !ok) {
+        fprintf(stderr, "%s\n", writer.lastError().c_str());
+        return 1;
+    }
+    double   packSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    uint64_t events      = lines - writer.textLines();
+
+    printf("%s: %llu lines, %llu events, %zu -> %llu bytes (%.2f bytes/event, ratio %.1f) in %.2f s\n", archivePath,
+           static_cast<unsigned long long>(lines), static_cast<unsigned long long>(events), capture.size,
+           static_cast<unsigned long long>(writer.bytesWritten()),
+           events ? static_cast<double>(writer.bytesWritten()) / events : 0.0,
+           writer.bytesWritten() ? static_cast<double>(capture.size) / writer.bytesWritten() : 0.0, packSeconds);
+
+    if (!verify) {
+        return 0;
+    }
+
+    CaptureArchiveReader reader;
+    if (!reader.open(archivePath)) {
+        fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+
+    ArchiveCursor cursor(reader);
+    uint64_t      compared = 0;
+    ok                     = forEachLine(capture, [&](const char *line, size_t length) {
+        compared++;
+        return cursor.matches(line, length);
+    });
+    ok = ok && unterminated(capture) == ((reader.flags() & ARCHIVE_FLAG_UNTERMINATED) != 0);
+    if (!ok || !cursor.exhausted()) {
+        fprintf(stderr, "%s: verification failed at line %llu%s%s\n", archivePath,
+                static_cast<unsigned long long>(compared), reader.lastError().empty() ? "" : ": ",
+                reader.lastError().c_str());
+        return 1;
+    }
+    printf("%s: verified, %llu lines identical\n", archivePath, static_cast<unsigned long long>(compared));
+    return 0;
+}
+
+int unpack(CaptureArchiveReader &reader) {
+    ArchiveBlock block;
+    std::string  text;
+
+    for (size_t index = 0; index < reader.blockCount(); index++) {
+        if (!reader.decode(index, block)) {
+            fprintf(stderr, "%s\n", reader.lastError().c_str());
+            return 1;
+        }
+        text.clear();
+        appendCaptureText(block, text);
+        if (index + 1 == reader.blockCount() && (reader.flags() & ARCHIVE_FLAG_UNTERMINATED) && !text.empty()) {
+            text.pop_back();
+        }
+        fwrite(text.data(), 1, text.size(), stdout);
+    }
+    return 0;
+}
+
+int info(CaptureArchiveReader &reader) {
+    uint64_t events                = 0;
+    uint64_t texts                 = 0;
+    uint64_t columns[COLUMN_COUNT] = {};
+    uint64_t first                 = 0;
+    uint64_t last                  = 0;
+
+    for (size_t index = 0; index < reader.blockCount(); index++) {
+        const ArchiveBlockHeader &header = reader.header(index);
+        if (header.events > 0) {
+            first = events == 0 || header.minUs < first ? header.minUs : first;
+            last  = header.maxUs > last ? header.maxUs : last;
+        }
+        events += header.events;
+        texts += header.texts;
+        for (int column = 0; column < COLUMN_COUNT; column++) {
+            columns[column] += header.columnSize[column];
+        }
+    }
+
+    static const char *const NAMES[COLUMN_COUNT] = {"time", "opcode", "param1", "param2", "text"};
+    printf("blocks   %zu\n", reader.blockCount());
+    printf("events   %llu (+%llu text lines)\n", static_cast<unsigned long long>(events),
+           static_cast<unsigned long long>(texts));
+    printf("time     %llu .. %llu us\n", static_cast<unsigned long long>(first), static_cast<unsigned long long>(last));
+    printf("size     %zu bytes, %.2f bytes/event\n", reader.size(),
+           events ? static_cast<double>(reader.size()) / events : 0.0);
+    for (int column = 0; column < COLUMN_COUNT; column++) {
+        printf("  %-7s %12llu bytes, %.2f bytes/event\n", NAMES[column],
+               static_cast<unsigned long long>(columns[column]),
+               events ? static_cast<double>(columns[column]) / events : 0.0);
+    }
+    return 0;
+}
+
+int bench(CaptureArchiveReader &reader) {
+    const size_t decodedBytes = sizeof(uint64_t) + 3 * sizeof(uint8_t) + 2 * sizeof(int32_t);
+    ArchiveBlock block;
+    uint64_t     events  = 0;
+    int          rounds  = 0;
+    double       elapsed = 0;
+
+    auto started = std::chrono::steady_clock::now();
+    while (elapsed < 1.0 || rounds < 3) {
+        for (size_t index = 0; index < reader.blockCount(); index++) {
+            if (!reader.decode(index, block)) {
+                fprintf(stderr, "%s\n", reader.lastError().c_str());
+                return 1;
+            }
+            events += block.size();
+        }
+        rounds++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    }
+
+    printf("%d rounds, %.1fM events/s, %.2f GB/s decoded columns, %.2f GB/s archive input\n", rounds,
+           events / elapsed / 1e6, events * decodedBytes / elapsed / 1e9,
+           static_cast<double>(reader.size()) * rounds / elapsed / 1e9);
+    return 0;
+}
+
+int query(int argc, char **argv) {
+    uint64_t from   = 0;
+    uint64_t to     = ~static_cast<uint64_t>(0);
+    int      device = -1;
+    int      event  = -1;
+
+    int option;
+    while ((option = getopt(argc, argv, "f:t:d:e:")) != -1) {
+        switch (option) {
+            case 'f': from = strtoull(optarg, nullptr, 10); break;
+            case 't': to = strtoull(optarg, nullptr, 10); break;
+            case 'd': device = atoi(optarg); break;
+            case 'e': event = atoi(optarg); break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    CaptureArchiveReader reader;
+    if (!reader.open(argv[optind])) {
+        fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+
+    uint32_t mask = 0;
+    for (int d = 0; d < 2; d++) {
+        for (int e = 0; e < 256; e++) {
+            if ((device < 0 || device == d) && (event < 0 || event == e)) {
+                mask |= archiveOpcodeBit(static_cast<uint8_t>(d), static_cast<uint8_t>(e));
+            }
+        }
+    }
+
+    ArchiveBlock block;
+    size_t       skipped = 0;
+    uint64_t     matched = 0;
+    char         line[MAX_CAPTURE_LINE];
+
+    for (size_t index = 0; index < reader.blockCount(); index++) {
+        const ArchiveBlockHeader &header = reader.header(index);
+        if (header.events == 0 || header.maxUs < from || header.minUs > to || !(header.opcodeMask & mask)) {
+            skipped++;
+            continue;
+        }
+        if (!reader.decode(index, block)) {
+            fprintf(stderr, "%s\n", reader.lastError().c_str());
+            return 1;
+        }
+        for (size_t i = 0; i < block.size(); i++) {
+            if (block.timeUs[i] < from || block.timeUs[i] > to || (device >= 0 && block.device[i] != device) ||
+                (event >= 0 && block.event[i] != event)) {
+                continue;
+            }
+            size_t length = formatCaptureLine(line, block.timeUs[i], block.device[i], block.event[i],
+                                              block.paramCount[i], block.param1[i], block.param2[i]);
+            fwrite(line, 1, length, stdout);
+            matched++;
+        }
+    }
+
+    fprintf(stderr, "%llu events, %zu of %zu blocks skipped\n", static_cast<unsigned long long>(matched), skipped,
+            reader.blockCount());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    const char *command = argv[1];
+    if (strcmp(command, "pack") == 0) {
+        return pack(argc - 1, argv + 1);
+    }
+    if (strcmp(command, "query") == 0) {
+        return query(argc - 1, argv + 1);
+    }
+    if (argc != 3) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    CaptureArchiveReader reader;
+    if (!reader.open(argv[2])) {
+        fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+    if (strcmp(command, "unpack") == 0) {
+        return unpack(reader);
+    }
+    if (strcmp(command, "info") == 0) {
+        return info(reader);
+    }
+    if (strcmp(command, "bench") == 0) {
+        return bench(reader);
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,284 @@
+/**
+ * @file SerialInputDaemon.cpp
+ * @brief Headless Linux host: serial port -> protocol decoder -> uinput
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: serial-input-daemon [-b BAUD] [-W WIDTH] [-H HEIGHT] [-j SHARDS] [-s NAME] [-n | -q] PORT...
+ *
+ *   -b  Baud rate (default 9600)
+ *   -W  Screen width for absolute positions (default 1920)
+ *   -H  Screen height for absolute positions (default 1080)
+ *   -j  Event loop threads for multiple ports (default 1)
+ *   -s  Also publish events into the shared memory ring NAME (e.g.
+ *       /serial-input) for other processes; see EventRing.h
+ *   -n  Dry run: print events instead of injecting them
+ *   -q  Neither inject nor print (publish only, with -s)
+ *
+ * Every wake-up of the reader is decoded completely and delivered to
+ * the sink as one batch, so a burst of events costs one flush.
+ *
+ * A single port is read with SerialReader, which also answers the
+ * device's clock sync pings (see ClockSync.h): stamped events then reach
+ * the ring with their device time mapped to CLOCK_MONOTONIC, and events
+ * sent ahead with a due time are held in a PlaybackSink and delivered at
+ * that time. Several ports are spread round-robin over SHARDS
+ * PortService loops, one thread each; every shard owns its sink, so no
+ * state is shared between threads. Sharded ports do not answer pings,
+ * so their events are not stamped. The ring has a single writer, so -s
+ * is limited to one event loop thread.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <atomic>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+#include "ClockSync.h"
+#include "EventRing.h"
+#include "EventSink.h"
+#include "PlaybackSink.h"
+#include "PortService.h"
+#include "SerialReader.h"
+#include "UinputSink.h"
+
+namespace {
+
+volatile sig_atomic_t g_running = 1;
+
+void onSignal(int) {
+    g_running = 0;
+}
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-b BAUD] [-W WIDTH] [-H HEIGHT] [-j SHARDS] [-s NAME] [-n | -q] PORT...\n",
+            program);
+}
+
+/**
+ * @brief Where events go besides the optional ring
+ */
+enum class LocalOutput : uint8_t {
+    INJECT = 0, ///< uinput
+    LOG    = 1, ///< stdout (-n)
+    NONE   = 2  ///< nothing (-q)
+};
+
+/**
+ * @brief One event loop thread with its own ports and sink
+ */
+struct ShardedPortService {
+    PortService service;
+    LogSink     logSink;
+    UinputSink  uinputSink;
+    TeeSink     sink;
+
+    ShardedPortService(int width, int height) : uinputSink(width, height) {
+    }
+};
+
+/**
+ * @brief Select the local sink
+ * @return Sink, nullptr for LocalOutput::NONE or when uinput fails
+ */
+EventSink *openLocal(LocalOutput output, LogSink &logSink, UinputSink &uinputSink, bool &failed) {
+    failed = false;
+    switch (output) {
+        case LocalOutput::LOG: return &logSink;
+        case LocalOutput::NONE: return nullptr;
+        default: break;
+    }
+    if (!uinputSink.open()) {
+        fprintf(stderr, "%s\n", uinputSink.lastError().c_str());
+        failed = true;
+        return nullptr;
+    }
+    return &uinputSink;
+}
+
+int runSharded(char **ports, int portCount, unsigned long baudRate, int width, int height, int shardCount,
+               LocalOutput output, EventSink *ring) {
+    if (shardCount < 1) {
+        shardCount = 1;
+    }
+    if (shardCount > portCount) {
+        shardCount = portCount;
+    }
+    if (ring && shardCount > 1) {
+        fprintf(stderr, "-s needs a single event loop thread (-j 1)\n");
+        return 2;
+    }
+
+    std::vector<ShardedPortService *> shards;
+    int                               status = 0;
+    for (int i = 0; i < shardCount && status == 0; i++) {
+        ShardedPortService *shard = new ShardedPortService(width, height);
+        shards.push_back(shard);
+
+        bool       failed;
+        EventSink *local = openLocal(output, shard->logSink, shard->uinputSink, failed);
+        status           = failed ? 1 : 0;
+        shard->sink.set(local, ring);
+    }
+
+    for (int i = 0; i < portCount && status == 0; i++) {
+        ShardedPortService *shard = shards[i % shardCount];
+        if (shard->service.addPort(ports[i], baudRate, &shard->sink) < 0) {
+            fprintf(stderr, "%s\n", shard->service.lastError().c_str());
+            status = 1;
+        }
+    }
+
+    if (status == 0) {
+        // Workers inherit a mask with the stop signals blocked, so only
+        // this thread receives them and wakes every shard
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        std::atomic<int>         active(shardCount);
+        std::vector<std::thread> threads;
+        for (ShardedPortService *shard : shards) {
+            threads.emplace_back([shard, &active]() {
+                shard->service.run(g_running);
+                active--;
+            });
+        }
+
+        timespec interval = {0, 250000000};
+        while (active > 0 && sigtimedwait(&signals, nullptr, &interval) < 0) {
+        }
+        for (ShardedPortService *shard : shards) {
+            shard->service.stop();
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    for (ShardedPortService *shard : shards) {
+        delete shard;
+    }
+    return status;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    unsigned long baudRate = 9600;
+    int           width    = 1920;
+    int           height   = 1080;
+    int           shards   = 1;
+    const char   *ringName = nullptr;
+    LocalOutput   output   = LocalOutput::INJECT;
+
+    int option;
+    while ((option = getopt(argc, argv, "b:W:H:j:s:nq")) != -1) {
+        switch (option) {
+            case 'b': baudRate = strtoul(optarg, nullptr, 10); break;
+            case 'W': width = atoi(optarg); break;
+            case 'H': height = atoi(optarg); break;
+            case 'j': shards = atoi(optarg); break;
+            case 's': ringName = optarg; break;
+            case 'n': output = LocalOutput::LOG; break;
+            case 'q': output = LocalOutput::NONE; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler       = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    // Only the single-port path answers pings, so the clock stays unsynced with several ports
+    ClockSync       clock;
+    EventRingWriter ring;
+    RingSink        ringSink(ring, &clock);
+    EventSink      *shared = nullptr;
+    if (ringName) {
+        if (!ring.create(ringName)) {
+            fprintf(stderr, "%s\n", ring.lastError().c_str());
+            return 1;
+        }
+        shared = &ringSink;
+    }
+
+    if (argc - optind > 1) {
+        return runSharded(argv + optind, argc - optind, baudRate, width, height, shards, output, shared);
+    }
+
+    SerialReader reader;
+    if (!reader.open(argv[optind], baudRate)) {
+        fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+
+    LogSink    logSink;
+    UinputSink uinputSink(width, height);
+    bool       failed;
+    EventSink *local = openLocal(output, logSink, uinputSink, failed);
+    if (failed) {
+        return 1;
+    }
+    TeeSink      tee(local, shared);
+    PlaybackSink playback(tee, clock);
+    EventSink   *sink = &playback;
+
+    SerialPort &port = reader.port();
+    while (g_running) {
+        // Sleep until shortly before the next held event, runDue() spins the rest
+        uint64_t deadlineNs = playback.nextDeadlineNs();
+        if (deadlineNs != TIMER_WHEEL_NEVER) {
+            deadlineNs = deadlineNs > PLAYBACK_SPIN_NS ? deadlineNs - PLAYBACK_SPIN_NS : 0;
+        }
+
+        int frames = reader.pollUntil(deadlineNs, [sink, &clock, &port](const ProtocolFrame &frame) {
+            if (frame.kind == FrameKind::EVENT) {
+                sink->event(frame);
+            } else if (frame.kind == FrameKind::SYNC) {
+                char   answer[CLOCK_SYNC_MAX_ANSWER];
+                size_t length = clock.handleLine(frame.text, frame.length, monotonicNs(), answer);
+                if (length > 0) {
+                    port.write(answer, length);
+                }
+            }
+        });
+        if (frames < 0) {
+            fprintf(stderr, "%s\n", reader.lastError().c_str());
+            break;
+        }
+        if (frames > 0) {
+            sink->flush();
+        }
+        playback.runDue();
+    }
+
+    const PlaybackStats &stats = playback.stats();
+    if (stats.scheduled > 0) {
+        fprintf(stderr, "playback: %llu scheduled, %llu late arrivals, lateness mean %llu ns, max %llu ns\n",
+                static_cast<unsigned long long>(stats.scheduled), static_cast<unsigned long long>(stats.lateArrivals),
+                static_cast<unsigned long long>(stats.delivered ? stats.totalLatenessNs / stats.delivered : 0),
+                static_cast<unsigned long long>(stats.maxLatenessNs));
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file SerialInputPath.cpp
+ * @brief Compile SVG polylines into mouse paths for PathPlayer
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: serial-input-path [-s SCALE] [-v SPEED] [-t TICK_MS] [-x X -y Y] [-d] [-n NAME] [-o FILE] [-l] SVG
+ *
+ *   -s  Screen pixels per SVG unit (default 1)
+ *   -v  Pointer speed in pixels per second (default 800)
+ *   -t  Time per tick in ms, 1-255 (default 8)
+ *   -x  Screen position of the SVG origin; the path then starts with
+ *   -y  an absolute move. Without them it plays from the pointer.
+ *   -d  Hold the left button during strokes (drawing, drag and drop)
+ *   -n  Identifier for the header (default PATH)
+ *   -o  Output file (default stdout)
+ *   -l  List the ticks instead
+ *
+ * The header holds the path in PROGMEM and a MousePath NAME to pass to
+ * PathPlayer::start(). The size and duration go to stderr. See
+ * PathCompiler.h for the SVG subset.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "PathCompiler.h"
+
+namespace {
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-s SCALE] [-v SPEED] [-t TICK_MS] [-x X -y Y] [-d] [-n NAME] [-o FILE] [-l] SVG\n",
+            program);
+}
+
+bool readFile(const char *path, std::string &contents) {
+    FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+
+    char   buffer[65536];
+    size_t size;
+    contents.clear();
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, size);
+    }
+    bool ok = !ferror(file);
+    if (!ok) {
+        perror(path);
+    }
+    if (file != stdin) {
+        fclose(file);
+    }
+    return ok;
+}
+
+std::string header(const std::vector<int8_t> &path, const PathCompiler &compiler, const PathCompiler::Options &options,
+                   const char *name, const char *source) {
+    std::string text = "// Generated by serial-input-path from " + std::string(source) + "\n\n";
+    char        line[96];
+
+    text += "const int8_t " + std::string(name) + "_POINTS[] PROGMEM = {";
+    for (size_t i = 0; i < path.size(); i++) {
+        snprintf(line, sizeof(line), "%s%d,", i % 16 == 0 ? "\n    " : " ", path[i]);
+        text += line;
+    }
+    snprintf(line, sizeof(line), "_POINTS), %u, %d, %d, true};\n", options.tickMs, compiler.startX(),
+             compiler.startY());
+    text += "\n};\n\nconst MousePath " + std::string(name) + " = {" + name + "_POINTS, sizeof(" + name + line;
+    return text;
+}
+
+const char *buttonName(uint8_t event) {
+    switch (static_cast<MouseEvent>(event)) {
+        case MouseEvent::RIGHT_PRESS: return "PRESS RIGHT";
+        case MouseEvent::RIGHT_RELEASE: return "RELEASE RIGHT";
+        case MouseEvent::LEFT_PRESS: return "PRESS LEFT";
+        case MouseEvent::LEFT_RELEASE: return "RELEASE LEFT";
+        case MouseEvent::MIDDLE_PRESS: return "PRESS MIDDLE";
+        case MouseEvent::MIDDLE_RELEASE: return "RELEASE MIDDLE";
+        default: return "?";
+    }
+}
+
+/**
+ * @brief Decode a path into one line per pair: time, operation, position relative to the start
+ */
+std::string listing(const std::vector<int8_t> &path, uint8_t tickMs) {
+    std::string text;
+    char        line[80];
+    uint32_t    tick = 0;
+    long        x    = 0;
+    long        y    = 0;
+
+    for (size_t i = 0; i + 1 < path.size(); i += 2) {
+        uint8_t op = static_cast<uint8_t>(path[i + 1]);
+        if (path[i] != PATH_ESCAPE) {
+            tick++;
+            x += path[i];
+            y += path[i + 1];
+            snprintf(line, sizeof(line), "%8lu MOVE %4d %4d  %6ld %6ld\n", static_cast<unsigned long>(tick) * tickMs,
+                     path[i], path[i + 1], x, y);
+        } else if (op & PATH_PAUSE) {
+            tick += (op & ~PATH_PAUSE) + 1u;
+            snprintf(line, sizeof(line), "%8lu PAUSE %u\n", static_cast<unsigned long>(tick) * tickMs,
+                     (op & ~PATH_PAUSE) + 1u);
+        } else if (op & PATH_BUTTON) {
+            snprintf(line, sizeof(line), "%8lu %s\n", static_cast<unsigned long>(tick) * tickMs,
+                     buttonName(op & ~PATH_BUTTON));
+        } else {
+            snprintf(line, sizeof(line), "%8lu END\n", static_cast<unsigned long>(tick) * tickMs);
+        }
+        text += line;
+    }
+    return text;
+}
+
+bool writeOutput(const char *path, const std::string &data) {
+    FILE *file = path ? fopen(path, "wb") : stdout;
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok      = (file == stdout ? fflush(file) == 0 : fclose(file) == 0) && ok;
+    if (!ok) {
+        perror(path ? path : "stdout");
+    }
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    PathCompiler::Options options;
+    const char           *name   = "PATH";
+    const char           *output = nullptr;
+    bool                  list   = false;
+    long                  tickMs = options.tickMs;
+    int                   option;
+
+    while ((option = getopt(argc, argv, "s:v:t:x:y:dn:o:l")) != -1) {
+        switch (option) {
+            case 's': options.scale = strtod(optarg, nullptr); break;
+            case 'v': options.speed = strtod(optarg, nullptr); break;
+            case 't': tickMs = strtol(optarg, nullptr, 10); break;
+            case 'x': options.originX = static_cast<int16_t>(strtol(optarg, nullptr, 10)); break;
+            case 'y': options.originY = static_cast<int16_t>(strtol(optarg, nullptr, 10)); break;
+            case 'd': options.drag = true; break;
+            case 'n': name = optarg; break;
+            case 'o': output = optarg; break;
+            case 'l': list = true; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (argc - optind != 1 || tickMs < 1 || tickMs > 255 || (options.originX < 0) != (options.originY < 0)) {
+        usage(argv[0]);
+        return 2;
+    }
+    options.tickMs = static_cast<uint8_t>(tickMs);
+
+    std::string         svg;
+    std::vector<int8_t> path;
+    PathCompiler        compiler;
+    if (!readFile(argv[optind], svg)) {
+        return 1;
+    }
+    if (!compiler.compile(svg.data(), svg.size(), options, path)) {
+        fprintf(stderr, "%s: %s\n", argv[optind], compiler.lastError().c_str());
+        return 1;
+    }
+    fprintf(stderr, "%zu strokes, %u ticks, %zu bytes, %.3f s\n", compiler.strokes(), compiler.ticks(), path.size(),
+            compiler.ticks() * options.tickMs / 1000.0);
+
+    std::string data = list ? listing(path, options.tickMs) : header(path, compiler, options, name, argv[optind]);
+    return writeOutput(output, data) ? 0 : 1;
+}
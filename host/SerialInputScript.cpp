@@ -0,0 +1,301 @@
+/**
+ * @file SerialInputScript.cpp
+ * @brief Compile DuckyScript-style scripts into event programs
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: serial-input-script [-f header|bin|lines] [-n NAME] [-o FILE] [-l] [-c] SCRIPT...
+ *        serial-input-script -u PORT [-b BAUD] SCRIPT
+ *
+ *   -f  Output format (default header):
+ *         header  C++ header with the program in PROGMEM and an
+ *                 EventProgram NAME to pass to play()
+ *         bin     Raw program bytes
+ *         lines   The "&HEX" upload lines, ending with "&"
+ *   -n  Identifier for the header (default PROGRAM)
+ *   -o  Output file (default stdout)
+ *   -l  List the compiled steps instead
+ *   -c  Check only: compile every SCRIPT and report errors, program
+ *       sizes and the compile rate (for CI over a directory of scripts)
+ *   -u  Upload to a device whose monitor has a ProgramBuffer attached
+ *   -b  Baud rate for -u (default 9600)
+ *
+ * See ScriptCompiler.h for the script commands and SerialInputProtocol.h
+ * for the program format.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "ScriptCompiler.h"
+#include "SerialInputKeyNames.h"
+#include "SerialPort.h"
+
+namespace {
+
+const size_t UPLOAD_LINE_BYTES = 32; ///< Program bytes per upload line
+
+void usage(const char *program) {
+    fprintf(stderr,
+            "Usage: %s [-f header|bin|lines] [-n NAME] [-o FILE] [-l] [-c] SCRIPT...\n"
+            "       %s -u PORT [-b BAUD] SCRIPT\n",
+            program, program);
+}
+
+bool readFile(const char *path, std::string &contents) {
+    FILE *file = strcmp(path, "-") == 0 ? stdin : fopen(path, "rb");
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+
+    char   buffer[65536];
+    size_t size;
+    contents.clear();
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        contents.append(buffer, size);
+    }
+    bool ok = !ferror(file);
+    if (!ok) {
+        perror(path);
+    }
+    if (file != stdin) {
+        fclose(file);
+    }
+    return ok;
+}
+
+/**
+ * @brief Upload lines of a program: "&HEX" per UPLOAD_LINE_BYTES bytes, then "&"
+ */
+std::string uploadLines(const std::vector<uint8_t> &program) {
+    static const char DIGITS[] = "0123456789ABCDEF";
+    std::string       lines;
+
+    for (size_t start = 0; start < program.size(); start += UPLOAD_LINE_BYTES) {
+        size_t end = start + UPLOAD_LINE_BYTES < program.size() ? start + UPLOAD_LINE_BYTES : program.size();
+        lines += PROGRAM_PREFIX;
+        for (size_t i = start; i < end; i++) {
+            lines += DIGITS[program[i] >> 4];
+            lines += DIGITS[program[i] & 0x0F];
+        }
+        lines += '\n';
+    }
+    lines += PROGRAM_PREFIX;
+    lines += '\n';
+    return lines;
+}
+
+std::string header(const std::vector<uint8_t> &program, const char *name, const char *source) {
+    std::string text = "// Generated by serial-input-script from " + std::string(source) + "\n\n";
+    char        line[32];
+
+    text += "const uint8_t " + std::string(name) + "_STEPS[] PROGMEM = {";
+    for (size_t i = 0; i < program.size(); i++) {
+        snprintf(line, sizeof(line), "%s0x%02X,", i % 12 == 0 ? "\n    " : " ", program[i]);
+        text += line;
+    }
+    text += "\n};\n\nconst EventProgram " + std::string(name) + " = {" + name + "_STEPS, sizeof(" + name +
+            "_STEPS), true};\n";
+    return text;
+}
+
+const char *opName(ProgramOp op) {
+    switch (op) {
+        case ProgramOp::END: return "END";
+        case ProgramOp::KEY_PRESS: return "KEY_PRESS";
+        case ProgramOp::KEY_RELEASE: return "KEY_RELEASE";
+        case ProgramOp::MOUSE_BUTTON: return "MOUSE_BUTTON";
+        case ProgramOp::MOUSE_POSITION: return "MOUSE_POSITION";
+        case ProgramOp::MOUSE_MOVE: return "MOUSE_MOVE";
+        case ProgramOp::MOUSE_SCROLL: return "MOUSE_SCROLL";
+    }
+    return "?";
+}
+
+/**
+ * @brief Decode a program back into one line per step: time, wait, operation, arguments
+ */
+std::string listing(const std::vector<uint8_t> &program) {
+    std::string text;
+    size_t      position = 0;
+    uint64_t    timeMs   = 0;
+    auto        next     = [&](uint8_t &byte) {
+        if (position == program.size()) {
+            return false;
+        }
+        byte = program[position++];
+        return true;
+    };
+
+    ProgramStep step;
+    char        line[96];
+    while (readProgramStep(next, step)) {
+        timeMs += step.waitMs;
+        int length = snprintf(line, sizeof(line), "%8llu +%-6u %-14s", static_cast<unsigned long long>(timeMs),
+                              step.waitMs, opName(step.op));
+        switch (step.op) {
+            case ProgramOp::KEY_PRESS:
+            case ProgramOp::KEY_RELEASE: {
+                const char *name = keyName(static_cast<VirtualKey>(step.code));
+                snprintf(line + length, sizeof(line) - length, " %02X %s", step.code, name ? name : "");
+                break;
+            }
+            case ProgramOp::MOUSE_BUTTON: snprintf(line + length, sizeof(line) - length, " %u", step.code); break;
+            case ProgramOp::MOUSE_POSITION:
+            case ProgramOp::MOUSE_MOVE:
+                snprintf(line + length, sizeof(line) - length, " %d %d", step.x, step.y);
+                break;
+            case ProgramOp::MOUSE_SCROLL: snprintf(line + length, sizeof(line) - length, " %d", step.x); break;
+            case ProgramOp::END: break;
+        }
+        text += line;
+        text += '\n';
+        if (step.op == ProgramOp::END) {
+            break;
+        }
+    }
+    return text;
+}
+
+bool writeOutput(const char *path, const std::string &data) {
+    FILE *file = path ? fopen(path, "wb") : stdout;
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+    bool ok = fwrite(data.data(), 1, data.size(), file) == data.size();
+    ok      = (file == stdout ? fflush(file) == 0 : fclose(file) == 0) && ok;
+    if (!ok) {
+        perror(path ? path : "stdout");
+    }
+    return ok;
+}
+
+bool upload(const char *path, unsigned long baudRate, const std::vector<uint8_t> &program) {
+    SerialPort port;
+    if (!port.open(path, baudRate)) {
+        fprintf(stderr, "%s\n", port.lastError().c_str());
+        return false;
+    }
+
+    std::string lines = uploadLines(program);
+    size_t      sent  = 0;
+    while (sent < lines.size()) {
+        ssize_t written = port.write(lines.data() + sent, lines.size() - sent);
+        if (written < 0) {
+            fprintf(stderr, "%s\n", port.lastError().c_str());
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+/**
+ * @brief Compile every script, print errors and sizes, then the rate
+ * @return Number of scripts that failed
+ */
+int check(ScriptCompiler &compiler, char **paths, int count) {
+    std::vector<std::string> scripts(count);
+    std::vector<uint8_t>     program;
+    int                      failed = 0;
+    size_t                   bytes  = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (!readFile(paths[i], scripts[i])) {
+            return count;
+        }
+        bytes += scripts[i].size();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < count; i++) {
+        if (!compiler.compile(scripts[i].data(), scripts[i].size(), program)) {
+            fprintf(stderr, "%s: %s\n", paths[i], compiler.lastError().c_str());
+            failed++;
+        } else if (count == 1) {
+            printf("%s: %zu events, %zu bytes, %.3f s\n", paths[i], compiler.events(), program.size(),
+                   compiler.durationMs() / 1000.0);
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("%d scripts, %d failed, %zu script bytes in %.3f ms (%.0f scripts/s, %.1f MB/s)\n", count, failed, bytes,
+           seconds * 1000.0, seconds > 0 ? count / seconds : 0.0, seconds > 0 ? bytes / seconds / 1e6 : 0.0);
+    return failed;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    const char   *format   = "header";
+    const char   *name     = "PROGRAM";
+    const char   *output   = nullptr;
+    const char   *port     = nullptr;
+    unsigned long baudRate = 9600;
+    bool          list     = false;
+    bool          checkAll = false;
+    int           option;
+
+    while ((option = getopt(argc, argv, "f:n:o:u:b:lc")) != -1) {
+        switch (option) {
+            case 'f': format = optarg; break;
+            case 'n': name = optarg; break;
+            case 'o': output = optarg; break;
+            case 'u': port = optarg; break;
+            case 'b': baudRate = strtoul(optarg, nullptr, 10); break;
+            case 'l': list = true; break;
+            case 'c': checkAll = true; break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+
+    bool known = strcmp(format, "header") == 0 || strcmp(format, "bin") == 0 || strcmp(format, "lines") == 0;
+    if (optind >= argc || !known || (!checkAll && argc - optind != 1)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    ScriptCompiler compiler;
+    if (checkAll) {
+        return check(compiler, argv + optind, argc - optind) == 0 ? 0 : 1;
+    }
+
+    std::string          script;
+    std::vector<uint8_t> program;
+    if (!readFile(argv[optind], script)) {
+        return 1;
+    }
+    if (!compiler.compile(script.data(), script.size(), program)) {
+        fprintf(stderr, "%s: %s\n", argv[optind], compiler.lastError().c_str());
+        return 1;
+    }
+
+    if (port != nullptr) {
+        if (!upload(port, baudRate, program)) {
+            return 1;
+        }
+        fprintf(stderr, "Uploaded %zu bytes, %zu events\n", program.size(), compiler.events());
+        return 0;
+    }
+
+    std::string data;
+    if (list) {
+        data = listing(program);
+    } else if (strcmp(format, "header") == 0) {
+        data = header(program, name, argv[optind]);
+    } else if (strcmp(format, "lines") == 0) {
+        data = uploadLines(program);
+    } else {
+        data.assign(program.begin(), program.end());
+    }
+    return writeOutput(output, data) ? 0 : 1;
+}
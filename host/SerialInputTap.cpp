@@ -0,0 +1,135 @@
+/**
+ * @file SerialInputTap.cpp
+ * @brief Read-only consumer of the daemon's shared memory event ring
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: serial-input-tap [-a] [-c] [-r FILE] NAME
+ *
+ *   -a       Start with the oldest event still in the ring
+ *   -c       Print one line of counters per second instead of every event
+ *   -r FILE  Append every event to a capture file (see CaptureFormat.h)
+ *
+ * Any number of taps can follow one daemon (serial-input-daemon -s NAME);
+ * a tap that falls behind reports the events it lost and never slows
+ * the daemon down.
+ *
+ * @author Leonardo Klein
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "CaptureFormat.h"
+#include "EventRing.h"
+
+namespace {
+
+volatile sig_atomic_t g_running = 1;
+
+void onSignal(int) {
+    g_running = 0;
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-a] [-c] [-r FILE] NAME\n", program);
+}
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    bool fromStart = false;
+    bool counters  = false;
+    FILE *capture  = nullptr;
+
+    int option;
+    while ((option = getopt(argc, argv, "acr:")) != -1) {
+        switch (option) {
+            case 'a': fromStart = true; break;
+            case 'c': counters = true; break;
+            case 'r':
+                capture = fopen(optarg, "a");
+                if (!capture) {
+                    perror(optarg);
+                    return 1;
+                }
+                break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (optind != argc - 1) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler       = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    EventRingReader reader;
+    if (!reader.open(argv[optind], fromStart)) {
+        fprintf(stderr, "%s\n", reader.lastError().c_str());
+        return 1;
+    }
+
+    uint64_t events     = 0;
+    uint64_t reportedAt = monotonicNs();
+
+    while (g_running) {
+        RingEvent event;
+        RingRead  result = reader.next(event);
+
+        if (result == RingRead::EVENT) {
+            events++;
+            if (capture) {
+                char   line[MAX_CAPTURE_LINE];
+                size_t length = formatCaptureLine(line, event.timestampNs / 1000, event.device, event.event,
+                                                  event.paramCount, event.param1, event.param2);
+                fwrite(line, 1, length, capture);
+            }
+            if (!counters) {
+                printf("device=%u event=%u param1=%d param2=%d age_us=%llu\n", event.device, event.event,
+                       static_cast<int>(event.param1), static_cast<int>(event.param2),
+                       static_cast<unsigned long long>((monotonicNs() - event.timestampNs) / 1000));
+            }
+            continue;
+        }
+        if (result == RingRead::OVERRUN) {
+            unsigned long long lost = reader.lost();
+            if (capture) {
+                fprintf(capture, "# overrun, %llu events lost so far\n", lost);
+            }
+            if (!counters) {
+                printf("# overrun, %llu events lost so far\n", lost);
+            }
+        }
+
+        fflush(stdout);
+        if (capture) {
+            fflush(capture);
+        }
+        reader.wait(counters ? 200 : -1);
+
+        uint64_t now = monotonicNs();
+        if (counters && now - reportedAt >= 1000000000ULL) {
+            printf("events=%llu lost=%llu\n", static_cast<unsigned long long>(events),
+                   static_cast<unsigned long long>(reader.lost()));
+            fflush(stdout);
+            reportedAt = now;
+        }
+    }
+
+    if (capture) {
+        fclose(capture);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * @file SerialPort.cpp
+ * @brief Implementation of the raw termios serial port
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "SerialPort.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+speed_t baudConstant(unsigned long baudRate) {
+    switch (baudRate) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+        case 460800: return B460800;
+        case 921600: return B921600;
+        case 1000000: return B1000000;
+        case 2000000: return B2000000;
+        default: return B0;
+    }
+}
+
+} // namespace
+
+SerialPort::SerialPort() : m_fd(-1) {
+}
+
+SerialPort::~SerialPort() {
+    close();
+}
+
+bool SerialPort::open(const char *path, unsigned long baudRate) {
+    close();
+
+    speed_t speed = baudConstant(baudRate);
+    if (speed == B0) {
+        m_lastError = "unsupported baud rate " + std::to_string(baudRate);
+        return false;
+    }
+
+    m_fd = ::open(path, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (m_fd < 0) {
+        m_lastError = std::string("cannot open ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    termios tty;
+    if (tcgetattr(m_fd, &tty) < 0) {
+        m_lastError = std::string("tcgetattr failed: ") + strerror(errno);
+        close();
+        return false;
+    }
+
+    cfmakeraw(&tty);
+    tty.c_cflag |= CLOCAL | CREAD;
+    tty.c_cflag &= ~CRTSCTS;
+    tty.c_cc[VMIN]  = 1;
+    tty.c_cc[VTIME] = 0;
+    cfsetispeed(&tty, speed);
+    cfsetospeed(&tty, speed);
+
+    if (tcsetattr(m_fd, TCSANOW, &tty) < 0) {
+        m_lastError = std::string("tcsetattr failed: ") + strerror(errno);
+        close();
+        return false;
+    }
+
+    tcflush(m_fd, TCIFLUSH);
+    return true;
+}
+
+void SerialPort::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+ssize_t SerialPort::read(char *buffer, size_t size) {
+    ssize_t count = ::read(m_fd, buffer, size);
+    if (count < 0 && errno != EINTR) {
+        m_lastError = std::string("read failed: ") + strerror(errno);
+    }
+    return count;
+}
+
+ssize_t SerialPort::write(const char *data, size_t size) {
+    ssize_t count = ::write(m_fd, data, size);
+    if (count < 0) {
+        m_lastError = std::string("write failed: ") + strerror(errno);
+    }
+    return count;
+}
@@ -0,0 +1,87 @@
+/**
+ * @file SerialPort.h
+ * @brief Raw termios serial port for the host daemon
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_PORT_H
+#define SERIAL_PORT_H
+
+#include <stddef.h>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * @brief Serial port opened in raw (non-canonical, 8N1) mode
+ */
+class SerialPort {
+  public:
+    SerialPort();
+    ~SerialPort();
+
+    SerialPort(const SerialPort &)            = delete;
+    SerialPort &operator=(const SerialPort &) = delete;
+
+    /**
+     * @brief Open and configure a port
+     * @param path Device path (e.g. /dev/ttyACM0 or a pty slave)
+     * @param baudRate Baud rate; ignored by pseudo-terminals
+     * @return false on failure, see lastError()
+     */
+    bool open(const char *path, unsigned long baudRate);
+
+    /**
+     * @brief Close the port
+     */
+    void close();
+
+    /**
+     * @brief Read available bytes, blocking until at least one arrives
+     * @param buffer Destination
+     * @param size Capacity of the destination
+     * @return Bytes read, 0 on end of file, -1 on error (errno EINTR
+     *         when interrupted by a signal)
+     */
+    ssize_t read(char *buffer, size_t size);
+
+    /**
+     * @brief Write bytes to the port
+     * @param data Bytes to send
+     * @param size Number of bytes
+     * @return Bytes written, -1 on error
+     */
+    ssize_t write(const char *data, size_t size);
+
+    /**
+     * @brief Check if the port is open
+     * @return true if open
+     */
+    inline bool isOpen() const {
+        return m_fd >= 0;
+    }
+
+    /**
+     * @brief Get the file descriptor
+     * @return Descriptor, -1 when closed
+     */
+    inline int fd() const {
+        return m_fd;
+    }
+
+    /**
+     * @brief Get the last error message
+     * @return Description of the last failure
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    int         m_fd;        ///< Port descriptor
+    std::string m_lastError; ///< Last failure description
+};
+
+#endif // SERIAL_PORT_H
@@ -0,0 +1,91 @@
+/**
+ * @file SerialReader.cpp
+ * @brief Implementation of the poll()-based serial reader
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "SerialReader.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+
+SerialReader::SerialReader(size_t bufferSize) : m_buffer(bufferSize ? bufferSize : 1) {
+}
+
+bool SerialReader::open(const char *path, unsigned long baudRate) {
+    m_decoder.reset();
+    if (!m_port.open(path, baudRate)) {
+        m_lastError = m_port.lastError();
+        return false;
+    }
+    return true;
+}
+
+void SerialReader::close() {
+    m_port.close();
+    m_decoder.reset();
+}
+
+ssize_t SerialReader::fill(int timeoutMs) {
+    if (!m_port.isOpen()) {
+        m_lastError = "port not open";
+        return -1;
+    }
+
+    pollfd descriptor = {m_port.fd(), POLLIN, 0};
+    return readReady(::poll(&descriptor, 1, timeoutMs), descriptor);
+}
+
+ssize_t SerialReader::fillUntil(uint64_t deadlineNs) {
+    if (!m_port.isOpen()) {
+        m_lastError = "port not open";
+        return -1;
+    }
+
+    timespec  timeout;
+    timespec *wait = nullptr;
+    if (deadlineNs != UINT64_MAX) {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        uint64_t nowNs  = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+        uint64_t leftNs = deadlineNs > nowNs ? deadlineNs - nowNs : 0;
+        timeout.tv_sec  = static_cast<time_t>(leftNs / 1000000000ULL);
+        timeout.tv_nsec = static_cast<long>(leftNs % 1000000000ULL);
+        wait            = &timeout;
+    }
+
+    pollfd descriptor = {m_port.fd(), POLLIN, 0};
+    return readReady(::ppoll(&descriptor, 1, wait, nullptr), descriptor);
+}
+
+ssize_t SerialReader::readReady(int ready, const pollfd &descriptor) {
+    if (ready < 0) {
+        if (errno == EINTR) {
+            return 0;
+        }
+        m_lastError = std::string("poll failed: ") + strerror(errno);
+        return -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+    if (!(descriptor.revents & POLLIN)) {
+        m_lastError = "port closed";
+        return -1;
+    }
+
+    ssize_t count = m_port.read(m_buffer.data(), m_buffer.size());
+    if (count < 0 && errno == EINTR) {
+        return 0;
+    }
+    if (count <= 0) {
+        m_lastError = count == 0 ? "port closed" : m_port.lastError();
+        return -1;
+    }
+    return count;
+}
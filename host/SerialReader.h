@@ -0,0 +1,144 @@
+/**
+ * @file SerialReader.h
+ * @brief Event-driven serial reader feeding the protocol decoder
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Waits on the port with poll() instead of sleeping between checks, so
+ * a frame is handed to the decoder as soon as its bytes arrive. Each
+ * wake-up drains everything the driver has buffered into one reusable
+ * buffer, so bursts cost one system call instead of one per line.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SERIAL_READER_H
+#define SERIAL_READER_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "ProtocolDecoder.h"
+#include "SerialPort.h"
+
+/**
+ * @brief Serial port + decoder with a poll()-based wait
+ */
+class SerialReader {
+  public:
+    /**
+     * @brief Create a reader
+     * @param bufferSize Bytes read per wake-up at most
+     */
+    explicit SerialReader(size_t bufferSize = 65536);
+
+    /**
+     * @brief Open the port
+     * @param path Device path
+     * @param baudRate Baud rate
+     * @return false on failure, see lastError()
+     */
+    bool open(const char *path, unsigned long baudRate);
+
+    /**
+     * @brief Close the port and drop any partial line
+     */
+    void close();
+
+    /**
+     * @brief Wait for data and decode it
+     * @param timeoutMs Maximum wait in ms, -1 to wait forever
+     * @param handler Called as handler(const ProtocolFrame &) per line
+     * @return Frames decoded, 0 on timeout or signal, -1 on error or
+     *         when the port was closed by the other side
+     */
+    template <typename Handler> int poll(int timeoutMs, Handler &&handler);
+
+    /**
+     * @brief Wait for data until an absolute time and decode it
+     * @param deadlineNs CLOCK_MONOTONIC time to wait until, UINT64_MAX to wait forever
+     * @param handler Called as handler(const ProtocolFrame &) per line
+     * @return As poll()
+     */
+    template <typename Handler> int pollUntil(uint64_t deadlineNs, Handler &&handler);
+
+    /**
+     * @brief Wait for data and read it into the internal buffer
+     * @param timeoutMs Maximum wait in ms, -1 to wait forever
+     * @return Bytes read, 0 on timeout or signal, -1 on error/hang-up
+     */
+    ssize_t fill(int timeoutMs);
+
+    /**
+     * @brief Wait for data until an absolute time and read it into the internal buffer
+     * @param deadlineNs CLOCK_MONOTONIC time to wait until, UINT64_MAX to wait forever
+     * @return As fill()
+     *
+     * Unlike fill(), the wait has nanosecond resolution (ppoll()).
+     */
+    ssize_t fillUntil(uint64_t deadlineNs);
+
+    /**
+     * @brief Get the bytes of the last fill()
+     * @return Start of the buffer
+     */
+    inline const char *data() const {
+        return m_buffer.data();
+    }
+
+    /**
+     * @brief Get the decoder
+     * @return Decoder instance used by poll()
+     */
+    inline ProtocolDecoder &decoder() {
+        return m_decoder;
+    }
+
+    /**
+     * @brief Get the underlying port
+     * @return Port instance
+     */
+    inline SerialPort &port() {
+        return m_port;
+    }
+
+    /**
+     * @brief Get the last error message
+     * @return Description of the last failure
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    SerialPort        m_port;      ///< Raw termios port
+    ProtocolDecoder   m_decoder;   ///< Line decoder
+    std::vector<char> m_buffer;    ///< Reusable read buffer
+    std::string       m_lastError; ///< Last failure description
+
+    /**
+     * @brief Read after a wait
+     * @param ready Result of poll()/ppoll()
+     * @param descriptor Polled descriptor
+     * @return As fill()
+     */
+    ssize_t readReady(int ready, const struct pollfd &descriptor);
+};
+
+template <typename Handler> int SerialReader::poll(int timeoutMs, Handler &&handler) {
+    ssize_t count = fill(timeoutMs);
+    if (count <= 0) {
+        return static_cast<int>(count);
+    }
+    return static_cast<int>(m_decoder.feed(m_buffer.data(), static_cast<size_t>(count), handler));
+}
+
+template <typename Handler> int SerialReader::pollUntil(uint64_t deadlineNs, Handler &&handler) {
+    ssize_t count = fillUntil(deadlineNs);
+    if (count <= 0) {
+        return static_cast<int>(count);
+    }
+    return static_cast<int>(m_decoder.feed(m_buffer.data(), static_cast<size_t>(count), handler));
+}
+
+#endif // SERIAL_READER_H
@@ -0,0 +1,549 @@
+/**
+ * @file SimNativeModule.cpp
+ * @brief CPython binding of the native host components (module sim_native)
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Exposes the protocol decoder and SerialReader to the Qt host:
+ *
+ *   decoder = sim_native.Decoder()
+ *   items = decoder.feed(data)       # bytes-like, GIL released
+ *
+ *   reader = sim_native.SerialReader("/dev/ttyACM0", 115200)
+ *   items = reader.read_events(100)  # waits up to 100 ms, GIL released
+ *
+ * Items are (device, event, param1, param2) tuples of ints for EVENT
+ * frames, with the device time appended for stamped events (and True
+ * after it for due times), and str for
+ * comment, clock sync and unrecognised lines, so Python never splits or
+ * converts event lines itself. SerialReader is POSIX only.
+ *
+ * Each object has a lock held by every method that touches its native
+ * state, so threads sharing a decoder or reader take turns instead of
+ * racing while the GIL is released. A thread waiting for the lock
+ * releases the GIL. fileno() and is_open read one descriptor and do not
+ * wait for a read in progress.
+ *
+ * Built by setup.py; the Python host falls back to pyserial and the
+ * pure-Python decoder in protocol_decoder.py when the module is missing.
+ *
+ * @author Leonardo Klein
+ */
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <new>
+#include <string>
+#include <vector>
+
+#include "ProtocolDecoder.h"
+#ifndef _WIN32
+#include "SerialReader.h"
+#endif
+
+namespace {
+
+// ==================== OBJECT LOCK ====================
+
+/**
+ * @brief Allocate an object's lock on first use
+ * @return false with MemoryError set on failure
+ */
+bool ensureLock(PyThread_type_lock &lock) {
+    if (!lock) {
+        lock = PyThread_allocate_lock();
+        if (!lock) {
+            PyErr_NoMemory();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Holds an object's lock for a scope
+ *
+ * Waits for the lock with the GIL released, so the holder can take the
+ * GIL back to finish.
+ */
+class ObjectLock {
+  public:
+    explicit ObjectLock(PyThread_type_lock lock) : m_lock(lock) {
+        if (!PyThread_acquire_lock(m_lock, NOWAIT_LOCK)) {
+            Py_BEGIN_ALLOW_THREADS
+            PyThread_acquire_lock(m_lock, WAIT_LOCK);
+            Py_END_ALLOW_THREADS
+        }
+    }
+
+    ~ObjectLock() {
+        PyThread_release_lock(m_lock);
+    }
+
+    ObjectLock(const ObjectLock &)            = delete;
+    ObjectLock &operator=(const ObjectLock &) = delete;
+
+  private:
+    PyThread_type_lock m_lock; ///< Held lock
+};
+
+// ==================== FRAME BATCH ====================
+
+/**
+ * @brief Decoded frame stored without references to transient buffers
+ */
+struct BatchFrame {
+    FrameKind kind;       ///< Line kind
+    uint8_t   device;     ///< Device (EVENT only)
+    uint8_t   event;      ///< Event (EVENT only)
+    int32_t   param1;     ///< First parameter (EVENT only)
+    int32_t   param2;     ///< Second parameter (EVENT only)
+    bool      stamped;    ///< Device time present (EVENT only)
+    bool      due;        ///< Device time is a due time
+    uint32_t  deviceUs;   ///< Device time (stamped only)
+    uint32_t  textOffset; ///< Offset into FrameBatch::text (other kinds)
+    uint32_t  textLength; ///< Text length (other kinds)
+};
+
+/**
+ * @brief Frames collected without the GIL, converted to Python after
+ */
+struct FrameBatch {
+    std::vector<BatchFrame> frames; ///< Frames in arrival order
+    std::string             text;   ///< Text of non-EVENT lines
+
+    void clear() {
+        frames.clear();
+        text.clear();
+    }
+
+    void add(const ProtocolFrame &frame) {
+        BatchFrame entry;
+        entry.kind       = frame.kind;
+        entry.device     = frame.device;
+        entry.event      = frame.event;
+        entry.param1     = frame.param1;
+        entry.param2     = frame.param2;
+        entry.stamped    = frame.stamped;
+        entry.due        = frame.due;
+        entry.deviceUs   = frame.deviceUs;
+        entry.textOffset = 0;
+        entry.textLength = 0;
+        if (frame.kind != FrameKind::EVENT) {
+            entry.textOffset = static_cast<uint32_t>(text.size());
+            entry.textLength = static_cast<uint32_t>(frame.length);
+            text.append(frame.text, frame.length);
+        }
+        frames.push_back(entry);
+    }
+
+    PyObject *toList() const {
+        PyObject *list = PyList_New(static_cast<Py_ssize_t>(frames.size()));
+        if (!list) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < frames.size(); i++) {
+            const BatchFrame &frame = frames[i];
+            PyObject         *item;
+            if (frame.kind == FrameKind::EVENT && frame.due) {
+                item = Py_BuildValue("(iiiikO)", frame.device, frame.event, frame.param1, frame.param2,
+                                     static_cast<unsigned long>(frame.deviceUs), Py_True);
+            } else if (frame.kind == FrameKind::EVENT && frame.stamped) {
+                item = Py_BuildValue("(iiiik)", frame.device, frame.event, frame.param1, frame.param2,
+                                     static_cast<unsigned long>(frame.deviceUs));
+            } else if (frame.kind == FrameKind::EVENT) {
+                item = Py_BuildValue("(iiii)", frame.device, frame.event, frame.param1, frame.param2);
+            } else {
+                item = PyUnicode_DecodeUTF8(text.data() + frame.textOffset,
+                                            static_cast<Py_ssize_t>(frame.textLength), "ignore");
+            }
+            if (!item) {
+                Py_DECREF(list);
+                return nullptr;
+            }
+            PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), item);
+        }
+        return list;
+    }
+};
+
+// ==================== DECODER ====================
+
+/**
+ * @brief Python object wrapping a ProtocolDecoder
+ */
+struct DecoderObject {
+    PyObject_HEAD
+    ProtocolDecoder   *decoder; ///< Native decoder (partial line state)
+    FrameBatch        *batch;   ///< Reused frame storage
+    PyThread_type_lock lock;    ///< Held while decoder or batch is used
+};
+
+void Decoder_dealloc(DecoderObject *self) {
+    delete self->decoder;
+    delete self->batch;
+    if (self->lock) {
+        PyThread_free_lock(self->lock);
+    }
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject *>(self));
+}
+
+int Decoder_init(DecoderObject *self, PyObject *args, PyObject *kwargs) {
+    static const char *keywords[] = {nullptr};
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "", const_cast<char **>(keywords))) {
+        return -1;
+    }
+    if (!ensureLock(self->lock)) {
+        return -1;
+    }
+
+    ObjectLock guard(self->lock);
+    delete self->decoder;
+    delete self->batch;
+    self->decoder = new (std::nothrow) ProtocolDecoder();
+    self->batch   = new (std::nothrow) FrameBatch();
+    if (!self->decoder || !self->batch) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+PyObject *Decoder_feed(DecoderObject *self, PyObject *args) {
+    Py_buffer buffer;
+    if (!PyArg_ParseTuple(args, "y*", &buffer)) {
+        return nullptr;
+    }
+    if (!self->lock) {
+        PyBuffer_Release(&buffer);
+        PyErr_SetString(PyExc_RuntimeError, "decoder not initialised");
+        return nullptr;
+    }
+
+    ObjectLock       guard(self->lock);
+    ProtocolDecoder *decoder = self->decoder;
+    FrameBatch      *batch   = self->batch;
+    if (!decoder) {
+        PyBuffer_Release(&buffer);
+        PyErr_SetString(PyExc_RuntimeError, "decoder not initialised");
+        return nullptr;
+    }
+
+    // Growing the batch may throw; nothing may unwind through Python
+    bool failed = false;
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        batch->clear();
+        decoder->feed(static_cast<const char *>(buffer.buf), static_cast<size_t>(buffer.len),
+                      [batch](const ProtocolFrame &frame) {
+                          batch->add(frame);
+                      });
+    } catch (...) {
+        failed = true;
+    }
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&buffer);
+
+    if (failed) {
+        batch->clear();
+        return PyErr_NoMemory();
+    }
+    return batch->toList();
+}
+
+PyObject *Decoder_reset(DecoderObject *self, PyObject *) {
+    if (self->lock) {
+        ObjectLock guard(self->lock);
+        if (self->decoder) {
+            self->decoder->reset();
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject *Decoder_framing_stats(DecoderObject *self, PyObject *) {
+    if (!self->lock) {
+        return Py_BuildValue("(KK)", 0ULL, 0ULL);
+    }
+    ObjectLock guard(self->lock);
+    if (!self->decoder) {
+        return Py_BuildValue("(KK)", 0ULL, 0ULL);
+    }
+    return Py_BuildValue("(KK)", static_cast<unsigned long long>(self->decoder->correctedBits()),
+                         static_cast<unsigned long long>(self->decoder->rejectedFrames()));
+}
+
+PyMethodDef Decoder_methods[] = {
+    {"feed", reinterpret_cast<PyCFunction>(Decoder_feed), METH_VARARGS,
+     "feed(data) -> list\n\nDecode received bytes. Returns (device, event, param1, param2) tuples for\n"
+     "events and str for other complete lines; a trailing partial line is kept."},
+    {"reset", reinterpret_cast<PyCFunction>(Decoder_reset), METH_NOARGS, "Drop any buffered partial line."},
+    {"framing_stats", reinterpret_cast<PyCFunction>(Decoder_framing_stats), METH_NOARGS,
+     "framing_stats() -> (corrected_bits, rejected_frames)\n\nFraming counters since creation."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyTypeObject DecoderType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+#ifndef _WIN32
+
+// ==================== SERIAL READER ====================
+
+/**
+ * @brief Python object wrapping a SerialReader
+ */
+struct SerialReaderObject {
+    PyObject_HEAD
+    SerialReader             *reader; ///< Native reader
+    std::vector<std::string> *lines;  ///< Reused line storage
+    FrameBatch               *batch;  ///< Reused frame storage
+    PyThread_type_lock        lock;   ///< Held while reader, lines or batch is used
+};
+
+void SerialReader_dealloc(SerialReaderObject *self) {
+    delete self->reader;
+    delete self->lines;
+    delete self->batch;
+    if (self->lock) {
+        PyThread_free_lock(self->lock);
+    }
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject *>(self));
+}
+
+int SerialReader_init(SerialReaderObject *self, PyObject *args, PyObject *kwargs) {
+    static const char *keywords[] = {"port", "baud_rate", "buffer_size", nullptr};
+    const char        *port       = nullptr;
+    unsigned long      baudRate   = 9600;
+    Py_ssize_t         bufferSize = 65536;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "s|kn", const_cast<char **>(keywords), &port, &baudRate,
+                                     &bufferSize)) {
+        return -1;
+    }
+    if (!ensureLock(self->lock)) {
+        return -1;
+    }
+
+    ObjectLock guard(self->lock);
+    delete self->reader;
+    delete self->lines;
+    delete self->batch;
+    self->reader = new (std::nothrow) SerialReader(static_cast<size_t>(bufferSize));
+    self->lines  = new (std::nothrow) std::vector<std::string>();
+    self->batch  = new (std::nothrow) FrameBatch();
+    if (!self->reader || !self->lines || !self->batch) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    bool opened;
+    Py_BEGIN_ALLOW_THREADS
+    opened = self->reader->open(port, baudRate);
+    Py_END_ALLOW_THREADS
+
+    if (!opened) {
+        PyErr_SetString(PyExc_OSError, self->reader->lastError().c_str());
+        return -1;
+    }
+    return 0;
+}
+
+PyObject *SerialReader_read_lines(SerialReaderObject *self, PyObject *args) {
+    int timeoutMs = 100;
+    if (!PyArg_ParseTuple(args, "|i", &timeoutMs)) {
+        return nullptr;
+    }
+    if (!self->lock) {
+        PyErr_SetString(PyExc_OSError, "port not open");
+        return nullptr;
+    }
+
+    ObjectLock guard(self->lock);
+    if (!self->reader || !self->reader->port().isOpen()) {
+        PyErr_SetString(PyExc_OSError, "port not open");
+        return nullptr;
+    }
+
+    SerialReader             *reader = self->reader;
+    std::vector<std::string> *lines  = self->lines;
+    int                       result = 0;
+    bool                      failed = false;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        lines->clear();
+        result = reader->poll(timeoutMs, [lines](const ProtocolFrame &frame) {
+            lines->emplace_back(frame.text, frame.length);
+        });
+    } catch (...) {
+        failed = true;
+    }
+    Py_END_ALLOW_THREADS
+
+    if (failed) {
+        lines->clear();
+        return PyErr_NoMemory();
+    }
+    if (result < 0) {
+        PyErr_SetString(PyExc_OSError, reader->lastError().c_str());
+        return nullptr;
+    }
+
+    PyObject *list = PyList_New(static_cast<Py_ssize_t>(lines->size()));
+    if (!list) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < lines->size(); i++) {
+        const std::string &line = (*lines)[i];
+        PyObject *text = PyUnicode_DecodeUTF8(line.data(), static_cast<Py_ssize_t>(line.size()), "ignore");
+        if (!text) {
+            Py_DECREF(list);
+            return nullptr;
+        }
+        PyList_SET_ITEM(list, static_cast<Py_ssize_t>(i), text);
+    }
+    return list;
+}
+
+PyObject *SerialReader_read_events(SerialReaderObject *self, PyObject *args) {
+    int timeoutMs = 100;
+    if (!PyArg_ParseTuple(args, "|i", &timeoutMs)) {
+        return nullptr;
+    }
+    if (!self->lock) {
+        PyErr_SetString(PyExc_OSError, "port not open");
+        return nullptr;
+    }
+
+    ObjectLock guard(self->lock);
+    if (!self->reader || !self->reader->port().isOpen()) {
+        PyErr_SetString(PyExc_OSError, "port not open");
+        return nullptr;
+    }
+
+    SerialReader *reader = self->reader;
+    FrameBatch   *batch  = self->batch;
+    int           result = 0;
+    bool          failed = false;
+
+    Py_BEGIN_ALLOW_THREADS
+    try {
+        batch->clear();
+        result = reader->poll(timeoutMs, [batch](const ProtocolFrame &frame) {
+            batch->add(frame);
+        });
+    } catch (...) {
+        failed = true;
+    }
+    Py_END_ALLOW_THREADS
+
+    if (failed) {
+        batch->clear();
+        return PyErr_NoMemory();
+    }
+    if (result < 0) {
+        PyErr_SetString(PyExc_OSError, reader->lastError().c_str());
+        return nullptr;
+    }
+    return batch->toList();
+}
+
+PyObject *SerialReader_close(SerialReaderObject *self, PyObject *) {
+    // Waits for a read in progress, at most its timeout
+    if (self->lock) {
+        ObjectLock guard(self->lock);
+        if (self->reader) {
+            self->reader->close();
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject *SerialReader_fileno(SerialReaderObject *self, PyObject *) {
+    return PyLong_FromLong(self->reader ? self->reader->port().fd() : -1);
+}
+
+PyObject *SerialReader_is_open(SerialReaderObject *self, void *) {
+    return PyBool_FromLong(self->reader && self->reader->port().isOpen());
+}
+
+PyMethodDef SerialReader_methods[] = {
+    {"read_lines", reinterpret_cast<PyCFunction>(SerialReader_read_lines), METH_VARARGS,
+     "read_lines(timeout_ms=100) -> list[str]\n\nWait for data and return the complete lines received."},
+    {"read_events", reinterpret_cast<PyCFunction>(SerialReader_read_events), METH_VARARGS,
+     "read_events(timeout_ms=100) -> list\n\nWait for data and return decoded items, as Decoder.feed()."},
+    {"close", reinterpret_cast<PyCFunction>(SerialReader_close), METH_NOARGS,
+     "Close the port, after a read in progress returns."},
+    {"fileno", reinterpret_cast<PyCFunction>(SerialReader_fileno), METH_NOARGS, "Port file descriptor."},
+    {nullptr, nullptr, 0, nullptr}};
+
+PyGetSetDef SerialReader_getset[] = {
+    {"is_open", reinterpret_cast<getter>(SerialReader_is_open), nullptr, "True while the port is open.", nullptr},
+    {nullptr, nullptr, nullptr, nullptr, nullptr}};
+
+PyTypeObject SerialReaderType = {PyVarObject_HEAD_INIT(nullptr, 0)};
+
+#endif // _WIN32
+
+PyModuleDef simNativeModule = {PyModuleDef_HEAD_INIT, "sim_native",
+                               "Native serial reader and protocol decoder for Serial Input Monitor.", -1,
+                               nullptr};
+
+int addType(PyObject *module, const char *name, PyTypeObject *type) {
+    Py_INCREF(type);
+    if (PyModule_AddObject(module, name, reinterpret_cast<PyObject *>(type)) < 0) {
+        Py_DECREF(type);
+        return -1;
+    }
+    return 0;
+}
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_sim_native(void) {
+    DecoderType.tp_name      = "sim_native.Decoder";
+    DecoderType.tp_doc       = "Decoder()";
+    DecoderType.tp_basicsize = sizeof(DecoderObject);
+    DecoderType.tp_flags     = Py_TPFLAGS_DEFAULT;
+    DecoderType.tp_new       = PyType_GenericNew;
+    DecoderType.tp_init      = reinterpret_cast<initproc>(Decoder_init);
+    DecoderType.tp_dealloc   = reinterpret_cast<destructor>(Decoder_dealloc);
+    DecoderType.tp_methods   = Decoder_methods;
+
+    if (PyType_Ready(&DecoderType) < 0) {
+        return nullptr;
+    }
+
+#ifndef _WIN32
+    SerialReaderType.tp_name      = "sim_native.SerialReader";
+    SerialReaderType.tp_doc       = "SerialReader(port, baud_rate=9600, buffer_size=65536)";
+    SerialReaderType.tp_basicsize = sizeof(SerialReaderObject);
+    SerialReaderType.tp_flags     = Py_TPFLAGS_DEFAULT;
+    SerialReaderType.tp_new       = PyType_GenericNew;
+    SerialReaderType.tp_init      = reinterpret_cast<initproc>(SerialReader_init);
+    SerialReaderType.tp_dealloc   = reinterpret_cast<destructor>(SerialReader_dealloc);
+    SerialReaderType.tp_methods   = SerialReader_methods;
+    SerialReaderType.tp_getset    = SerialReader_getset;
+
+    if (PyType_Ready(&SerialReaderType) < 0) {
+        return nullptr;
+    }
+#endif
+
+    PyObject *module = PyModule_Create(&simNativeModule);
+    if (!module) {
+        return nullptr;
+    }
+
+    if (addType(module, "Decoder", &DecoderType) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+#ifndef _WIN32
+    if (addType(module, "SerialReader", &SerialReaderType) < 0) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+#endif
+    return module;
+}
@@ -0,0 +1,187 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hashed timing wheel holding values until their deadline
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Deadlines are hashed into SLOTS buckets of one tick each by their
+ * tick number; a bucket keeps its entries sorted by deadline, and
+ * entries with equal deadlines in insertion order. Scheduling is O(1)
+ * for the common case of deadlines arriving in order (append to the
+ * bucket), and expiry only visits the buckets between two calls.
+ * Deadlines further than SLOTS ticks ahead wait in an overflow list and
+ * are moved into the wheel once it has turned far enough.
+ *
+ * The wheel only orders entries; callers sleep until nextDeadline()
+ * themselves, to the nanosecond, so the tick size does not limit the
+ * precision.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <algorithm>
+#include <deque>
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+const uint64_t TIMER_WHEEL_NEVER = UINT64_MAX; ///< nextDeadline() of an empty wheel
+
+/**
+ * @brief Timing wheel of values of type T
+ * @tparam T Stored value (copied in and handed out by reference)
+ */
+template <typename T> class TimerWheel {
+  public:
+    static const size_t SLOTS = 256; ///< Buckets, one tick each
+
+    /**
+     * @brief Create an empty wheel
+     * @param tickNs Bucket width in ns
+     */
+    explicit TimerWheel(uint64_t tickNs = 1000000)
+        : m_tickNs(tickNs ? tickNs : 1), m_cursor(0), m_inWheel(0), m_overflowMin(TIMER_WHEEL_NEVER) {
+    }
+
+    /**
+     * @brief Add a value
+     * @param deadlineNs Absolute deadline; past deadlines expire on the next expire() call
+     * @param value Value to hold
+     */
+    void schedule(uint64_t deadlineNs, const T &value) {
+        Entry entry = {deadlineNs, value};
+        if (size() == 0) {
+            m_cursor = deadlineNs / m_tickNs;
+        }
+        place(entry);
+    }
+
+    /**
+     * @brief Earliest deadline held
+     * @return Deadline in ns, TIMER_WHEEL_NEVER when empty
+     */
+    uint64_t nextDeadline() const {
+        if (m_inWheel > 0) {
+            for (size_t i = 0; i < SLOTS; i++) {
+                const std::deque<Entry> &slot = m_slots[(m_cursor + i) % SLOTS];
+                if (!slot.empty()) {
+                    return std::min(slot.front().deadlineNs, m_overflowMin);
+                }
+            }
+        }
+        return m_overflowMin;
+    }
+
+    /**
+     * @brief Hand out every value whose deadline has passed, earliest first
+     * @param nowNs Current time
+     * @param handler Called as handler(uint64_t deadlineNs, const T &value)
+     * @return Number of values handed out
+     */
+    template <typename Handler> size_t expire(uint64_t nowNs, Handler &&handler) {
+        size_t   count   = 0;
+        uint64_t nowTick = nowNs / m_tickNs;
+
+        while (size() > 0) {
+            if (m_inWheel == 0) {
+                // Only far deadlines left: jump to the earliest one
+                m_cursor = std::max(m_cursor, m_overflowMin / m_tickNs);
+                cascade();
+            }
+            std::deque<Entry> &slot = m_slots[m_cursor % SLOTS];
+            while (!slot.empty() && slot.front().deadlineNs <= nowNs) {
+                Entry entry = slot.front();
+                slot.pop_front();
+                m_inWheel--;
+                handler(entry.deadlineNs, static_cast<const T &>(entry.value));
+                count++;
+            }
+            if (!slot.empty() || m_cursor >= nowTick) {
+                break;
+            }
+            m_cursor++;
+            cascade();
+        }
+        if (size() == 0 && m_cursor < nowTick) {
+            m_cursor = nowTick;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Number of values held
+     * @return Value count
+     */
+    inline size_t size() const {
+        return m_inWheel + m_overflow.size();
+    }
+
+    /**
+     * @brief Drop every value
+     */
+    void clear() {
+        for (std::deque<Entry> &slot : m_slots) {
+            slot.clear();
+        }
+        m_overflow.clear();
+        m_inWheel     = 0;
+        m_overflowMin = TIMER_WHEEL_NEVER;
+    }
+
+  private:
+    /**
+     * @brief Value with its deadline
+     */
+    struct Entry {
+        uint64_t deadlineNs; ///< Absolute deadline
+        T        value;      ///< Payload
+    };
+
+    uint64_t           m_tickNs;       ///< Bucket width
+    uint64_t           m_cursor;       ///< Tick of the bucket expired next
+    size_t             m_inWheel;      ///< Entries in the buckets
+    std::deque<Entry>  m_slots[SLOTS]; ///< Buckets, sorted by deadline
+    std::vector<Entry> m_overflow;     ///< Entries SLOTS or more ticks ahead
+    uint64_t           m_overflowMin;  ///< Earliest deadline in m_overflow
+
+    void place(const Entry &entry) {
+        uint64_t tick = std::max(entry.deadlineNs / m_tickNs, m_cursor);
+        if (tick - m_cursor >= SLOTS) {
+            m_overflow.push_back(entry);
+            m_overflowMin = std::min(m_overflowMin, entry.deadlineNs);
+            return;
+        }
+
+        std::deque<Entry> &slot = m_slots[tick % SLOTS];
+        if (slot.empty() || slot.back().deadlineNs <= entry.deadlineNs) {
+            slot.push_back(entry);
+        } else {
+            auto position = std::upper_bound(slot.begin(), slot.end(), entry.deadlineNs,
+                                             [](uint64_t deadline, const Entry &other) {
+                                                 return deadline < other.deadlineNs;
+                                             });
+            slot.insert(position, entry);
+        }
+        m_inWheel++;
+    }
+
+    /**
+     * @brief Move overflow entries that now fit into the wheel
+     */
+    void cascade() {
+        if (m_overflow.empty() || m_overflowMin / m_tickNs >= m_cursor + SLOTS) {
+            return;
+        }
+        std::vector<Entry> pending;
+        pending.swap(m_overflow);
+        m_overflowMin = TIMER_WHEEL_NEVER;
+        for (const Entry &entry : pending) {
+            place(entry);
+        }
+    }
+};
+
+#endif // TIMER_WHEEL_H
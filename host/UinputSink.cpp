@@ -0,0 +1,334 @@
+/**
+ * @file UinputSink.cpp
+ * @brief Implementation of the /dev/uinput event sink
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "UinputSink.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+const uint16_t KEY_SLOTS = KEY_MAX + 1;
+
+/**
+ * @brief Virtual key to Linux key code table (0 = unmapped)
+ */
+struct LinuxKeyTable {
+    uint16_t codes[256];
+
+    LinuxKeyTable() : codes() {
+        static const uint16_t digits[10]  = {KEY_0, KEY_1, KEY_2, KEY_3, KEY_4, KEY_5, KEY_6, KEY_7, KEY_8, KEY_9};
+        static const uint16_t letters[26] = {KEY_A, KEY_B, KEY_C, KEY_D, KEY_E, KEY_F, KEY_G, KEY_H, KEY_I,
+                                             KEY_J, KEY_K, KEY_L, KEY_M, KEY_N, KEY_O, KEY_P, KEY_Q, KEY_R,
+                                             KEY_S, KEY_T, KEY_U, KEY_V, KEY_W, KEY_X, KEY_Y, KEY_Z};
+        static const uint16_t numpad[10]  = {KEY_KP0, KEY_KP1, KEY_KP2, KEY_KP3, KEY_KP4,
+                                             KEY_KP5, KEY_KP6, KEY_KP7, KEY_KP8, KEY_KP9};
+        static const uint16_t functions[24] = {KEY_F1,  KEY_F2,  KEY_F3,  KEY_F4,  KEY_F5,  KEY_F6,
+                                               KEY_F7,  KEY_F8,  KEY_F9,  KEY_F10, KEY_F11, KEY_F12,
+                                               KEY_F13, KEY_F14, KEY_F15, KEY_F16, KEY_F17, KEY_F18,
+                                               KEY_F19, KEY_F20, KEY_F21, KEY_F22, KEY_F23, KEY_F24};
+
+        for (int i = 0; i < 10; i++) {
+            set(VirtualKey::NUM_0, i, digits[i]);
+            set(VirtualKey::NUMPAD_0, i, numpad[i]);
+        }
+        for (int i = 0; i < 26; i++) {
+            set(VirtualKey::A, i, letters[i]);
+        }
+        for (int i = 0; i < 24; i++) {
+            set(VirtualKey::F1, i, functions[i]);
+        }
+
+        set(VirtualKey::BACKSPACE, 0, KEY_BACKSPACE);
+        set(VirtualKey::TAB, 0, KEY_TAB);
+        set(VirtualKey::CLEAR, 0, KEY_CLEAR);
+        set(VirtualKey::ENTER, 0, KEY_ENTER);
+        set(VirtualKey::SHIFT, 0, KEY_LEFTSHIFT);
+        set(VirtualKey::CONTROL, 0, KEY_LEFTCTRL);
+        set(VirtualKey::ALT, 0, KEY_LEFTALT);
+        set(VirtualKey::PAUSE, 0, KEY_PAUSE);
+        set(VirtualKey::CAPS_LOCK, 0, KEY_CAPSLOCK);
+        set(VirtualKey::ESCAPE, 0, KEY_ESC);
+        set(VirtualKey::SPACE, 0, KEY_SPACE);
+        set(VirtualKey::PAGE_UP, 0, KEY_PAGEUP);
+        set(VirtualKey::PAGE_DOWN, 0, KEY_PAGEDOWN);
+        set(VirtualKey::END, 0, KEY_END);
+        set(VirtualKey::HOME, 0, KEY_HOME);
+        set(VirtualKey::ARROW_LEFT, 0, KEY_LEFT);
+        set(VirtualKey::ARROW_UP, 0, KEY_UP);
+        set(VirtualKey::ARROW_RIGHT, 0, KEY_RIGHT);
+        set(VirtualKey::ARROW_DOWN, 0, KEY_DOWN);
+        set(VirtualKey::SELECT, 0, KEY_SELECT);
+        set(VirtualKey::PRINT, 0, KEY_PRINT);
+        set(VirtualKey::PRINT_SCREEN, 0, KEY_SYSRQ);
+        set(VirtualKey::INSERT, 0, KEY_INSERT);
+        set(VirtualKey::DELETE, 0, KEY_DELETE);
+        set(VirtualKey::HELP, 0, KEY_HELP);
+        set(VirtualKey::LEFT_WIN, 0, KEY_LEFTMETA);
+        set(VirtualKey::RIGHT_WIN, 0, KEY_RIGHTMETA);
+        set(VirtualKey::APPS, 0, KEY_COMPOSE);
+        set(VirtualKey::SLEEP, 0, KEY_SLEEP);
+        set(VirtualKey::MULTIPLY, 0, KEY_KPASTERISK);
+        set(VirtualKey::ADD, 0, KEY_KPPLUS);
+        set(VirtualKey::SEPARATOR, 0, KEY_KPCOMMA);
+        set(VirtualKey::SUBTRACT, 0, KEY_KPMINUS);
+        set(VirtualKey::DECIMAL, 0, KEY_KPDOT);
+        set(VirtualKey::DIVIDE, 0, KEY_KPSLASH);
+        set(VirtualKey::NUM_LOCK, 0, KEY_NUMLOCK);
+        set(VirtualKey::SCROLL_LOCK, 0, KEY_SCROLLLOCK);
+        set(VirtualKey::LEFT_SHIFT, 0, KEY_LEFTSHIFT);
+        set(VirtualKey::RIGHT_SHIFT, 0, KEY_RIGHTSHIFT);
+        set(VirtualKey::LEFT_CONTROL, 0, KEY_LEFTCTRL);
+        set(VirtualKey::RIGHT_CONTROL, 0, KEY_RIGHTCTRL);
+        set(VirtualKey::LEFT_ALT, 0, KEY_LEFTALT);
+        set(VirtualKey::RIGHT_ALT, 0, KEY_RIGHTALT);
+        set(VirtualKey::BROWSER_BACK, 0, KEY_BACK);
+        set(VirtualKey::BROWSER_FORWARD, 0, KEY_FORWARD);
+        set(VirtualKey::BROWSER_REFRESH, 0, KEY_REFRESH);
+        set(VirtualKey::BROWSER_STOP, 0, KEY_STOP);
+        set(VirtualKey::BROWSER_SEARCH, 0, KEY_SEARCH);
+        set(VirtualKey::BROWSER_FAVORITES, 0, KEY_BOOKMARKS);
+        set(VirtualKey::BROWSER_HOME, 0, KEY_HOMEPAGE);
+        set(VirtualKey::VOLUME_MUTE, 0, KEY_MUTE);
+        set(VirtualKey::VOLUME_DOWN, 0, KEY_VOLUMEDOWN);
+        set(VirtualKey::VOLUME_UP, 0, KEY_VOLUMEUP);
+        set(VirtualKey::MEDIA_NEXT_TRACK, 0, KEY_NEXTSONG);
+        set(VirtualKey::MEDIA_PREV_TRACK, 0, KEY_PREVIOUSSONG);
+        set(VirtualKey::MEDIA_STOP, 0, KEY_STOPCD);
+        set(VirtualKey::MEDIA_PLAY_PAUSE, 0, KEY_PLAYPAUSE);
+        set(VirtualKey::LAUNCH_MAIL, 0, KEY_MAIL);
+        set(VirtualKey::LAUNCH_MEDIA_SELECT, 0, KEY_MEDIA);
+        set(VirtualKey::LAUNCH_APP1, 0, KEY_PROG1);
+        set(VirtualKey::LAUNCH_APP2, 0, KEY_PROG2);
+        set(VirtualKey::OEM_1, 0, KEY_SEMICOLON);
+        set(VirtualKey::OEM_PLUS, 0, KEY_EQUAL);
+        set(VirtualKey::OEM_COMMA, 0, KEY_COMMA);
+        set(VirtualKey::OEM_MINUS, 0, KEY_MINUS);
+        set(VirtualKey::OEM_PERIOD, 0, KEY_DOT);
+        set(VirtualKey::OEM_2, 0, KEY_SLASH);
+        set(VirtualKey::OEM_3, 0, KEY_GRAVE);
+        set(VirtualKey::OEM_4, 0, KEY_LEFTBRACE);
+        set(VirtualKey::OEM_5, 0, KEY_BACKSLASH);
+        set(VirtualKey::OEM_6, 0, KEY_RIGHTBRACE);
+        set(VirtualKey::OEM_7, 0, KEY_APOSTROPHE);
+        set(VirtualKey::OEM_102, 0, KEY_102ND);
+        set(VirtualKey::PLAY, 0, KEY_PLAY);
+        set(VirtualKey::ZOOM, 0, KEY_ZOOM);
+    }
+
+    void set(VirtualKey base, int offset, uint16_t code) {
+        codes[(static_cast<uint16_t>(base) + offset) & 0xFF] = code;
+    }
+};
+
+const LinuxKeyTable &linuxKeys() {
+    static const LinuxKeyTable table;
+    return table;
+}
+
+} // namespace
+
+uint16_t virtualKeyToLinux(uint16_t virtualKey) {
+    return virtualKey < 256 ? linuxKeys().codes[virtualKey] : 0;
+}
+
+UinputSink::UinputSink(int screenWidth, int screenHeight) : m_width(screenWidth), m_height(screenHeight) {
+    m_relative.touched.assign(KEY_SLOTS, false);
+    m_absolute.touched.assign(KEY_SLOTS, false);
+}
+
+UinputSink::~UinputSink() {
+    close();
+}
+
+bool UinputSink::open(const char *path) {
+    close();
+    if (!createDevice(m_relative, path, false) || !createDevice(m_absolute, path, true)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void UinputSink::close() {
+    Batch *batches[] = {&m_relative, &m_absolute};
+    for (Batch *batch : batches) {
+        if (batch->fd >= 0) {
+            ioctl(batch->fd, UI_DEV_DESTROY);
+            ::close(batch->fd);
+            batch->fd = -1;
+        }
+        batch->events.clear();
+    }
+}
+
+bool UinputSink::createDevice(Batch &batch, const char *path, bool absolute) {
+    batch.fd = ::open(path, O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+    if (batch.fd < 0) {
+        m_lastError = std::string("cannot open ") + path + ": " + strerror(errno);
+        return false;
+    }
+
+    int fd = batch.fd;
+    ioctl(fd, UI_SET_EVBIT, EV_SYN);
+    ioctl(fd, UI_SET_EVBIT, EV_KEY);
+    ioctl(fd, UI_SET_KEYBIT, BTN_LEFT);
+    ioctl(fd, UI_SET_KEYBIT, BTN_RIGHT);
+    ioctl(fd, UI_SET_KEYBIT, BTN_MIDDLE);
+
+    uinput_setup setup;
+    memset(&setup, 0, sizeof(setup));
+    setup.id.bustype = BUS_VIRTUAL;
+    setup.id.vendor  = 0x5349; // "SI"
+    setup.id.product = absolute ? 0x0002 : 0x0001;
+
+    if (absolute) {
+        ioctl(fd, UI_SET_EVBIT, EV_ABS);
+        ioctl(fd, UI_SET_PROPBIT, INPUT_PROP_POINTER);
+
+        uinput_abs_setup axis;
+        memset(&axis, 0, sizeof(axis));
+        axis.code            = ABS_X;
+        axis.absinfo.maximum = m_width - 1;
+        ioctl(fd, UI_ABS_SETUP, &axis);
+        axis.code            = ABS_Y;
+        axis.absinfo.maximum = m_height - 1;
+        ioctl(fd, UI_ABS_SETUP, &axis);
+
+        strncpy(setup.name, "Serial Input Monitor Pointer", UINPUT_MAX_NAME_SIZE - 1);
+    } else {
+        ioctl(fd, UI_SET_EVBIT, EV_REL);
+        ioctl(fd, UI_SET_RELBIT, REL_X);
+        ioctl(fd, UI_SET_RELBIT, REL_Y);
+        ioctl(fd, UI_SET_RELBIT, REL_WHEEL);
+        for (int vk = 0; vk < 256; vk++) {
+            uint16_t code = virtualKeyToLinux(vk);
+            if (code) {
+                ioctl(fd, UI_SET_KEYBIT, code);
+            }
+        }
+
+        strncpy(setup.name, "Serial Input Monitor", UINPUT_MAX_NAME_SIZE - 1);
+    }
+
+    if (ioctl(fd, UI_DEV_SETUP, &setup) < 0 || ioctl(fd, UI_DEV_CREATE) < 0) {
+        m_lastError = std::string("cannot create uinput device: ") + strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+void UinputSink::queue(Batch &batch, uint16_t type, uint16_t code, int32_t value) {
+    input_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.type  = type;
+    ev.code  = code;
+    ev.value = value;
+    batch.events.push_back(ev);
+}
+
+void UinputSink::queueKey(Batch &batch, uint16_t code, bool pressed) {
+    if (batch.touched[code]) {
+        queue(batch, EV_SYN, SYN_REPORT, 0);
+        for (const input_event &ev : batch.events) {
+            if (ev.type == EV_KEY) {
+                batch.touched[ev.code] = false;
+            }
+        }
+    }
+    batch.touched[code] = true;
+    queue(batch, EV_KEY, code, pressed ? 1 : 0);
+}
+
+void UinputSink::switchTo(const Batch &batch) {
+    // Events queued for the other device came first: send them first
+    write(&batch == &m_relative ? m_absolute : m_relative);
+}
+
+void UinputSink::event(const ProtocolFrame &frame) {
+    bool position = frame.device == static_cast<uint8_t>(Device::MOUSE) &&
+                    frame.event == static_cast<uint8_t>(MouseEvent::POSITION);
+    switchTo(position ? m_absolute : m_relative);
+
+    if (frame.device == static_cast<uint8_t>(Device::KEYBOARD)) {
+        // Not a virtual key: the cast would wrap 10041 onto 'A'
+        if (frame.param1 < 0 || frame.param1 > 0xFF) {
+            return;
+        }
+        uint16_t code = virtualKeyToLinux(static_cast<uint16_t>(frame.param1));
+        if (code) {
+            queueKey(m_relative, code, frame.event == static_cast<uint8_t>(KeyboardEvent::PRESS));
+        }
+        return;
+    }
+
+    switch (static_cast<MouseEvent>(frame.event)) {
+        case MouseEvent::RIGHT_PRESS: queueKey(m_relative, BTN_RIGHT, true); break;
+        case MouseEvent::RIGHT_RELEASE: queueKey(m_relative, BTN_RIGHT, false); break;
+        case MouseEvent::LEFT_PRESS: queueKey(m_relative, BTN_LEFT, true); break;
+        case MouseEvent::LEFT_RELEASE: queueKey(m_relative, BTN_LEFT, false); break;
+        case MouseEvent::MIDDLE_PRESS: queueKey(m_relative, BTN_MIDDLE, true); break;
+        case MouseEvent::MIDDLE_RELEASE: queueKey(m_relative, BTN_MIDDLE, false); break;
+        case MouseEvent::SCROLL: queue(m_relative, EV_REL, REL_WHEEL, frame.param1); break;
+        case MouseEvent::MOVE:
+            if (frame.param1) {
+                queue(m_relative, EV_REL, REL_X, frame.param1);
+            }
+            if (frame.param2) {
+                queue(m_relative, EV_REL, REL_Y, frame.param2);
+            }
+            break;
+        case MouseEvent::POSITION:
+            queue(m_absolute, EV_ABS, ABS_X, frame.param1);
+            queue(m_absolute, EV_ABS, ABS_Y, frame.param2);
+            break;
+        default: break;
+    }
+}
+
+void UinputSink::flush() {
+    // At most one of them has events: event() sends the other on a switch
+    write(m_absolute);
+    write(m_relative);
+}
+
+void UinputSink::write(Batch &batch) {
+    if (batch.events.empty()) {
+        return;
+    }
+    queue(batch, EV_SYN, SYN_REPORT, 0);
+
+    if (batch.fd >= 0) {
+        const char *data = reinterpret_cast<const char *>(batch.events.data());
+        size_t      left = batch.events.size() * sizeof(input_event);
+        while (left > 0) {
+            ssize_t written = ::write(batch.fd, data, left);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                m_lastError = std::string("uinput write failed: ") + strerror(errno);
+                break;
+            }
+            data += written;
+            left -= written;
+        }
+    }
+
+    for (const input_event &ev : batch.events) {
+        if (ev.type == EV_KEY) {
+            batch.touched[ev.code] = false;
+        }
+    }
+    batch.events.clear();
+}
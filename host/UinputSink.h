@@ -0,0 +1,98 @@
+/**
+ * @file UinputSink.h
+ * @brief Event sink injecting input through Linux /dev/uinput
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Creates two virtual devices: a keyboard/relative mouse and an
+ * absolute pointer for POSITION events. Events are queued and written
+ * with one SYN_REPORT per flush(); a report is closed early when a key
+ * or button would change twice inside it, and when the next event goes
+ * to the other device, which sends the queued ones first. Events reach
+ * the OS in the order they arrived, so a press, POSITION, release clicks
+ * where the press was.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef UINPUT_SINK_H
+#define UINPUT_SINK_H
+
+#include <linux/input.h>
+#include <string>
+#include <vector>
+
+#include "EventSink.h"
+
+/**
+ * @brief Map a Windows virtual key code to a Linux KEY_* code
+ * @param virtualKey Virtual key code (0-255)
+ * @return Linux key code, or 0 when the key has no equivalent
+ */
+uint16_t virtualKeyToLinux(uint16_t virtualKey);
+
+/**
+ * @brief Sink writing evdev events to uinput devices
+ */
+class UinputSink : public EventSink {
+  public:
+    /**
+     * @brief Create the sink (devices are created by open())
+     * @param screenWidth Width used for absolute positions
+     * @param screenHeight Height used for absolute positions
+     */
+    UinputSink(int screenWidth = 1920, int screenHeight = 1080);
+    ~UinputSink() override;
+
+    /**
+     * @brief Create the virtual devices
+     * @param path uinput device node
+     * @return false on failure, see lastError()
+     */
+    bool open(const char *path = "/dev/uinput");
+
+    /**
+     * @brief Destroy the virtual devices
+     */
+    void close();
+
+    void event(const ProtocolFrame &frame) override;
+    void flush() override;
+
+    /**
+     * @brief Get the last error message
+     * @return Description of the last failure
+     */
+    inline const std::string &lastError() const {
+        return m_lastError;
+    }
+
+  private:
+    /**
+     * @brief Pending events for one virtual device
+     */
+    struct Batch {
+        int                      fd = -1; ///< uinput file descriptor
+        std::vector<input_event> events;  ///< Queued events
+        std::vector<bool>        touched; ///< Key codes changed in this report
+    };
+
+    Batch       m_relative;  ///< Keyboard, buttons, relative motion, wheel
+    Batch       m_absolute;  ///< Absolute pointer
+    int         m_width;     ///< Absolute X range
+    int         m_height;    ///< Absolute Y range
+    std::string m_lastError; ///< Last failure description
+
+    bool createDevice(Batch &batch, const char *path, bool absolute);
+    void queue(Batch &batch, uint16_t type, uint16_t code, int32_t value);
+    void queueKey(Batch &batch, uint16_t code, bool pressed);
+
+    /**
+     * @brief Send what is queued for the other device before queueing for this one
+     * @param batch Device the next event goes to
+     */
+    void switchTo(const Batch &batch);
+    void write(Batch &batch);
+};
+
+#endif // UINPUT_SINK_H
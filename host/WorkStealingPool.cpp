@@ -0,0 +1,114 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the work-stealing thread pool
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * @author Leonardo Klein
+ */
+
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(size_t threads)
+    : m_queues(threads ? threads : (std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1)),
+      m_task(nullptr), m_batch(0), m_busy(0), m_steals(0), m_stopping(false) {
+    for (size_t worker = 1; worker < m_queues.size(); worker++) {
+        m_threads.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_stopping = true;
+    }
+    m_start.notify_all();
+    for (std::thread &thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t)> &task) {
+    const size_t workers = m_queues.size();
+    for (size_t worker = 0; worker < workers; worker++) {
+        std::lock_guard<std::mutex> guard(m_queues[worker].lock);
+        for (size_t index = count * worker / workers; index < count * (worker + 1) / workers; index++) {
+            m_queues[worker].tasks.push_back(index);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_task   = &task;
+        m_busy   = workers;
+        m_steals = 0;
+        m_batch++;
+    }
+    m_start.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> guard(m_lock);
+    m_done.wait(guard, [this]() {
+        return m_busy == 0;
+    });
+    m_task = nullptr;
+}
+
+void WorkStealingPool::workerLoop(size_t worker) {
+    size_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> guard(m_lock);
+            m_start.wait(guard, [this, seen]() {
+                return m_stopping || m_batch != seen;
+            });
+            if (m_stopping) {
+                return;
+            }
+            seen = m_batch;
+        }
+        work(worker);
+    }
+}
+
+void WorkStealingPool::work(size_t worker) {
+    const std::function<void(size_t)> &task = *m_task;
+
+    size_t index;
+    while (take(worker, index)) {
+        task(index);
+    }
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    if (--m_busy == 0) {
+        m_done.notify_all();
+    }
+}
+
+bool WorkStealingPool::take(size_t worker, size_t &index) {
+    {
+        Queue                      &own = m_queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.tasks.empty()) {
+            index = own.tasks.front();
+            own.tasks.pop_front();
+            return true;
+        }
+    }
+
+    const size_t workers = m_queues.size();
+    for (size_t offset = 1; offset < workers; offset++) {
+        Queue                      &victim = m_queues[(worker + offset) % workers];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            index = victim.tasks.back();
+            victim.tasks.pop_back();
+
+            std::lock_guard<std::mutex> stats(m_lock);
+            m_steals++;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Fixed thread pool running indexed tasks with work stealing
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * run(count, task) deals task indices out in contiguous ranges, one per
+ * worker, so neighbouring chunks of a file stay on one core. A worker
+ * takes tasks from the front of its own range; when it runs dry it
+ * steals from the back of another worker's range. The calling thread
+ * works as worker 0.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stddef.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Thread pool for batches of independent tasks
+ */
+class WorkStealingPool {
+  public:
+    /**
+     * @brief Start the pool
+     * @param threads Worker count including the caller (0 = hardware threads)
+     */
+    explicit WorkStealingPool(size_t threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &)            = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /**
+     * @brief Run task(0) .. task(count - 1) and wait for all of them
+     * @param count Number of tasks
+     * @param task Called once per index, from any worker
+     */
+    void run(size_t count, const std::function<void(size_t)> &task);
+
+    /**
+     * @brief Number of workers (including the caller)
+     * @return Worker count
+     */
+    inline size_t size() const {
+        return m_queues.size();
+    }
+
+    /**
+     * @brief Tasks taken from another worker's range during the last run()
+     * @return Steal count
+     */
+    inline size_t steals() const {
+        return m_steals;
+    }
+
+  private:
+    /**
+     * @brief Task indices owned by one worker
+     */
+    struct Queue {
+        std::mutex         lock;  ///< Guards tasks
+        std::deque<size_t> tasks; ///< Pending indices
+    };
+
+    std::vector<Queue>                   m_queues;   ///< One per worker
+    std::vector<std::thread>             m_threads;  ///< Workers 1..n-1
+    std::mutex                           m_lock;     ///< Guards the batch state
+    std::condition_variable              m_start;    ///< Signals a new batch
+    std::condition_variable              m_done;     ///< Signals batch completion
+    const std::function<void(size_t)>   *m_task;     ///< Current batch
+    size_t                               m_batch;    ///< Batch generation
+    size_t                               m_busy;     ///< Workers still in the batch
+    size_t                               m_steals;   ///< Steals in the last batch
+    bool                                 m_stopping; ///< Set by the destructor
+
+    void workerLoop(size_t worker);
+    void work(size_t worker);
+    bool take(size_t worker, size_t &index);
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+"""
+Decoder throughput benchmark: pure-Python decoder vs sim_native.Decoder.
+
+Feeds the same synthetic capture (mouse movement, clicks, scrolls, key
+presses and comments) to both decoders in serial-sized chunks and prints
+lines per second. Build the extension first (pip install -e .).
+
+Usage: python host/bench_decoder.py [LINES] [CHUNK]
+
+Author: Leonardo Klein
+"""
+
+import os
+import random
+import sys
+import time
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"))
+
+from protocol_decoder import PythonDecoder, sim_native  # noqa: E402
+
+
+def make_capture(lines: int) -> bytes:
+    """
+    Build a capture with a realistic event mix.
+
+    :param lines: Number of lines
+    :return: Encoded capture
+    """
+    rng = random.Random(1)
+    out = []
+    for _ in range(lines):
+        kind = rng.random()
+        if kind < 0.7:
+            out.append(f"0 8 {rng.randint(-20, 20)} {rng.randint(-20, 20)}")
+        elif kind < 0.8:
+            out.append(f"0 {rng.choice((0, 1, 2, 3))}")
+        elif kind < 0.85:
+            out.append(f"0 6 {rng.choice((-1, 1))}")
+        elif kind < 0.99:
+            out.append(f"1 {rng.choice((0, 1))} {rng.randint(0x30, 0x5A):X}")
+        else:
+            out.append("# status ok")
+    return ("\r\n".join(out) + "\r\n").encode()
+
+
+def run(decoder, capture: bytes, chunk: int):
+    """
+    Feed a capture in chunks.
+
+    :return: (items decoded, elapsed seconds)
+    """
+    count = 0
+    start = time.perf_counter()
+    for offset in range(0, len(capture), chunk):
+        count += len(decoder.feed(capture[offset : offset + chunk]))
+    return count, time.perf_counter() - start
+
+
+def main():
+    lines = int(sys.argv[1]) if len(sys.argv) > 1 else 500000
+    chunk = int(sys.argv[2]) if len(sys.argv) > 2 else 4096
+    capture = make_capture(lines)
+
+    count, elapsed = run(PythonDecoder(), capture, chunk)
+    python_rate = count / elapsed
+    print(f"python  {count} lines  {python_rate:12,.0f} lines/s")
+
+    if sim_native is None:
+        print("native  sim_native not built")
+        return
+
+    count, elapsed = run(sim_native.Decoder(), capture, chunk)
+    native_rate = count / elapsed
+    print(f"native  {count} lines  {native_rate:12,.0f} lines/s  ({native_rate / python_rate:.1f}x)")
+
+    if PythonDecoder().feed(capture) != sim_native.Decoder().feed(capture):
+        print("MISMATCH between decoders")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
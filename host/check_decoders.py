@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Decoder agreement check: pure-Python decoder vs sim_native.Decoder.
+
+Feeds both decoders the same bytes and fails on the first line they
+decode differently: hand-picked edge cases (int32 limits, overlong
+decimal and hexadecimal tokens, signs, stamps, malformed lines), then
+random lines built from those pieces, whole and in random chunks.
+Build the extension first (pip install -e .).
+
+Usage: python host/check_decoders.py [LINES] [SEED]
+
+Exit status 0 when they agree, 1 on a mismatch, 2 without sim_native.
+
+Author: Leonardo Klein
+"""
+
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src"))
+
+from protocol_decoder import PythonDecoder, sim_native  # noqa: E402
+
+EDGE_LINES = [
+    "0 7 99999999999 1",
+    "0 7 2147483647 -2147483648",
+    "0 7 2147483648 0",
+    "0 7 -2147483649 0",
+    "0 8 -0 +0",
+    "0 8 4294967296 4294967295",
+    "0 6 00000000000000000000000000012",
+    "0 6 999999999999999999999999999999999",
+    "1 1 7FFFFFFF",
+    "1 1 80000000",
+    "1 1 -80000000",
+    "1 1 -80000001",
+    "1 1 FFFFFFFF",
+    "1 1 0x7fffffff",
+    "1 1 0x100000000",
+    "1 1 FFFFFFFFFFFFFFFFFF",
+    "1 0 41 @FFFFFFFF",
+    "1 0 41 @123456789",
+    "0 8 1 2 !0",
+    "4294967296 7 1 1",
+    "0 4294967303 1 1",
+    "0 256 1",
+    "0 7 1x 2",
+    "0 7 - 2",
+    "0 7 0x10 2",
+    "# 99999999999",
+    "",
+]
+
+TOKENS = [
+    "0", "1", "7", "8", "-", "+", "-1", "41", "0x", "0x41", "FF", "ff",
+    "2147483647", "2147483648", "-2147483648", "-2147483649", "4294967295",
+    "7FFFFFFF", "80000000", "FFFFFFFF", "@1F", "!FFFFFFFF", "@", "#",
+]
+
+
+def random_token(rng: random.Random) -> str:
+    """
+    A token from the edge pieces or a run of random digits.
+
+    :param rng: Random source
+    :return: Token text
+    """
+    if rng.random() < 0.5:
+        return rng.choice(TOKENS)
+    digits = "0123456789ABCDEFabcdef" if rng.random() < 0.3 else "0123456789"
+    sign = rng.choice(("", "", "-", "+"))
+    return sign + "".join(rng.choice(digits) for _ in range(rng.randint(1, 14)))
+
+
+def random_line(rng: random.Random) -> str:
+    """
+    A line of 1-5 tokens, usually starting with a device and event code.
+
+    :param rng: Random source
+    :return: Line text
+    """
+    tokens = [rng.choice(("0", "1")), str(rng.randint(0, 9))] if rng.random() < 0.8 else []
+    tokens += [random_token(rng) for _ in range(rng.randint(0, 3))]
+    return rng.choice((" ", "  ", "\t")).join(tokens)
+
+
+def compare(lines: list, rng: random.Random) -> bool:
+    """
+    Decode the lines with both decoders, whole and in random chunks.
+
+    :return: True if every decoded item matched
+    """
+    data = ("\r\n".join(lines) + "\r\n").encode()
+    python = PythonDecoder().feed(data)
+    native = sim_native.Decoder().feed(data)
+
+    chunked = []
+    decoder = sim_native.Decoder()
+    offset = 0
+    while offset < len(data):
+        size = rng.randint(1, 64)
+        chunked += decoder.feed(data[offset : offset + size])
+        offset += size
+
+    for candidate, label in ((native, "native"), (chunked, "native, chunked")):
+        if candidate != python:
+            for index, (left, right) in enumerate(zip(python, candidate)):
+                if left != right:
+                    print(f"MISMATCH at item {index}: python {left!r}, {label} {right!r}")
+                    return False
+            print(f"MISMATCH: python decoded {len(python)} items, {label} {len(candidate)}")
+            return False
+    return True
+
+
+def main():
+    lines = int(sys.argv[1]) if len(sys.argv) > 1 else 200000
+    seed = int(sys.argv[2]) if len(sys.argv) > 2 else 1
+
+    if sim_native is None:
+        print("native  sim_native not built")
+        sys.exit(2)
+
+    rng = random.Random(seed)
+    ok = compare(EDGE_LINES, rng)
+    print(f"edge    {len(EDGE_LINES)} lines  {'ok' if ok else 'FAILED'}")
+
+    random_lines = [random_line(rng) for _ in range(lines)]
+    random_ok = compare(random_lines, rng)
+    print(f"random  {lines} lines  {'ok' if random_ok else 'FAILED'}")
+
+    if not (ok and random_ok):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""
+Generate the key name tables from the VirtualKey enum.
+
+Reads VirtualKey in arduino/SerialInputProtocol.h and writes:
+
+- arduino/SerialInputKeyNames.cpp: the name blob, the 256 code to name
+  offsets and a perfect hash from name to code, for the device, the
+  script compiler and the host tools (see SerialInputKeyNames.h)
+- src/key_names.py: the same names for the Python host
+
+The hash is FNV-1a over the name. Its low bits pick one of
+KEY_NAME_BUCKETS buckets; each bucket has a seed, found here, that
+places all of its names in distinct free slots out of 256:
+slot = (hash >> 8) + seed * ((hash >> 16) | 1), modulo 256.
+
+Usage: python host/gen_key_names.py [--check]
+
+With --check, nothing is written; the exit status tells whether the
+files are up to date.
+
+Author: Leonardo Klein
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+PROTOCOL = os.path.join(ROOT, "arduino", "SerialInputProtocol.h")
+CPP_OUTPUT = os.path.join(ROOT, "arduino", "SerialInputKeyNames.cpp")
+PY_OUTPUT = os.path.join(ROOT, "src", "key_names.py")
+
+SLOTS = 256
+BUCKETS = 64
+NO_NAME = 0xFFFF
+
+
+def read_keys() -> list:
+    """
+    Parse the VirtualKey enum.
+
+    :return: (name, code) pairs in declaration order, aliases included
+    """
+    with open(PROTOCOL) as source:
+        text = source.read()
+    body = re.search(r"enum class VirtualKey : uint16_t \{(.*?)\n\};", text, re.S).group(1)
+    body = re.sub(r"//[^\n]*", "", body)
+    keys = [(name, int(code, 16)) for name, code in re.findall(r"(\w+)\s*=\s*0x([0-9A-Fa-f]+)", body)]
+    if any(code >= SLOTS for _, code in keys):
+        sys.exit("VirtualKey codes must fit in a byte")
+    return keys
+
+
+def fnv1a(name: str) -> int:
+    value = 2166136261
+    for byte in name.encode("ascii"):
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+def slot(value: int, seed: int) -> int:
+    return ((value >> 8) + seed * ((value >> 16) | 1)) & (SLOTS - 1)
+
+
+def place(names: list) -> tuple:
+    """
+    Find a seed per bucket so every name gets its own slot.
+
+    :return: (seeds, slot to name index or None)
+    """
+    buckets = [[] for _ in range(BUCKETS)]
+    for index, name in enumerate(names):
+        buckets[fnv1a(name) & (BUCKETS - 1)].append(index)
+
+    seeds = [0] * BUCKETS
+    slots = [None] * SLOTS
+    # Fullest buckets first, while most slots are free
+    for bucket in sorted(range(BUCKETS), key=lambda b: -len(buckets[b])):
+        for seed in range(256):
+            wanted = [slot(fnv1a(names[index]), seed) for index in buckets[bucket]]
+            if len(set(wanted)) == len(wanted) and all(slots[s] is None for s in wanted):
+                break
+        else:
+            sys.exit(f"no seed places bucket {bucket}")
+        seeds[bucket] = seed
+        for index, position in zip(buckets[bucket], wanted):
+            slots[position] = index
+    return seeds, slots
+
+
+def table(type_name: str, name: str, values: list, width: int, per_line: int) -> str:
+    lines = [f"const {type_name} {name}[] PROGMEM = {{"]
+    for start in range(0, len(values), per_line):
+        chunk = values[start : start + per_line]
+        lines.append("    " + " ".join(f"0x{value:0{width}X}," for value in chunk))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def generate_cpp(keys: list) -> str:
+    names = [name for name, _ in keys]
+    blob = bytearray()
+    offsets = {}
+    for name in names:
+        offsets[name] = len(blob)
+        blob += name.encode("ascii") + b"\0"
+    if len(blob) >= NO_NAME:
+        sys.exit("key name blob too large")
+
+    code_offsets = [NO_NAME] * SLOTS
+    for name, code in keys:
+        if code_offsets[code] == NO_NAME:
+            code_offsets[code] = offsets[name]
+
+    seeds, slots = place(names)
+    slot_offsets = [NO_NAME if index is None else offsets[names[index]] for index in slots]
+    slot_codes = [0 if index is None else keys[index][1] for index in slots]
+
+    blob_lines = []
+    for name in names:
+        blob_lines.append(f'    "{name}\\0"')
+
+    checks = "\n".join(
+        f'static_assert(keyNameHash("{name}", {len(name)}) == 0x{fnv1a(name):08X}UL, "{name}");' for name in names
+    )
+
+    return f"""/**
+ * @file SerialInputKeyNames.cpp
+ * @brief Key name tables, generated by host/gen_key_names.py from VirtualKey
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Do not edit: change VirtualKey and run python host/gen_key_names.py.
+ * {len(names)} names, {sum(1 for offset in code_offsets if offset != NO_NAME)} codes, {len(blob)} blob bytes.
+ *
+ * @author Leonardo Klein
+ */
+
+#include "SerialInputKeyNames.h"
+
+const char KEY_NAME_BLOB[] PROGMEM =
+{chr(10).join(blob_lines)};
+
+{table("uint16_t", "KEY_NAME_OFFSETS", code_offsets, 4, 8)}
+
+{table("uint8_t", "KEY_NAME_SEEDS", seeds, 2, 16)}
+
+{table("uint16_t", "KEY_NAME_SLOT_OFFSETS", slot_offsets, 4, 8)}
+
+{table("uint8_t", "KEY_NAME_SLOT_CODES", slot_codes, 2, 16)}
+
+// keyNameHash() must agree with the generator for the slots to be right
+{checks}
+"""
+
+
+def generate_py(keys: list) -> str:
+    canonical = {}
+    for name, code in keys:
+        canonical.setdefault(code, name)
+
+    lines = [
+        '"""',
+        "VirtualKey names, generated by host/gen_key_names.py.",
+        "",
+        "Do not edit: change VirtualKey in arduino/SerialInputProtocol.h and",
+        "run python host/gen_key_names.py. The C++ side has the same names in",
+        "arduino/SerialInputKeyNames.cpp.",
+        "",
+        "Author: Leonardo Klein",
+        '"""',
+        "",
+        "# Name of each key code, None for codes without a VirtualKey",
+        "KEY_NAMES = (",
+    ]
+    for start in range(0, SLOTS, 4):
+        values = ", ".join(f'"{canonical[code]}"' if code in canonical else "None" for code in range(start, start + 4))
+        lines.append(f"    {values},")
+    lines += [")", "", "# Code of every VirtualKey name, aliases included", "KEY_CODES = {"]
+    for name, code in keys:
+        lines.append(f'    "{name}": 0x{code:02X},')
+    lines += ["}", ""]
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the key name tables from the VirtualKey enum")
+    parser.add_argument("--check", action="store_true", help="only check that the files are up to date")
+    args = parser.parse_args()
+
+    keys = read_keys()
+    outputs = {CPP_OUTPUT: generate_cpp(keys), PY_OUTPUT: generate_py(keys)}
+
+    stale = []
+    for path, text in outputs.items():
+        current = open(path).read() if os.path.exists(path) else None
+        if current == text:
+            continue
+        stale.append(os.path.relpath(path, ROOT))
+        if not args.check:
+            with open(path, "w") as output:
+                output.write(text)
+
+    if args.check and stale:
+        sys.exit("out of date: " + ", ".join(stale))
+    for path in stale:
+        print(f"wrote   {path}")
+
+
+if __name__ == "__main__":
+    main()
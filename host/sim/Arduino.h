@@ -0,0 +1,342 @@
+/**
+ * @file Arduino.h
+ * @brief Linux stand-in for the Arduino core used by the device simulator
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Provides the subset of the Arduino API used by the library and its
+ * examples so that sketches compile natively. `Serial` is the master
+ * side of a pseudo-terminal: hosts open the slave path printed at start
+ * exactly as they would open /dev/ttyACM0. Time comes from SimClock (see
+ * ArduinoSim.cpp) and runs in real time, scaled, or fully virtual.
+ *
+ * One simulated compare-match timer stands in for a hardware timer
+ * interrupt (simTimerAttach()); noInterrupts()/interrupts() mask it.
+ * simIdle() stands in for the sleep instruction and counts the time spent
+ * asleep.
+ *
+ * @author Leonardo Klein
+ */
+
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+// ==================== CORE DEFINITIONS ====================
+
+#define SERIAL_INPUT_SIMULATOR 1 ///< Built by host/sim, not for a board
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define SERIAL_TX_BUFFER_SIZE 64 ///< As in the AVR core's HardwareSerial.h
+
+#define LED_BUILTIN 13
+#define NUM_DIGITAL_PINS 20
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+#define pgm_read_byte(p) (*reinterpret_cast<const uint8_t *>(p))
+#define pgm_read_word(p) (*reinterpret_cast<const uint16_t *>(p))
+#define pgm_read_dword(p) (*reinterpret_cast<const uint32_t *>(p))
+#define pgm_read_ptr(p) (*reinterpret_cast<void *const *>(p))
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+class __FlashStringHelper;
+
+template <typename T> inline T min(T a, T b) {
+    return b < a ? b : a;
+}
+
+template <typename T> inline T max(T a, T b) {
+    return a < b ? b : a;
+}
+
+template <typename T> inline T constrain(T value, T low, T high) {
+    return value < low ? low : (high < value ? high : value);
+}
+
+inline long map(long value, long fromLow, long fromHigh, long toLow, long toHigh) {
+    return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+// ==================== TIME, PINS, RANDOM ====================
+
+unsigned long millis();
+unsigned long micros();
+void          delay(unsigned long ms);
+void          delayMicroseconds(unsigned int us);
+void          yield();
+
+void noInterrupts();
+void interrupts();
+
+// ==================== SIMULATED TIMER ====================
+
+/**
+ * @brief Set the interrupt handler of the simulated timer
+ * @param handler Called like an ISR: asynchronously (from a signal in
+ *                real or scaled time, between clock reads in virtual
+ *                time), never while interrupts are masked or Serial is
+ *                busy; its Serial output is passed on after it returns
+ */
+void simTimerAttach(void (*handler)());
+
+/**
+ * @brief Fire the handler once, after a delay
+ * @param delayUs Simulated microseconds from now (replaces any armed delay)
+ */
+void simTimerArm(uint32_t delayUs);
+
+/**
+ * @brief Disarm the timer
+ */
+void simTimerCancel();
+
+// ==================== SIMULATED SLEEP ====================
+
+/**
+ * @brief Stand-in for the sleep instruction
+ * @param maxUs Simulated microseconds to sleep at most
+ *
+ * Returns after maxUs, when a byte arrives on Serial, or after the
+ * timer handler ran, whichever comes first. The time spent counts as
+ * sleeping in simSleptUs().
+ */
+void simIdle(uint32_t maxUs);
+
+/**
+ * @brief Simulated time spent in simIdle() since start
+ * @return Microseconds; micros() minus this is the active time
+ */
+uint64_t simSleptUs();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int  digitalRead(uint8_t pin);
+int  analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+// ==================== SIMULATED DMA ====================
+
+/**
+ * @brief Start a DMA transfer to the transmitter
+ * @param data Bytes to send, copied at once
+ * @param length Number of bytes; only called once simTxDmaBusy() is false
+ *
+ * The transfer drains after Serial's transmit buffer, with the same
+ * -z stalls and -e noise (see SERIAL_TX_DMA in SerialInputMonitor.h).
+ */
+void simTxDmaStart(const uint8_t *data, uint16_t length);
+
+/**
+ * @brief Check if the last transfer is still being sent
+ */
+bool simTxDmaBusy();
+
+/**
+ * @brief Block until the last transfer has been sent
+ */
+void simTxDmaWait();
+
+// ==================== STRING ====================
+
+/**
+ * @brief Minimal Arduino String backed by std::string
+ */
+class String {
+  public:
+    String(const char *text = "") : m_text(text ? text : "") {
+    }
+    String(const std::string &text) : m_text(text) {
+    }
+    String(char c) : m_text(1, c) {
+    }
+    String(int value, unsigned char base = DEC);
+    String(long value, unsigned char base = DEC);
+    String(unsigned long value, unsigned char base = DEC);
+
+    inline unsigned int length() const {
+        return static_cast<unsigned int>(m_text.size());
+    }
+    inline const char *c_str() const {
+        return m_text.c_str();
+    }
+    inline char charAt(unsigned int index) const {
+        return index < m_text.size() ? m_text[index] : 0;
+    }
+    inline char operator[](unsigned int index) const {
+        return charAt(index);
+    }
+
+    void   trim();
+    void   toUpperCase();
+    void   toLowerCase();
+    long   toInt() const;
+    int    indexOf(char c, unsigned int from = 0) const;
+    int    indexOf(const String &text, unsigned int from = 0) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+    bool   startsWith(const String &prefix) const;
+    bool   endsWith(const String &suffix) const;
+
+    inline bool equals(const String &other) const {
+        return m_text == other.m_text;
+    }
+    inline bool operator==(const String &other) const {
+        return m_text == other.m_text;
+    }
+    inline bool operator==(const char *other) const {
+        return m_text == other;
+    }
+    inline bool operator!=(const String &other) const {
+        return m_text != other.m_text;
+    }
+    inline String &operator+=(const String &other) {
+        m_text += other.m_text;
+        return *this;
+    }
+    inline String &operator+=(const char *other) {
+        m_text += other;
+        return *this;
+    }
+    inline String &operator+=(char c) {
+        m_text += c;
+        return *this;
+    }
+    inline friend String operator+(String left, const String &right) {
+        left += right;
+        return left;
+    }
+
+  private:
+    std::string m_text; ///< Contents
+};
+
+// ==================== PRINT / STREAM ====================
+
+/**
+ * @brief Arduino Print: formatting on top of write()
+ */
+class Print {
+  public:
+    virtual ~Print() {
+    }
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    virtual int    availableForWrite() {
+        return 0;
+    }
+    virtual void flush() {
+    }
+
+    inline size_t write(const char *text) {
+        return text ? write(reinterpret_cast<const uint8_t *>(text), strlen(text)) : 0;
+    }
+    inline size_t write(const char *buffer, size_t size) {
+        return write(reinterpret_cast<const uint8_t *>(buffer), size);
+    }
+
+    size_t print(const char *text);
+    size_t print(const __FlashStringHelper *text);
+    size_t print(const String &text);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+
+    size_t println();
+    template <typename T> size_t println(const T &value) {
+        size_t count = print(value);
+        return count + println();
+    }
+    template <typename T> size_t println(const T &value, int format) {
+        size_t count = print(value, format);
+        return count + println();
+    }
+
+  private:
+    size_t printNumber(unsigned long value, int base);
+};
+
+/**
+ * @brief Arduino Stream: reading with a timeout
+ */
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read()      = 0;
+    virtual int peek()      = 0;
+
+    inline void setTimeout(unsigned long timeoutMs) {
+        m_timeout = timeoutMs;
+    }
+
+    String readString();
+    String readStringUntil(char terminator);
+    size_t readBytes(char *buffer, size_t length);
+
+  protected:
+    unsigned long m_timeout = 1000; ///< Read timeout in ms
+
+    int timedRead();
+};
+
+/**
+ * @brief Serial port backed by a pseudo-terminal master
+ */
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baudRate);
+    void end();
+
+    int    available() override;
+    int    read() override;
+    int    peek() override;
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    int    availableForWrite() override;
+    void   flush() override;
+
+    using Print::write;
+
+    inline operator bool() const {
+        return true;
+    }
+};
+
+extern HardwareSerial Serial;
+
+// Sketch entry points (defined by the .ino)
+void setup();
+void loop();
+
+#endif // SIM_ARDUINO_H
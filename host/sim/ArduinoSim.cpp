@@ -0,0 +1,992 @@
+/**
+ * @file ArduinoSim.cpp
+ * @brief Runtime of the native device simulator: pty Serial, clock, main()
+ * @version 1.0.0
+ * @date 2025-09-05
+ *
+ * Usage: <sketch>-sim [-x FACTOR] [-l LINK] [-t SECONDS] [-r SEED] [-w] [-s] [-z START,SECONDS] [-e BER]
+ *
+ *   -x  Clock speed: 1 real time (default), 10 ten times faster,
+ *       0 virtual time (delay() returns at once, the sketch runs as fast
+ *       as the host reads)
+ *   -l  Create a symlink LINK to the pty slave (e.g. /tmp/sim0)
+ *   -t  Stop after SECONDS of simulated time
+ *   -r  Seed for random() and -e (default 1, so runs are reproducible)
+ *   -w  Start the sketch only once a host opens the port, like an Uno
+ *       that resets when the port is opened
+ *   -s  Print the simulated time spent active and in simIdle() on exit
+ *   -z  Hold the transmitter for SECONDS from START (simulated seconds),
+ *       like a stalled link deasserting CTS
+ *   -e  Flip each transmitted bit with probability BER, like a noisy
+ *       cable; the bits flipped are reported on exit
+ *
+ * The slave path is printed as "PTY <path>" on stdout once the port is
+ * ready. Output goes through a 64-byte buffer like the Uno's UART
+ * transmit buffer. It is passed to the pty without blocking on delay(),
+ * yield(), and after every loop(); availableForWrite() reports the room
+ * left. write() blocks only on a full buffer and flush() until it is
+ * empty, so when nobody reads the slave (or -z holds the transmitter)
+ * a sketch stalls as it would on a full UART buffer.
+ *
+ * simTxDmaStart() stands in for a DMA channel feeding the same
+ * transmitter: it takes a copy of the transfer, which drains after
+ * Serial's buffer at the same points and is held by -z alike. The
+ * transfers and their bytes are reported on exit.
+ *
+ * In virtual time each millis()/micros() call advances the clock by one
+ * microsecond, so sketches that busy-wait on millis() still progress.
+ *
+ * The simulated timer interrupt is a POSIX timer signal in real and
+ * scaled time, so it preempts busy loops like a hardware interrupt. In
+ * virtual time it fires when the clock passes its deadline. While
+ * interrupts are masked, or Serial is inside one of its methods, a
+ * firing is held back and runs as soon as the mask is lifted. Printing
+ * does not allocate, so handlers may print.
+ *
+ * @author Leonardo Klein
+ */
+
+#include "Arduino.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <random>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+
+namespace {
+
+const size_t TX_BUFFER = SERIAL_TX_BUFFER_SIZE; ///< Transmit buffer, as on the Uno
+
+double                g_factor    = 1.0; ///< Clock speed, 0 for virtual time
+uint64_t              g_originNs  = 0;   ///< Real time at start
+uint64_t              g_virtualUs = 0;   ///< Virtual clock
+uint64_t              g_stopUs    = 0;   ///< Simulated stop time, 0 for none
+uint64_t              g_holdFromUs = 0;  ///< Transmitter held from this simulated time (-z)
+uint64_t              g_holdToUs   = 0;  ///< ... until this one, 0 for never
+volatile sig_atomic_t g_running   = 1;
+
+int         g_master = -1; ///< pty master (the device side)
+int         g_slave  = -1; ///< Slave kept open so reads never see EIO
+int         g_peeked = -1; ///< Byte returned by peek(), -1 if none
+char        g_tx[TX_BUFFER];
+size_t      g_txLength = 0;
+char        g_dma[65535];       ///< Transfer in flight, as the DMA channel reads it
+size_t      g_dmaLength    = 0; ///< Its length
+size_t      g_dmaSent      = 0; ///< Bytes of it passed to the pty
+uint64_t    g_dmaTransfers = 0; ///< Transfers started
+uint64_t    g_dmaBytes     = 0; ///< Bytes in them
+const char *g_link     = nullptr;
+
+uint8_t      g_pinMode[NUM_DIGITAL_PINS];
+uint8_t      g_pinValue[NUM_DIGITAL_PINS];
+std::mt19937 g_random(1);
+
+void (*g_timerHandler)() = nullptr;   ///< simTimerAttach() handler
+timer_t               g_timer;        ///< Signalling timer (real and scaled time)
+bool                  g_timerCreated = false;
+bool                  g_timerArmed   = false; ///< Virtual time: g_timerDueUs is set
+uint64_t              g_timerDueUs   = 0;     ///< Virtual time deadline
+volatile sig_atomic_t g_timerPending = 0;     ///< Fired while masked
+volatile sig_atomic_t g_maskDepth    = 0;     ///< Serial methods and running handlers
+volatile sig_atomic_t g_interruptsOff = 0;    ///< noInterrupts() in effect
+
+uint64_t g_sleptUs    = 0;     ///< Simulated time spent in simIdle()
+bool     g_sleepStats = false; ///< Print active and sleeping time on exit (-s)
+
+double       g_bitErrorRate = 0.0; ///< Probability of a transmitted bit flipping (-e)
+uint64_t     g_bitsToError  = 0;   ///< Bits left until the next flip
+uint64_t     g_flippedBits  = 0;   ///< Bits flipped so far
+uint64_t     g_sentBytes    = 0;   ///< Bytes passed through the noise
+std::mt19937 g_noise(1);           ///< Noise generator, seeded with -r
+
+/**
+ * @brief Bits until the next flip
+ * @return Draw from the geometric distribution of the gaps between errors
+ */
+uint64_t nextBitError() {
+    return std::geometric_distribution<uint64_t>(g_bitErrorRate)(g_noise);
+}
+
+/**
+ * @brief Pass a byte through the noisy line of -e
+ * @param c Byte written by the sketch
+ * @return Byte as the host receives it
+ */
+uint8_t addNoise(uint8_t c) {
+    while (g_bitsToError < 8) {
+        c ^= static_cast<uint8_t>(1u << g_bitsToError);
+        g_flippedBits++;
+        g_bitsToError += 1 + nextBitError();
+    }
+    g_bitsToError -= 8;
+    g_sentBytes++;
+    return c;
+}
+
+void onSignal(int) {
+    g_running = 0;
+}
+
+void drainTx();
+
+/**
+ * @brief Run the timer handler like an ISR, with further firings held back
+ */
+void runTimer() {
+    g_maskDepth++;
+    do {
+        g_timerPending = 0;
+        if (g_timerHandler) {
+            g_timerHandler();
+        }
+        drainTx();
+    } while (g_timerPending && !g_interruptsOff);
+    g_maskDepth--;
+}
+
+/**
+ * @brief Enter a section the timer handler must not interrupt
+ */
+void maskTimer() {
+    g_maskDepth++;
+}
+
+/**
+ * @brief Leave a masked section and run a firing held back meanwhile
+ */
+void unmaskTimer() {
+    g_maskDepth--;
+    if (g_maskDepth == 0 && !g_interruptsOff && g_timerPending) {
+        runTimer();
+    }
+}
+
+void onTimerSignal(int) {
+    int saved = errno;
+    if (g_maskDepth > 0 || g_interruptsOff) {
+        g_timerPending = 1;
+    } else {
+        runTimer();
+    }
+    errno = saved;
+}
+
+uint64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+uint64_t nowUs() {
+    if (g_factor <= 0.0) {
+        return g_virtualUs++;
+    }
+    return static_cast<uint64_t>(static_cast<double>(monotonicNs() - g_originNs) * g_factor / 1000.0);
+}
+
+/**
+ * @brief Fire the timer if virtual time has passed its deadline
+ */
+void checkVirtualTimer() {
+    if (g_timerArmed && g_virtualUs >= g_timerDueUs) {
+        g_timerArmed   = false;
+        g_timerPending = 1;
+    }
+    if (g_timerPending && g_maskDepth == 0 && !g_interruptsOff) {
+        runTimer();
+    }
+}
+
+void shutdown() {
+    drainTx();
+    if (g_sleepStats) {
+        uint64_t totalUs = g_factor <= 0.0 ? g_virtualUs : nowUs();
+        fprintf(stderr, "sleep: %llu us active, %llu us sleeping (%.1f%%)\n",
+                static_cast<unsigned long long>(totalUs - g_sleptUs), static_cast<unsigned long long>(g_sleptUs),
+                totalUs > 0 ? 100.0 * static_cast<double>(g_sleptUs) / static_cast<double>(totalUs) : 0.0);
+    }
+    if (g_dmaTransfers > 0) {
+        fprintf(stderr, "dma: %llu transfers, %llu bytes\n", static_cast<unsigned long long>(g_dmaTransfers),
+                static_cast<unsigned long long>(g_dmaBytes));
+    }
+    if (g_bitErrorRate > 0.0) {
+        fprintf(stderr, "noise: %llu bits flipped in %llu bytes\n", static_cast<unsigned long long>(g_flippedBits),
+                static_cast<unsigned long long>(g_sentBytes));
+    }
+    if (g_link) {
+        unlink(g_link);
+    }
+    exit(0);
+}
+
+/**
+ * @brief Stop when signalled or when the simulated run time is over
+ */
+void checkStop() {
+    if (!g_running || (g_stopUs > 0 && nowUs() >= g_stopUs)) {
+        shutdown();
+    }
+}
+
+/**
+ * @brief Let simulated time pass, running the timer on the way
+ * @param us Simulated microseconds
+ */
+void passTime(uint64_t us) {
+    if (g_factor <= 0.0) {
+        // Stop at the timer deadline on the way, as the interrupt would
+        uint64_t targetUs = g_virtualUs + us;
+        while (g_timerArmed && g_timerDueUs < targetUs) {
+            g_virtualUs = g_timerDueUs > g_virtualUs ? g_timerDueUs : g_virtualUs;
+            checkVirtualTimer();
+        }
+        g_virtualUs = targetUs > g_virtualUs ? targetUs : g_virtualUs;
+        checkVirtualTimer();
+    } else {
+        uint64_t ns = static_cast<uint64_t>(static_cast<double>(us) * 1000.0 / g_factor);
+        timespec duration;
+        duration.tv_sec  = static_cast<time_t>(ns / 1000000000ULL);
+        duration.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+        while (nanosleep(&duration, &duration) < 0 && errno == EINTR && g_running) {
+        }
+    }
+}
+
+/**
+ * @brief Let simulated time pass
+ * @param us Simulated microseconds
+ */
+void sleepUs(uint64_t us) {
+    drainTx();
+    passTime(us);
+    checkStop();
+}
+
+/**
+ * @brief Time left while -z holds the transmitter
+ * @return Simulated microseconds until it is released, 0 when not held
+ */
+uint64_t txHeldUs() {
+    if (g_holdToUs == 0) {
+        return 0;
+    }
+    uint64_t now = g_factor <= 0.0 ? g_virtualUs : nowUs();
+    return now >= g_holdFromUs && now < g_holdToUs ? g_holdToUs - now : 0;
+}
+
+/**
+ * @brief Pass bytes to the pty as far as it takes them, without blocking
+ * @param data Bytes
+ * @param length Number of bytes
+ * @return Bytes taken
+ */
+size_t writePty(const char *data, size_t length) {
+    ssize_t count;
+    do {
+        count = ::write(g_master, data, length);
+    } while (count < 0 && errno == EINTR && g_running);
+    return count > 0 ? static_cast<size_t>(count) : 0;
+}
+
+/**
+ * @brief Pass buffered output, then the DMA transfer, to the pty without blocking
+ */
+void drainTx() {
+    maskTimer();
+    if (g_txLength > 0 && txHeldUs() == 0) {
+        size_t count = writePty(g_tx, g_txLength);
+        g_txLength -= count;
+        memmove(g_tx, g_tx + count, g_txLength);
+    }
+    if (g_txLength == 0 && g_dmaSent < g_dmaLength && txHeldUs() == 0) {
+        g_dmaSent += writePty(g_dma + g_dmaSent, g_dmaLength - g_dmaSent);
+    }
+    unmaskTimer();
+}
+
+/**
+ * @brief Bytes written and not yet passed to the pty
+ * @return Serial's buffer and the rest of the DMA transfer
+ */
+size_t unsentTx() {
+    return g_txLength + (g_dmaLength - g_dmaSent);
+}
+
+/**
+ * @brief Wait until the pty may take more output or -z releases the transmitter
+ */
+void waitTxRoom() {
+    uint64_t heldUs = txHeldUs();
+    if (heldUs > 0) {
+        passTime(heldUs);
+    } else {
+        pollfd ready = {g_master, POLLOUT, 0};
+        poll(&ready, 1, 100);
+    }
+    drainTx();
+}
+
+/**
+ * @brief Block until at most `keep` bytes of output are buffered
+ * @param keep Bytes that may stay in the buffer
+ */
+void waitTx(size_t keep) {
+    drainTx();
+    while (g_txLength > keep && g_running) {
+        waitTxRoom();
+    }
+}
+
+/**
+ * @brief Block until the DMA transfer has been passed on
+ */
+void waitDma() {
+    drainTx();
+    while (g_dmaSent < g_dmaLength && g_running) {
+        waitTxRoom();
+    }
+}
+
+bool openPty() {
+    g_master = posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if (g_master < 0 || grantpt(g_master) < 0 || unlockpt(g_master) < 0) {
+        perror("posix_openpt");
+        return false;
+    }
+
+    // Output is drained without blocking; waitTx() blocks where a UART would
+    fcntl(g_master, F_SETFL, fcntl(g_master, F_GETFL) | O_NONBLOCK);
+
+    const char *path = ptsname(g_master);
+    g_slave          = path ? open(path, O_RDWR | O_NOCTTY | O_CLOEXEC) : -1;
+    if (g_slave < 0) {
+        perror("open pty slave");
+        return false;
+    }
+
+    termios tty;
+    tcgetattr(g_slave, &tty);
+    cfmakeraw(&tty);
+    tcsetattr(g_slave, TCSANOW, &tty);
+
+    if (g_link) {
+        unlink(g_link);
+        if (symlink(path, g_link) < 0) {
+            perror("symlink");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Watch the pty slave for opens (before its path is announced)
+ * @return inotify descriptor, -1 on failure
+ */
+int watchForHost() {
+    int watch = inotify_init1(IN_CLOEXEC);
+    if (watch < 0 || inotify_add_watch(watch, ptsname(g_master), IN_OPEN) < 0) {
+        perror("inotify");
+        return -1;
+    }
+    return watch;
+}
+
+/**
+ * @brief Block until another process opens the pty slave
+ * @param watch Descriptor from watchForHost()
+ * @return false when interrupted
+ */
+bool waitForHost(int watch) {
+    pollfd ready = {watch, POLLIN, 0};
+    while (g_running && poll(&ready, 1, -1) <= 0) {
+    }
+    close(watch);
+
+    // Hosts flush the input queue right after opening; give them time to
+    // finish configuring the port, as the bootloader does on a real board
+    usleep(100000);
+    return g_running;
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s [-x FACTOR] [-l LINK] [-t SECONDS] [-r SEED] [-w] [-s] [-z START,SECONDS] [-e BER]\n",
+            program);
+}
+
+} // namespace
+
+// ==================== TIME ====================
+
+unsigned long millis() {
+    unsigned long now = static_cast<unsigned long>(nowUs() / 1000);
+    if (g_factor <= 0.0) {
+        checkVirtualTimer();
+    }
+    return now;
+}
+
+unsigned long micros() {
+    unsigned long now = static_cast<unsigned long>(nowUs());
+    if (g_factor <= 0.0) {
+        checkVirtualTimer();
+    }
+    return now;
+}
+
+void delay(unsigned long ms) {
+    sleepUs(static_cast<uint64_t>(ms) * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+    sleepUs(us);
+}
+
+void yield() {
+    // Busy-wait loops end up here: wait for input instead of spinning
+    drainTx();
+    if (g_factor <= 0.0) {
+        sleepUs(1000);
+    } else {
+        pollfd ready = {g_master, POLLIN, 0};
+        poll(&ready, 1, 1);
+    }
+    checkStop();
+}
+
+void noInterrupts() {
+    g_interruptsOff = 1;
+}
+
+void interrupts() {
+    g_interruptsOff = 0;
+    if (g_maskDepth == 0 && g_timerPending) {
+        runTimer();
+    }
+}
+
+// ==================== SIMULATED TIMER ====================
+
+void simTimerAttach(void (*handler)()) {
+    g_timerHandler = handler;
+    if (g_timerCreated || g_factor <= 0.0) {
+        return;
+    }
+
+    struct sigaction action = {};
+    action.sa_handler       = onTimerSignal;
+    action.sa_flags         = SA_RESTART;
+    sigaction(SIGALRM, &action, nullptr);
+
+    sigevent event        = {};
+    event.sigev_notify    = SIGEV_SIGNAL;
+    event.sigev_signo     = SIGALRM;
+    g_timerCreated        = timer_create(CLOCK_MONOTONIC, &event, &g_timer) == 0;
+    if (!g_timerCreated) {
+        perror("timer_create");
+    }
+}
+
+void simTimerArm(uint32_t delayUs) {
+    if (g_factor <= 0.0) {
+        g_timerDueUs = g_virtualUs + delayUs;
+        g_timerArmed = true;
+        return;
+    }
+    if (!g_timerCreated) {
+        return;
+    }
+
+    uint64_t   ns      = static_cast<uint64_t>(static_cast<double>(delayUs) * 1000.0 / g_factor);
+    itimerspec setting = {};
+    setting.it_value.tv_sec  = static_cast<time_t>(ns / 1000000000ULL);
+    setting.it_value.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+    if (ns == 0) {
+        setting.it_value.tv_nsec = 1; // zero would disarm
+    }
+    timer_settime(g_timer, 0, &setting, nullptr);
+}
+
+void simTimerCancel() {
+    g_timerArmed = false;
+    if (g_timerCreated) {
+        itimerspec setting = {};
+        timer_settime(g_timer, 0, &setting, nullptr);
+    }
+}
+
+// ==================== SIMULATED SLEEP ====================
+
+void simIdle(uint32_t maxUs) {
+    // Room freed in the transmit buffer wakes the CPU, as its interrupt would
+    size_t buffered = unsentTx();
+    drainTx();
+    if (unsentTx() < buffered) {
+        checkStop();
+        return;
+    }
+    uint64_t heldUs = txHeldUs();
+    if (heldUs > 0 && heldUs < maxUs) {
+        maxUs = static_cast<uint32_t>(heldUs);
+    }
+
+    if (g_factor <= 0.0) {
+        // Wake at the timer deadline, as its interrupt would
+        uint64_t startUs  = g_virtualUs;
+        uint64_t targetUs = startUs + maxUs;
+        if (g_timerArmed && g_timerDueUs < targetUs) {
+            targetUs = g_timerDueUs > startUs ? g_timerDueUs : startUs;
+        }
+        g_virtualUs = targetUs;
+        g_sleptUs += targetUs - startUs;
+        checkVirtualTimer();
+    } else if (g_peeked < 0) {
+        // Block the timer signal until ppoll() unblocks it, so a firing
+        // in between wakes the sleep instead of being missed
+        sigset_t timerSignal, previous;
+        sigemptyset(&timerSignal);
+        sigaddset(&timerSignal, SIGALRM);
+        sigprocmask(SIG_BLOCK, &timerSignal, &previous);
+
+        uint64_t startUs = nowUs();
+        uint64_t ns      = static_cast<uint64_t>(static_cast<double>(maxUs) * 1000.0 / g_factor);
+        timespec timeout;
+        timeout.tv_sec  = static_cast<time_t>(ns / 1000000000ULL);
+        timeout.tv_nsec = static_cast<long>(ns % 1000000000ULL);
+        short    events = static_cast<short>(POLLIN | (unsentTx() > 0 && heldUs == 0 ? POLLOUT : 0));
+        pollfd   ready  = {g_master, events, 0};
+        ppoll(&ready, 1, &timeout, &previous);
+
+        sigprocmask(SIG_SETMASK, &previous, nullptr);
+        g_sleptUs += nowUs() - startUs;
+    }
+    checkStop();
+}
+
+uint64_t simSleptUs() {
+    return g_sleptUs;
+}
+
+// ==================== PINS, RANDOM ====================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+    if (pin < NUM_DIGITAL_PINS) {
+        g_pinMode[pin]  = mode;
+        g_pinValue[pin] = mode == INPUT_PULLUP ? HIGH : g_pinValue[pin];
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+    if (pin < NUM_DIGITAL_PINS) {
+        g_pinValue[pin] = value ? HIGH : LOW;
+    }
+}
+
+int digitalRead(uint8_t pin) {
+    return pin < NUM_DIGITAL_PINS ? g_pinValue[pin] : LOW;
+}
+
+int analogRead(uint8_t) {
+    return 0;
+}
+
+void analogWrite(uint8_t pin, int value) {
+    digitalWrite(pin, value > 127 ? HIGH : LOW);
+}
+
+long random(long max) {
+    return max > 0 ? static_cast<long>(g_random() % static_cast<unsigned long>(max)) : 0;
+}
+
+long random(long min, long max) {
+    return max > min ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed) {
+    if (seed != 0) {
+        g_random.seed(static_cast<std::mt19937::result_type>(seed));
+    }
+}
+
+// ==================== STRING ====================
+
+namespace {
+
+const size_t NUMBER_BUFFER = 8 * sizeof(long) + 2; ///< Sign, binary digits, terminator
+
+/**
+ * @brief Format a number without allocating (safe in the timer handler)
+ * @param buffer At least NUMBER_BUFFER bytes
+ * @return Start of the null-terminated text inside buffer
+ */
+const char *formatDigits(char *buffer, unsigned long value, int base) {
+    if (base < 2) {
+        base = DEC;
+    }
+    char *cursor = buffer + NUMBER_BUFFER - 1;
+    *cursor      = '\0';
+    do {
+        int digit = static_cast<int>(value % static_cast<unsigned long>(base));
+        *--cursor = static_cast<char>(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= static_cast<unsigned long>(base);
+    } while (value);
+    return cursor;
+}
+
+const char *formatSignedDigits(char *buffer, long value, int base) {
+    if (base == DEC && value < 0) {
+        char *cursor = const_cast<char *>(formatDigits(buffer, static_cast<unsigned long>(-value), DEC));
+        *--cursor    = '-';
+        return cursor;
+    }
+    // Non-decimal negatives print as 32-bit two's complement, as on AVR
+    return formatDigits(buffer, value < 0 ? static_cast<uint32_t>(value) : static_cast<unsigned long>(value), base);
+}
+
+std::string formatNumber(unsigned long value, int base) {
+    char buffer[NUMBER_BUFFER];
+    return formatDigits(buffer, value, base);
+}
+
+std::string formatSigned(long value, int base) {
+    char buffer[NUMBER_BUFFER];
+    return formatSignedDigits(buffer, value, base);
+}
+
+} // namespace
+
+String::String(int value, unsigned char base) : m_text(formatSigned(value, base)) {
+}
+
+String::String(long value, unsigned char base) : m_text(formatSigned(value, base)) {
+}
+
+String::String(unsigned long value, unsigned char base) : m_text(formatNumber(value, base)) {
+}
+
+void String::trim() {
+    size_t begin = m_text.find_first_not_of(" \t\r\n");
+    size_t end   = m_text.find_last_not_of(" \t\r\n");
+    m_text       = begin == std::string::npos ? std::string() : m_text.substr(begin, end - begin + 1);
+}
+
+void String::toUpperCase() {
+    for (char &c : m_text) {
+        c = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+}
+
+void String::toLowerCase() {
+    for (char &c : m_text) {
+        c = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+}
+
+long String::toInt() const {
+    return strtol(m_text.c_str(), nullptr, 10);
+}
+
+int String::indexOf(char c, unsigned int from) const {
+    size_t index = m_text.find(c, from);
+    return index == std::string::npos ? -1 : static_cast<int>(index);
+}
+
+int String::indexOf(const String &text, unsigned int from) const {
+    size_t index = m_text.find(text.m_text, from);
+    return index == std::string::npos ? -1 : static_cast<int>(index);
+}
+
+String String::substring(unsigned int from) const {
+    return from < m_text.size() ? String(m_text.substr(from)) : String();
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+    if (from > to) {
+        unsigned int swap = from;
+        from              = to;
+        to                = swap;
+    }
+    return from < m_text.size() ? String(m_text.substr(from, to - from)) : String();
+}
+
+bool String::startsWith(const String &prefix) const {
+    return m_text.compare(0, prefix.m_text.size(), prefix.m_text) == 0;
+}
+
+bool String::endsWith(const String &suffix) const {
+    return m_text.size() >= suffix.m_text.size() &&
+           m_text.compare(m_text.size() - suffix.m_text.size(), suffix.m_text.size(), suffix.m_text) == 0;
+}
+
+// ==================== PRINT / STREAM ====================
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+    size_t count = 0;
+    while (size--) {
+        count += write(*buffer++);
+    }
+    return count;
+}
+
+size_t Print::print(const char *text) {
+    return write(text);
+}
+
+size_t Print::print(const __FlashStringHelper *text) {
+    return write(reinterpret_cast<const char *>(text));
+}
+
+size_t Print::print(const String &text) {
+    return write(text.c_str(), text.length());
+}
+
+size_t Print::print(char c) {
+    return write(static_cast<uint8_t>(c));
+}
+
+size_t Print::print(unsigned char value, int base) {
+    return printNumber(value, base);
+}
+
+size_t Print::print(int value, int base) {
+    return print(static_cast<long>(value), base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+    return printNumber(value, base);
+}
+
+size_t Print::print(long value, int base) {
+    char buffer[NUMBER_BUFFER];
+    return write(formatSignedDigits(buffer, value, base));
+}
+
+size_t Print::print(unsigned long value, int base) {
+    return printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits) {
+    char buffer[48];
+    int  length = snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+}
+
+size_t Print::println() {
+    return write("\r\n");
+}
+
+size_t Print::printNumber(unsigned long value, int base) {
+    char buffer[NUMBER_BUFFER];
+    return write(formatDigits(buffer, value, base));
+}
+
+int Stream::timedRead() {
+    unsigned long start = millis();
+    do {
+        int c = read();
+        if (c >= 0) {
+            return c;
+        }
+        yield();
+    } while (millis() - start < m_timeout);
+    return -1;
+}
+
+String Stream::readString() {
+    String text;
+    int    c;
+    while ((c = timedRead()) >= 0) {
+        text += static_cast<char>(c);
+    }
+    return text;
+}
+
+String Stream::readStringUntil(char terminator) {
+    String text;
+    int    c;
+    while ((c = timedRead()) >= 0 && c != terminator) {
+        text += static_cast<char>(c);
+    }
+    return text;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+    size_t count = 0;
+    while (count < length) {
+        int c = timedRead();
+        if (c < 0) {
+            break;
+        }
+        buffer[count++] = static_cast<char>(c);
+    }
+    return count;
+}
+
+// ==================== SERIAL ====================
+
+void HardwareSerial::begin(unsigned long) {
+}
+
+void HardwareSerial::end() {
+    flush();
+}
+
+int HardwareSerial::available() {
+    int pending = 0;
+    if (ioctl(g_master, FIONREAD, &pending) < 0) {
+        pending = 0;
+    }
+    return pending + (g_peeked >= 0 ? 1 : 0);
+}
+
+int HardwareSerial::read() {
+    if (g_peeked >= 0) {
+        int c    = g_peeked;
+        g_peeked = -1;
+        return c;
+    }
+
+    pollfd ready = {g_master, POLLIN, 0};
+    if (poll(&ready, 1, 0) <= 0) {
+        return -1;
+    }
+    uint8_t c;
+    return ::read(g_master, &c, 1) == 1 ? c : -1;
+}
+
+int HardwareSerial::peek() {
+    if (g_peeked < 0) {
+        g_peeked = read();
+    }
+    return g_peeked;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    maskTimer();
+    if (g_txLength == TX_BUFFER) {
+        waitTx(TX_BUFFER - 1);
+    }
+    g_tx[g_txLength++] = static_cast<char>(g_bitErrorRate > 0.0 ? addNoise(c) : c);
+    unmaskTimer();
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+    maskTimer();
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    unmaskTimer();
+    return size;
+}
+
+int HardwareSerial::availableForWrite() {
+    drainTx(); // The UART keeps sending while the sketch checks
+    return static_cast<int>(TX_BUFFER - g_txLength);
+}
+
+void HardwareSerial::flush() {
+    maskTimer();
+    waitTx(0);
+    unmaskTimer();
+}
+
+// ==================== SIMULATED DMA ====================
+
+void simTxDmaStart(const uint8_t *data, uint16_t length) {
+    maskTimer();
+    for (uint16_t i = 0; i < length; i++) {
+        g_dma[i] = static_cast<char>(g_bitErrorRate > 0.0 ? addNoise(data[i]) : data[i]);
+    }
+    g_dmaLength = length;
+    g_dmaSent   = 0;
+    g_dmaTransfers++;
+    g_dmaBytes += length;
+    drainTx();
+    unmaskTimer();
+}
+
+bool simTxDmaBusy() {
+    drainTx(); // The channel keeps sending while the sketch checks
+    return g_dmaSent < g_dmaLength;
+}
+
+void simTxDmaWait() {
+    maskTimer();
+    waitDma();
+    unmaskTimer();
+}
+
+// ==================== ENTRY POINT ====================
+
+int main(int argc, char **argv) {
+    bool waitOpen = false;
+
+    int option;
+    while ((option = getopt(argc, argv, "x:l:t:r:wsz:e:")) != -1) {
+        switch (option) {
+            case 'x': g_factor = atof(optarg); break;
+            case 'l': g_link = optarg; break;
+            case 't': g_stopUs = static_cast<uint64_t>(atof(optarg) * 1000000.0); break;
+            case 'r':
+                g_random.seed(static_cast<std::mt19937::result_type>(strtoul(optarg, nullptr, 10)));
+                g_noise.seed(static_cast<std::mt19937::result_type>(strtoul(optarg, nullptr, 10)));
+                break;
+            case 'w': waitOpen = true; break;
+            case 's': g_sleepStats = true; break;
+            case 'z': {
+                char *end;
+                g_holdFromUs = static_cast<uint64_t>(strtod(optarg, &end) * 1000000.0);
+                g_holdToUs   = g_holdFromUs + static_cast<uint64_t>((*end == ',' ? atof(end + 1) : 0.0) * 1000000.0);
+                break;
+            }
+            case 'e': g_bitErrorRate = atof(optarg); break;
+            default: usage(argv[0]); return 2;
+        }
+    }
+    if (g_bitErrorRate < 0.0 || g_bitErrorRate >= 1.0) {
+        usage(argv[0]);
+        return 2;
+    }
+    if (g_bitErrorRate > 0.0) {
+        g_bitsToError = nextBitError();
+    }
+
+    struct sigaction action = {};
+    action.sa_handler       = onSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    if (!openPty()) {
+        return 1;
+    }
+
+    int watch = waitOpen ? watchForHost() : -1;
+    if (waitOpen && watch < 0) {
+        return 1;
+    }
+    printf("PTY %s\n", ptsname(g_master));
+    fflush(stdout);
+
+    if (waitOpen && !waitForHost(watch)) {
+        shutdown();
+    }
+
+    g_originNs = monotonicNs();
+    setup();
+    for (;;) {
+        loop();
+        drainTx();
+        checkStop();
+    }
+}
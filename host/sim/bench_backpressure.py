@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+Stalled-link benchmark for the TX queue of the Arduino library.
+
+Runs a simulator built from example_backpressure (or any sketch that
+enables clock sync), holds its transmitter for a while with -z, and
+reads the port like a host that answers pings. Reports:
+
+- memory: the largest queue depth the sketch reported (# tx max N)
+- staleness: how long after its device time each event arrived, per
+  class, for events generated after the stall began
+- edge integrity: every press followed by its release, in order
+- whether the sketch itself stalled (the slowest loop() it reported)
+
+Events older than the queue's age limit can only come from the UART's
+own transmit buffer (filled just before the stall) or be edges, which
+are never dropped; they are counted separately.
+
+Usage: python host/sim/bench_backpressure.py [-b BINARY] [-s START] [-d SECONDS] [-t SECONDS] [-a MS]
+
+Author: Leonardo Klein
+"""
+
+import argparse
+import os
+import select
+import subprocess
+import sys
+import tempfile
+import termios
+import time
+import tty
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "src"))
+
+from clock_sync import ClockSync  # noqa: E402
+from protocol_decoder import DEVICE_KEYBOARD, DEVICE_MOUSE, PythonDecoder  # noqa: E402
+
+MOUSE_PRESSES = {0: "right", 2: "left", 4: "middle"}
+MOUSE_RELEASES = {1: "right", 3: "left", 5: "middle"}
+MOTION_EVENTS = (7, 8)
+SCROLL_EVENT = 6
+
+
+def event_class(item) -> str:
+    """
+    Name the TX class of a decoded event.
+
+    :param item: Decoded event tuple
+    :return: "motion", "scroll" or "edge"
+    """
+    device, event = item[0], item[1]
+    if device == DEVICE_MOUSE and event in MOTION_EVENTS:
+        return "motion"
+    if device == DEVICE_MOUSE and event == SCROLL_EVENT:
+        return "scroll"
+    return "edge"
+
+
+def percentile(values: list, fraction: float) -> float:
+    """Nearest-rank percentile of a non-empty list."""
+    ordered = sorted(values)
+    return ordered[min(int(fraction * len(ordered)), len(ordered) - 1)]
+
+
+def run(binary: str, stall_at: float, stall: float, duration: float, max_age_ms: float) -> int:
+    """
+    Run one stalled-link session and print its figures.
+
+    :return: Exit status (1 on an edge integrity violation)
+    """
+    link = os.path.join(tempfile.mkdtemp(), "pty")
+    sim = subprocess.Popen(
+        [binary, "-w", "-l", link, "-t", str(duration), "-z", f"{stall_at},{stall}"],
+        stdout=subprocess.PIPE,
+    )
+    sim.stdout.readline()  # PTY <path>
+    fd = os.open(link, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+    termios.tcflush(fd, termios.TCIOFLUSH)
+    started_ns = time.monotonic_ns()
+
+    decoder = PythonDecoder()
+    clock = ClockSync()
+    stall_ns = started_ns + int(stall_at * 1e9)
+    staleness = {"motion": [], "scroll": [], "edge": []}
+    held = set()
+    violations = []
+    reports = []
+    events = 0
+
+    while sim.poll() is None:
+        ready, _, _ = select.select([fd], [], [], 0.1)
+        if not ready:
+            continue
+        try:
+            data = os.read(fd, 4096)
+        except OSError:
+            break
+        received_ns = time.monotonic_ns()
+
+        for item in decoder.feed(data):
+            if isinstance(item, str):
+                if item.startswith("~"):
+                    answer = clock.handle_line(item, received_ns)
+                    if answer:
+                        os.write(fd, answer)
+                elif item.startswith("# tx"):
+                    reports.append(item.strip())
+                continue
+
+            events += 1
+            device, event, param1 = item[0], item[1], item[2]
+            if device == DEVICE_KEYBOARD:
+                name = ("key", param1)
+                pressed = event == 1
+            elif event in MOUSE_PRESSES or event in MOUSE_RELEASES:
+                name = ("button", MOUSE_PRESSES.get(event) or MOUSE_RELEASES.get(event))
+                pressed = event in MOUSE_PRESSES
+            else:
+                name = None
+            if name is not None:
+                if pressed == (name in held):
+                    violations.append(f"{'press' if pressed else 'release'} of {name} out of order")
+                (held.add if pressed else held.discard)(name)
+
+            if len(item) >= 5 and clock.synced:
+                generated_ns = clock.to_host_ns(item[4])
+                if generated_ns >= stall_ns:
+                    staleness[event_class(item)].append((received_ns - generated_ns) / 1e6)
+
+    os.close(fd)
+    sim.wait()
+
+    print(f"{events} events, transmitter held {stall:g} s from {stall_at:g} s")
+    for report in reports:
+        print(f"  device {report[2:]}")
+    for name, values in staleness.items():
+        if values:
+            older = sum(value > max_age_ms for value in values)
+            print(
+                f"  {name:6} staleness ms  p50 {percentile(values, 0.5):8.1f}"
+                f"  p99 {percentile(values, 0.99):8.1f}  max {max(values):8.1f}"
+                f"  ({len(values)} events, {older} over {max_age_ms:g} ms)"
+            )
+    for violation in violations[:10]:
+        print(f"  EDGE VIOLATION: {violation}")
+    if held:
+        print(f"  still held at the end: {sorted(held)}")
+    print("  edges intact" if not violations else f"  {len(violations)} edge violations")
+    return 1 if violations else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Stalled-link benchmark for the TX queue")
+    parser.add_argument("-b", "--binary", default="sim-build/example_backpressure-sim", help="simulator binary")
+    parser.add_argument("-s", "--stall-at", type=float, default=4.0, help="stall start (simulated seconds)")
+    parser.add_argument("-d", "--stall", type=float, default=3.0, help="stall length in seconds")
+    parser.add_argument("-t", "--duration", type=float, default=10.0, help="run length in seconds")
+    parser.add_argument("-a", "--max-age", type=float, default=250.0, help="age limit of the sketch's queue in ms")
+    args = parser.parse_args()
+    sys.exit(run(args.binary, args.stall_at, args.stall, args.duration, args.max_age))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""
+Goodput versus bit error rate of the three framings.
+
+Runs a simulator built from example_noisy_link once per bit error rate
+(-e), in virtual time, and decodes what arrives with the reference
+decoder. The sketch sends a block of absolute positions plain, one with
+a CRC and one FEC-coded; position n is known, so every decoded event is
+either intact or wrong. Reports per framing and rate:
+
+- intact: events that arrived as sent
+- wrong: events that decoded to something that was never sent
+  (undetected errors; what the framing is there to prevent)
+- bytes: average line length on the wire
+- goodput: intact events per second at 115200 baud (8N1)
+
+When sim_native is built, its decoder is fed the same bytes and must
+return the same items.
+
+Usage: python host/sim/bench_framing.py [-b BINARY] [-e RATE ...] [-n BLOCK] [-s SEED]
+
+Author: Leonardo Klein
+"""
+
+import argparse
+import os
+import select
+import subprocess
+import sys
+import tempfile
+import termios
+import time
+import tty
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "src"))
+
+from protocol_decoder import PythonDecoder, sim_native  # noqa: E402
+
+FRAMINGS = ("plain", "crc", "fec")
+BYTES_PER_SECOND = 115200 / 10
+DEFAULT_RATES = (0.0, 1e-5, 1e-4, 1e-3, 3e-3, 1e-2)
+
+
+def position(index: int) -> tuple:
+    """Event the sketch sends as its index-th position."""
+    return (0, 7, index * 37 % 1920, index * 53 % 1080)
+
+
+def wire_length(event: tuple, framing: str) -> int:
+    """
+    Bytes of an event line on the wire.
+
+    :param event: (device, event, param1, param2)
+    :param framing: "plain", "crc" or "fec"
+    :return: Length with terminator
+    """
+    fields = [str(value) for value in event[:2]]
+    if event[2] or event[3]:
+        fields.append(str(event[2]))
+    if event[3]:
+        fields.append(str(event[3]))
+    text = len(" ".join(fields))
+    if framing == "plain":
+        return text + 2
+    if framing == "crc":
+        return text + 8
+    return 2 + 2 * (text + 2)
+
+
+def receive(binary: str, rate: float, seed: int, timeout: float) -> tuple:
+    """
+    Run the sketch over a noisy link and collect what arrives.
+
+    :return: (raw bytes, noise report of the simulator)
+    """
+    link = os.path.join(tempfile.mkdtemp(), "pty")
+    sim = subprocess.Popen(
+        [binary, "-x", "0", "-w", "-l", link, "-r", str(seed), "-e", repr(rate)],
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+    )
+    sim.stdout.readline()  # PTY <path>
+    fd = os.open(link, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+
+    received = bytearray()
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        ready, _, _ = select.select([fd], [], [], 0.1)
+        if not ready:
+            continue
+        try:
+            data = os.read(fd, 4096)
+        except OSError:
+            break
+        received += data
+        if b"# done" in received[-64:]:
+            break
+
+    sim.terminate()
+    _, errors = sim.communicate()
+    os.close(fd)
+    report = next((line for line in errors.decode().splitlines() if line.startswith("noise:")), "")
+    return bytes(received), report
+
+
+def decode(data: bytes) -> tuple:
+    """
+    Decode with the reference decoder and, when built, the native one.
+
+    :return: (items, (corrected bits, rejected lines), decoders agree or None)
+    """
+    decoder = PythonDecoder()
+    items = []
+    for start in range(0, len(data), 256):
+        items += decoder.feed(data[start : start + 256])
+
+    agree = None
+    if sim_native is not None:
+        native = sim_native.Decoder()
+        native_items = []
+        for start in range(0, len(data), 256):
+            native_items += native.feed(data[start : start + 256])
+        agree = native_items == items and native.framing_stats() == decoder.framing_stats()
+    return items, decoder.framing_stats(), agree
+
+
+def score(items: list, block: int) -> dict:
+    """
+    Count intact and wrong events per framing.
+
+    Decoded events are matched in order against the sent positions
+    (all distinct); one that is not still to come is wrong and counts
+    against the framing of the block in progress.
+    """
+    expected = [position(index) for index in range(3 * block)]
+    indices = {event: index for index, event in enumerate(expected)}
+    counts = {name: {"sent": 0, "intact": 0, "wrong": 0, "bytes": 0} for name in FRAMINGS}
+    for index, event in enumerate(expected):
+        framing = FRAMINGS[index // block]
+        counts[framing]["sent"] += 1
+        counts[framing]["bytes"] += wire_length(event, framing)
+
+    cursor = 0
+    for item in items:
+        if not isinstance(item, tuple):
+            continue
+        index = indices.get(tuple(item[:4]), -1)
+        if index >= cursor:
+            counts[FRAMINGS[index // block]]["intact"] += 1
+            cursor = index + 1
+        else:
+            counts[FRAMINGS[min(cursor, len(expected) - 1) // block]]["wrong"] += 1
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Goodput versus bit error rate of the framings")
+    parser.add_argument("-b", "--binary", default="sim-build/example_noisy_link-sim", help="simulator binary")
+    parser.add_argument("-e", "--rates", type=float, nargs="+", default=DEFAULT_RATES, help="bit error rates")
+    parser.add_argument("-n", "--block", type=int, default=2000, help="positions per framing (BLOCK of the sketch)")
+    parser.add_argument("-s", "--seed", type=int, default=1, help="noise seed")
+    parser.add_argument("-t", "--timeout", type=float, default=60.0, help="give up on a run after SECONDS")
+    args = parser.parse_args()
+
+    print(f"{'BER':>8}  {'framing':7} {'intact %':>9} {'wrong':>6} {'bytes':>6} {'goodput/s':>10}")
+    status = 0
+    for rate in args.rates:
+        data, report = receive(args.binary, rate, args.seed, args.timeout)
+        items, (corrected, rejected), agree = decode(data)
+        counts = score(items, args.block)
+        for name in FRAMINGS:
+            count = counts[name]
+            intact = count["intact"] / count["sent"] if count["sent"] else 0.0
+            length = count["bytes"] / count["sent"] if count["sent"] else 0.0
+            goodput = intact * BYTES_PER_SECOND / length if length else 0.0
+            print(
+                f"{rate:8.0e}  {name:7} {100 * intact:9.2f} {count['wrong']:6d}"
+                f" {length:6.1f} {goodput:10.0f}"
+            )
+        notes = [report or "noise: none", f"{corrected} bits corrected", f"{rejected} lines rejected"]
+        if agree is not None:
+            notes.append("native decoder agrees" if agree else "NATIVE DECODER DIFFERS")
+            status |= 0 if agree else 1
+        print(f"{'':8}  ({', '.join(notes)})")
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,146 @@
+#!/usr/bin/env python3
+"""
+Wire cost of typed text with and without a text window.
+
+Runs a simulator built from example_text_window in virtual time. The
+sketch types the same entries as key events, then as text lines
+through a 128, 256 and 512 byte window. Every pass is decoded with the
+reference decoder and must give exactly the key events of the first;
+when sim_native is built, its decoder must agree too. Reports per pass:
+
+- bytes/char: wire bytes per character typed
+- vs keys: wire bytes relative to the key event pass
+- payload: payload bytes per character (1.0 without back-references)
+- compares/char: window bytes compared per character by the encoder
+- AVR us/char: estimated encode time on a 16 MHz AVR, from the
+  compares and AVR_CYCLES_PER_COMPARE (an instruction count of the
+  search loop, not a measurement)
+
+Usage: python host/sim/bench_text.py [-b BINARY] [-t TIMEOUT]
+
+Author: Leonardo Klein
+"""
+
+import argparse
+import os
+import select
+import subprocess
+import sys
+import tempfile
+import time
+import tty
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "src"))
+
+from protocol_decoder import PythonDecoder, sim_native  # noqa: E402
+
+AVR_CYCLES_PER_COMPARE = 18
+AVR_MHZ = 16
+
+
+def receive(binary: str, timeout: float) -> bytes:
+    """Run the sketch until it reports done and return what it sent."""
+    link = os.path.join(tempfile.mkdtemp(), "pty")
+    sim = subprocess.Popen([binary, "-x", "0", "-w", "-l", link], stdout=subprocess.PIPE)
+    sim.stdout.readline()  # PTY <path>
+    fd = os.open(link, os.O_RDWR | os.O_NOCTTY)
+    tty.setraw(fd)
+
+    received = bytearray()
+    deadline = time.monotonic() + timeout
+    while time.monotonic() < deadline:
+        ready, _, _ = select.select([fd], [], [], 0.1)
+        if not ready:
+            continue
+        try:
+            data = os.read(fd, 4096)
+        except OSError:
+            break
+        received += data
+        if b"# done" in received[-64:]:
+            break
+
+    sim.terminate()
+    sim.wait()
+    os.close(fd)
+    return bytes(received)
+
+
+def split_passes(data: bytes) -> list:
+    """
+    Cut the output at the "# window N" lines.
+
+    :return: List of (window size, bytes of the pass, stats fields)
+    """
+    passes = []
+    for line in data.split(b"\n"):
+        text = line.rstrip(b"\r")
+        if text.startswith(b"# window "):
+            passes.append([int(text[9:]), bytearray(), []])
+        elif text.startswith(b"# stats ") and passes:
+            passes[-1][2] = [int(field) for field in text[8:].split()[1:]]
+        elif passes and line and not text.startswith(b"#"):
+            passes[-1][1] += line + b"\n"
+    return passes
+
+
+def decode(data: bytes) -> tuple:
+    """
+    Decode one pass with a fresh reference decoder and, when built, the native one.
+
+    :return: (key events, decoders agree or None)
+    """
+    decoder = PythonDecoder()
+    items = []
+    for start in range(0, len(data), 256):
+        items += decoder.feed(data[start : start + 256])
+
+    agree = None
+    if sim_native is not None:
+        native = sim_native.Decoder()
+        native_items = []
+        for start in range(0, len(data), 256):
+            native_items += native.feed(data[start : start + 256])
+        agree = native_items == items
+    return [item for item in items if isinstance(item, tuple)], agree
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Wire cost of typed text with and without a text window")
+    parser.add_argument("-b", "--binary", default="sim-build/example_text_window-sim", help="simulator binary")
+    parser.add_argument("-t", "--timeout", type=float, default=60.0, help="give up after SECONDS")
+    args = parser.parse_args()
+
+    passes = split_passes(receive(args.binary, args.timeout))
+    if len(passes) < 2:
+        sys.exit("the sketch did not finish its passes")
+
+    reference, _ = decode(bytes(passes[0][1]))
+    key_bytes = len(passes[0][1])
+    characters = sum(1 for event in reference if event[1] == 1 and event[2] != 0xA0)
+
+    print(
+        f"{'window':>6} {'bytes':>7} {'bytes/char':>10} {'vs keys':>8} {'payload':>8}"
+        f" {'compares/char':>13} {'AVR us/char':>11}  check"
+    )
+    status = 0
+    for size, data, stats in passes:
+        events, agree = decode(bytes(data))
+        notes = ["same key events" if events == reference else "KEY EVENTS DIFFER"]
+        if agree is not None:
+            notes.append("native decoder agrees" if agree else "NATIVE DECODER DIFFERS")
+        status |= 0 if events == reference and agree is not False else 1
+
+        line = f"{size:6d} {len(data):7d} {len(data) / characters:10.2f} {len(data) / key_bytes:8.3f}"
+        if stats:
+            chars, payload, _, compares = stats
+            avr_us = compares / chars * AVR_CYCLES_PER_COMPARE / AVR_MHZ
+            line += f" {payload / chars:8.3f} {compares / chars:13.1f} {avr_us:11.1f}"
+        else:
+            line += f" {'-':>8} {'-':>13} {'-':>11}"
+        print(f"{line}  {', '.join(notes)}")
+    sys.exit(status)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Build Arduino sketches as native device simulators.
+
+Does what the Arduino IDE does before compiling a sketch (include
+Arduino.h, declare prototypes for the functions defined in the .ino,
+find headers next to the sketch), then links it with the library and the simulator runtime in host/sim.
+
+Usage: python host/sim/build_sketches.py [-o DIR] [SKETCH.ino ...]
+
+Without sketches, every example under arduino/examples/ is built, except
+those in SKIPPED_EXAMPLES; the exit status is 1 if one failed. Binaries
+are named <sketch>-sim; run one with -h for its options.
+
+Author: Leonardo Klein
+"""
+
+import argparse
+import glob
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".."))
+SIM_DIR = os.path.join(ROOT, "host", "sim")
+LIBRARY_DIR = os.path.join(ROOT, "arduino")
+
+# Examples the default run leaves out, with the reason it prints; naming one builds it anyway
+SKIPPED_EXAMPLES = {
+    "example_using_library": "calls monitor.begin() and processIncomingData(), which the library does not have",
+}
+
+# Top-level function definition: "type name(args) {" at column 0
+FUNCTION_RE = re.compile(
+    r"^(?!(?:if|else|for|while|switch|return|static_assert)\b)"
+    r"([A-Za-z_][\w:<>,\s\*&]*?[\s\*&])([A-Za-z_]\w*)\s*\(([^;{}]*)\)\s*(?:const\s*)?\{",
+    re.MULTILINE,
+)
+
+
+def prototypes(source: str) -> list:
+    """
+    Collect prototypes for the functions defined in a sketch.
+
+    :param source: Sketch source
+    :return: Prototype declarations
+    """
+    result = []
+    for match in FUNCTION_RE.finditer(source):
+        return_type, name, args = match.groups()
+        if name in ("setup", "loop"):
+            continue
+        args = re.sub(r"\s*=\s*[^,]+", "", args)  # defaults stay on the definition
+        result.append(f"{' '.join(return_type.split())} {name}({' '.join(args.split())});")
+    return result
+
+
+def translate(path: str) -> str:
+    """
+    Turn a .ino into a C++ translation unit.
+
+    :param path: Sketch path
+    :return: C++ source
+    """
+    with open(path, encoding="utf-8") as handle:
+        source = handle.read()
+
+    # Prototypes go after the sketch's own includes, like the Arduino IDE does
+    lines = source.splitlines(keepends=True)
+    last_include = 0
+    for index, line in enumerate(lines):
+        if line.lstrip().startswith("#include"):
+            last_include = index + 1
+
+    head = "".join(lines[:last_include])
+    body = "".join(lines[last_include:])
+    return (
+        "#include <Arduino.h>\n"
+        f'#line 1 "{path}"\n{head}'
+        + "\n".join(prototypes(body))
+        + f'\n#line {last_include + 1} "{path}"\n{body}'
+    )
+
+
+def build(sketch: str, output_dir: str, cxx: str) -> bool:
+    """
+    Compile one sketch.
+
+    :return: True on success
+    """
+    name = os.path.splitext(os.path.basename(sketch))[0]
+    target = os.path.join(output_dir, f"{name}-sim")
+
+    with tempfile.NamedTemporaryFile("w", suffix=".cpp", delete=False) as unit:
+        unit.write(translate(sketch))
+
+    command = [
+        cxx, "-std=gnu++17", "-O2", "-pthread",
+        "-I", SIM_DIR, "-I", LIBRARY_DIR,
+        "-I", os.path.dirname(os.path.abspath(sketch)),
+        unit.name,
+        os.path.join(SIM_DIR, "ArduinoSim.cpp"),
+        *sorted(glob.glob(os.path.join(LIBRARY_DIR, "*.cpp"))),
+        "-o", target,
+    ]
+    result = subprocess.run(command, capture_output=True, text=True)
+    os.unlink(unit.name)
+
+    if result.returncode != 0:
+        print(f"FAILED  {name}\n{result.stderr.strip()}\n", file=sys.stderr)
+        return False
+    print(f"built   {target}")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build sketches as native device simulators")
+    parser.add_argument("sketches", nargs="*", help=".ino files (default: all examples)")
+    parser.add_argument("-o", "--output", default="sim-build", help="output directory")
+    parser.add_argument("--cxx", default=os.environ.get("CXX", "g++"), help="C++ compiler")
+    args = parser.parse_args()
+
+    sketches = args.sketches
+    if not sketches:
+        examples = os.path.join(LIBRARY_DIR, "examples")
+        sketches = []
+        for name in sorted(os.listdir(examples)):
+            if not os.path.isfile(os.path.join(examples, name, f"{name}.ino")):
+                continue
+            if name in SKIPPED_EXAMPLES:
+                print(f"skipped {name}: {SKIPPED_EXAMPLES[name]}")
+                continue
+            sketches.append(os.path.join(examples, name, f"{name}.ino"))
+
+    os.makedirs(args.output, exist_ok=True)
+    failures = sum(not build(sketch, args.output, args.cxx) for sketch in sketches)
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
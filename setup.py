@@ -7,7 +7,26 @@ Author: Leonardo Klein
 Date: 2025
 """
 
-from setuptools import setup, find_packages
+import os
+
+from setuptools import Extension, setup, find_packages
+
+# Native protocol decoder (all platforms) and serial reader (POSIX); the
+# app falls back to pyserial and the Python decoder when it is not built.
+native_sources = ["host/SimNativeModule.cpp", "host/ProtocolDecoder.cpp"]
+if os.name == "posix":
+    native_sources += ["host/SerialReader.cpp", "host/SerialPort.cpp"]
+
+native_extensions = [
+    Extension(
+        "sim_native",
+        sources=native_sources,
+        include_dirs=["host", "arduino"],
+        extra_compile_args=["/std:c++17", "/O2"] if os.name == "nt" else ["-std=c++17", "-O2"],
+        language="c++",
+        optional=True,
+    )
+]
 
 setup(
     name="serial-input-monitor",
@@ -27,6 +46,7 @@ setup(
     },
     package_dir={"": "src"},
     packages=find_packages(where="src"),
+    ext_modules=native_extensions,
     python_requires=">=3.8",
     install_requires=[
         "pyserial>=3.5",
@@ -0,0 +1,147 @@
+"""
+Device/host clock synchronisation for the Serial Input Monitor protocol.
+Answers the device's ~P pings and maps the @TIME stamps of its events to
+time.monotonic_ns(), with the same integer estimator as host/ClockSync.cpp:
+
+- each ~P / ~A / ~R exchange gives one sample: the device midpoint
+  (T1 + T4) / 2 matches the host midpoint (T2 + T3) / 2, with a delay of
+  (T4 - T1) - (T3 - T2)
+- the lowest-delay sample of the newest quarter of the window anchors the
+  mapping; its slope to the lowest-delay sample of the oldest quarter
+  gives the drift in parts per billion
+
+Author: Leonardo Klein
+"""
+
+import time
+
+from protocol_decoder import SYNC_PREFIX
+
+WINDOW = 32
+MIN_DRIFT_SPAN_US = 2_000_000
+MAX_DRIFT_DIVISOR = 50
+RESTART_SLACK_NS = 20_000_000
+
+
+def _wrap32(value: int) -> int:
+    """Interpret a 32-bit difference as signed."""
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+class ClockSync:
+    """
+    Clock offset and drift estimator for one device.
+    """
+
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        """Forget all samples (e.g. when the port is reopened)."""
+        self.pending = {}
+        self.window = []
+        self.anchor = None
+        self.drift_ppb = 0
+        self.samples = 0
+
+    @property
+    def synced(self) -> bool:
+        """True once an exchange has completed."""
+        return self.anchor is not None
+
+    def handle_line(self, line: str, received_ns: int):
+        """
+        Handle a sync line from the device.
+
+        :param line: Line starting with '~'
+        :param received_ns: time.monotonic_ns() when the line was read
+        :return: Answer bytes to write to the port right away, or None
+        """
+        parts = line.strip()[1:].split()
+        if not line.strip().startswith(SYNC_PREFIX) or not parts or len(parts[0]) != 1:
+            return None
+        try:
+            fields = [int(part, 16) for part in parts[1:]]
+        except ValueError:
+            return None
+        if not fields or not 0 <= fields[0] <= 0xFF:
+            return None
+
+        kind, seq = parts[0], fields[0]
+        if kind == "P":
+            self.pending[seq & 3] = (seq, received_ns, time.monotonic_ns())
+            return f"{SYNC_PREFIX}A {seq:X}\n".encode("ascii")
+
+        if kind == "R" and len(fields) >= 3:
+            pending = self.pending.pop(seq & 3, None)
+            if pending is not None and pending[0] == seq:
+                self._add_sample(pending[1], pending[2], fields[1], fields[2])
+        return None
+
+    def to_host_ns(self, device_us: int) -> int:
+        """
+        Map a device timestamp to host time.
+
+        :param device_us: Device micros() from an event's @TIME token
+        :return: time.monotonic_ns() value (meaningless before synced)
+        """
+        anchor_us, anchor_ns, _ = self.anchor
+        elapsed_us = _wrap32(device_us - anchor_us)
+        drift_ns = _div(elapsed_us * self.drift_ppb, 1_000_000)
+        return anchor_ns + elapsed_us * 1000 + drift_ns
+
+    def _add_sample(
+        self, received_ns: int, answered_ns: int, ping_us: int, answer_us: int
+    ):
+        round_trip_us = (answer_us - ping_us) & 0xFFFFFFFF
+        turnaround = answered_ns - received_ns
+        host_ns = received_ns + turnaround // 2
+        delay_ns = max(round_trip_us * 1000 - turnaround, 0)
+        device_us = ping_us + round_trip_us // 2
+
+        if self.window:
+            last_us, last_ns, last_delay_ns = self.window[-1]
+            elapsed_us = _wrap32(device_us - last_us)
+            device_us = last_us + elapsed_us
+            host_elapsed_ns = host_ns - last_ns
+            disagreement = abs(host_elapsed_ns - elapsed_us * 1000)
+            tolerance = (
+                RESTART_SLACK_NS
+                + host_elapsed_ns // MAX_DRIFT_DIVISOR
+                + delay_ns
+                + last_delay_ns
+            )
+            if elapsed_us < 0 or disagreement > tolerance:
+                self.reset()
+                device_us = ping_us + round_trip_us // 2
+
+        self.window.append((device_us, host_ns, delay_ns))
+        del self.window[:-WINDOW]
+        self.samples += 1
+
+        quarter = max(len(self.window) // 4, 1)
+        self.anchor = _best(self.window[-quarter:])
+        if len(self.window) < 2:
+            return
+
+        base = _best(self.window[:quarter])
+        span = self.anchor[0] - base[0]
+        if span >= MIN_DRIFT_SPAN_US:
+            error = (self.anchor[1] - base[1]) - span * 1000
+            self.drift_ppb = _div(error * 1_000_000, span)
+
+
+def _best(samples: list):
+    """Lowest-delay sample, the newest one on ties."""
+    best = samples[0]
+    for sample in samples[1:]:
+        if sample[2] <= best[2]:
+            best = sample
+    return best
+
+
+def _div(numerator: int, denominator: int) -> int:
+    """Integer division truncating toward zero, as in C++."""
+    quotient = abs(numerator) // abs(denominator)
+    return quotient if (numerator < 0) == (denominator < 0) else -quotient
@@ -1,46 +1,12 @@
 """
 Key mappings for Serial Input Monitor.
 Contains all keyboard key code mappings for both technical and friendly names.
+Technical names are the VirtualKey names generated into key_names.py.
 
 Author: Leonardo Klein
 """
 
-# Technical key names mapping (hexadecimal code to technical name)
-TECHNICAL_KEY_MAP = {
-    "08": "BACKSPACE",
-    "09": "TAB",
-    "0D": "ENTER",
-    "10": "SHIFT",
-    "11": "CTRL",
-    "12": "ALT",
-    "13": "PAUSE",
-    "14": "CAPS_LOCK",
-    "1B": "ESC",
-    "20": "SPACE",
-    "21": "PAGE_UP",
-    "22": "PAGE_DOWN",
-    "23": "END",
-    "24": "HOME",
-    "25": "LEFT_ARROW",
-    "26": "UP_ARROW",
-    "27": "RIGHT_ARROW",
-    "28": "DOWN_ARROW",
-    "2C": "PRINT_SCREEN",
-    "2D": "INSERT",
-    "2E": "DELETE",
-    "70": "F1",
-    "71": "F2",
-    "72": "F3",
-    "73": "F4",
-    "74": "F5",
-    "75": "F6",
-    "76": "F7",
-    "77": "F8",
-    "78": "F9",
-    "79": "F10",
-    "7A": "F11",
-    "7B": "F12",
-}
+from key_names import KEY_NAMES
 
 # User-friendly key names mapping (hexadecimal code to friendly name)
 FRIENDLY_KEY_MAP = {
@@ -201,19 +167,14 @@ def get_technical_key_name(key_code: str) -> str:
     Get technical key name from hexadecimal code.
 
     :param key_code: Hexadecimal key code
-    :return: Technical key name
+    :return: VirtualKey name
     """
-    key_map = TECHNICAL_KEY_MAP.copy()
-
-    # Add numeric keys 0-9
-    for i in range(10):
-        key_map[f"{48 + i:02X}"] = str(i)
-
-    # Add letters A-Z
-    for i in range(26):
-        key_map[f"{65 + i:02X}"] = chr(65 + i)
-
-    return key_map.get(key_code.upper(), f"KEY_{key_code}")
+    try:
+        code = int(key_code, 16)
+    except ValueError:
+        code = -1
+    name = KEY_NAMES[code] if 0 <= code < len(KEY_NAMES) else None
+    return name or f"KEY_{key_code}"
 
 
 def get_friendly_key_name(key_code: str) -> str:
@@ -241,7 +202,12 @@ def get_friendly_key_name(key_code: str) -> str:
     elif code_upper.startswith("16") and len(code_upper) == 3:
         return f"EXTENDED KEY ({code_upper})"
 
-    return friendly_map.get(code_upper, f"UNKNOWN KEY (0x{code_upper})")
+    if code_upper in friendly_map:
+        return friendly_map[code_upper]
+    technical = get_technical_key_name(code_upper)
+    if technical.startswith("KEY_"):
+        return f"UNKNOWN KEY (0x{code_upper})"
+    return technical.replace("_", " ")
 
 
 def get_keyboard_module_name(key_code: str) -> str:
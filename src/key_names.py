@@ -0,0 +1,249 @@
+"""
+VirtualKey names, generated by host/gen_key_names.py.
+
+Do not edit: change VirtualKey in arduino/SerialInputProtocol.h and
+run python host/gen_key_names.py. The C++ side has the same names in
+arduino/SerialInputKeyNames.cpp.
+
+Author: Leonardo Klein
+"""
+
+# Name of each key code, None for codes without a VirtualKey
+KEY_NAMES = (
+    None, None, None, None,
+    None, None, None, None,
+    "BACKSPACE", "TAB", None, None,
+    "CLEAR", "ENTER", None, None,
+    "SHIFT", "CONTROL", "ALT", "PAUSE",
+    "CAPS_LOCK", "KANA", "IME_ON", "JUNJA",
+    "FINAL", "HANJA", "IME_OFF", "ESCAPE",
+    "CONVERT", "NONCONVERT", "ACCEPT", "MODECHANGE",
+    "SPACE", "PAGE_UP", "PAGE_DOWN", "END",
+    "HOME", "ARROW_LEFT", "ARROW_UP", "ARROW_RIGHT",
+    "ARROW_DOWN", "SELECT", "PRINT", "EXECUTE",
+    "PRINT_SCREEN", "INSERT", "DELETE", "HELP",
+    "NUM_0", "NUM_1", "NUM_2", "NUM_3",
+    "NUM_4", "NUM_5", "NUM_6", "NUM_7",
+    "NUM_8", "NUM_9", None, None,
+    None, None, None, None,
+    None, "A", "B", "C",
+    "D", "E", "F", "G",
+    "H", "I", "J", "K",
+    "L", "M", "N", "O",
+    "P", "Q", "R", "S",
+    "T", "U", "V", "W",
+    "X", "Y", "Z", "LEFT_WIN",
+    "RIGHT_WIN", "APPS", None, "SLEEP",
+    "NUMPAD_0", "NUMPAD_1", "NUMPAD_2", "NUMPAD_3",
+    "NUMPAD_4", "NUMPAD_5", "NUMPAD_6", "NUMPAD_7",
+    "NUMPAD_8", "NUMPAD_9", "MULTIPLY", "ADD",
+    "SEPARATOR", "SUBTRACT", "DECIMAL", "DIVIDE",
+    "F1", "F2", "F3", "F4",
+    "F5", "F6", "F7", "F8",
+    "F9", "F10", "F11", "F12",
+    "F13", "F14", "F15", "F16",
+    "F17", "F18", "F19", "F20",
+    "F21", "F22", "F23", "F24",
+    None, None, None, None,
+    None, None, None, None,
+    "NUM_LOCK", "SCROLL_LOCK", None, None,
+    None, None, None, None,
+    None, None, None, None,
+    None, None, None, None,
+    "LEFT_SHIFT", "RIGHT_SHIFT", "LEFT_CONTROL", "RIGHT_CONTROL",
+    "LEFT_ALT", "RIGHT_ALT", "BROWSER_BACK", "BROWSER_FORWARD",
+    "BROWSER_REFRESH", "BROWSER_STOP", "BROWSER_SEARCH", "BROWSER_FAVORITES",
+    "BROWSER_HOME", "VOLUME_MUTE", "VOLUME_DOWN", "VOLUME_UP",
+    "MEDIA_NEXT_TRACK", "MEDIA_PREV_TRACK", "MEDIA_STOP", "MEDIA_PLAY_PAUSE",
+    "LAUNCH_MAIL", "LAUNCH_MEDIA_SELECT", "LAUNCH_APP1", "LAUNCH_APP2",
+    None, None, "OEM_1", "OEM_PLUS",
+    "OEM_COMMA", "OEM_MINUS", "OEM_PERIOD", "OEM_2",
+    "OEM_3", None, None, None,
+    None, None, None, None,
+    None, None, None, None,
+    None, None, None, None,
+    None, None, None, None,
+    None, None, None, None,
+    None, None, None, "OEM_4",
+    "OEM_5", "OEM_6", "OEM_7", "OEM_8",
+    None, None, "OEM_102", None,
+    None, "PROCESS_KEY", None, "PACKET",
+    None, None, None, None,
+    None, None, None, None,
+    None, None, None, None,
+    None, None, "ATTN", "CRSEL",
+    "EXSEL", "EREOF", "PLAY", "ZOOM",
+    None, "PA1", "OEM_CLEAR", None,
+)
+
+# Code of every VirtualKey name, aliases included
+KEY_CODES = {
+    "BACKSPACE": 0x08,
+    "TAB": 0x09,
+    "CLEAR": 0x0C,
+    "ENTER": 0x0D,
+    "SHIFT": 0x10,
+    "CONTROL": 0x11,
+    "ALT": 0x12,
+    "PAUSE": 0x13,
+    "CAPS_LOCK": 0x14,
+    "KANA": 0x15,
+    "HANGEUL": 0x15,
+    "HANGUL": 0x15,
+    "IME_ON": 0x16,
+    "JUNJA": 0x17,
+    "FINAL": 0x18,
+    "HANJA": 0x19,
+    "KANJI": 0x19,
+    "IME_OFF": 0x1A,
+    "ESCAPE": 0x1B,
+    "CONVERT": 0x1C,
+    "NONCONVERT": 0x1D,
+    "ACCEPT": 0x1E,
+    "MODECHANGE": 0x1F,
+    "SPACE": 0x20,
+    "PAGE_UP": 0x21,
+    "PAGE_DOWN": 0x22,
+    "END": 0x23,
+    "HOME": 0x24,
+    "ARROW_LEFT": 0x25,
+    "ARROW_UP": 0x26,
+    "ARROW_RIGHT": 0x27,
+    "ARROW_DOWN": 0x28,
+    "SELECT": 0x29,
+    "PRINT": 0x2A,
+    "EXECUTE": 0x2B,
+    "PRINT_SCREEN": 0x2C,
+    "INSERT": 0x2D,
+    "DELETE": 0x2E,
+    "HELP": 0x2F,
+    "NUM_0": 0x30,
+    "NUM_1": 0x31,
+    "NUM_2": 0x32,
+    "NUM_3": 0x33,
+    "NUM_4": 0x34,
+    "NUM_5": 0x35,
+    "NUM_6": 0x36,
+    "NUM_7": 0x37,
+    "NUM_8": 0x38,
+    "NUM_9": 0x39,
+    "A": 0x41,
+    "B": 0x42,
+    "C": 0x43,
+    "D": 0x44,
+    "E": 0x45,
+    "F": 0x46,
+    "G": 0x47,
+    "H": 0x48,
+    "I": 0x49,
+    "J": 0x4A,
+    "K": 0x4B,
+    "L": 0x4C,
+    "M": 0x4D,
+    "N": 0x4E,
+    "O": 0x4F,
+    "P": 0x50,
+    "Q": 0x51,
+    "R": 0x52,
+    "S": 0x53,
+    "T": 0x54,
+    "U": 0x55,
+    "V": 0x56,
+    "W": 0x57,
+    "X": 0x58,
+    "Y": 0x59,
+    "Z": 0x5A,
+    "LEFT_WIN": 0x5B,
+    "RIGHT_WIN": 0x5C,
+    "APPS": 0x5D,
+    "SLEEP": 0x5F,
+    "NUMPAD_0": 0x60,
+    "NUMPAD_1": 0x61,
+    "NUMPAD_2": 0x62,
+    "NUMPAD_3": 0x63,
+    "NUMPAD_4": 0x64,
+    "NUMPAD_5": 0x65,
+    "NUMPAD_6": 0x66,
+    "NUMPAD_7": 0x67,
+    "NUMPAD_8": 0x68,
+    "NUMPAD_9": 0x69,
+    "MULTIPLY": 0x6A,
+    "ADD": 0x6B,
+    "SEPARATOR": 0x6C,
+    "SUBTRACT": 0x6D,
+    "DECIMAL": 0x6E,
+    "DIVIDE": 0x6F,
+    "F1": 0x70,
+    "F2": 0x71,
+    "F3": 0x72,
+    "F4": 0x73,
+    "F5": 0x74,
+    "F6": 0x75,
+    "F7": 0x76,
+    "F8": 0x77,
+    "F9": 0x78,
+    "F10": 0x79,
+    "F11": 0x7A,
+    "F12": 0x7B,
+    "F13": 0x7C,
+    "F14": 0x7D,
+    "F15": 0x7E,
+    "F16": 0x7F,
+    "F17": 0x80,
+    "F18": 0x81,
+    "F19": 0x82,
+    "F20": 0x83,
+    "F21": 0x84,
+    "F22": 0x85,
+    "F23": 0x86,
+    "F24": 0x87,
+    "NUM_LOCK": 0x90,
+    "SCROLL_LOCK": 0x91,
+    "LEFT_SHIFT": 0xA0,
+    "RIGHT_SHIFT": 0xA1,
+    "LEFT_CONTROL": 0xA2,
+    "RIGHT_CONTROL": 0xA3,
+    "LEFT_ALT": 0xA4,
+    "RIGHT_ALT": 0xA5,
+    "BROWSER_BACK": 0xA6,
+    "BROWSER_FORWARD": 0xA7,
+    "BROWSER_REFRESH": 0xA8,
+    "BROWSER_STOP": 0xA9,
+    "BROWSER_SEARCH": 0xAA,
+    "BROWSER_FAVORITES": 0xAB,
+    "BROWSER_HOME": 0xAC,
+    "VOLUME_MUTE": 0xAD,
+    "VOLUME_DOWN": 0xAE,
+    "VOLUME_UP": 0xAF,
+    "MEDIA_NEXT_TRACK": 0xB0,
+    "MEDIA_PREV_TRACK": 0xB1,
+    "MEDIA_STOP": 0xB2,
+    "MEDIA_PLAY_PAUSE": 0xB3,
+    "LAUNCH_MAIL": 0xB4,
+    "LAUNCH_MEDIA_SELECT": 0xB5,
+    "LAUNCH_APP1": 0xB6,
+    "LAUNCH_APP2": 0xB7,
+    "OEM_1": 0xBA,
+    "OEM_PLUS": 0xBB,
+    "OEM_COMMA": 0xBC,
+    "OEM_MINUS": 0xBD,
+    "OEM_PERIOD": 0xBE,
+    "OEM_2": 0xBF,
+    "OEM_3": 0xC0,
+    "OEM_4": 0xDB,
+    "OEM_5": 0xDC,
+    "OEM_6": 0xDD,
+    "OEM_7": 0xDE,
+    "OEM_8": 0xDF,
+    "OEM_102": 0xE2,
+    "PROCESS_KEY": 0xE5,
+    "PACKET": 0xE7,
+    "ATTN": 0xF6,
+    "CRSEL": 0xF7,
+    "EXSEL": 0xF8,
+    "EREOF": 0xF9,
+    "PLAY": 0xFA,
+    "ZOOM": 0xFB,
+    "PA1": 0xFD,
+    "OEM_CLEAR": 0xFE,
+}
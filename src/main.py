@@ -6,6 +6,7 @@ Uses UI file created with Qt Designer.
 Author: Leonardo Klein
 """
 
+import os
 import sys
 import logging
 import configparser
@@ -20,7 +21,20 @@ import serial
 import serial.tools.list_ports
 import keyboard
 
+try:
+    import sim_native
+except ImportError:
+    sim_native = None
+
 from ui.main_ui import Ui_main_ui
+from protocol_decoder import (
+    DEVICE_KEYBOARD,
+    DEVICE_MOUSE,
+    SYNC_PREFIX,
+    create_decoder,
+    decode_line,
+)
+from clock_sync import ClockSync
 from key_mappings import (
     get_technical_key_name,
     get_friendly_key_name,
@@ -34,16 +48,44 @@ class SerialWorker(QThread):
     """
 
     data_received = Signal(str)
+    event_received = Signal(str, float)  # event log line, device time (epoch seconds)
     error_occurred = Signal(str)
     port_opened = Signal()
     port_closed = Signal()
     baud_rate_detected = Signal(int)
 
     COMMON_BAUD_RATES = [9600, 115200, 57600, 38400, 19200, 14400, 4800, 2400, 1200]
+    MAX_DUE_WAIT_NS = 10_000_000_000  # due times further ahead are not waited for
+    DUE_WAIT_SLICE_NS = 50_000_000  # longest sleep between checks for close_port()
+
+    MOUSE_EVENT_NAMES = (
+        "RIGHT BUTTON",
+        "RIGHT BUTTON",
+        "LEFT BUTTON",
+        "LEFT BUTTON",
+        "MIDDLE BUTTON",
+        "MIDDLE BUTTON",
+        "SCROLL WHEEL",
+        "CURSOR POSITION",
+        "CURSOR MOVEMENT",
+    )
+
+    MOUSE_EVENT_ACTIONS = (
+        "pressed",
+        "released",
+        "pressed",
+        "released",
+        "pressed",
+        "released",
+        "scrolled",
+        "positioned",
+        "moved",
+    )
 
     def __init__(self, keyboard_emulator=None, mouse_emulator=None, config_manager=None):
         super().__init__()
         self.serial_connection: Optional[serial.Serial] = None
+        self.native_reader = None
         self.running = False
         self.port_name = ""
         self.baud_rate = 9600
@@ -51,6 +93,8 @@ class SerialWorker(QThread):
         self.keyboard_emulator = keyboard_emulator
         self.mouse_emulator = mouse_emulator
         self.config_manager = config_manager
+        self.clock_sync = ClockSync()
+        self.event_time = None
 
     def get_prioritized_baud_rates(self, preferred_rate: int) -> list:
         """
@@ -220,12 +264,15 @@ class SerialWorker(QThread):
             else:
                 self.data_received.emit(f"Using configured baud rate: {self.baud_rate}")
 
-            timeout_val = 1.0
-            if self.config_manager:
-                timeout_val = self.config_manager.get_serial_timeout()
-            self.serial_connection = serial.Serial(
-                port=self.port_name, baudrate=detected_baud, timeout=timeout_val
-            )
+            self.clock_sync.reset()
+            self.native_reader = self.open_native_reader(detected_baud)
+            if self.native_reader is None:
+                timeout_val = 1.0
+                if self.config_manager:
+                    timeout_val = self.config_manager.get_serial_timeout()
+                self.serial_connection = serial.Serial(
+                    port=self.port_name, baudrate=detected_baud, timeout=timeout_val
+                )
             self.running = True
             self.data_received.emit(
                 f"Port {self.port_name} opened successfully at {detected_baud} baud"
@@ -237,9 +284,33 @@ class SerialWorker(QThread):
             self.error_occurred.emit(error_msg)
             logging.exception(error_msg)
 
+    def open_native_reader(self, baud_rate: int):
+        """
+        Open the port with the native poll()-based reader, if available.
+
+        :param baud_rate: Baud rate to use
+        :return: sim_native.SerialReader or None to fall back to pyserial
+        """
+        if sim_native is None or not hasattr(sim_native, "SerialReader"):
+            return None
+        try:
+            return sim_native.SerialReader(self.port_name, baud_rate)
+        except OSError as e:
+            logging.info(f"Native reader unavailable, using pyserial: {e}")
+            return None
+
     def close_port(self):
         """Close serial connection."""
         self.running = False
+        if self.native_reader is not None:
+            # The reader thread polls with a short timeout; let it exit
+            # before the descriptor is closed under it.
+            self.wait()
+            self.native_reader.close()
+            self.native_reader = None
+            self.data_received.emit(f"Port {self.port_name} closed")
+            self.port_closed.emit()
+            return
         if self.serial_connection and self.serial_connection.is_open:
             try:
                 self.serial_connection.close()
@@ -253,15 +324,22 @@ class SerialWorker(QThread):
 
     def run(self):
         """Main serial reading loop."""
+        if self.native_reader is not None:
+            self.run_native()
+            return
+
+        decoder = create_decoder()
         while (
             self.running and self.serial_connection and self.serial_connection.is_open
         ):
             try:
-                if self.serial_connection.in_waiting > 0:
-                    data = self.serial_connection.readline().decode("utf-8").strip()
-                    if data:
-                        self.parse_received_data(data)
-                self.msleep(10)
+                waiting = self.serial_connection.in_waiting
+                if waiting > 0:
+                    data = self.serial_connection.read(waiting)
+                    received_ns = time.monotonic_ns()
+                    self.handle_items(decoder.feed(data), received_ns)
+                else:
+                    self.msleep(10)
             except Exception as e:
                 if self.running:
                     error_msg = f"Serial reading error: {str(e)}"
@@ -269,74 +347,165 @@ class SerialWorker(QThread):
                     logging.exception(error_msg)
                 break
 
+    def run_native(self):
+        """Reading loop using the native reader (blocks in poll, no sleep)."""
+        while self.running:
+            try:
+                items = self.native_reader.read_events(100)
+                self.handle_items(items, time.monotonic_ns())
+            except Exception as e:
+                if self.running:
+                    error_msg = f"Serial reading error: {str(e)}"
+                    self.error_occurred.emit(error_msg)
+                    logging.exception(error_msg)
+                break
+
+    def handle_items(self, items: list, received_ns: Optional[int] = None):
+        """
+        Dispatch a batch of decoded items.
+
+        :param items: (device, event, param1, param2[, device_us[, due]])
+                      tuples and str lines
+        :param received_ns: time.monotonic_ns() when the batch was read
+        """
+        for item in items:
+            try:
+                if type(item) is tuple:
+                    self.handle_event(*item)
+                elif item.lstrip().startswith(SYNC_PREFIX):
+                    self.handle_sync(item, received_ns)
+                else:
+                    self.handle_text(item)
+            except Exception:
+                logging.exception(f"Error handling data: {item}")
+                self.data_received.emit(f"Critical error parsing data: {item}")
+
     def parse_received_data(self, data: str):
         """
-        Parse data received from Arduino and emit formatted logs.
+        Parse one line received from Arduino and emit formatted logs.
 
         :param data: Data received from serial port
         """
-        try:
-            data = data.strip()
-            if not data:
-                return
-
-            if data.startswith("#"):
-                comment_msg = f"<span style='color:#888888; font-style:italic;'>Comment: {data[1:].strip()}</span>"
-                self.data_received.emit(comment_msg)
-                return
-
-            parts = data.split()
-
-            if len(parts) >= 3:
-                device = parts[0]
-                event = parts[1]
-                key_code = parts[2]
-
-                try:
-                    device_num = int(device)
-                    event_num = int(event)
-                except ValueError:
-                    formatted_data = self.format_unknown_data(data)
-                    self.data_received.emit(formatted_data)
-                    return
-
-                if device_num == 1:
-                    if event_num in [0, 1]:
-                        key_name = get_technical_key_name(key_code)
-                        friendly_name = get_friendly_key_name(key_code)
-                        action = "pressed" if event_num == 1 else "released"
-                        log_msg = f"{friendly_name} (0x{key_code.upper()} {key_name}) {action}"
-                        self.data_received.emit(log_msg)
-                        
-                        if event_num == 1:
-                            if self.keyboard_emulator:
-                                self.keyboard_emulator.press_key(key_code)
-                        else:
-                            if self.keyboard_emulator:
-                                self.keyboard_emulator.release_key(key_code)
-                    else:
-                        self.data_received.emit(
-                            f"Invalid keyboard event (event={event_num}, key={key_code})"
-                        )
+        data = data.strip()
+        if data:
+            self.handle_items([decode_line(data)])
 
-                elif device_num == 0:
-                    self.parse_mouse_event(event, parts[2:])
+    def handle_text(self, data: str):
+        """
+        Handle a comment or unrecognised line.
 
-                else:
-                    formatted_data = self.format_unknown_data(data)
-                    self.data_received.emit(formatted_data)
+        :param data: Line text
+        """
+        data = data.strip()
+        if data.startswith("#"):
+            comment_msg = f"<span style='color:#888888; font-style:italic;'>Comment: {data[1:].strip()}</span>"
+            self.data_received.emit(comment_msg)
+        else:
+            self.data_received.emit(self.format_unknown_data(data))
+
+    def handle_sync(self, line: str, received_ns: Optional[int]):
+        """
+        Answer a clock sync ping and take in the device's reports.
 
+        :param line: Sync line ('~' prefix)
+        :param received_ns: time.monotonic_ns() when the line was read
+        """
+        if received_ns is None:
+            received_ns = time.monotonic_ns()
+        answer = self.clock_sync.handle_line(line, received_ns)
+        if answer:
+            if self.native_reader is not None:
+                os.write(self.native_reader.fileno(), answer)
+            elif self.serial_connection and self.serial_connection.is_open:
+                self.serial_connection.write(answer)
+
+    def device_event_time(self, device_us: Optional[int]) -> Optional[float]:
+        """
+        Convert an event's device timestamp to wall-clock time.
+
+        :param device_us: Device micros() of the event, None if not stamped
+        :return: Seconds since the epoch, None when unknown
+        """
+        if device_us is None or not self.clock_sync.synced:
+            return None
+        host_ns = self.clock_sync.to_host_ns(device_us)
+        return (time.time_ns() - time.monotonic_ns() + host_ns) / 1e9
+
+    def wait_until_due(self, due_us: int):
+        """
+        Sleep until a scheduled event's due time.
+
+        Events arrive in due order, so waiting in this thread keeps their
+        order. Ping answers sent after a wait carry the wait in their
+        turnaround, which the clock estimate subtracts. The wait ends
+        early once close_port() clears self.running.
+
+        :param due_us: Device micros() at which the event should run
+        """
+        if not self.clock_sync.synced:
+            return
+        now_ns = time.monotonic_ns()
+        deadline_ns = now_ns + min(self.clock_sync.to_host_ns(due_us) - now_ns, self.MAX_DUE_WAIT_NS)
+        while self.running:
+            remaining_ns = deadline_ns - time.monotonic_ns()
+            if remaining_ns <= 0:
+                break
+            time.sleep(min(remaining_ns, self.DUE_WAIT_SLICE_NS) / 1e9)
+
+    def emit_event_log(self, message: str):
+        """
+        Emit the log line of the event being handled, with its device time.
+
+        :param message: Log line
+        """
+        if self.event_time is None:
+            self.data_received.emit(message)
+        else:
+            self.event_received.emit(message, self.event_time)
+
+    def handle_event(
+        self,
+        device: int,
+        event: int,
+        param1: int,
+        param2: int,
+        device_us: Optional[int] = None,
+        due: bool = False,
+    ):
+        """
+        Handle a decoded event frame.
+
+        :param device: Device (0 mouse, 1 keyboard)
+        :param event: Event code
+        :param param1: First parameter (key code for keyboard events)
+        :param param2: Second parameter
+        :param device_us: Device micros() when the event was generated, if stamped
+        :param due: device_us is when the event should run (scheduled playback)
+        """
+        if due:
+            self.wait_until_due(device_us)
+        self.event_time = self.device_event_time(device_us)
+        if device == DEVICE_KEYBOARD:
+            key_code = f"{param1:02X}"
+            if event in (0, 1):
+                key_name = get_technical_key_name(key_code)
+                friendly_name = get_friendly_key_name(key_code)
+                action = "pressed" if event == 1 else "released"
+                log_msg = f"{friendly_name} (0x{key_code} {key_name}) {action}"
+                self.emit_event_log(log_msg)
+
+                if self.keyboard_emulator:
+                    if event == 1:
+                        self.keyboard_emulator.press_key(key_code)
+                    else:
+                        self.keyboard_emulator.release_key(key_code)
             else:
-                formatted_data = self.format_unknown_data(data)
-                self.data_received.emit(formatted_data)
+                self.data_received.emit(
+                    f"Invalid keyboard event (event={event}, key={key_code})"
+                )
 
-        except Exception:
-            logging.exception(f"Error parsing data: {data}")
-            try:
-                formatted_data = self.format_unknown_data(data)
-                self.data_received.emit(formatted_data)
-            except Exception:
-                self.data_received.emit(f"Critical error parsing data: {data}")
+        elif device == DEVICE_MOUSE:
+            self.parse_mouse_event(event, param1, param2)
 
     def format_unknown_data(self, data: str) -> str:
         """
@@ -423,80 +592,48 @@ class SerialWorker(QThread):
             else:
                 return f"Unrecognized data format ({data}) received"
 
-    def parse_mouse_event(self, event: str, params: list):
+    def parse_mouse_event(self, event: int, param1: int, param2: int):
         """
         Parse mouse events.
 
         :param event: Mouse event type
-        :param params: Event parameters
+        :param param1: First parameter (X, delta)
+        :param param2: Second parameter (Y)
         """
-        event_map = {
-            "0": "RIGHT BUTTON",
-            "1": "RIGHT BUTTON",
-            "2": "LEFT BUTTON",
-            "3": "LEFT BUTTON",
-            "4": "MIDDLE BUTTON",
-            "5": "MIDDLE BUTTON",
-            "6": "SCROLL WHEEL",
-            "7": "CURSOR POSITION",
-            "8": "CURSOR MOVEMENT",
-        }
-
-        action_map = {
-            "0": "pressed",
-            "1": "released",
-            "2": "pressed",
-            "3": "released",
-            "4": "pressed",
-            "5": "released",
-            "6": "scrolled",
-            "7": "positioned",
-            "8": "moved",
-        }
-
-        event_name = event_map.get(event, "UNKNOWN MOUSE EVENT")
-        action = action_map.get(event, "detected")
+        if event < len(self.MOUSE_EVENT_NAMES):
+            event_name = self.MOUSE_EVENT_NAMES[event]
+            action = self.MOUSE_EVENT_ACTIONS[event]
+        else:
+            event_name = "UNKNOWN MOUSE EVENT"
+            action = "detected"
 
         # Execute mouse actions if emulator is available and enabled
         if self.mouse_emulator and self.mouse_emulator.enabled:
             try:
-                if event == "2":  # Left button pressed
+                if event == 2:  # Left button pressed
                     self.mouse_emulator.click_left()
-                elif event == "0":  # Right button pressed
+                elif event == 0:  # Right button pressed
                     self.mouse_emulator.click_right()
-                elif event == "4":  # Middle button pressed (not implemented in MouseEmulator)
+                elif event == 4:  # Middle button pressed (not implemented in MouseEmulator)
                     pass
-                elif event == "6" and len(params) >= 1:  # Scroll wheel
-                    delta = int(params[0])
-                    self.mouse_emulator.scroll(delta)
-                elif event in ["7", "8"] and len(params) >= 2:  # Position/Movement
-                    x, y = int(params[0]), int(params[1])
-                    if event == "7":  # Position
-                        self.mouse_emulator.set_position(x, y)
-                    else:  # Movement (relative)
-                        self.mouse_emulator.move_relative(x, y)
+                elif event == 6:  # Scroll wheel
+                    self.mouse_emulator.scroll(param1)
+                elif event == 7:  # Position
+                    self.mouse_emulator.set_position(param1, param2)
+                elif event == 8:  # Movement (relative)
+                    self.mouse_emulator.move_relative(param1, param2)
             except Exception as e:
                 self.data_received.emit(f"Mouse emulation error: {str(e)}")
 
-        if len(params) >= 2 and event in ["7", "8"]:
-            log_msg = (
-                f"Mouse {event_name.lower()} (X={params[0]}, Y={params[1]}) {action}"
-            )
-        elif len(params) >= 1 and event == "6":
-            direction = (
-                "up"
-                if int(params[0]) > 0
-                else "down"
-                if int(params[0]) < 0
-                else "neutral"
-            )
-            log_msg = (
-                f"Mouse {event_name.lower()} (delta={params[0]}) scrolled {direction}"
-            )
+        if event in (7, 8):
+            log_msg = f"Mouse {event_name.lower()} (X={param1}, Y={param2}) {action}"
+        elif event == 6:
+            direction = "up" if param1 > 0 else "down" if param1 < 0 else "neutral"
+            log_msg = f"Mouse {event_name.lower()} (delta={param1}) scrolled {direction}"
         else:
             log_msg = f"Mouse {event_name.lower()} {action}"
 
-        self.data_received.emit(log_msg)
+        self.emit_event_log(log_msg)
 
 
 class MouseEmulator:
@@ -821,6 +958,7 @@ class MainWindow(QDialog):
         self.edit_hotkey_stop.installEventFilter(self)
 
         self.serial_worker.data_received.connect(self.append_log)
+        self.serial_worker.event_received.connect(self.append_log)
         self.serial_worker.error_occurred.connect(self.show_error)
         self.serial_worker.port_opened.connect(self.on_port_opened)
         self.serial_worker.port_closed.connect(self.on_port_closed)
@@ -1122,12 +1260,21 @@ class MainWindow(QDialog):
 
         self.repaint()
 
-    def append_log(self, message: str):
-        """Add message to log with HTML formatting for technical details."""
+    def append_log(self, message: str, event_time: Optional[float] = None):
+        """
+        Add message to log with HTML formatting for technical details.
+
+        :param message: Log line
+        :param event_time: Device time of an event (epoch seconds), shown with
+                           microseconds instead of the time the line is logged
+        """
         from datetime import datetime
         from PySide6.QtGui import QTextCursor
 
-        timestamp = datetime.now().strftime("%H:%M:%S")
+        if event_time is not None:
+            timestamp = datetime.fromtimestamp(event_time).strftime("%H:%M:%S.%f")
+        else:
+            timestamp = datetime.now().strftime("%H:%M:%S")
 
         # Check max log lines and truncate if needed
         max_lines = self.config_manager.get_max_log_lines()
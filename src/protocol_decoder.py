@@ -0,0 +1,409 @@
+"""
+Serial Input Monitor protocol decoder.
+Turns received bytes into decoded items: (device, event, param1, param2)
+tuples for event frames and str for comments, clock sync lines and
+unrecognised lines. Events stamped by a synced device carry their device
+time as a fifth element: (device, event, param1, param2, device_us).
+Events sent ahead for scheduled playback carry the device time at which
+they are due instead, flagged by a sixth element:
+(device, event, param1, param2, due_us, True).
+
+Framed lines (CRC token or FEC frame, see SerialInputProtocol.h) are
+checked and unwrapped first; damaged ones come back as the raw line
+text and are counted by framing_stats(). Once a framed event has been
+seen, plain events are treated as damaged too.
+
+Text lines (">POS PAYLOAD", see TextWindow) come back as the key event
+tuples that type their characters; the decoder mirrors the device's
+window to resolve their back-references.
+
+Uses the native sim_native.Decoder when it is built (GIL released while
+parsing) and an equivalent pure-Python decoder otherwise.
+
+Author: Leonardo Klein
+"""
+
+try:
+    import sim_native
+except ImportError:
+    sim_native = None
+
+DEVICE_MOUSE = 0
+DEVICE_KEYBOARD = 1
+
+SYNC_PREFIX = "~"
+STAMP_PREFIX = "@"
+DUE_PREFIX = "!"
+
+CRC_PREFIX = b"%"
+FEC_PREFIX = ord("$")
+CRC_INIT = 0xFFFF
+
+TEXT_PREFIX = b">"
+TEXT_ESCAPE = 0x7F
+TEXT_MATCH_MIN = 3
+TEXT_DISTANCE_MAX = 512
+
+KEY_PRESS = 1
+KEY_RELEASE = 0
+KEY_LEFT_SHIFT = 0xA0
+
+MAX_LINE = 128
+INT32_MIN = -(2**31)
+INT32_MAX = 2**31 - 1
+HEX_DIGITS = frozenset("0123456789abcdefABCDEF")
+DEC_DIGITS = frozenset("0123456789")
+
+
+def crc16(data: bytes, crc: int = CRC_INIT) -> int:
+    """
+    CRC-16/CCITT-FALSE (polynomial 0x1021), as crc16Update() on the device.
+
+    :param data: Bytes to add
+    :param crc: CRC so far
+    :return: Updated CRC
+    """
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+        crc &= 0xFFFF
+    return crc
+
+
+def fec_encode_nibble(nibble: int) -> int:
+    """
+    Extended Hamming(8,4) codeword of a nibble, as fecEncodeNibble().
+
+    :param nibble: Value 0-15
+    :return: Codeword byte
+    """
+    nibble &= 0x0F
+    odd = bin(nibble).count("1") & 1
+    return nibble << 4 | (nibble ^ 0x0F if odd else nibble)
+
+
+# Received byte -> (nibble, corrected bits), None beyond one flipped bit
+FEC_DECODE = [None] * 256
+for _nibble in range(16):
+    _code = fec_encode_nibble(_nibble)
+    FEC_DECODE[_code] = (_nibble, 0)
+    for _bit in range(8):
+        FEC_DECODE[_code ^ (1 << _bit)] = (_nibble, 1)
+
+
+# Keys of characters on a US layout, as characterKey(); SPACE otherwise
+CHARACTER_KEYS = {" ": 0x20, "\t": 0x09, "\r": 0x0D, "\n": 0x0D, "\b": 0x08}
+CHARACTER_KEYS.update({chr(code): code for code in range(ord("0"), ord("9") + 1)})
+CHARACTER_KEYS.update({chr(code): code for code in range(ord("A"), ord("Z") + 1)})
+CHARACTER_KEYS.update({chr(code + 32): code for code in range(ord("A"), ord("Z") + 1)})
+CHARACTER_KEYS.update(
+    zip(
+        ",./;'[]\\`-=",
+        (0xBC, 0xBE, 0xBF, 0xBA, 0xDE, 0xDB, 0xDD, 0xDC, 0xC0, 0xBD, 0xBB),
+    )
+)
+CHARACTER_KEYS.update(
+    zip("!@#$%^&*()", (0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x30))
+)
+CHARACTER_KEYS.update(
+    zip(
+        '_+{}|:"<>?~',
+        (0xBD, 0xBB, 0xDB, 0xDD, 0xDC, 0xBA, 0xDE, 0xBC, 0xBE, 0xBF, 0xC0),
+    )
+)
+SHIFTED_CHARACTERS = frozenset('!@#$%^&*()_+{}|:"<>?~ABCDEFGHIJKLMNOPQRSTUVWXYZ')
+
+
+def character_events(character: str) -> list:
+    """
+    Key events that type one character, as typeCharacter() sends them.
+
+    :param character: Character to type
+    :return: Event tuples, Shift around shifted characters
+    """
+    key = CHARACTER_KEYS.get(character, 0x20)
+    events = [
+        (DEVICE_KEYBOARD, KEY_PRESS, key, 0),
+        (DEVICE_KEYBOARD, KEY_RELEASE, key, 0),
+    ]
+    if character in SHIFTED_CHARACTERS:
+        events.insert(0, (DEVICE_KEYBOARD, KEY_PRESS, KEY_LEFT_SHIFT, 0))
+        events.append((DEVICE_KEYBOARD, KEY_RELEASE, KEY_LEFT_SHIFT, 0))
+    return events
+
+
+def text_tokens(payload: bytes):
+    """
+    Split a text line payload into tokens, as ProtocolDecoder::textToken().
+
+    :param payload: Bytes after the line header
+    :return: List of (character code, 0) and (length, distance) pairs,
+             None when malformed
+    """
+    tokens = []
+    index = 0
+    while index < len(payload):
+        byte = payload[index]
+        index += 1
+        if 0x20 <= byte < TEXT_ESCAPE and byte != CRC_PREFIX[0]:
+            tokens.append((byte, 0))
+            continue
+        if index == len(payload):
+            return None
+        following = payload[index]
+        index += 1
+        if byte == TEXT_ESCAPE and following < 0x80:
+            tokens.append((following ^ 0x40, 0))
+        elif byte >= 0x80 and following >= 0x80:
+            distance = ((byte & 0x03) << 7 | (following & 0x7F)) + 1
+            tokens.append((((byte >> 2) & 0x1F) + TEXT_MATCH_MIN, distance))
+        else:
+            return None
+    return tokens
+
+
+def strip_return(raw: bytes) -> bytes:
+    """Drop one trailing carriage return, as the native decoder does."""
+    return raw[:-1] if raw.endswith(b"\r") else raw
+
+
+def unframe_line(raw: bytes):
+    """
+    Check and unwrap one framed line, as ProtocolDecoder::unframe().
+
+    :param raw: Line without its newline
+    :return: (text, framed, corrected bits); text is None when the line
+             is framed but damaged beyond repair
+    """
+    prefix_diff = raw[0] ^ FEC_PREFIX if raw else 0xFF
+    if prefix_diff & (prefix_diff - 1) == 0:
+        codes = raw[1:]
+        if len(codes) % 2 == 1 and codes.endswith(b"\r"):
+            codes = codes[:-1]
+        decoded = [FEC_DECODE[code] for code in codes]
+        if len(codes) % 2 == 0 and len(codes) >= 6 and None not in decoded:
+            pairs = zip(decoded[::2], decoded[1::2])
+            data = bytes(high[0] << 4 | low[0] for high, low in pairs)
+            if crc16(data[:-2]) == int.from_bytes(data[-2:], "big"):
+                flips = sum(flip for _, flip in decoded) + (prefix_diff != 0)
+                return data[:-2], True, flips
+        if prefix_diff == 0:
+            return None, False, 0
+
+    text = strip_return(raw)
+    if len(text) >= 6 and text[-6:-4] == b" " + CRC_PREFIX:
+        token = text[-4:].decode("ascii", "replace")
+        if not HEX_DIGITS.issuperset(token) or crc16(text[:-6]) != int(token, 16):
+            return None, False, 0
+        return text[:-6], True, 0
+    return text, False, 0
+
+
+def parse_token(token: str, hexadecimal: bool = False) -> int:
+    """
+    Parse one integer token as strictly as the native decoder.
+
+    :param token: Token text: optional sign, optional 0x when hexadecimal, digits
+    :param hexadecimal: Parse as hexadecimal
+    :return: Value
+    :raises ValueError: If the token is not a number or does not fit an int32
+    """
+    digits = token[1:] if token[:1] in ("+", "-") else token
+    if hexadecimal and len(digits) > 2 and digits[:2] in ("0x", "0X"):
+        digits = digits[2:]
+    if not digits or not (HEX_DIGITS if hexadecimal else DEC_DIGITS).issuperset(digits):
+        raise ValueError(token)
+    value = int(digits, 16 if hexadecimal else 10)
+    value = -value if token[:1] == "-" else value
+    if not INT32_MIN <= value <= INT32_MAX:
+        raise ValueError(token)
+    return value
+
+
+def decode_line(line: str):
+    """
+    Decode one line without terminator.
+
+    :param line: Line text
+    :return: (device, event, param1, param2[, device_us[, True]]) for event
+             frames, else the line
+    """
+    stripped = line.strip(" \t")
+    if not stripped or stripped.startswith(("#", SYNC_PREFIX)):
+        return line
+
+    parts = [part for part in stripped.replace("\t", " ").split(" ") if part]
+    device_us = None
+    due = False
+    if len(parts) >= 3 and parts[-1].startswith((STAMP_PREFIX, DUE_PREFIX)):
+        due = parts[-1].startswith(DUE_PREFIX)
+        stamp = parts.pop()[1:]
+        if not 1 <= len(stamp) <= 8 or not HEX_DIGITS.issuperset(stamp):
+            return line
+        device_us = int(stamp, 16)
+    if len(parts) < 2 or len(parts) > 4:
+        return line
+
+    try:
+        device = parse_token(parts[0])
+        event = parse_token(parts[1])
+        # Key codes are hexadecimal, the second parameter never is
+        keyboard = device == DEVICE_KEYBOARD
+        params = [
+            parse_token(part, keyboard and index == 0)
+            for index, part in enumerate(parts[2:])
+        ]
+    except ValueError:
+        return line
+
+    if device not in (DEVICE_MOUSE, DEVICE_KEYBOARD) or not 0 <= event <= 255:
+        return line
+
+    params += [0] * (2 - len(params))
+    if due:
+        return (device, event, params[0], params[1], device_us, True)
+    if device_us is not None:
+        return (device, event, params[0], params[1], device_us)
+    return (device, event, params[0], params[1])
+
+
+class PythonDecoder:
+    """
+    Pure-Python fallback with the same interface as sim_native.Decoder.
+    """
+
+    def __init__(self):
+        self.partial = b""
+        self.overflow = False
+        self.framed = False
+        self.text_known = 0
+        self.corrected_bits = 0
+        self.rejected_frames = 0
+        self.text_window = bytearray(TEXT_DISTANCE_MAX)
+        self.text_position = 0
+        self.text_known = 0
+
+    def feed(self, data: bytes) -> list:
+        """
+        Decode received bytes, keeping a trailing partial line.
+
+        :param data: Received bytes
+        :return: List of decoded items
+        """
+        lines = bytes(data).split(b"\n")
+        rest = lines.pop()
+        if lines and (self.partial or self.overflow):
+            # A line longer than MAX_LINE across reads is reported empty
+            too_long = len(self.partial) + len(lines[0]) > MAX_LINE
+            lines[0] = None if self.overflow or too_long else self.partial + lines[0]
+            self.partial = b""
+            self.overflow = False
+        if len(self.partial) + len(rest) > MAX_LINE:
+            self.partial = b""
+            self.overflow = True
+        elif not self.overflow:
+            self.partial += rest
+
+        items = []
+        for raw in lines:
+            if raw is None:
+                items.append("")
+                continue
+            text, framed, flips = unframe_line(raw)
+            if text is None:
+                self.rejected_frames += 1
+                items.append(strip_return(raw).decode("utf-8", "ignore"))
+                continue
+            if not text:
+                continue
+            if text.startswith(TEXT_PREFIX):
+                damaged = not framed and self.framed
+                events = None if damaged else self.decode_text(text)
+                if events is None:
+                    self.rejected_frames += damaged
+                    self.text_known = 0
+                    items.append(text.decode("utf-8", "ignore"))
+                else:
+                    self.framed = self.framed or framed
+                    items += events
+                self.corrected_bits += flips
+                continue
+            # Parse with damaged bytes kept in place, so they fail the line
+            item = decode_line(text.decode("utf-8", "replace"))
+            if isinstance(item, tuple) and not framed and self.framed:
+                self.rejected_frames += 1
+                item = None
+            elif isinstance(item, tuple):
+                self.framed = self.framed or framed
+            if not isinstance(item, tuple):
+                item = text.decode("utf-8", "ignore")
+            self.corrected_bits += flips
+            items.append(item)
+        return items
+
+    def decode_text(self, text: bytes):
+        """
+        Type the characters of a text line, as ProtocolDecoder::emitText().
+
+        :param text: Line text starting with TEXT_PREFIX
+        :return: Key event tuples, None if the line is malformed or
+                 refers to text not received
+        """
+        header, space, payload = text[1:].partition(b" ")
+        header = header.decode("ascii", "replace")
+        if not space or not 1 <= len(header) <= 4 or not HEX_DIGITS.issuperset(header):
+            return None
+        tokens = text_tokens(payload)
+        if tokens is None:
+            return None
+
+        position = int(header, 16)
+        known = self.text_known if position == self.text_position else 0
+        for value, distance in tokens:
+            if distance > known:
+                return None
+            known = min(known + (value if distance else 1), TEXT_DISTANCE_MAX)
+        if position != self.text_position:
+            self.text_position = position
+            self.text_known = 0
+
+        events = []
+        mask = TEXT_DISTANCE_MAX - 1
+        for value, distance in tokens:
+            for _ in range(value if distance else 1):
+                if distance:
+                    value_at = self.text_window[(self.text_position - distance) & mask]
+                else:
+                    value_at = value
+                self.text_window[self.text_position & mask] = value_at
+                self.text_position = (self.text_position + 1) & 0xFFFF
+                self.text_known = min(self.text_known + 1, TEXT_DISTANCE_MAX)
+                events += character_events(chr(value_at))
+        return events
+
+    def framing_stats(self) -> tuple:
+        """
+        Framing counters since creation.
+
+        :return: (bits corrected in FEC frames, lines dropped as damaged)
+        """
+        return (self.corrected_bits, self.rejected_frames)
+
+    def reset(self):
+        """Drop any buffered partial line."""
+        self.partial = b""
+        self.overflow = False
+        self.framed = False
+        self.text_known = 0
+
+
+def create_decoder():
+    """
+    Create the fastest available decoder.
+
+    :return: sim_native.Decoder or PythonDecoder
+    """
+    if sim_native is not None:
+        return sim_native.Decoder()
+    return PythonDecoder()